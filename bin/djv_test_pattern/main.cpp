@@ -47,13 +47,14 @@ namespace djv
             static std::shared_ptr<Application> create(std::list<std::string>&);
 
             void run() override;
-            void tick() override;
 
         protected:
             void _parseCmdLine(std::list<std::string>&) override;
             void _printUsage() override;
 
         private:
+            void _writeUpdate();
+
             std::string _output;
             std::unique_ptr<size_t> _frameCount;
             std::unique_ptr<AV::Image::Size> _size;
@@ -65,6 +66,7 @@ namespace djv
             std::shared_ptr<AV::OpenGL::OffscreenBuffer> _offscreenBuffer;
             std::shared_ptr<AV::Render2D::Render> _render;
             std::shared_ptr<AV::IO::IWrite> _write;
+            std::shared_ptr<Core::Time::Timer> _writeTimer;
             std::shared_ptr<Core::Time::Timer> _statsTimer;
         };
 
@@ -114,6 +116,16 @@ namespace djv
                 Core::Frame::Sequence(1, *_frameCount));
             _write = io->write(fileInfo, ioInfo, writeOptions);
 
+            // The frames are written on every tick of the event loop.
+            _writeTimer = Core::Time::Timer::create(shared_from_this());
+            _writeTimer->setRepeating(true);
+            _writeTimer->start(
+                Core::Time::Duration::zero(),
+                [this](const std::chrono::steady_clock::time_point&, const Core::Time::Duration&)
+                {
+                    _writeUpdate();
+                });
+
             _statsTimer = Core::Time::Timer::create(shared_from_this());
             _statsTimer->setRepeating(true);
             _statsTimer->start(
@@ -126,9 +138,8 @@ namespace djv
             CmdLine::Application::run();
         }
 
-        void Application::tick()
+        void Application::_writeUpdate()
         {
-            CmdLine::Application::tick();
             {
                 std::lock_guard<std::mutex> writeLock(_write->getMutex());
                 auto& writeQueue = _write->getVideoQueue();
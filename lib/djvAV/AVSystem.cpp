@@ -13,6 +13,7 @@
 #include <djvAV/Render3D.h>
 #include <djvAV/ShaderSystem.h>
 #include <djvAV/ThumbnailSystem.h>
+#include <djvAV/WaveformSystem.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/Error.h>
@@ -37,6 +38,7 @@ namespace djv
             std::shared_ptr<ValueSubject<bool> > textLCDRendering;
             std::shared_ptr<Font::System> fontSystem;
             std::shared_ptr<ThumbnailSystem> thumbnailSystem;
+            std::shared_ptr<WaveformSystem> waveformSystem;
             std::shared_ptr<Render2D::Render> render2D;
         };
 
@@ -56,6 +58,7 @@ namespace djv
             auto ioSystem = IO::System::create(context);
             p.fontSystem = Font::System::create(context);
             p.thumbnailSystem = ThumbnailSystem::create(context);
+            p.waveformSystem = WaveformSystem::create(context);
             auto shaderSystem = Render::ShaderSystem::create(context);
             p.render2D = Render2D::Render::create(context);
             auto render3D = Render3D::Render::create(context);
@@ -66,6 +69,7 @@ namespace djv
             addDependency(ioSystem);
             addDependency(p.fontSystem);
             addDependency(p.thumbnailSystem);
+            addDependency(p.waveformSystem);
             addDependency(shaderSystem);
             addDependency(p.render2D);
             addDependency(render3D);
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/AudioRingBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            void RingBuffer::_init(const Info& info, size_t sampleCount)
+            {
+                _info = info;
+                _info.sampleCount = sampleCount;
+                _sampleByteCount = info.channelCount * Audio::getByteCount(info.type);
+                _data.resize(sampleCount * _sampleByteCount);
+                _size = sampleCount;
+            }
+
+            RingBuffer::RingBuffer() :
+                _writePos(0),
+                _readPos(0),
+                _started(false),
+                _finished(false),
+                _underrunCount(0)
+            {}
+
+            RingBuffer::~RingBuffer()
+            {}
+
+            std::shared_ptr<RingBuffer> RingBuffer::create(const Info& info, size_t sampleCount)
+            {
+                auto out = std::shared_ptr<RingBuffer>(new RingBuffer);
+                out->_init(info, sampleCount);
+                return out;
+            }
+
+            size_t RingBuffer::write(const uint8_t* data, size_t sampleCount)
+            {
+                const size_t writePos = _writePos.load(std::memory_order_relaxed);
+                const size_t readPos = _readPos.load(std::memory_order_acquire);
+                const size_t count = std::min(sampleCount, _size - (writePos - readPos));
+                if (count > 0)
+                {
+                    // Copy the samples in up to two pieces around the end of the buffer.
+                    const size_t offset = writePos % _size;
+                    const size_t size = std::min(count, _size - offset);
+                    memcpy(_data.data() + offset * _sampleByteCount, data, size * _sampleByteCount);
+                    memcpy(_data.data(), data + size * _sampleByteCount, (count - size) * _sampleByteCount);
+                    _writePos.store(writePos + count, std::memory_order_release);
+                    _started.store(true, std::memory_order_release);
+                }
+                return count;
+            }
+
+            size_t RingBuffer::read(uint8_t* data, size_t sampleCount, float volume)
+            {
+                const size_t readPos = _readPos.load(std::memory_order_relaxed);
+                const size_t writePos = _writePos.load(std::memory_order_acquire);
+                const size_t count = std::min(sampleCount, writePos - readPos);
+                if (count < sampleCount &&
+                    _started.load(std::memory_order_acquire) &&
+                    !_finished.load(std::memory_order_acquire))
+                {
+                    _underrunCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (count > 0)
+                {
+                    const size_t offset = readPos % _size;
+                    const size_t size = std::min(count, _size - offset);
+                    Data::volume(
+                        _data.data() + offset * _sampleByteCount,
+                        data,
+                        volume,
+                        size,
+                        _info.channelCount,
+                        _info.type);
+                    Data::volume(
+                        _data.data(),
+                        data + size * _sampleByteCount,
+                        volume,
+                        count - size,
+                        _info.channelCount,
+                        _info.type);
+                    _readPos.store(readPos + count, std::memory_order_release);
+                }
+                return count;
+            }
+
+            void RingBuffer::clear()
+            {
+                _readPos.store(_writePos.load(std::memory_order_acquire), std::memory_order_release);
+                _started.store(false, std::memory_order_release);
+                _finished.store(false, std::memory_order_release);
+            }
+
+            void RingBuffer::resetCounters()
+            {
+                _underrunCount.store(0, std::memory_order_relaxed);
+            }
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
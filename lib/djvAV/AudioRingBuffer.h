@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/AudioData.h>
+
+#include <atomic>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            //! This class provides a single producer, single consumer ring buffer
+            //! of audio samples.
+            //!
+            //! The memory is allocated when the buffer is created. Writing and
+            //! reading are wait-free and do not allocate or free memory, so the
+            //! buffer can be read from a real-time audio callback while another
+            //! thread writes to it.
+            class RingBuffer
+            {
+                DJV_NON_COPYABLE(RingBuffer);
+
+            protected:
+                void _init(const Info&, size_t sampleCount);
+                RingBuffer();
+
+            public:
+                ~RingBuffer();
+
+                //! Create a new ring buffer that holds the given number of samples.
+                //! The sample count of the information is ignored.
+                static std::shared_ptr<RingBuffer> create(const Info&, size_t sampleCount);
+
+                const Info& getInfo() const;
+
+                //! Get the number of samples the buffer can hold.
+                size_t getSize() const;
+
+                //! Get the number of samples that can be read.
+                size_t getReadAvailable() const;
+
+                //! Get the number of samples that can be written.
+                size_t getWriteAvailable() const;
+
+                //! Write samples to the buffer and return the number of samples
+                //! that were written. This function should only be called by the
+                //! producer.
+                size_t write(const uint8_t*, size_t sampleCount);
+
+                //! Read samples from the buffer, scaling them by the volume, and
+                //! return the number of samples that were read. This function
+                //! should only be called by the consumer.
+                size_t read(uint8_t*, size_t sampleCount, float volume = 1.F);
+
+                //! Discard the samples in the buffer. Running out of samples is not
+                //! counted as an underrun until the next write. This function
+                //! should only be called when neither the producer nor the
+                //! consumer are running.
+                void clear();
+
+                //! Set whether the producer has reached the end of the stream, so
+                //! that running out of samples is not counted as an underrun.
+                void setFinished(bool);
+
+                //! Get the number of times the consumer ran out of samples.
+                size_t getUnderrunCount() const;
+
+                void resetCounters();
+
+            private:
+                Info _info;
+                size_t _sampleByteCount = 0;
+                std::vector<uint8_t> _data;
+                size_t _size = 0;
+
+                // The positions increase monotonically and are wrapped when the
+                // buffer is accessed. The write position is only changed by the
+                // producer and the read position only by the consumer.
+                std::atomic<size_t> _writePos;
+                std::atomic<size_t> _readPos;
+
+                std::atomic<bool> _started;
+                std::atomic<bool> _finished;
+                std::atomic<size_t> _underrunCount;
+            };
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/AudioRingBufferInline.h>
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            inline const Info& RingBuffer::getInfo() const
+            {
+                return _info;
+            }
+
+            inline size_t RingBuffer::getSize() const
+            {
+                return _size;
+            }
+
+            inline size_t RingBuffer::getReadAvailable() const
+            {
+                return _writePos.load(std::memory_order_acquire) - _readPos.load(std::memory_order_acquire);
+            }
+
+            inline size_t RingBuffer::getWriteAvailable() const
+            {
+                return _size - getReadAvailable();
+            }
+
+            inline void RingBuffer::setFinished(bool value)
+            {
+                _finished.store(value, std::memory_order_release);
+            }
+
+            inline size_t RingBuffer::getUnderrunCount() const
+            {
+                return _underrunCount.load(std::memory_order_relaxed);
+            }
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
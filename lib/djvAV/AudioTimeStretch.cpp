@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/AudioTimeStretch.h>
+
+#include <djvCore/Math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_AUDIO_TIME_STRETCH_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const float  windowTime = .04F;
+                const float  seekTime   = .01F;
+                const size_t seekStep   = 4;
+
+                float dot(const float* a, const float* b, size_t size)
+                {
+                    float out = 0.F;
+                    size_t i = 0;
+#if defined(DJV_AUDIO_TIME_STRETCH_SSE2)
+                    __m128 sum = _mm_setzero_ps();
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                    }
+                    float tmp[4];
+                    _mm_storeu_ps(tmp, sum);
+                    out = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+#endif // DJV_AUDIO_TIME_STRETCH_SSE2
+                    for (; i < size; ++i)
+                    {
+                        out += a[i] * b[i];
+                    }
+                    return out;
+                }
+
+            } // namespace
+
+            struct TimeStretch::Private
+            {
+                Info info;
+                size_t channelCount = 0;
+                float speed = 1.F;
+                size_t windowSize = 0;
+                size_t hopSize = 0;
+                size_t seekSize = 0;
+                std::vector<float> window;
+
+                // The input samples are interleaved, and the positions are in
+                // samples relative to the start of the input.
+                std::vector<float> input;
+                double inputPos = 0.0;
+                size_t naturalPos = 0;
+                bool first = true;
+
+                std::vector<float> overlap;
+                std::vector<float> output;
+
+                float getMatch(size_t pos, size_t natural) const;
+            };
+
+            float TimeStretch::Private::getMatch(size_t pos, size_t natural) const
+            {
+                // Normalize by the energy of the candidate so that louder
+                // windows are not preferred.
+                const size_t size = hopSize * channelCount;
+                const float* candidate = input.data() + pos * channelCount;
+                const float energy = dot(candidate, candidate, size);
+                return dot(candidate, input.data() + natural * channelCount, size) / sqrtf(energy + 1.e-6F);
+            }
+
+            void TimeStretch::_init(const Info& info)
+            {
+                DJV_PRIVATE_PTR();
+                p.info = info;
+                p.info.sampleCount = 0;
+                p.channelCount = info.channelCount;
+                p.hopSize = std::max(static_cast<size_t>(info.sampleRate * windowTime / 2.F), static_cast<size_t>(1));
+                p.windowSize = p.hopSize * 2;
+                p.seekSize = static_cast<size_t>(info.sampleRate * seekTime);
+
+                // A periodic Hann window, which sums to one when overlapped by
+                // half of its size.
+                p.window.resize(p.windowSize);
+                for (size_t i = 0; i < p.windowSize; ++i)
+                {
+                    p.window[i] = .5F - .5F * cosf(2.F * Math::pi * i / static_cast<float>(p.windowSize));
+                }
+                p.overlap.resize(p.windowSize * p.channelCount, 0.F);
+            }
+
+            TimeStretch::TimeStretch() :
+                _p(new Private)
+            {}
+
+            TimeStretch::~TimeStretch()
+            {}
+
+            std::shared_ptr<TimeStretch> TimeStretch::create(const Info& info)
+            {
+                auto out = std::shared_ptr<TimeStretch>(new TimeStretch);
+                out->_init(info);
+                return out;
+            }
+
+            const Info& TimeStretch::getInfo() const
+            {
+                return _p->info;
+            }
+
+            float TimeStretch::getSpeed() const
+            {
+                return _p->speed;
+            }
+
+            void TimeStretch::setSpeed(float value)
+            {
+                _p->speed = Math::clamp(value, timeStretchSpeedMin, timeStretchSpeedMax);
+            }
+
+            void TimeStretch::addInput(const std::shared_ptr<Data>& value)
+            {
+                DJV_PRIVATE_PTR();
+                if (value->getChannelCount() != p.channelCount)
+                    return;
+                const auto data = Data::convert(value, Type::F32);
+                const float* in = reinterpret_cast<const float*>(data->getData());
+                p.input.insert(p.input.end(), in, in + data->getSampleCount() * p.channelCount);
+            }
+
+            size_t TimeStretch::getInputSampleCount() const
+            {
+                DJV_PRIVATE_PTR();
+                return p.channelCount ? (p.input.size() / p.channelCount) : 0;
+            }
+
+            std::shared_ptr<Data> TimeStretch::getOutput()
+            {
+                DJV_PRIVATE_PTR();
+                _process();
+                std::shared_ptr<Data> out;
+                const size_t sampleCount = p.channelCount ? (p.output.size() / p.channelCount) : 0;
+                if (sampleCount > 0)
+                {
+                    auto data = Data::create(Info(p.info.channelCount, Type::F32, p.info.sampleRate, sampleCount));
+                    memcpy(data->getData(), p.output.data(), p.output.size() * sizeof(float));
+                    p.output.clear();
+                    out = Data::convert(data, p.info.type);
+                }
+                return out;
+            }
+
+            void TimeStretch::clear()
+            {
+                DJV_PRIVATE_PTR();
+                p.input.clear();
+                p.inputPos = 0.0;
+                p.naturalPos = 0;
+                p.first = true;
+                std::fill(p.overlap.begin(), p.overlap.end(), 0.F);
+                p.output.clear();
+            }
+
+            void TimeStretch::_process()
+            {
+                DJV_PRIVATE_PTR();
+                if (!p.channelCount)
+                    return;
+                while (true)
+                {
+                    const size_t inputSize = p.input.size() / p.channelCount;
+                    const size_t nominal = static_cast<size_t>(p.inputPos + .5);
+                    size_t pos = nominal;
+                    if (p.first)
+                    {
+                        if (nominal + p.windowSize > inputSize)
+                            break;
+                    }
+                    else
+                    {
+                        if (nominal + p.seekSize + p.windowSize > inputSize)
+                            break;
+
+                        // Find the window that best continues the previous
+                        // window, first with a coarse search and then refined
+                        // around the best match.
+                        const size_t natural = p.naturalPos;
+                        const size_t seekMin = nominal > p.seekSize ? (nominal - p.seekSize) : 0;
+                        const size_t seekMax = nominal + p.seekSize;
+                        float match = p.getMatch(nominal, natural);
+                        for (size_t i = seekMin; i <= seekMax; i += seekStep)
+                        {
+                            const float value = p.getMatch(i, natural);
+                            if (value > match)
+                            {
+                                match = value;
+                                pos = i;
+                            }
+                        }
+                        const size_t refineMin = std::max(pos > seekStep ? (pos - seekStep + 1) : 0, seekMin);
+                        const size_t refineMax = std::min(pos + seekStep - 1, seekMax);
+                        for (size_t i = refineMin; i <= refineMax; ++i)
+                        {
+                            const float value = p.getMatch(i, natural);
+                            if (value > match)
+                            {
+                                match = value;
+                                pos = i;
+                            }
+                        }
+                    }
+
+                    // Overlap-add the window and output the finished samples.
+                    const float* in = p.input.data() + pos * p.channelCount;
+                    float* overlap = p.overlap.data();
+                    for (size_t i = 0; i < p.windowSize; ++i)
+                    {
+                        const float w = p.window[i];
+                        for (size_t c = 0; c < p.channelCount; ++c, ++in, ++overlap)
+                        {
+                            *overlap += *in * w;
+                        }
+                    }
+                    const size_t hopCount = p.hopSize * p.channelCount;
+                    p.output.insert(p.output.end(), p.overlap.begin(), p.overlap.begin() + hopCount);
+                    std::copy(p.overlap.begin() + hopCount, p.overlap.end(), p.overlap.begin());
+                    std::fill(p.overlap.end() - hopCount, p.overlap.end(), 0.F);
+
+                    p.naturalPos = pos + p.hopSize;
+                    p.first = false;
+                    p.inputPos += p.hopSize * static_cast<double>(p.speed);
+
+                    // Discard the input that is no longer needed.
+                    const size_t inputPos = static_cast<size_t>(p.inputPos);
+                    const size_t discard = std::min(
+                        p.naturalPos,
+                        inputPos > p.seekSize ? (inputPos - p.seekSize) : 0);
+                    if (discard > 0)
+                    {
+                        p.input.erase(p.input.begin(), p.input.begin() + discard * p.channelCount);
+                        p.inputPos -= discard;
+                        p.naturalPos -= discard;
+                    }
+                }
+            }
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
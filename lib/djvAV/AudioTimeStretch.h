@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/AudioData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            //! This constant provides the minimum time-stretch speed.
+            const float timeStretchSpeedMin = .25F;
+
+            //! This constant provides the maximum time-stretch speed.
+            const float timeStretchSpeedMax = 4.F;
+
+            //! This class provides time-stretching, which changes the speed of
+            //! audio without changing the pitch.
+            //!
+            //! The audio is stretched with WSOLA (waveform similarity based
+            //! overlap-add): windows of the input are overlapped at a fixed
+            //! output hop, and each window is moved within a small search range
+            //! to the position that best matches the end of the previous window.
+            class TimeStretch
+            {
+                DJV_NON_COPYABLE(TimeStretch);
+
+            protected:
+                void _init(const Info&);
+                TimeStretch();
+
+            public:
+                ~TimeStretch();
+
+                //! Create a new time-stretch. The sample count of the information
+                //! is ignored.
+                static std::shared_ptr<TimeStretch> create(const Info&);
+
+                const Info& getInfo() const;
+
+                float getSpeed() const;
+
+                //! Set the speed, which is clamped to the range timeStretchSpeedMin
+                //! to timeStretchSpeedMax.
+                void setSpeed(float);
+
+                //! Add input data, which must have the same channel count as the
+                //! information.
+                void addInput(const std::shared_ptr<Data>&);
+
+                //! Get the number of input samples that have not been processed.
+                size_t getInputSampleCount() const;
+
+                //! Process the input and get the output data, or a null pointer if
+                //! there is not enough input yet.
+                std::shared_ptr<Data> getOutput();
+
+                //! Discard the input and output.
+                void clear();
+
+            private:
+                void _process();
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
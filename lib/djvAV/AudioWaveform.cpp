@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/AudioWaveform.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            namespace
+            {
+                const std::string fileMagic = "djvwaveform";
+                const uint32_t fileVersion = 1;
+
+                //! Combine peaks that each cover the same number of samples.
+                void combine(Peak& out, const Peak& value, size_t count)
+                {
+                    if (0 == count)
+                    {
+                        out = value;
+                        out.rms *= out.rms;
+                    }
+                    else
+                    {
+                        out.min = std::min(out.min, value.min);
+                        out.max = std::max(out.max, value.max);
+                        out.rms += value.rms * value.rms;
+                    }
+                }
+
+                void finish(Peak& out, size_t count)
+                {
+                    out.rms = count ? sqrtf(out.rms / static_cast<float>(count)) : 0.F;
+                }
+
+            } // namespace
+
+            void Waveform::_init(size_t sampleRate, size_t sampleCount)
+            {
+                _sampleRate = sampleRate;
+                _sampleCount = sampleCount;
+                _levels.push_back(std::vector<Peak>(
+                    (sampleCount + waveformPeakSampleCount - 1) / waveformPeakSampleCount));
+                updateLevels();
+            }
+
+            Waveform::Waveform()
+            {}
+
+            Waveform::~Waveform()
+            {}
+
+            std::shared_ptr<Waveform> Waveform::create(size_t sampleRate, size_t sampleCount)
+            {
+                auto out = std::shared_ptr<Waveform>(new Waveform);
+                out->_init(sampleRate, sampleCount);
+                return out;
+            }
+
+            void Waveform::setPeaks(size_t index, const std::vector<Peak>& value)
+            {
+                auto& level = _levels[0];
+                if (index < level.size())
+                {
+                    const size_t size = std::min(value.size(), level.size() - index);
+                    std::copy(value.begin(), value.begin() + size, level.begin() + index);
+                }
+            }
+
+            void Waveform::updateLevels()
+            {
+                _levels.resize(1);
+                while (_levels.back().size() > 1)
+                {
+                    const auto& in = _levels.back();
+                    std::vector<Peak> out((in.size() + 1) / 2);
+                    for (size_t i = 0; i < out.size(); ++i)
+                    {
+                        size_t count = 0;
+                        for (size_t j = i * 2; j < i * 2 + 2 && j < in.size(); ++j, ++count)
+                        {
+                            combine(out[i], in[j], count);
+                        }
+                        finish(out[i], count);
+                    }
+                    _levels.push_back(std::move(out));
+                }
+            }
+
+            std::vector<Peak> Waveform::getPeaks(size_t sampleStart, size_t sampleEnd, size_t count) const
+            {
+                std::vector<Peak> out(count);
+                if (sampleEnd <= sampleStart || 0 == count)
+                    return out;
+
+                // Find the coarsest level with at least one peak for each output.
+                const float samplesPerPeak = (sampleEnd - sampleStart) / static_cast<float>(count);
+                size_t level = 0;
+                while (level + 1 < _levels.size() &&
+                    (waveformPeakSampleCount << (level + 1)) <= samplesPerPeak)
+                {
+                    ++level;
+                }
+                const auto& peaks = _levels[level];
+                const size_t levelSampleCount = waveformPeakSampleCount << level;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const size_t s0 = sampleStart + static_cast<size_t>(i * samplesPerPeak);
+                    const size_t s1 = sampleStart + static_cast<size_t>((i + 1) * samplesPerPeak);
+                    const size_t p0 = s0 / levelSampleCount;
+                    const size_t p1 = std::min(std::max((s1 + levelSampleCount - 1) / levelSampleCount, p0 + 1), peaks.size());
+                    size_t peakCount = 0;
+                    for (size_t j = p0; j < p1; ++j, ++peakCount)
+                    {
+                        combine(out[i], peaks[j], peakCount);
+                    }
+                    finish(out[i], peakCount);
+                }
+                return out;
+            }
+
+            std::shared_ptr<Waveform> Waveform::read(const std::string& fileName, const std::string& key)
+            {
+                std::shared_ptr<Waveform> out;
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                std::string magic(fileMagic.size(), 0);
+                io->read(&magic[0], magic.size());
+                uint32_t version = 0;
+                io->readU32(&version);
+                uint32_t keySize = 0;
+                io->readU32(&keySize);
+                if (magic == fileMagic && fileVersion == version && keySize == key.size())
+                {
+                    std::string fileKey(keySize, 0);
+                    io->read(&fileKey[0], keySize);
+                    if (fileKey == key)
+                    {
+                        uint32_t sampleRate = 0;
+                        uint32_t sampleCount[2] = { 0, 0 };
+                        uint32_t peakCount = 0;
+                        io->readU32(&sampleRate);
+                        io->readU32(sampleCount, 2);
+                        io->readU32(&peakCount);
+                        out = std::shared_ptr<Waveform>(new Waveform);
+                        out->_sampleRate = sampleRate;
+                        out->_sampleCount = static_cast<size_t>(sampleCount[0]) | (static_cast<size_t>(sampleCount[1]) << 32);
+                        std::vector<float> data(static_cast<size_t>(peakCount) * 3);
+                        io->readF32(data.data(), data.size());
+                        std::vector<Peak> peaks(peakCount);
+                        for (size_t i = 0; i < peakCount; ++i)
+                        {
+                            peaks[i].min = data[i * 3];
+                            peaks[i].max = data[i * 3 + 1];
+                            peaks[i].rms = data[i * 3 + 2];
+                        }
+                        out->_levels.push_back(std::move(peaks));
+                        out->updateLevels();
+                    }
+                }
+                return out;
+            }
+
+            void Waveform::write(const std::string& fileName, const std::string& key) const
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write(fileMagic);
+                io->writeU32(fileVersion);
+                io->writeU32(static_cast<uint32_t>(key.size()));
+                io->write(key);
+                io->writeU32(static_cast<uint32_t>(_sampleRate));
+                io->writeU32(static_cast<uint32_t>(_sampleCount & 0xffffffff));
+                io->writeU32(static_cast<uint32_t>(static_cast<uint64_t>(_sampleCount) >> 32));
+                const auto& peaks = _levels[0];
+                io->writeU32(static_cast<uint32_t>(peaks.size()));
+                std::vector<float> data(peaks.size() * 3);
+                for (size_t i = 0; i < peaks.size(); ++i)
+                {
+                    data[i * 3] = peaks[i].min;
+                    data[i * 3 + 1] = peaks[i].max;
+                    data[i * 3 + 2] = peaks[i].rms;
+                }
+                io->writeF32(data.data(), data.size());
+            }
+
+            void PeakExtractor::add(const std::shared_ptr<Data>& value)
+            {
+                const auto data = Data::convert(value, Type::F32);
+                const size_t channelCount = data->getChannelCount();
+                const size_t sampleCount = data->getSampleCount();
+                const float* p = reinterpret_cast<const float*>(data->getData());
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    for (size_t c = 0; c < channelCount; ++c, ++p)
+                    {
+                        if (0 == _peakSampleCount && 0 == c)
+                        {
+                            _peak.min = _peak.max = *p;
+                        }
+                        else
+                        {
+                            _peak.min = std::min(_peak.min, *p);
+                            _peak.max = std::max(_peak.max, *p);
+                        }
+                        _sum += *p * *p;
+                    }
+                    ++_sampleCount;
+                    if (++_peakSampleCount == waveformPeakSampleCount)
+                    {
+                        _peak.rms = sqrtf(_sum / static_cast<float>(_peakSampleCount * channelCount));
+                        _peaks.push_back(_peak);
+                        _peakSampleCount = 0;
+                        _sum = 0.F;
+                    }
+                }
+                _channelCount = channelCount;
+            }
+
+            void PeakExtractor::flush()
+            {
+                if (_peakSampleCount > 0)
+                {
+                    _peak.rms = sqrtf(_sum / static_cast<float>(_peakSampleCount * std::max(_channelCount, static_cast<size_t>(1))));
+                    _peaks.push_back(_peak);
+                    _peakSampleCount = 0;
+                    _sum = 0.F;
+                }
+            }
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/AudioData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            //! This constant provides the number of samples for each peak in the
+            //! first level of a waveform.
+            const size_t waveformPeakSampleCount = 512;
+
+            //! This struct provides the peak values of a range of audio samples.
+            struct Peak
+            {
+                float min = 0.F;
+                float max = 0.F;
+                float rms = 0.F;
+
+                bool operator == (const Peak&) const;
+            };
+
+            //! This class provides a multi-resolution pyramid of audio peaks for
+            //! drawing waveforms. The channels are combined into a single peak.
+            class Waveform
+            {
+                DJV_NON_COPYABLE(Waveform);
+
+            protected:
+                void _init(size_t sampleRate, size_t sampleCount);
+                Waveform();
+
+            public:
+                ~Waveform();
+
+                static std::shared_ptr<Waveform> create(size_t sampleRate, size_t sampleCount);
+
+                size_t getSampleRate() const;
+                size_t getSampleCount() const;
+
+                //! Get the number of levels in the pyramid.
+                size_t getLevelCount() const;
+
+                //! Get a level of the pyramid. The first level has one peak for
+                //! every waveformPeakSampleCount samples, and each following level
+                //! has half as many peaks as the one before it.
+                const std::vector<Peak>& getLevel(size_t) const;
+
+                //! Set peaks in the first level. Ranges that do not overlap may be
+                //! set from different threads.
+                void setPeaks(size_t index, const std::vector<Peak>&);
+
+                //! Build the other levels from the first level.
+                void updateLevels();
+
+                //! Get the given number of peaks for a range of samples, using the
+                //! coarsest level that has enough detail.
+                std::vector<Peak> getPeaks(size_t sampleStart, size_t sampleEnd, size_t count) const;
+
+                //! Read a waveform from a file. The key identifies the source of the
+                //! waveform, and a null pointer is returned if it does not match.
+                //! Throws:
+                //! - Core::FileSystem::Error
+                static std::shared_ptr<Waveform> read(const std::string& fileName, const std::string& key);
+
+                //! Write the waveform to a file.
+                //! Throws:
+                //! - Core::FileSystem::Error
+                void write(const std::string& fileName, const std::string& key) const;
+
+            private:
+                size_t _sampleRate = 0;
+                size_t _sampleCount = 0;
+                std::vector<std::vector<Peak> > _levels;
+            };
+
+            //! This class computes the peaks of a stream of audio data, with one
+            //! peak for every waveformPeakSampleCount samples.
+            class PeakExtractor
+            {
+            public:
+                //! Add audio data.
+                void add(const std::shared_ptr<Data>&);
+
+                //! Add a peak for the remaining samples.
+                void flush();
+
+                //! Get the number of samples that have been added.
+                size_t getSampleCount() const;
+
+                //! Get the peaks.
+                const std::vector<Peak>& getPeaks() const;
+
+            private:
+                size_t _channelCount = 0;
+                size_t _sampleCount = 0;
+                size_t _peakSampleCount = 0;
+                Peak _peak;
+                float _sum = 0.F;
+                std::vector<Peak> _peaks;
+            };
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/AudioWaveformInline.h>
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Audio
+        {
+            inline bool Peak::operator == (const Peak& other) const
+            {
+                return min == other.min && max == other.max && rms == other.rms;
+            }
+
+            inline size_t Waveform::getSampleRate() const
+            {
+                return _sampleRate;
+            }
+
+            inline size_t Waveform::getSampleCount() const
+            {
+                return _sampleCount;
+            }
+
+            inline size_t Waveform::getLevelCount() const
+            {
+                return _levels.size();
+            }
+
+            inline const std::vector<Peak>& Waveform::getLevel(size_t value) const
+            {
+                return _levels[value];
+            }
+
+            inline size_t PeakExtractor::getSampleCount() const
+            {
+                return _sampleCount;
+            }
+
+            inline const std::vector<Peak>& PeakExtractor::getPeaks() const
+            {
+                return _peaks;
+            }
+
+        } // namespace Audio
+    } // namespace AV
+} // namespace djv
@@ -603,6 +603,7 @@ namespace djv
 
                 struct Plugin::Private
                 {
+                    Options options;
                 };
 
                 Plugin::Plugin() :
@@ -620,9 +621,19 @@ namespace djv
                     return out;
                 }
 
+                rapidjson::Value Plugin::getOptions(rapidjson::Document::AllocatorType& allocator) const
+                {
+                    return toJSON(_p->options, allocator);
+                }
+
+                void Plugin::setOptions(const rapidjson::Value& value)
+                {
+                    fromJSON(value, _p->options);
+                }
+
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info& info, const WriteOptions& options) const
@@ -633,5 +644,31 @@ namespace djv
             } // namespace Cineon
         } // namespace IO
     } // namespace AV
-} // namespace djv
 
+    rapidjson::Value toJSON(const AV::IO::Cineon::Options& value, rapidjson::Document::AllocatorType& allocator)
+    {
+        rapidjson::Value out(rapidjson::kObjectType);
+        out.AddMember("MemoryMap", toJSON(value.memoryMap, allocator), allocator);
+        return out;
+    }
+
+    void fromJSON(const rapidjson::Value& value, AV::IO::Cineon::Options& out)
+    {
+        if (value.IsObject())
+        {
+            for (const auto& i : value.GetObject())
+            {
+                if (0 == strcmp("MemoryMap", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.memoryMap);
+                }
+            }
+        }
+        else
+        {
+            //! \todo How can we translate this?
+            throw std::invalid_argument(DJV_TEXT("error_cannot_parse_the_value"));
+        }
+    }
+
+} // namespace djv
@@ -186,6 +186,12 @@ namespace djv
                 //! Finish writing the Cineon file header after image data is written.
                 void writeFinish(const std::shared_ptr<Core::FileSystem::FileIO>&);
 
+                //! This struct provides the Cineon file I/O options.
+                struct Options
+                {
+                    bool memoryMap = false; //!< Read images with memory mapping
+                };
+
                 //! This class provides the Cineon file reader.
                 class Read : public ISequenceRead
                 {
@@ -200,10 +206,15 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const Options&,
+                        const std::shared_ptr<ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    //! Read the image data. If the file I/O is memory mapped and the
+                    //! data does not need byte swapping, the image references the
+                    //! memory map until it is detached.
                     static std::shared_ptr<Image::Image> readImage(
                         const Info&,
                         const std::shared_ptr<Core::FileSystem::FileIO>&);
@@ -257,6 +268,9 @@ namespace djv
                 public:
                     static std::shared_ptr<Plugin> create(const std::shared_ptr<Core::Context>&);
 
+                    rapidjson::Value getOptions(rapidjson::Document::AllocatorType&) const override;
+                    void setOptions(const rapidjson::Value&) override;
+
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
                     std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info&, const WriteOptions&) const override;
 
@@ -267,4 +281,11 @@ namespace djv
             } // namespace Cineon
         } // namespace IO
     } // namespace AV
+
+    rapidjson::Value toJSON(const AV::IO::Cineon::Options&, rapidjson::Document::AllocatorType&);
+
+    //! Throws:
+    //! - std::exception
+    void fromJSON(const rapidjson::Value&, AV::IO::Cineon::Options&);
+
 } // namespace djv
@@ -19,6 +19,7 @@ namespace djv
                 struct Read::Private
                 {
                     ColorProfile colorProfile = ColorProfile::FilmPrint;
+                    Options options;
                 };
 
                 Read::Read() :
@@ -33,12 +34,15 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_p->options = options;
+                    out->_init(fileInfo, readOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
                 
@@ -46,33 +50,41 @@ namespace djv
                     const Info& info,
                     const std::shared_ptr<FileSystem::FileIO>& io)
                 {
-#if defined(DJV_MMAP)
-                    auto out = Image::Image::create(info.video[0].info, io);
-#else // DJV_MMAP
                     auto infoTmp = info;
                     bool convertEndian = false;
                     if (infoTmp.video[0].layout.endian != Memory::getEndian())
                     {
-                        convertEndian = true;
+                        convertEndian = Image::getByteCount(Image::getDataType(infoTmp.video[0].type)) > 1;
                         infoTmp.video[0].layout.endian = Memory::getEndian();
                     }
-                    auto out = Image::Image::create(infoTmp.video[0]);
-                    io->read(out->getData(), out->getDataByteCount());
+                    auto out = Image::Image::create(infoTmp.video[0], !convertEndian ? io : nullptr);
+                    if (!out->isMemoryMapped())
+                    {
+                        io->read(out->getData(), out->getDataByteCount());
+                    }
                     if (convertEndian)
                     {
-                        const size_t dataByteCount = out->getDataByteCount();
+                        size_t wordSize = 0;
                         switch (Image::getDataType(infoTmp.video[0].type))
                         {
-                            case Image::DataType::U10:
-                                Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                break;
-                            case Image::DataType::U16:
-                                Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                break;
+                            case Image::DataType::U10: wordSize = 4; break;
+                            case Image::DataType::U16: wordSize = 2; break;
                             default: break;                            
                         }
+                        if (wordSize)
+                        {
+                            // Split the scanlines across the idle threads of the pool.
+                            uint8_t* data = out->getData();
+                            const size_t scanlineByteCount = out->getScanlineByteCount();
+                            ThreadPool::parallel(
+                                out->getHeight(),
+                                out->getDataByteCount(),
+                                [data, scanlineByteCount, wordSize](size_t y0, size_t y1)
+                                {
+                                    Memory::endian(data + y0 * scanlineByteCount, (y1 - y0) * scanlineByteCount / wordSize, wordSize);
+                                });
+                        }
                     }
-#endif // DJV_MMAP
                     out->setTags(infoTmp.tags);
                     return out;
                 }
@@ -95,7 +107,7 @@ namespace djv
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<FileSystem::FileIO>& io)
                 {
                     DJV_PRIVATE_PTR();
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    io->open(fileName, FileSystem::FileIO::Mode::Read, p.options.memoryMap);
                     Info info;
                     info.videoSpeed = _speed;
                     info.videoSequence = _sequence;
@@ -874,7 +874,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _p->options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info& info, const WriteOptions& options) const
@@ -915,6 +915,7 @@ namespace djv
                 const std::string& s = ss.str();
                 out.AddMember("Endian", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
             }
+            out.AddMember("MemoryMap", toJSON(value.memoryMap, allocator), allocator);
         }
         return out;
     }
@@ -935,6 +936,10 @@ namespace djv
                     std::stringstream ss(i.value.GetString());
                     ss >> out.endian;
                 }
+                else if (0 == strcmp("MemoryMap", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.memoryMap);
+                }
             }
         }
         else
@@ -293,6 +293,7 @@ namespace djv
                 {
                     Version     version    = Version::_2_0;
                     Endian      endian     = Endian::MSB;
+                    bool        memoryMap  = false; //!< Read uncompressed images with memory mapping
                 };
 
                 //! This class provides the DPX file reader.
@@ -310,6 +311,7 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
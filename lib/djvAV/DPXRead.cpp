@@ -35,13 +35,14 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -63,7 +64,7 @@ namespace djv
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<FileSystem::FileIO>& io)
                 {
                     DJV_PRIVATE_PTR();
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    io->open(fileName, FileSystem::FileIO::Mode::Read, p.options.memoryMap);
                     Info info;
                     info.videoSpeed = _speed;
                     info.videoSequence = _sequence;
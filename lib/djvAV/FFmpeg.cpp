@@ -283,6 +283,7 @@ namespace djv
         rapidjson::Value out(rapidjson::kObjectType);
         {
             out.AddMember("ThreadCount", toJSON(value.threadCount, allocator), allocator);
+            out.AddMember("SaveIndex", toJSON(value.saveIndex, allocator), allocator);
         }
         return out;
     }
@@ -297,6 +298,10 @@ namespace djv
                 {
                     fromJSON(i.value, out.threadCount);
                 }
+                else if (0 == strcmp("SaveIndex", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.saveIndex);
+                }
             }
         }
         else
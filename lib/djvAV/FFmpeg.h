@@ -68,6 +68,7 @@ namespace djv
                 struct Options
                 {
                     size_t threadCount = 4;
+                    bool   saveIndex   = false; //!< Save the key frame index next to the movie
                 };
 
                 //! This class provides the FFmpeg file reader.
@@ -102,19 +103,51 @@ namespace djv
 
                     void seek(int64_t, Direction) override;
 
+                    bool hasCache() const override;
+
                 private:
+                    bool _hasWork() const;
+
+                    //! Read the key frame index, either from the index file or by
+                    //! scanning the packets. Returns false if the scan was
+                    //! interrupted by a seek.
+                    bool _readIndex();
+                    Core::Frame::Number _getKeyFrame(Core::Frame::Number) const;
+
+                    bool _seekDecoder(Core::Frame::Number);
+                    //! Decode up to the given frame. With cacheOnly the video frames
+                    //! are only added to the cache and the audio is not decoded.
+                    bool _decode(Core::Frame::Number, bool cacheEnabled, bool cacheOnly);
+                    void _readQueue(bool cacheEnabled);
+                    void _readCache(const InOutPoints&);
+                    void _readAudio();
+                    Core::Frame::Number _getCacheFrame(const InOutPoints&) const;
+
+                    bool _getImage(Core::Frame::Number, bool cacheEnabled, std::shared_ptr<Image::Image>&);
+                    void _storeFrame(Core::Frame::Number, const std::shared_ptr<Image::Image>&, bool cacheEnabled);
+                    void _addVideoFrame(Core::Frame::Number, const std::shared_ptr<Image::Image>&);
+
+                    //! Add the reversed audio for a frame when playing backwards.
+                    void _addReverseAudio(Core::Frame::Number);
+
+                    //! Decode the audio for a frame that was taken from the cache
+                    //! when playing backwards, without decoding the video.
+                    void _decodeReverseAudio(Core::Frame::Number);
+
                     struct DecodeVideo
                     {
                         AVPacket*           packet       = nullptr;
                         Core::Frame::Number seek         = -1;
                         bool                cacheEnabled = false;
+                        bool                cacheOnly    = false;
                     };
                     int _decodeVideo(const DecodeVideo&, Core::Frame::Number&);
 
                     struct DecodeAudio
                     {
-                        AVPacket*           packet = nullptr;
-                        Core::Frame::Number seek   = -1;
+                        AVPacket*           packet  = nullptr;
+                        Core::Frame::Number seek    = -1;
+                        bool                reverse = false;
                     };
                     int _decodeAudio(const DecodeAudio&, Core::Frame::Number&);
 
@@ -4,8 +4,10 @@
 
 #include <djvAV/FFmpeg.h>
 
+#include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
@@ -20,6 +22,8 @@ extern "C"
 
 } // extern "C"
 
+#include <algorithm>
+
 using namespace djv::Core;
 
 namespace djv
@@ -30,6 +34,18 @@ namespace djv
         {
             namespace FFmpeg
             {
+                namespace
+                {
+                    const double infoTimeout = 0.5;
+
+                    //! \todo Should this be configurable?
+                    const float reverseAudioTimeMax = 60.F;
+
+                    const std::string indexFileExtension = ".djvindex";
+                    const std::string indexFileHeader = "djvindex 1";
+
+                } // namespace
+
                 struct Read::Private
                 {
                     Options options;
@@ -49,6 +65,27 @@ namespace djv
                     AVFrame * avFrame = nullptr;
                     AVFrame * avFrameRgb = nullptr;
                     SwsContext * swsContext = nullptr;
+
+                    size_t sequenceSize = 0;
+                    std::atomic<bool> hasVideo;
+                    Frame::Number frame = Frame::invalid;
+                    Frame::Number decodeFrame = Frame::invalid;
+                    Frame::Number audioSeek = Frame::invalid;
+                    int64_t audioPts = AV_NOPTS_VALUE;
+                    std::map<Frame::Number, std::shared_ptr<Image::Image> > gop;
+                    std::map<int64_t, std::shared_ptr<Audio::Data> > reverseAudio;
+                    Frame::Number reverseAudioDecode = Frame::invalid;
+                    std::vector<Frame::Number> keyFrames;
+                    bool keyFramesInit = false;
+                    bool playback = false;
+                    bool cacheDecode = false;
+                    std::chrono::steady_clock::time_point infoTimer;
+
+                    Frame::Number getFrame(int stream, int64_t pts) const;
+                    int64_t getTimestamp(int stream, Frame::Number) const;
+                    int64_t getSample(Frame::Number) const;
+                    int64_t getSampleFromPts(int64_t) const;
+                    bool hasReverseAudio(int64_t start, int64_t end) const;
                 };
 
                 void Read::_init(
@@ -63,6 +100,7 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     p.options = options;
                     p.running = true;
+                    p.hasVideo = false;
                     p.thread = std::thread(
                         [this]
                     {
@@ -98,7 +136,9 @@ namespace djv
                             // Find the first video and audio stream.
                             for (unsigned int i = 0; i < p.avFormatContext->nb_streams; ++i)
                             {
-                                if (-1 == p.avVideoStream && p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+                                if (-1 == p.avVideoStream &&
+                                    _options.video &&
+                                    p.avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
                                 {
                                     p.avVideoStream = i;
                                 }
@@ -153,6 +193,13 @@ namespace djv
                                 }
                                 p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
                                 p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
+
+                                // Decoders that support it decode proxy images at a
+                                // lower resolution.
+                                p.avCodecContext[p.avVideoStream]->lowres = std::min(
+                                    static_cast<int>(_options.proxyScale),
+                                    static_cast<int>(avVideoCodec->max_lowres));
+
                                 r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
                                 if (r < 0)
                                 {
@@ -164,23 +211,28 @@ namespace djv
                                 // Initialize the buffers.
                                 p.avFrameRgb = av_frame_alloc();
 
-                                // Initialize the software scaler.
+                                // Initialize the software scaler. Proxy images are
+                                // scaled down in the same pass as the color conversion.
+                                const Image::Size size = getProxySize(
+                                    Image::Size(
+                                        p.avCodecParameters[p.avVideoStream]->width,
+                                        p.avCodecParameters[p.avVideoStream]->height),
+                                    _options.proxyScale);
                                 p.swsContext = sws_getContext(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
+                                    p.avCodecContext[p.avVideoStream]->width,
+                                    p.avCodecContext[p.avVideoStream]->height,
                                     static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format),
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
+                                    size.w,
+                                    size.h,
                                     AV_PIX_FMT_RGBA,
-                                    SWS_BILINEAR,
+                                    _options.proxyScale != ProxyScale::None ? SWS_AREA : SWS_BILINEAR,
                                     0,
                                     0,
                                     0);
 
                                 // Get information.
                                 Image::Info imageInfo;
-                                imageInfo.size.w = p.avCodecParameters[p.avVideoStream]->width;
-                                imageInfo.size.h = p.avCodecParameters[p.avVideoStream]->height;
+                                imageInfo.size = size;
                                 imageInfo.type = Image::Type::RGBA_U8;
                                 imageInfo.codec = avVideoCodec->long_name;
                                 if (avVideoStream->duration != AV_NOPTS_VALUE)
@@ -260,17 +312,23 @@ namespace djv
                                 }
 
                                 // Get information.
+                                AVRational sampleTimeBase;
+                                sampleTimeBase.num = 1;
+                                sampleTimeBase.den = p.avCodecParameters[p.avAudioStream]->sample_rate;
                                 size_t sampleCount = 0;
                                 if (avAudioStream->duration != AV_NOPTS_VALUE)
                                 {
-                                    sampleCount = avAudioStream->duration;
+                                    sampleCount = av_rescale_q(
+                                        avAudioStream->duration,
+                                        avAudioStream->time_base,
+                                        sampleTimeBase);
                                 }
                                 else if (p.avFormatContext->duration != AV_NOPTS_VALUE)
                                 {
                                     sampleCount = av_rescale_q(
                                         p.avFormatContext->duration,
                                         av_get_time_base_q(),
-                                        avAudioStream->time_base);
+                                        sampleTimeBase);
                                 }
                                 uint8_t channelCount = p.avCodecParameters[p.avAudioStream]->channels;
                                 switch (channelCount)
@@ -295,75 +353,93 @@ namespace djv
                                 p.info.tags.setTag(tag->key, tag->value);
                             }
 
+                            p.sequenceSize = sequenceSize;
+                            p.hasVideo = p.avVideoStream != -1;
                             p.infoPromise.set_value(p.info);
 
+                            // Build the key frame index. If the scan is interrupted
+                            // by a seek it is started again when the reader is idle
+                            // and playback is stopped.
+                            if (p.avVideoStream != -1)
+                            {
+                                _readIndex();
+                            }
+
+                            // Start looping...
+                            p.infoTimer = std::chrono::steady_clock::now();
                             while (p.running)
                             {
-                                //! \todo Implement me!
-                                /*bool cacheEnabled = false;
+                                // Update the options.
+                                bool cacheEnabled = false;
                                 size_t cacheMaxByteCount = 0;
+                                InOutPoints inOutPoints;
+                                Frame::Number currentFrame = p.frame;
                                 {
                                     std::lock_guard<std::mutex> lock(_mutex);
                                     cacheEnabled = _cacheEnabled;
                                     cacheMaxByteCount = _cacheMaxByteCount;
-                                    _cachedFrames = _getCachedFrames(_cache);
+                                    inOutPoints = _inOutPoints;
+                                    p.playback = _playback;
+                                    if (_videoQueue.getCount())
+                                    {
+                                        currentFrame = _videoQueue.getFrame().frame;
+                                    }
                                 }
                                 if (!cacheEnabled)
                                 {
                                     _cache.clear();
                                 }
-                                if (info.video.size() && _options.layer < info.video.size())
+                                size_t cacheRequiredByteCount = 0;
+                                if (p.avVideoStream != -1 && p.info.video.size())
                                 {
-                                    const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
-                                    _cache.setMax(cacheMaxByteCount / dataByteCount);
+                                    // Use the average size of the cached images since
+                                    // the frames may have different pixel aspect ratios.
+                                    const size_t cacheCount = _cache.getCount();
+                                    const size_t dataByteCount = cacheCount ?
+                                        (_cache.getTotalByteCount() / cacheCount) :
+                                        p.info.video[0].getDataByteCount();
+                                    _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
+                                    _cache.setMaxByteCount(cacheMaxByteCount);
+                                    _cache.setSequenceSize(p.sequenceSize);
+                                    _cache.setInOutPoints(inOutPoints);
+                                    _cache.setDirection(p.direction);
+                                    if (currentFrame != Frame::invalid)
+                                    {
+                                        _cache.setCurrentFrame(currentFrame);
+                                    }
+                                    if (p.sequenceSize > 1)
+                                    {
+                                        const auto range = inOutPoints.getRange(p.sequenceSize);
+                                        cacheRequiredByteCount = (range.getMax() - range.getMin() + 1) * dataByteCount;
+                                    }
                                 }
                                 else
                                 {
                                     _cache.setMax(0);
-                                }*/
+                                }
+                                const bool cacheWork = cacheEnabled && _getCacheFrame(inOutPoints) != Frame::invalid;
 
-                                bool read = false;
-                                int64_t seek = Frame::invalid;
+                                // Check to see if there is work to be done.
+                                bool work = false;
+                                Frame::Number seek = Frame::invalid;
                                 {
-                                    //const std::vector<Frame::Number> cachedFrames = _cache.getKeys();
                                     std::unique_lock<std::mutex> lock(_mutex);
-                                    if (p.queueCV.wait_for(
+                                    work = p.queueCV.wait_for(
                                         lock,
                                         Time::getTime(Time::TimerValue::Fast),
-                                        [this, sequenceSize]
-                                        //[this, sequenceSize, cacheEnabled, &cachedFrames]
-                                    {
-                                        DJV_PRIVATE_PTR();
-                                        const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax()));
-                                        const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
-
-                                        /*bool cache = false;
-                                        if (cacheEnabled && !_videoQueue.isFinished() && !_audioQueue.isFinished())
+                                        [this, cacheWork]
                                         {
-                                            const size_t cacheMax = _cache.getMax();
-                                            cache |= _cache.getSize() < cacheMax;
-                                            if (_videoQueue.getFrameCount())
-                                            {
-                                                const auto& frame = _videoQueue.getFrame();
-                                                for (const auto& i : cachedFrames)
-                                                {
-                                                    if (i < frame.frame || i > frame.frame + cacheMax)
-                                                    {
-                                                        cache = true;
-                                                        break;
-                                                    }
-                                                }
-                                            }
-                                        }*/
-                                        
-                                        return video || audio || p.seek != Frame::invalid || p.direction != _direction;
-                                        //return video || audio || p.seek != Frame::invalid || p.direction != _direction || cache;
-                                    }))
+                                            return cacheWork || _hasWork();
+                                        });
+                                    if (work)
                                     {
-                                        read = true;
                                         if (p.direction != _direction)
                                         {
                                             p.direction = _direction;
+                                            p.cacheDecode = false;
+                                            p.gop.clear();
+                                            p.reverseAudio.clear();
+                                            p.reverseAudioDecode = Frame::invalid;
                                             _videoQueue.setFinished(false);
                                             _videoQueue.clearFrames();
                                             _audioQueue.setFinished(false);
@@ -380,150 +456,77 @@ namespace djv
                                         }
                                     }
                                 }
-                                AVPacket packet;
+
                                 try
                                 {
                                     if (seek != Frame::invalid)
                                     {
-                                        int64_t t = 0;
-                                        int stream = -1;
-                                        if (p.avVideoStream != -1)
-                                        {
-                                            stream = p.avVideoStream;
-                                            AVRational r;
-                                            r.num = p.info.videoSpeed.getDen();
-                                            r.den = p.info.videoSpeed.getNum();
-                                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
-                                            //t = av_rescale_q(seek, r, av_get_time_base_q());
-                                        }
-                                        else if (p.avAudioStream != -1)
-                                        {
-                                            stream = p.avAudioStream;
-                                            AVRational r;
-                                            r.num = 1;
-                                            r.den = p.info.audio.sampleRate;
-                                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
-                                            //t = av_rescale_q(seek, r, av_get_time_base_q());
-                                        }
-                                        if (p.avVideoStream != -1)
-                                        {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                        }
-                                        if (p.avAudioStream != -1)
-                                        {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                        }
-                                        if (av_seek_frame(
-                                            p.avFormatContext,
-                                            stream,
-                                            t,
-                                            AVSEEK_FLAG_BACKWARD) < 0)
-                                        {
-                                            throw std::exception();
-                                        }
-                                        Frame::Number videoFrame = Frame::invalid;
-                                        Frame::Number audioFrame = Frame::invalid;
-                                        while (videoFrame < seek - 1 || audioFrame < seek - 1)
+                                        p.frame = seek;
+                                        p.audioSeek = seek;
+                                        p.audioPts = AV_NOPTS_VALUE;
+                                        p.reverseAudioDecode = Frame::invalid;
+                                        p.cacheDecode = false;
+
+                                        // Video files move the decoder on the next decode,
+                                        // which is skipped when the frames are cached.
+                                        if (-1 == p.avVideoStream)
                                         {
-                                            if (av_read_frame(p.avFormatContext, &packet) < 0)
+                                            if (!_seekDecoder(seek))
                                             {
-                                                if (p.avVideoStream != -1)
-                                                {
-                                                    DecodeVideo dv;
-                                                    //dv.cacheEnabled = cacheEnabled;
-                                                    dv.seek         = seek;
-                                                    _decodeVideo(dv, videoFrame);
-                                                    avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                                }
-                                                if (p.avAudioStream != -1)
-                                                {
-                                                    DecodeAudio da;
-                                                    da.seek = seek;
-                                                    _decodeAudio(da, audioFrame);
-                                                    avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                                }
                                                 throw std::exception();
                                             }
-                                            if (p.avVideoStream == packet.stream_index)
-                                            {
-                                                DecodeVideo dv;
-                                                dv.packet       = &packet;
-                                                dv.seek         = seek;
-                                                //dv.cacheEnabled = cacheEnabled;
-                                                if (_decodeVideo(dv, videoFrame) < 0)
-                                                {
-                                                    throw std::exception();
-                                                }
-                                            }
-                                            else if (p.avAudioStream == packet.stream_index)
-                                            {
-                                                DecodeAudio da;
-                                                da.packet = &packet;
-                                                da.seek   = seek;
-                                                if (_decodeAudio(da, audioFrame) < 0)
-                                                {
-                                                    throw std::exception();
-                                                }
-                                            }
-                                            av_packet_unref(&packet);
                                         }
-                                    }
-                                    if (read)
-                                    {
-                                        Frame::Number videoFrame = Frame::invalid;
-                                        Frame::Number audioFrame = Frame::invalid;
-                                        int r = av_read_frame(p.avFormatContext, &packet);
-                                        if (r < 0)
+                                        else
                                         {
-                                            if (p.avVideoStream != -1)
-                                            {
-                                                DecodeVideo dv;
-                                                //dv.cacheEnabled = cacheEnabled;
-                                                _decodeVideo(dv, videoFrame);
-                                                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                            }
-                                            if (p.avAudioStream != -1)
-                                            {
-                                                DecodeAudio da;
-                                                _decodeAudio(da, audioFrame);
-                                                avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                            }
-                                            throw std::exception();
+                                            p.decodeFrame = Frame::invalid;
                                         }
-                                        if (p.avVideoStream == packet.stream_index)
+                                    }
+                                    if (work)
+                                    {
+                                        if (p.avVideoStream != -1)
                                         {
-                                            DecodeVideo dv;
-                                            dv.packet       = &packet;
-                                            //dv.cacheEnabled = cacheEnabled;
-                                            if (_decodeVideo(dv, videoFrame) < 0)
-                                            {
-                                                throw std::exception();
-                                            }
+                                            _readQueue(cacheEnabled);
                                         }
-                                        else if (p.avAudioStream == packet.stream_index)
+                                        else
                                         {
-                                            DecodeAudio da;
-                                            da.packet = &packet;
-                                            if (_decodeAudio(da, audioFrame) < 0)
-                                            {
-                                                throw std::exception();
-                                            }
+                                            _readAudio();
                                         }
-                                        av_packet_unref(&packet);
+                                    }
+
+                                    // Fill the cache.
+                                    if (cacheWork)
+                                    {
+                                        _readCache(inOutPoints);
+                                    }
+                                    else if (!work && !p.playback && p.avVideoStream != -1 && !p.keyFramesInit)
+                                    {
+                                        _readIndex();
                                     }
                                 }
                                 catch (const std::exception&)
                                 {
-                                    /*{
-                                        std::stringstream ss;
-                                        ss << _fileInfo << ": finished";
-                                        _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
-                                    }*/
-                                    av_packet_unref(&packet);
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    _videoQueue.setFinished(true);
+                                    _audioQueue.setFinished(true);
+                                    _queueCV.notify_all();
+                                }
+
+                                // Update information.
+                                const auto now = std::chrono::steady_clock::now();
+                                std::chrono::duration<double> delta = now - p.infoTimer;
+                                if (delta.count() > infoTimeout)
+                                {
+                                    p.infoTimer = now;
+                                    size_t cacheByteCount = _cache.getTotalByteCount();
+                                    auto cacheSequence = _cache.getSequence();
+                                    auto cachedFrames = _cache.getFrames();
                                     {
                                         std::lock_guard<std::mutex> lock(_mutex);
-                                        _videoQueue.setFinished(true);
-                                        _audioQueue.setFinished(true);
+                                        _cacheByteCount = cacheByteCount;
+                                        _cacheRequiredByteCount = cacheRequiredByteCount;
+                                        _cacheStats = _cache.getStats();
+                                        _cacheSequence = cacheSequence;
+                                        _cachedFrames = std::move(cachedFrames);
                                     }
                                 }
                             }
@@ -599,7 +602,7 @@ namespace djv
                     return _p->infoPromise.get_future();
                 }
 
-                void Read::seek(Frame::Number value, Direction)
+                void Read::seek(Frame::Number value, Direction direction)
                 {
                     DJV_PRIVATE_PTR();
                     {
@@ -607,10 +610,658 @@ namespace djv
                         _videoQueue.clearFrames();
                         _audioQueue.clearFrames();
                         p.seek = value;
+                        _direction = direction;
                     }
                     p.queueCV.notify_one();
                 }
 
+                bool Read::hasCache() const
+                {
+                    return _p->hasVideo;
+                }
+
+                Frame::Number Read::Private::getFrame(int stream, int64_t pts) const
+                {
+                    const auto avStream = avFormatContext->streams[stream];
+                    if (avStream->start_time != AV_NOPTS_VALUE)
+                    {
+                        pts -= avStream->start_time;
+                    }
+                    AVRational r;
+                    r.num = info.videoSpeed.getDen();
+                    r.den = info.videoSpeed.getNum();
+                    return av_rescale_q(pts, avStream->time_base, r);
+                }
+
+                int64_t Read::Private::getTimestamp(int stream, Frame::Number frame) const
+                {
+                    const auto avStream = avFormatContext->streams[stream];
+                    AVRational r;
+                    r.num = info.videoSpeed.getDen();
+                    r.den = info.videoSpeed.getNum();
+                    int64_t out = av_rescale_q(frame, r, avStream->time_base);
+                    if (avStream->start_time != AV_NOPTS_VALUE)
+                    {
+                        out += avStream->start_time;
+                    }
+                    return out;
+                }
+
+                int64_t Read::Private::getSample(Frame::Number frame) const
+                {
+                    AVRational r;
+                    r.num = info.videoSpeed.getDen();
+                    r.den = info.videoSpeed.getNum();
+                    AVRational r2;
+                    r2.num = 1;
+                    r2.den = info.audio.sampleRate;
+                    return av_rescale_q(frame, r, r2);
+                }
+
+                int64_t Read::Private::getSampleFromPts(int64_t pts) const
+                {
+                    const auto avStream = avFormatContext->streams[avAudioStream];
+                    if (avStream->start_time != AV_NOPTS_VALUE)
+                    {
+                        pts -= avStream->start_time;
+                    }
+                    AVRational r;
+                    r.num = 1;
+                    r.den = info.audio.sampleRate;
+                    return av_rescale_q(pts, avStream->time_base, r);
+                }
+
+                bool Read::Private::hasReverseAudio(int64_t start, int64_t end) const
+                {
+                    int64_t t = start;
+                    auto i = reverseAudio.upper_bound(start);
+                    if (i != reverseAudio.begin())
+                    {
+                        --i;
+                    }
+                    for (; i != reverseAudio.end() && i->first <= t && t < end; ++i)
+                    {
+                        t = std::max(t, i->first + static_cast<int64_t>(i->second->getSampleCount()));
+                    }
+                    return t >= end;
+                }
+
+                bool Read::_hasWork() const
+                {
+                    DJV_PRIVATE_PTR();
+                    const bool video =
+                        p.avVideoStream != -1 &&
+                        !_videoQueue.isFinished() &&
+                        _videoQueue.getCount() < _videoQueue.getMax();
+                    const bool audio =
+                        p.avAudioStream != -1 &&
+                        Direction::Forward == p.direction &&
+                        !_audioQueue.isFinished() &&
+                        _audioQueue.getCount() < _audioQueue.getMax();
+                    return video || audio || p.seek != Frame::invalid || p.direction != _direction;
+                }
+
+                bool Read::_readIndex()
+                {
+                    DJV_PRIVATE_PTR();
+                    std::stringstream ss;
+                    ss << _fileInfo.getSize() << " " << _fileInfo.getTime();
+                    const std::string fileInfo = ss.str();
+                    const std::string fileName = _fileInfo.getFileName() + indexFileExtension;
+
+                    // Read the index saved next to the movie.
+                    if (p.options.saveIndex)
+                    {
+                        try
+                        {
+                            const auto lines = FileSystem::FileIO::readLines(fileName);
+                            if (lines.size() > 2 && indexFileHeader == lines[0] && fileInfo == lines[1])
+                            {
+                                for (size_t i = 2; i < lines.size(); ++i)
+                                {
+                                    p.keyFrames.push_back(std::stoll(lines[i]));
+                                }
+                                p.keyFramesInit = true;
+                                return true;
+                            }
+                        }
+                        catch (const std::exception&)
+                        {
+                            p.keyFrames.clear();
+                        }
+                    }
+
+                    // Scan the packets for the key frames. The packets are only
+                    // demultiplexed, not decoded. A pending seek stops the scan,
+                    // it is started again the next time the index is needed.
+                    av_seek_frame(
+                        p.avFormatContext,
+                        p.avVideoStream,
+                        p.getTimestamp(p.avVideoStream, 0),
+                        AVSEEK_FLAG_BACKWARD);
+                    bool interrupted = false;
+                    AVPacket packet;
+                    while (p.running && av_read_frame(p.avFormatContext, &packet) >= 0)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            interrupted = p.seek != Frame::invalid;
+                        }
+                        if (interrupted)
+                        {
+                            av_packet_unref(&packet);
+                            break;
+                        }
+                        if (p.avVideoStream == packet.stream_index && (packet.flags & AV_PKT_FLAG_KEY))
+                        {
+                            const int64_t pts = packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+                            if (pts != AV_NOPTS_VALUE)
+                            {
+                                p.keyFrames.push_back(p.getFrame(p.avVideoStream, pts));
+                            }
+                        }
+                        av_packet_unref(&packet);
+                    }
+
+                    // The decoder needs to be moved after scanning.
+                    p.decodeFrame = Frame::invalid;
+
+                    if (interrupted || !p.running)
+                    {
+                        p.keyFrames.clear();
+                        return false;
+                    }
+                    std::sort(p.keyFrames.begin(), p.keyFrames.end());
+                    p.keyFrames.erase(std::unique(p.keyFrames.begin(), p.keyFrames.end()), p.keyFrames.end());
+                    p.keyFramesInit = true;
+
+                    if (p.options.saveIndex && p.keyFrames.size())
+                    {
+                        std::vector<std::string> lines;
+                        lines.push_back(indexFileHeader);
+                        lines.push_back(fileInfo);
+                        for (const auto i : p.keyFrames)
+                        {
+                            lines.push_back(std::to_string(i));
+                        }
+                        try
+                        {
+                            FileSystem::FileIO::writeLines(fileName, lines);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), LogLevel::Warning);
+                        }
+                    }
+                    return true;
+                }
+
+                Frame::Number Read::_getKeyFrame(Frame::Number value) const
+                {
+                    DJV_PRIVATE_PTR();
+                    Frame::Number out = value;
+                    if (p.keyFrames.size())
+                    {
+                        auto i = std::upper_bound(p.keyFrames.begin(), p.keyFrames.end(), value);
+                        out = i != p.keyFrames.begin() ? *(i - 1) : std::min(value, p.keyFrames.front());
+                    }
+                    return out;
+                }
+
+                bool Read::_seekDecoder(Frame::Number value)
+                {
+                    DJV_PRIVATE_PTR();
+                    int64_t t = 0;
+                    int stream = -1;
+                    if (p.avVideoStream != -1)
+                    {
+                        stream = p.avVideoStream;
+                        t = p.getTimestamp(p.avVideoStream, value);
+                    }
+                    else if (p.avAudioStream != -1)
+                    {
+                        stream = p.avAudioStream;
+                        AVRational r;
+                        r.num = 1;
+                        r.den = p.info.audio.sampleRate;
+                        t = av_rescale_q(value, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
+                    }
+                    if (p.avVideoStream != -1)
+                    {
+                        avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                    }
+                    if (p.avAudioStream != -1)
+                    {
+                        avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                    }
+                    p.decodeFrame = Frame::invalid;
+                    return av_seek_frame(p.avFormatContext, stream, t, AVSEEK_FLAG_BACKWARD) >= 0;
+                }
+
+                bool Read::_decode(Frame::Number value, bool cacheEnabled, bool cacheOnly)
+                {
+                    DJV_PRIVATE_PTR();
+                    const bool reverse = Direction::Reverse == p.direction;
+
+                    // Reverse playback decodes each group of pictures from the
+                    // key frame, which needs the index.
+                    if (reverse && !p.keyFramesInit && !_readIndex())
+                    {
+                        return false;
+                    }
+
+                    // Move the decoder unless it can get to the frame by decoding
+                    // forward without passing a key frame. Without an index the
+                    // decoder only moves backwards.
+                    const Frame::Number keyFrame = _getKeyFrame(value);
+                    if (Frame::invalid == p.decodeFrame ||
+                        value < p.decodeFrame ||
+                        (p.keyFrames.size() && keyFrame > p.decodeFrame))
+                    {
+                        if (!_seekDecoder(keyFrame))
+                        {
+                            return false;
+                        }
+                    }
+
+                    bool out = true;
+                    Frame::Number videoFrame = Frame::invalid;
+                    Frame::Number audioFrame = Frame::invalid;
+                    AVPacket packet;
+                    while (p.running && (Frame::invalid == p.decodeFrame || p.decodeFrame <= value))
+                    {
+                        if (av_read_frame(p.avFormatContext, &packet) < 0)
+                        {
+                            // Flush the decoders at the end of the file.
+                            DecodeVideo dv;
+                            dv.seek         = reverse ? Frame::invalid : value;
+                            dv.cacheEnabled = cacheEnabled;
+                            dv.cacheOnly    = cacheOnly;
+                            _decodeVideo(dv, videoFrame);
+                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                            if (p.avAudioStream != -1 && !cacheOnly)
+                            {
+                                DecodeAudio da;
+                                da.seek    = p.audioSeek;
+                                da.reverse = reverse;
+                                _decodeAudio(da, audioFrame);
+                                avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                            }
+                            p.decodeFrame = Frame::invalid;
+                            out = false;
+                            break;
+                        }
+                        if (p.avVideoStream == packet.stream_index)
+                        {
+                            DecodeVideo dv;
+                            dv.packet       = &packet;
+                            dv.seek         = reverse ? Frame::invalid : value;
+                            dv.cacheEnabled = cacheEnabled;
+                            dv.cacheOnly    = cacheOnly;
+                            if (_decodeVideo(dv, videoFrame) < 0)
+                            {
+                                av_packet_unref(&packet);
+                                p.decodeFrame = Frame::invalid;
+                                out = false;
+                                break;
+                            }
+                        }
+                        else if (p.avAudioStream == packet.stream_index && !cacheOnly)
+                        {
+                            DecodeAudio da;
+                            da.packet  = &packet;
+                            da.seek    = p.audioSeek;
+                            da.reverse = reverse;
+                            if (_decodeAudio(da, audioFrame) < 0)
+                            {
+                                av_packet_unref(&packet);
+                                out = false;
+                                break;
+                            }
+                        }
+                        av_packet_unref(&packet);
+                    }
+                    return out;
+                }
+
+                void Read::_readQueue(bool cacheEnabled)
+                {
+                    DJV_PRIVATE_PTR();
+                    while (p.running)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            const bool full = _videoQueue.getCount() >= _videoQueue.getMax();
+                            const bool audio =
+                                p.avAudioStream != -1 &&
+                                Direction::Forward == p.direction &&
+                                !_audioQueue.isFinished() &&
+                                _audioQueue.getCount() < _audioQueue.getMax();
+                            if ((full && !audio) || _videoQueue.isFinished() || p.seek != Frame::invalid)
+                            {
+                                break;
+                            }
+                            if (p.frame < 0 || p.frame >= static_cast<Frame::Number>(p.sequenceSize))
+                            {
+                                _videoQueue.setFinished(true);
+                                _queueCV.notify_all();
+                                break;
+                            }
+                        }
+
+                        // The audio was not decoded when the cache was read ahead of
+                        // the queue, so the decoder is moved back to the queue.
+                        if (p.cacheDecode)
+                        {
+                            p.cacheDecode = false;
+                            p.decodeFrame = Frame::invalid;
+                        }
+
+                        // Frames the decoder has already passed are taken from the
+                        // cache, otherwise the audio would be skipped.
+                        std::shared_ptr<Image::Image> image;
+                        const bool cached =
+                            (-1 == p.avAudioStream ||
+                                Direction::Reverse == p.direction ||
+                                (p.decodeFrame != Frame::invalid && p.frame < p.decodeFrame)) &&
+                            _getImage(p.frame, cacheEnabled, image);
+                        if (cached)
+                        {
+                            _addVideoFrame(p.frame, image);
+                            if (Direction::Reverse == p.direction)
+                            {
+                                _addReverseAudio(p.frame);
+                            }
+                            p.frame += Direction::Forward == p.direction ? 1 : -1;
+                            continue;
+                        }
+
+                        const bool decoded = _decode(p.frame, cacheEnabled, false);
+                        switch (p.direction)
+                        {
+                        case Direction::Forward:
+                            // The decoded frames are added to the queue by _storeFrame().
+                            if (!decoded)
+                            {
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                _videoQueue.setFinished(true);
+                                _audioQueue.setFinished(true);
+                                _queueCV.notify_all();
+                            }
+                            break;
+                        case Direction::Reverse:
+                            // Frames that cannot be decoded are skipped.
+                            if (_getImage(p.frame, cacheEnabled, image))
+                            {
+                                _addVideoFrame(p.frame, image);
+                                _addReverseAudio(p.frame);
+                            }
+                            --p.frame;
+                            break;
+                        default: break;
+                        }
+                    }
+                }
+
+                void Read::_readCache(const InOutPoints& inOutPoints)
+                {
+                    DJV_PRIVATE_PTR();
+                    const Frame::Number frame = _getCacheFrame(inOutPoints);
+                    if (frame != Frame::invalid)
+                    {
+                        // Reading ahead of the queue with audio only decodes the
+                        // video into the cache.
+                        const bool cacheOnly = p.avAudioStream != -1 && Direction::Forward == p.direction;
+                        p.cacheDecode |= cacheOnly;
+                        _decode(frame, true, cacheOnly);
+                    }
+                }
+
+                void Read::_readAudio()
+                {
+                    DJV_PRIVATE_PTR();
+                    Frame::Number audioFrame = Frame::invalid;
+                    AVPacket packet;
+                    if (av_read_frame(p.avFormatContext, &packet) < 0)
+                    {
+                        DecodeAudio da;
+                        _decodeAudio(da, audioFrame);
+                        avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                        throw std::exception();
+                    }
+                    if (p.avAudioStream == packet.stream_index)
+                    {
+                        DecodeAudio da;
+                        da.packet = &packet;
+                        da.seek   = p.audioSeek;
+                        if (_decodeAudio(da, audioFrame) < 0)
+                        {
+                            av_packet_unref(&packet);
+                            throw std::exception();
+                        }
+                    }
+                    av_packet_unref(&packet);
+                }
+
+                Frame::Number Read::_getCacheFrame(const InOutPoints& inOutPoints) const
+                {
+                    DJV_PRIVATE_PTR();
+                    Frame::Number out = Frame::invalid;
+
+                    // While playing forward with audio the queue is read in step
+                    // with the audio and fills the cache itself. When stopped the
+                    // cache is read ahead without the audio.
+                    if (Frame::invalid == p.frame ||
+                        (p.avAudioStream != -1 && Direction::Forward == p.direction && p.playback))
+                        return out;
+
+                    // Stop once the byte budget would be exceeded, otherwise the
+                    // frames at the end of the cache would be evicted and read
+                    // again in a loop.
+                    const size_t cacheCount = _cache.getCount();
+                    const size_t maxByteCount = _cache.getMaxByteCount();
+                    if (cacheCount && maxByteCount &&
+                        _cache.getTotalByteCount() + _cache.getTotalByteCount() / cacheCount > maxByteCount)
+                        return out;
+
+                    const auto range = inOutPoints.getRange(p.sequenceSize);
+                    const auto& sequence = _cache.getSequence();
+                    Frame::Number frame = p.frame;
+                    for (size_t i = 0; i < _cache.getMax(); ++i)
+                    {
+                        if (frame < range.getMin() || frame > range.getMax() || !sequence.contains(frame))
+                        {
+                            break;
+                        }
+                        if (!_cache.contains(frame))
+                        {
+                            out = frame;
+                            break;
+                        }
+                        frame += Direction::Forward == p.direction ? 1 : -1;
+                    }
+                    return out;
+                }
+
+                bool Read::_getImage(Frame::Number frame, bool cacheEnabled, std::shared_ptr<Image::Image>& image)
+                {
+                    DJV_PRIVATE_PTR();
+                    const auto i = p.gop.find(frame);
+                    if (i != p.gop.end())
+                    {
+                        image = i->second;
+                        return true;
+                    }
+                    return cacheEnabled && _cache.get(frame, image);
+                }
+
+                void Read::_storeFrame(Frame::Number frame, const std::shared_ptr<Image::Image>& image, bool cacheEnabled)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (cacheEnabled)
+                    {
+                        _cache.add(frame, image);
+                    }
+                    switch (p.direction)
+                    {
+                    case Direction::Forward:
+                        if (frame >= p.frame)
+                        {
+                            // Frames read ahead into the cache are not added to
+                            // the queue. With audio the frames are always added so
+                            // they stay in step.
+                            bool add = false;
+                            {
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                add =
+                                    !_videoQueue.isFinished() &&
+                                    (p.avAudioStream != -1 || _videoQueue.getCount() < _videoQueue.getMax());
+                            }
+                            if (add)
+                            {
+                                _addVideoFrame(frame, image);
+                                p.frame = frame + 1;
+                            }
+                        }
+                        break;
+                    case Direction::Reverse:
+                    {
+                        // Keep the decoded group of pictures for playing backwards.
+                        // Only the group of the current frame is kept, less the
+                        // frames that have already been played; the other groups
+                        // are only kept by the frame cache so they are charged
+                        // to its budget.
+                        p.gop[frame] = image;
+                        p.gop.erase(p.gop.upper_bound(p.frame), p.gop.end());
+                        p.gop.erase(p.gop.begin(), p.gop.lower_bound(_getKeyFrame(p.frame)));
+                        break;
+                    }
+                    default: break;
+                    }
+                }
+
+                void Read::_addVideoFrame(Frame::Number frame, const std::shared_ptr<Image::Image>& image)
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (Frame::invalid == p.seek)
+                    {
+                        _videoQueue.addFrame(VideoFrame(frame, image));
+                        _queueCV.notify_all();
+                    }
+                }
+
+                void Read::_addReverseAudio(Frame::Number frame)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (-1 == p.avAudioStream)
+                        return;
+                    const int64_t start = p.getSample(frame);
+                    const int64_t end = p.getSample(frame + 1);
+                    if (end <= start)
+                        return;
+
+                    // Frames taken from the cache or the group of pictures may
+                    // not have had their audio decoded.
+                    const int64_t audioEnd = std::min(end, static_cast<int64_t>(p.info.audio.sampleCount));
+                    if (start < audioEnd && !p.hasReverseAudio(start, audioEnd))
+                    {
+                        _decodeReverseAudio(frame);
+                    }
+
+                    // Copy the samples for the frame from the decoded audio, with
+                    // silence where the audio has not been decoded.
+                    auto audioInfo = p.info.audio;
+                    audioInfo.sampleCount = end - start;
+                    auto audioData = Audio::Data::create(audioInfo);
+                    audioData->zero();
+                    const size_t sampleByteCount = audioInfo.channelCount * Audio::getByteCount(audioInfo.type);
+                    auto i = p.reverseAudio.upper_bound(start);
+                    if (i != p.reverseAudio.begin())
+                    {
+                        --i;
+                    }
+                    for (; i != p.reverseAudio.end() && i->first < end; ++i)
+                    {
+                        const int64_t dataEnd = i->first + static_cast<int64_t>(i->second->getSampleCount());
+                        const int64_t copyStart = std::max(start, i->first);
+                        const int64_t copyEnd = std::min(end, dataEnd);
+                        if (copyEnd > copyStart)
+                        {
+                            memcpy(
+                                audioData->getData() + (copyStart - start) * sampleByteCount,
+                                i->second->getData() + (copyStart - i->first) * sampleByteCount,
+                                (copyEnd - copyStart) * sampleByteCount);
+                        }
+                    }
+
+                    // Reverse the samples.
+                    std::vector<uint8_t> tmp(sampleByteCount);
+                    uint8_t* a = audioData->getData();
+                    uint8_t* b = a + (audioInfo.sampleCount - 1) * sampleByteCount;
+                    for (; a < b; a += sampleByteCount, b -= sampleByteCount)
+                    {
+                        memcpy(tmp.data(), a, sampleByteCount);
+                        memcpy(a, b, sampleByteCount);
+                        memcpy(b, tmp.data(), sampleByteCount);
+                    }
+
+                    // The audio after the start of the frame is no longer needed.
+                    p.reverseAudio.erase(p.reverseAudio.lower_bound(start), p.reverseAudio.end());
+
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (Frame::invalid == p.seek)
+                    {
+                        _audioQueue.addFrame(AudioFrame(audioData));
+                        _queueCV.notify_all();
+                    }
+                }
+
+                void Read::_decodeReverseAudio(Frame::Number frame)
+                {
+                    DJV_PRIVATE_PTR();
+
+                    // Only decode once for each frame range, otherwise audio that
+                    // is missing from the file would be decoded for every frame.
+                    if (p.reverseAudioDecode != Frame::invalid && frame >= p.reverseAudioDecode)
+                        return;
+
+                    // Decode the audio from the key frame, or from a second
+                    // before the frame without an index. The decoder is moved
+                    // again on the next video decode.
+                    Frame::Number decodeFrame = p.keyFrames.size() ?
+                        _getKeyFrame(frame) :
+                        (frame - static_cast<Frame::Number>(p.info.videoSpeed.toFloat()));
+                    decodeFrame = std::max(decodeFrame, static_cast<Frame::Number>(0));
+                    p.reverseAudioDecode = decodeFrame;
+                    if (!_seekDecoder(decodeFrame))
+                        return;
+                    const int64_t end = p.getSample(frame + 1);
+                    Frame::Number audioFrame = Frame::invalid;
+                    AVPacket packet;
+                    while (p.running && av_read_frame(p.avFormatContext, &packet) >= 0)
+                    {
+                        bool done = false;
+                        if (p.avAudioStream == packet.stream_index)
+                        {
+                            DecodeAudio da;
+                            da.packet  = &packet;
+                            da.seek    = p.audioSeek;
+                            da.reverse = true;
+                            done =
+                                _decodeAudio(da, audioFrame) < 0 ||
+                                (p.reverseAudio.size() &&
+                                    p.reverseAudio.rbegin()->first +
+                                    static_cast<int64_t>(p.reverseAudio.rbegin()->second->getSampleCount()) >= end);
+                        }
+                        av_packet_unref(&packet);
+                        if (done)
+                        {
+                            break;
+                        }
+                    }
+                }
+
                 int Read::_decodeVideo(const DecodeVideo& dv, Frame::Number& frame)
                 {
                     DJV_PRIVATE_PTR();
@@ -627,17 +1278,16 @@ namespace djv
                         {
                             break;
                         }
-                        
-                        AVRational r;
-                        r.num = p.info.videoSpeed.getDen();
-                        r.den = p.info.videoSpeed.getNum();
-                        frame = av_rescale_q(
-                            p.avFrame->pts,
-                            p.avFormatContext->streams[p.avVideoStream]->time_base,
-                            r);
+
+                        frame = p.getFrame(p.avVideoStream, p.avFrame->pts);
+                        p.decodeFrame = frame + 1;
                         //std::cout << "decode video = " << frame << std::endl;
 
-                        if (Frame::invalid == dv.seek || frame >= dv.seek)
+                        // Frames before the seek frame are only converted when they
+                        // are missing from the cache.
+                        if (Frame::invalid == dv.seek ||
+                            frame >= dv.seek ||
+                            (dv.cacheEnabled && !_cache.contains(frame)))
                         {
                             std::shared_ptr<Image::Image> image;
                             if (dv.cacheEnabled && _cache.get(frame, image))
@@ -669,20 +1319,17 @@ namespace djv
                                     (uint8_t const* const*)p.avFrame->data,
                                     p.avFrame->linesize,
                                     0,
-                                    p.avCodecParameters[p.avVideoStream]->height,
+                                    p.avCodecContext[p.avVideoStream]->height,
                                     p.avFrameRgb->data,
                                     p.avFrameRgb->linesize);
-                                if (dv.cacheEnabled)
-                                {
-                                    _cache.add(frame, image);
-                                }
                             }
+                            if (dv.cacheOnly)
                             {
-                                std::lock_guard<std::mutex> lock(_mutex);
-                                if (Frame::invalid == p.seek)
-                                {
-                                    _videoQueue.addFrame(VideoFrame(frame, image));
-                                }
+                                _cache.add(frame, image);
+                            }
+                            else
+                            {
+                                _storeFrame(frame, image, dv.cacheEnabled);
                             }
                         }
                     }
@@ -706,30 +1353,86 @@ namespace djv
                             break;
                         }
 
+                        // Audio files use the sample number for the frame.
                         AVRational r;
-                        r.num = p.info.videoSpeed.getDen();
-                        r.den = p.info.videoSpeed.getNum();
+                        if (p.avVideoStream != -1)
+                        {
+                            r.num = p.info.videoSpeed.getDen();
+                            r.den = p.info.videoSpeed.getNum();
+                        }
+                        else
+                        {
+                            r.num = 1;
+                            r.den = p.info.audio.sampleRate;
+                        }
                         frame = av_rescale_q(
                             p.avFrame->pts,
                             p.avFormatContext->streams[p.avAudioStream]->time_base,
                             r);
                         //std::cout << "decode audio = " << frame << std::endl;
 
-                        if (Frame::invalid == da.seek || frame >= da.seek)
+                        // Audio decoded while playing backwards is kept until the
+                        // video frames it belongs to are added to the queue.
+                        if (da.reverse)
                         {
+                            const int64_t sample = p.getSampleFromPts(p.avFrame->pts);
+                            if (p.reverseAudio.find(sample) == p.reverseAudio.end())
+                            {
+                                auto audioInfo = p.info.audio;
+                                audioInfo.sampleCount = p.avFrame->nb_samples;
+                                auto audioData = Audio::Data::create(audioInfo);
+                                extractAudio(
+                                    p.avFrame->data,
+                                    p.avCodecParameters[p.avAudioStream]->format,
+                                    p.avCodecParameters[p.avAudioStream]->channels,
+                                    audioData);
+                                p.reverseAudio[sample] = audioData;
+                                const int64_t max = static_cast<int64_t>(p.info.audio.sampleRate * reverseAudioTimeMax);
+                                while (p.reverseAudio.size() > 1 &&
+                                    p.reverseAudio.rbegin()->first - p.reverseAudio.begin()->first > max)
+                                {
+                                    p.reverseAudio.erase(p.reverseAudio.begin());
+                                }
+                            }
+                            continue;
+                        }
+
+                        // The packets may be read again after the decoder is moved,
+                        // so skip the audio that has already been added.
+                        // Audio files start at the seek sample, so the samples
+                        // before it are removed from the first frame.
+                        const Frame::Number sampleCount = p.avFrame->nb_samples;
+                        Frame::Number offset = 0;
+                        if (-1 == p.avVideoStream && da.seek != Frame::invalid && frame < da.seek)
+                        {
+                            offset = std::min(da.seek - frame, sampleCount);
+                        }
+                        if ((Frame::invalid == da.seek || frame >= da.seek || (-1 == p.avVideoStream && offset < sampleCount)) &&
+                            (AV_NOPTS_VALUE == p.audioPts || p.avFrame->pts > p.audioPts))
+                        {
+                            p.audioPts = p.avFrame->pts;
                             auto audioInfo = p.info.audio;
-                            audioInfo.sampleCount = p.avFrame->nb_samples;
+                            audioInfo.sampleCount = sampleCount;
                             auto audioData = Audio::Data::create(audioInfo);
                             extractAudio(
                                 p.avFrame->data,
                                 p.avCodecParameters[p.avAudioStream]->format,
                                 p.avCodecParameters[p.avAudioStream]->channels,
                                 audioData);
+                            if (offset > 0)
+                            {
+                                audioInfo.sampleCount = sampleCount - offset;
+                                auto tmp = Audio::Data::create(audioInfo);
+                                const size_t sampleByteCount = audioInfo.channelCount * Audio::getByteCount(audioInfo.type);
+                                memcpy(tmp->getData(), audioData->getData() + offset * sampleByteCount, tmp->getByteCount());
+                                audioData = tmp;
+                            }
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 if (Frame::invalid == p.seek)
                                 {
                                     _audioQueue.addFrame(AudioFrame(audioData));
+                                    _queueCV.notify_all();
                                 }
                             }
                         }
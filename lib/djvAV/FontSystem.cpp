@@ -306,6 +306,12 @@ namespace djv
                             p.glyphsRequests = std::move(p.glyphsQueue);
                             p.textLinesRequests = std::move(p.textLinesQueue);
                         }
+                        const bool results =
+                            p.metricsRequests.size() ||
+                            p.measureRequests.size() ||
+                            p.measureGlyphsRequests.size() ||
+                            p.glyphsRequests.size() ||
+                            p.textLinesRequests.size();
                         if (lcdRenderingChanged)
                         {
                             p.glyphCache.clear();
@@ -332,6 +338,10 @@ namespace djv
                         {
                             _handleTextLinesRequests();
                         }
+                        if (results)
+                        {
+                            _wake();
+                        }
                     }
                     _delFreeType();
                 });
@@ -38,6 +38,7 @@ namespace djv
                 FaceID   getFace() const;
                 uint16_t getSize() const;
                 uint16_t getDPI() const;
+                size_t   getHash() const;
 
                 bool operator == (const FontInfo&) const;
                 bool operator < (const FontInfo&) const;
@@ -195,4 +196,20 @@ namespace djv
     } // namespace AV
 } // namespace djv
 
+namespace std
+{
+    template<>
+    struct hash<djv::AV::Font::FontInfo>
+    {
+        std::size_t operator() (const djv::AV::Font::FontInfo&) const noexcept;
+    };
+
+    template<>
+    struct hash<djv::AV::Font::GlyphInfo>
+    {
+        std::size_t operator() (const djv::AV::Font::GlyphInfo&) const noexcept;
+    };
+
+} // namespace std
+
 #include <djvAV/FontSystemInline.h>
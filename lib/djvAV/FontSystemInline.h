@@ -45,6 +45,11 @@ namespace djv
                 return _dpi;
             }
 
+            inline size_t FontInfo::getHash() const
+            {
+                return _hash;
+            }
+
             inline bool FontInfo::operator == (const FontInfo& other) const
             {
                 return _hash == other._hash;
@@ -93,3 +98,19 @@ namespace djv
         } // namespace Font
     } // namespace AV
 } // namespace djv
+
+namespace std
+{
+    inline std::size_t hash<djv::AV::Font::FontInfo>::operator() (const djv::AV::Font::FontInfo& value) const noexcept
+    {
+        return value.getHash();
+    }
+
+    inline std::size_t hash<djv::AV::Font::GlyphInfo>::operator() (const djv::AV::Font::GlyphInfo& value) const noexcept
+    {
+        size_t hash = value.fontInfo.getHash();
+        djv::Core::Memory::hashCombine(hash, value.code);
+        return hash;
+    }
+
+} // namespace std
@@ -4,6 +4,7 @@
 
 #include <djvAV/IO.h>
 
+#include <djvCore/Math.h>
 #include <djvCore/Speed.h>
 
 using namespace djv::Core;
@@ -86,6 +87,32 @@ namespace djv
                 _finished = value;
             }
 
+            Image::Size getProxySize(const Image::Size& value, ProxyScale proxyScale)
+            {
+                const size_t denominator = getProxyDenominator(proxyScale);
+                return Image::Size(
+                    static_cast<uint16_t>((value.w + denominator - 1) / denominator),
+                    static_cast<uint16_t>((value.h + denominator - 1) / denominator));
+            }
+
+            ProxyScale getProxyScale(const Image::Size& imageSize, const Image::Size& size)
+            {
+                ProxyScale out = ProxyScale::None;
+                if (size.isValid())
+                {
+                    for (auto i : getProxyScaleEnums())
+                    {
+                        const Image::Size proxySize = getProxySize(imageSize, i);
+                        if (proxySize.w < size.w || proxySize.h < size.h)
+                        {
+                            break;
+                        }
+                        out = i;
+                    }
+                }
+                return out;
+            }
+
             Frame::Sequence Cache::getFrames() const
             {
                 Frame::Sequence out;
@@ -126,14 +153,24 @@ namespace djv
                 if (value == _max)
                     return;
                 _max = value;
+                _windowUpdate();
                 _cacheUpdate();
             }
 
+            void Cache::setMaxByteCount(size_t value)
+            {
+                if (value == _maxByteCount)
+                    return;
+                _maxByteCount = value;
+                _maxByteCountUpdate();
+            }
+
             void Cache::setSequenceSize(size_t value)
             {
                 if (value == _sequenceSize)
                     return;
                 _sequenceSize = value;
+                _windowUpdate();
                 _cacheUpdate();
             }
 
@@ -142,6 +179,7 @@ namespace djv
                 if (value == _inOutPoints)
                     return;
                 _inOutPoints = value;
+                _windowUpdate();
                 _cacheUpdate();
             }
 
@@ -150,6 +188,7 @@ namespace djv
                 if (value == _direction)
                     return;
                 _direction = value;
+                _windowUpdate();
                 _cacheUpdate();
             }
 
@@ -158,100 +197,149 @@ namespace djv
                 if (value == _currentFrame)
                     return;
                 _currentFrame = value;
+                _windowUpdate();
                 _cacheUpdate();
             }
 
             void Cache::add(Frame::Index index, const std::shared_ptr<AV::Image::Image>& image)
             {
-                _cache[index] = image;
-                _cacheUpdate();
+                if (!_sequence.contains(index))
+                    return;
+                auto i = _cache.find(index);
+                if (i != _cache.end())
+                {
+                    _byteCount -= _getByteCount(i->second);
+                    i->second = image;
+                }
+                else
+                {
+                    _cache[index] = image;
+                }
+                _byteCount += _getByteCount(image);
+                _maxByteCountUpdate();
             }
 
-            void Cache::_cacheUpdate()
+            void Cache::_erase(std::map<Frame::Index, std::shared_ptr<AV::Image::Image> >::iterator i)
             {
-                const auto range = _inOutPoints.getRange(_sequenceSize);
-                Frame::Index frame = _currentFrame;
+                _byteCount -= _getByteCount(i->second);
+                _cache.erase(i);
+                ++_stats.evictionCount;
+            }
+
+            void Cache::_windowUpdate()
+            {
+                _window.clear();
                 _sequence = Frame::Sequence();
-                switch (_direction)
-                {
-                case Direction::Forward:
+                const auto range = _inOutPoints.getRange(_sequenceSize);
+                const Frame::Index min = range.getMin();
+                const Frame::Index max = range.getMax();
+                const Frame::Index size = max - min + 1;
+                const Frame::Index count = _max ? std::min(static_cast<Frame::Index>(_max) + 1, size) : 0;
+                if (count > 0)
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    const Frame::Index readBehind = static_cast<Frame::Index>(_readBehind) % size;
+                    const Frame::Index current = Math::clamp(_currentFrame, min, max);
+                    switch (_direction)
+                    {
+                    case Direction::Forward:
                     {
-                        --frame;
-                        if (frame < range.getMin())
+                        Frame::Index start = current - readBehind;
+                        if (start < min)
                         {
-                            frame = range.getMax();
+                            start += size;
                         }
-                    }
-                    _sequence.add(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
-                    {
-                        ++frame;
-                        if (first == frame)
+                        const Frame::Index end = start + count - 1;
+                        _window.push_back(Frame::Range(start, std::min(end, max)));
+                        if (end > max)
                         {
-                            break;
+                            _window.push_back(Frame::Range(min, min + end - max - 1));
                         }
-                        if (frame > range.getMax())
+                        break;
+                    }
+                    case Direction::Reverse:
+                    {
+                        Frame::Index start = current + readBehind;
+                        if (start > max)
                         {
-                            frame = range.getMin();
-                            if (frame != _sequence.getRanges().back().getMax())
-                            {
-                                _sequence.add(Frame::Range(frame));
-                            }
+                            start -= size;
                         }
-                        else
+                        const Frame::Index end = start - count + 1;
+                        _window.push_back(Frame::Range(std::max(end, min), start));
+                        if (end < min)
                         {
-                            _sequence.add(Frame::Range(frame));
+                            _window.push_back(Frame::Range(max - (min - end) + 1, max));
                         }
+                        break;
                     }
-                    break;
+                    default: break;
+                    }
+                }
+                for (const auto& i : _window)
+                {
+                    _sequence.add(i);
                 }
-                case Direction::Reverse:
+            }
+
+            void Cache::_cacheUpdate()
+            {
+                auto i = _cache.begin();
+                while (i != _cache.end())
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    auto j = i;
+                    ++i;
+                    if (!_sequence.contains(j->first))
                     {
-                        ++frame;
-                        if (frame > range.getMax())
-                        {
-                            frame = range.getMin();
-                        }
+                        _erase(j);
                     }
-                    _sequence.add(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                }
+                _maxByteCountUpdate();
+            }
+
+            void Cache::_maxByteCountUpdate()
+            {
+                if (!_maxByteCount)
+                    return;
+
+                // Evict the frames furthest from the current frame in the playback
+                // direction until the cache fits in the maximum byte count. Each
+                // eviction is a logarithmic lookup in the cache.
+                auto window = _window.rbegin();
+                while (_byteCount > _maxByteCount && window != _window.rend())
+                {
+                    auto i = _cache.end();
+                    switch (_direction)
                     {
-                        --frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame < range.getMin())
+                    case Direction::Forward:
+                    {
+                        auto j = _cache.upper_bound(window->getMax());
+                        if (j != _cache.begin())
                         {
-                            frame = range.getMax();
-                            if (frame != _sequence.getRanges().back().getMin())
+                            --j;
+                            if (j->first >= window->getMin())
                             {
-                                _sequence.add(Frame::Range(frame));
+                                i = j;
                             }
                         }
-                        else
+                        break;
+                    }
+                    case Direction::Reverse:
+                    {
+                        auto j = _cache.lower_bound(window->getMin());
+                        if (j != _cache.end() && j->first <= window->getMax())
                         {
-                            _sequence.add(Frame::Range(frame));
+                            i = j;
                         }
+                        break;
                     }
-                    break;
-                }
-                default: break;
-                }
-                auto i = _cache.begin();
-                while (i != _cache.end())
-                {
-                    auto j = i;
-                    ++i;
-                    if (!_sequence.contains(j->first))
+                    default: break;
+                    }
+                    if (i != _cache.end())
+                    {
+                        _erase(i);
+                    }
+                    else
                     {
-                        _cache.erase(j);
+                        ++window;
                     }
                 }
             }
@@ -140,6 +140,31 @@ namespace djv
                 Core::Frame::Index _out = Core::Frame::invalid;
             };
 
+            //! This enumeration provides the scales for reading reduced resolution
+            //! proxy images.
+            enum class ProxyScale
+            {
+                None,    //!< Full resolution
+                Half,
+                Quarter,
+                Eighth,
+
+                Count,
+                First = None
+            };
+            DJV_ENUM_HELPERS(ProxyScale);
+
+            //! Get the denominator of a proxy scale (1, 2, 4, or 8).
+            size_t getProxyDenominator(ProxyScale);
+
+            //! Get the size of an image read with a proxy scale. The size is rounded
+            //! up, the same as libjpeg DCT scaling.
+            Image::Size getProxySize(const Image::Size&, ProxyScale);
+
+            //! Get the smallest proxy scale that keeps an image at least as large
+            //! as the given size.
+            ProxyScale getProxyScale(const Image::Size& imageSize, const Image::Size&);
+
             //! This enumeration provides the playback direction for caching.
             enum class Direction
             {
@@ -147,19 +172,40 @@ namespace djv
                 Reverse
             };
 
+            //! This struct provides frame cache statistics.
+            struct CacheStats
+            {
+                size_t hitCount      = 0;
+                size_t missCount     = 0;
+                size_t evictionCount = 0;
+
+                CacheStats& operator += (const CacheStats&);
+
+                bool operator == (const CacheStats&) const;
+            };
+
             //! This class provides a frame cache.
+            //!
+            //! The cache keeps the frames inside a window that starts a few frames
+            //! behind the current frame and extends in the playback direction. The
+            //! size of the window is limited both by a frame count and a byte count,
+            //! when the byte count is exceeded the frames furthest from the current
+            //! frame in the playback direction are evicted first.
             class Cache
             {
             public:
                 Cache();
                 
                 size_t getMax() const;
+                size_t getMaxByteCount() const;
                 size_t getCount() const;
                 size_t getTotalByteCount() const;
+                size_t getByteCount(Core::Frame::Index) const;
                 Core::Frame::Sequence getFrames() const;
                 size_t getReadBehind() const;
                 const Core::Frame::Sequence& getSequence() const;
                 void setMax(size_t);
+                void setMaxByteCount(size_t);
                 void setSequenceSize(size_t);
                 void setInOutPoints(const InOutPoints&);
                 void setDirection(Direction);
@@ -170,18 +216,29 @@ namespace djv
                 void add(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&);
                 void clear();
 
+                const CacheStats& getStats() const;
+
             private:
+                static size_t _getByteCount(const std::shared_ptr<AV::Image::Image>&);
+                void _erase(std::map<Core::Frame::Index, std::shared_ptr<AV::Image::Image> >::iterator);
+                void _windowUpdate();
                 void _cacheUpdate();
+                void _maxByteCountUpdate();
 
                 size_t _max = 0;
+                size_t _maxByteCount = 0;
                 size_t _sequenceSize = 0;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
                 Core::Frame::Index _currentFrame = 0;
                 //! \todo Should this be configurable?
                 size_t _readBehind = 10;
+                //! The window ranges in playback order.
+                std::vector<Core::Frame::Range> _window;
                 Core::Frame::Sequence _sequence;
                 std::map<Core::Frame::Index, std::shared_ptr<AV::Image::Image> > _cache;
+                size_t _byteCount = 0;
+                mutable CacheStats _stats;
             };
 
         } // namespace IO
@@ -19,6 +19,11 @@ namespace djv
                     tags == other.tags;
             }
 
+            inline size_t getProxyDenominator(ProxyScale value)
+            {
+                return static_cast<size_t>(1) << static_cast<size_t>(value);
+            }
+
             inline VideoFrame::VideoFrame()
             {}
 
@@ -149,6 +154,22 @@ namespace djv
                     _out == other._out;
             }
 
+            inline CacheStats& CacheStats::operator += (const CacheStats& other)
+            {
+                hitCount      += other.hitCount;
+                missCount     += other.missCount;
+                evictionCount += other.evictionCount;
+                return *this;
+            }
+
+            inline bool CacheStats::operator == (const CacheStats& other) const
+            {
+                return
+                    hitCount == other.hitCount &&
+                    missCount == other.missCount &&
+                    evictionCount == other.evictionCount;
+            }
+
             inline Cache::Cache()
             {}
             
@@ -156,6 +177,11 @@ namespace djv
             {
                 return _max;
             }
+
+            inline size_t Cache::getMaxByteCount() const
+            {
+                return _maxByteCount;
+            }
             
             inline size_t Cache::getCount() const
             {
@@ -164,15 +190,13 @@ namespace djv
 
             inline size_t Cache::getTotalByteCount() const
             {
-                size_t out = 0;
-                for (const auto& i : _cache)
-                {
-                    if (i.second)
-                    {
-                        out += i.second->getDataByteCount();
-                    }
-                }
-                return out;
+                return _byteCount;
+            }
+
+            inline size_t Cache::getByteCount(Core::Frame::Index index) const
+            {
+                const auto i = _cache.find(index);
+                return i != _cache.end() ? _getByteCount(i->second) : 0;
             }
 
             inline size_t Cache::getReadBehind() const
@@ -197,6 +221,11 @@ namespace djv
                 if (found)
                 {
                     out = i->second;
+                    ++_stats.hitCount;
+                }
+                else
+                {
+                    ++_stats.missCount;
                 }
                 return found;
             }
@@ -204,6 +233,17 @@ namespace djv
             inline void Cache::clear()
             {
                 _cache.clear();
+                _byteCount = 0;
+            }
+
+            inline const CacheStats& Cache::getStats() const
+            {
+                return _stats;
+            }
+
+            inline size_t Cache::_getByteCount(const std::shared_ptr<AV::Image::Image>& value)
+            {
+                return value ? value->getDataByteCount() : 0;
             }
 
         } // namespace IO
@@ -4,6 +4,8 @@
 
 #include <djvAV/IOPlugin.h>
 
+#include <djvAV/IOSystem.h>
+
 #include <djvCore/Context.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/ResourceSystem.h>
@@ -113,6 +115,18 @@ namespace djv
                 _cacheMaxByteCount = value;
             }
 
+            size_t IRead::getCacheRequiredByteCount()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _cacheRequiredByteCount;
+            }
+
+            CacheStats IRead::getCacheStats()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _cacheStats;
+            }
+
             void IWrite::_init(
                 const FileSystem::FileInfo& fileInfo,
                 const Info& info,
@@ -141,6 +155,10 @@ namespace djv
                 _pluginName     = pluginName;
                 _pluginInfo     = pluginInfo;
                 _fileExtensions = fileExtensions;
+                if (auto ioSystem = context->getSystemT<System>())
+                {
+                    _threadPool = ioSystem->getThreadPool();
+                }
             }
 
             IPlugin::~IPlugin()
@@ -192,6 +210,19 @@ namespace djv
                 return nullptr;
             }
 
+            bool IPlugin::hasCache() const
+            {
+                return false;
+            }
+
+            size_t IPlugin::getCacheByteCount() const
+            {
+                return 0;
+            }
+
+            void IPlugin::setCacheMaxByteCount(size_t)
+            {}
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
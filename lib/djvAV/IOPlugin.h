@@ -5,9 +5,12 @@
 #pragma once
 
 #include <djvAV/IO.h>
+#include <djvAV/IOThreadPool.h>
 
 #include <djvCore/FileInfo.h>
 
+#include <condition_variable>
+
 namespace djv
 {
     namespace Core
@@ -54,12 +57,18 @@ namespace djv
                 VideoQueue& getVideoQueue();
                 AudioQueue& getAudioQueue();
 
+                //! Get the condition variable that readers notify when frames are
+                //! added to the queues or the queues are finished. It is used with
+                //! the mutex.
+                std::condition_variable& getQueueCV();
+
             protected:
                 std::shared_ptr<Core::LogSystem> _logSystem;
                 std::shared_ptr<Core::ResourceSystem> _resourceSystem;
                 std::shared_ptr<Core::TextSystem> _textSystem;
                 Core::FileSystem::FileInfo _fileInfo;
                 std::mutex _mutex;
+                std::condition_variable _queueCV;
                 VideoQueue _videoQueue;
                 AudioQueue _audioQueue;
                 size_t _threadCount = 4;
@@ -70,6 +79,15 @@ namespace djv
             {
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! Read reduced resolution images. Readers that cannot decode at a
+                //! reduced resolution have their images resampled after reading.
+                //! The information returned by the reader has the proxy size.
+                ProxyScale proxyScale = ProxyScale::None;
+
+                //! Read the video. When this is disabled movie files are read as
+                //! audio files.
+                bool video = true;
             };
 
             //! This class provides an interface for reading.
@@ -105,6 +123,12 @@ namespace djv
                 void setCacheEnabled(bool);
                 void setCacheMaxByteCount(size_t);
 
+                //! Get the number of bytes required to cache every frame between
+                //! the in/out points.
+                size_t getCacheRequiredByteCount();
+
+                CacheStats getCacheStats();
+
             protected:
                 ReadOptions _options;
                 InOutPoints _inOutPoints;
@@ -114,6 +138,8 @@ namespace djv
                 bool _cacheEnabled = false;
                 size_t _cacheMaxByteCount = 0;
                 size_t _cacheByteCount = 0;
+                size_t _cacheRequiredByteCount = 0;
+                CacheStats _cacheStats;
                 Core::Frame::Sequence _cacheSequence;
                 Core::Frame::Sequence _cachedFrames;
                 Cache _cache;
@@ -180,11 +206,21 @@ namespace djv
                 //! - std::exception
                 virtual std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info&, const WriteOptions&) const;
 
+                //! Get whether the plugin has a cache that is shared by its readers.
+                virtual bool hasCache() const;
+                virtual size_t getCacheByteCount() const;
+
+                //! Set the maximum byte count of the plugin cache. This is set by
+                //! the I/O system from the global cache budget; a value of zero lets
+                //! the plugin use its own maximum.
+                virtual void setCacheMaxByteCount(size_t);
+
             protected:
                 std::weak_ptr<Core::Context> _context;
                 std::shared_ptr<Core::LogSystem> _logSystem;
                 std::shared_ptr<Core::ResourceSystem> _resourceSystem;
                 std::shared_ptr<Core::TextSystem> _textSystem;
+                std::shared_ptr<ThreadPool> _threadPool;
                 std::string _pluginName;
                 std::string _pluginInfo;
                 std::set<std::string> _fileExtensions;
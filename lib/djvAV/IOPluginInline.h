@@ -28,6 +28,11 @@ namespace djv
                 return  _audioQueue;
             }
 
+            inline std::condition_variable& IIO::getQueueCV()
+            {
+                return _queueCV;
+            }
+
             inline const std::string& IPlugin::getPluginName() const
             {
                 return _pluginName;
@@ -34,6 +34,10 @@
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 using namespace djv::Core;
 
 namespace djv
@@ -42,10 +46,20 @@ namespace djv
     {
         namespace IO
         {
+            namespace
+            {
+                const size_t threadCountDefault = 4;
+
+            } // namespace
+
             struct System::Private
             {
                 std::shared_ptr<TextSystem> textSystem;
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
+                std::shared_ptr<ThreadPool> threadPool;
+                size_t cacheMaxByteCount = 0;
+                mutable std::mutex readersMutex;
+                std::vector<std::weak_ptr<IRead> > readers;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
                 std::set<std::string> nonSequenceExtensions;
@@ -63,6 +77,9 @@ namespace djv
 
                 p.optionsChanged = ValueSubject<bool>::create();
 
+                // The thread pool must be created before the plugins.
+                p.threadPool = ThreadPool::create(threadCountDefault);
+
                 p.plugins[Cineon::pluginName] = Cineon::Plugin::create(context);
                 p.plugins[DPX::pluginName] = DPX::Plugin::create(context);
                 p.plugins[IFF::pluginName] = IFF::Plugin::create(context);
@@ -171,6 +188,56 @@ namespace djv
                 return _p->optionsChanged;
             }
 
+            const std::shared_ptr<ThreadPool>& System::getThreadPool() const
+            {
+                return _p->threadPool;
+            }
+
+            size_t System::getThreadCount() const
+            {
+                return _p->threadPool->getThreadCount();
+            }
+
+            void System::setThreadCount(size_t value)
+            {
+                _p->threadPool->setThreadCount(value);
+            }
+
+            size_t System::getCacheMaxByteCount() const
+            {
+                return _p->cacheMaxByteCount;
+            }
+
+            void System::setCacheMaxByteCount(size_t value)
+            {
+                _p->cacheMaxByteCount = value;
+            }
+
+            size_t System::getCacheByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                size_t out = 0;
+                for (const auto& i : _getReaders())
+                {
+                    out += i->getCacheByteCount();
+                }
+                for (const auto& i : p.plugins)
+                {
+                    out += i.second->getCacheByteCount();
+                }
+                return out;
+            }
+
+            CacheStats System::getCacheStats() const
+            {
+                CacheStats out;
+                for (const auto& i : _getReaders())
+                {
+                    out += i->getCacheStats();
+                }
+                return out;
+            }
+
             const std::set<std::string>& System::getSequenceExtensions() const
             {
                 return _p->sequenceExtensions;
@@ -234,6 +301,10 @@ namespace djv
                         arg(fileInfo.getFileName()).
                         arg(p.textSystem->getText(DJV_TEXT("error_file_read"))));
                 }
+                {
+                    std::lock_guard<std::mutex> lock(p.readersMutex);
+                    p.readers.push_back(out);
+                }
                 return out;
             }
 
@@ -258,6 +329,81 @@ namespace djv
                 return out;
             }
 
+            void System::tick()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.cacheMaxByteCount)
+                {
+                    // The plugin caches share the budget with the readers; they
+                    // can use any amount so they are given what is left over.
+                    typedef std::pair<size_t, std::function<void(size_t)> > Cache;
+                    std::vector<Cache> caches;
+                    for (const auto& i : _getReaders())
+                    {
+                        if (i->hasCache() && i->isCacheEnabled())
+                        {
+                            caches.push_back(std::make_pair(
+                                i->getCacheRequiredByteCount(),
+                                [i](size_t value) { i->setCacheMaxByteCount(value); }));
+                        }
+                    }
+                    for (const auto& i : p.plugins)
+                    {
+                        if (i.second->hasCache())
+                        {
+                            // A share of zero would let the plugin use its own maximum.
+                            auto plugin = i.second;
+                            caches.push_back(std::make_pair(
+                                std::numeric_limits<size_t>::max(),
+                                [plugin](size_t value) { plugin->setCacheMaxByteCount(std::max(value, static_cast<size_t>(1))); }));
+                        }
+                    }
+                    std::stable_sort(
+                        caches.begin(),
+                        caches.end(),
+                        [](const Cache& a, const Cache& b)
+                        {
+                            return a.first < b.first;
+                        });
+                    size_t byteCount = p.cacheMaxByteCount;
+                    const size_t size = caches.size();
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        const size_t cacheByteCount = std::min(caches[i].first, byteCount / (size - i));
+                        caches[i].second(cacheByteCount);
+                        byteCount -= cacheByteCount;
+                    }
+                }
+                else
+                {
+                    for (const auto& i : p.plugins)
+                    {
+                        i.second->setCacheMaxByteCount(0);
+                    }
+                }
+            }
+
+            std::vector<std::shared_ptr<IRead> > System::_getReaders() const
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<std::shared_ptr<IRead> > out;
+                std::lock_guard<std::mutex> lock(p.readersMutex);
+                auto i = p.readers.begin();
+                while (i != p.readers.end())
+                {
+                    if (auto read = i->lock())
+                    {
+                        out.push_back(read);
+                        ++i;
+                    }
+                    else
+                    {
+                        i = p.readers.erase(i);
+                    }
+                }
+                return out;
+            }
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
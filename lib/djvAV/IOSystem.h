@@ -50,6 +50,28 @@ namespace djv
 
                 std::shared_ptr<Core::IValueSubject<bool> > observeOptionsChanged() const;
 
+                //! Get the thread pool shared by the readers.
+                const std::shared_ptr<ThreadPool>& getThreadPool() const;
+
+                size_t getThreadCount() const;
+                void setThreadCount(size_t);
+
+                //! Get the total number of bytes that may be used by the frame
+                //! caches of all the readers.
+                size_t getCacheMaxByteCount() const;
+
+                //! Set the total number of bytes that may be used by the frame caches
+                //! of all the readers. The total is divided between the readers that
+                //! have caching enabled and the plugin caches; readers that need less
+                //! than an equal share get what they need and the remainder is divided
+                //! between the others. A value of zero lets each reader and plugin use
+                //! its own maximum.
+                void setCacheMaxByteCount(size_t);
+
+                //! Get the number of bytes used by the reader and plugin caches.
+                size_t getCacheByteCount() const;
+                CacheStats getCacheStats() const;
+
                 const std::set<std::string>& getSequenceExtensions() const;
                 const std::set<std::string>& getNonSequenceExtensions() const;
                 bool canSequence(const Core::FileSystem::FileInfo&) const;
@@ -64,7 +86,11 @@ namespace djv
                 //! - std::exception
                 std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info&, const WriteOptions& = WriteOptions());
 
+                void tick() override;
+
             private:
+                std::vector<std::shared_ptr<IRead> > _getReaders() const;
+
                 DJV_PRIVATE();
             };
 
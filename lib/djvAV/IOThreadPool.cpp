@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/IOThreadPool.h>
+
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                const size_t priorityCount = static_cast<size_t>(TaskPriority::Count);
+
+                //! \todo Should this be configurable?
+                const size_t bandByteCountMin = 256 * Core::Memory::kilobyte;
+
+                //! The pool that owns the current thread.
+                thread_local ThreadPool* currentPool = nullptr;
+
+                struct Bands
+                {
+                    std::function<void(size_t, size_t)> function;
+                    size_t count = 0;
+                    size_t rows = 0;
+                    size_t bandCount = 0;
+                    std::atomic<size_t> next;
+                    std::atomic<size_t> finished;
+                    std::mutex mutex;
+                    std::condition_variable cv;
+                    std::exception_ptr error;
+
+                    void run()
+                    {
+                        size_t band = 0;
+                        while ((band = next++) < bandCount)
+                        {
+                            try
+                            {
+                                const size_t row = band * rows;
+                                function(row, std::min(row + rows, count));
+                            }
+                            catch (...)
+                            {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                if (!error)
+                                {
+                                    error = std::current_exception();
+                                }
+                            }
+                            if (++finished == bandCount)
+                            {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                cv.notify_all();
+                            }
+                        }
+                    }
+                };
+
+            } // namespace
+
+            struct TaskQueue::Private
+            {
+                std::shared_ptr<ThreadPool> pool;
+                std::deque<std::function<void(void)> > tasks[priorityCount];
+            };
+
+            struct ThreadPool::Private
+            {
+                size_t threadCount = 0;
+                std::mutex threadsMutex;
+                std::vector<std::thread> threads;
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::list<TaskQueue*> queues;
+                bool running = true;
+
+                bool getTask(std::function<void(void)>&);
+            };
+
+            TaskQueue::TaskQueue() :
+                _p(new Private)
+            {}
+
+            TaskQueue::~TaskQueue()
+            {
+                // The queue is removed from the pool here rather than being
+                // tracked with a weak pointer, so that the worker threads never
+                // hold a reference to it and it is always destroyed by its owner.
+                DJV_PRIVATE_PTR();
+                std::deque<std::function<void(void)> > tasks[priorityCount];
+                {
+                    std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                    p.pool->_p->queues.remove(this);
+                    for (size_t i = 0; i < priorityCount; ++i)
+                    {
+                        std::swap(tasks[i], p.tasks[i]);
+                    }
+                }
+            }
+
+            size_t TaskQueue::getPendingCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                size_t out = 0;
+                for (size_t i = 0; i < priorityCount; ++i)
+                {
+                    out += p.tasks[i].size();
+                }
+                return out;
+            }
+
+            void TaskQueue::cancel(TaskPriority priority)
+            {
+                DJV_PRIVATE_PTR();
+                std::deque<std::function<void(void)> > tasks;
+                {
+                    std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                    std::swap(tasks, p.tasks[static_cast<size_t>(priority)]);
+                }
+                // The cancelled tasks are destroyed outside of the lock, which
+                // sets their futures to a broken promise.
+            }
+
+            void TaskQueue::cancel()
+            {
+                for (size_t i = 0; i < priorityCount; ++i)
+                {
+                    cancel(static_cast<TaskPriority>(i));
+                }
+            }
+
+            void TaskQueue::_add(TaskPriority priority, const std::function<void(void)>& value)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                    p.tasks[static_cast<size_t>(priority)].push_back(value);
+                }
+                p.pool->_notify();
+            }
+
+            bool ThreadPool::Private::getTask(std::function<void(void)>& out)
+            {
+                for (size_t i = 0; i < priorityCount; ++i)
+                {
+                    for (auto j = queues.begin(); j != queues.end(); ++j)
+                    {
+                        auto& tasks = (*j)->_p->tasks[i];
+                        if (tasks.size())
+                        {
+                            out = std::move(tasks.front());
+                            tasks.pop_front();
+
+                            // Move the queue to the back of the list so the
+                            // next task is taken from a different reader.
+                            queues.splice(queues.end(), queues, j);
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            void ThreadPool::_init(size_t threadCount)
+            {
+                setThreadCount(threadCount);
+            }
+
+            ThreadPool::ThreadPool() :
+                _p(new Private)
+            {}
+
+            ThreadPool::~ThreadPool()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.cv.notify_all();
+                std::lock_guard<std::mutex> threadsLock(p.threadsMutex);
+                for (auto& i : p.threads)
+                {
+                    if (i.joinable())
+                    {
+                        i.join();
+                    }
+                }
+            }
+
+            std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+            {
+                auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+                out->_init(threadCount);
+                return out;
+            }
+
+            size_t ThreadPool::getThreadCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.threadCount;
+            }
+
+            void ThreadPool::setThreadCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                value = std::max(value, static_cast<size_t>(1));
+                std::lock_guard<std::mutex> threadsLock(p.threadsMutex);
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (value == p.threadCount)
+                        return;
+                    p.threadCount = value;
+                }
+
+                // Threads with an index greater than the thread count exit after
+                // finishing their current task.
+                p.cv.notify_all();
+                while (p.threads.size() > value)
+                {
+                    if (p.threads.back().joinable())
+                    {
+                        p.threads.back().join();
+                    }
+                    p.threads.pop_back();
+                }
+                for (size_t i = p.threads.size(); i < value; ++i)
+                {
+                    p.threads.push_back(std::thread(&ThreadPool::_run, this, i));
+                }
+            }
+
+            std::shared_ptr<TaskQueue> ThreadPool::createQueue()
+            {
+                DJV_PRIVATE_PTR();
+                auto out = std::shared_ptr<TaskQueue>(new TaskQueue);
+                out->_p->pool = shared_from_this();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.queues.push_back(out.get());
+                return out;
+            }
+
+            void ThreadPool::parallel(size_t count, size_t byteCount, const std::function<void(size_t, size_t)>& function)
+            {
+                size_t bandCount = 1;
+                if (auto pool = currentPool)
+                {
+                    bandCount = std::min(
+                        std::min(pool->getThreadCount(), count),
+                        std::max(byteCount / bandByteCountMin, static_cast<size_t>(1)));
+                }
+                if (bandCount <= 1)
+                {
+                    function(0, count);
+                    return;
+                }
+
+                // The bands are shared with the pool through a separate queue,
+                // which cancels the tasks that have not started when it is
+                // destroyed. Tasks that start after all of the bands have been
+                // taken return immediately.
+                auto bands = std::make_shared<Bands>();
+                bands->function = function;
+                bands->count = count;
+                bands->rows = (count + bandCount - 1) / bandCount;
+                bands->bandCount = (count + bands->rows - 1) / bands->rows;
+                bands->next = 0;
+                bands->finished = 0;
+                auto queue = currentPool->createQueue();
+                for (size_t i = 1; i < bands->bandCount; ++i)
+                {
+                    queue->_add(
+                        TaskPriority::Queue,
+                        [bands]
+                        {
+                            bands->run();
+                        });
+                }
+                bands->run();
+                {
+                    std::unique_lock<std::mutex> lock(bands->mutex);
+                    bands->cv.wait(
+                        lock,
+                        [bands]
+                        {
+                            return bands->finished == bands->bandCount;
+                        });
+                }
+                if (bands->error)
+                {
+                    std::rethrow_exception(bands->error);
+                }
+            }
+
+            void ThreadPool::_notify()
+            {
+                _p->cv.notify_one();
+            }
+
+            void ThreadPool::_run(size_t index)
+            {
+                DJV_PRIVATE_PTR();
+                currentPool = this;
+                while (true)
+                {
+                    std::function<void(void)> task;
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        while (p.running && index < p.threadCount && !p.getTask(task))
+                        {
+                            p.cv.wait(lock);
+                        }
+                    }
+                    if (!task)
+                    {
+                        break;
+                    }
+                    task();
+                }
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            class ThreadPool;
+
+            //! This enumeration provides the task priorities.
+            enum class TaskPriority
+            {
+                Queue, //!< Frames needed for playback
+                Cache, //!< Frames read ahead into the cache
+
+                Count,
+                First = Queue
+            };
+
+            //! This class provides a queue of tasks that are run by a thread pool.
+            //!
+            //! Each reader owns a task queue so that its pending requests can be
+            //! cancelled without affecting other readers sharing the pool.
+            class TaskQueue : public std::enable_shared_from_this<TaskQueue>
+            {
+                DJV_NON_COPYABLE(TaskQueue);
+
+            protected:
+                TaskQueue();
+
+            public:
+                ~TaskQueue();
+
+                //! Add a task to the queue.
+                template<typename T>
+                std::future<T> add(TaskPriority, const std::function<T(void)>&);
+
+                //! Get the number of pending tasks.
+                size_t getPendingCount() const;
+
+                //! Cancel the pending tasks with the given priority. Tasks that
+                //! have already started are not affected. The futures for the
+                //! cancelled tasks are set to a broken promise.
+                void cancel(TaskPriority);
+
+                //! Cancel all of the pending tasks.
+                void cancel();
+
+            private:
+                void _add(TaskPriority, const std::function<void(void)>&);
+
+                DJV_PRIVATE();
+
+                friend class ThreadPool;
+            };
+
+            //! This class provides a bounded pool of worker threads shared by the readers.
+            //!
+            //! Tasks with a higher priority are always run first. Tasks with the same
+            //! priority are taken from the task queues in round-robin order so that one
+            //! reader cannot starve the others.
+            class ThreadPool : public std::enable_shared_from_this<ThreadPool>
+            {
+                DJV_NON_COPYABLE(ThreadPool);
+
+            protected:
+                void _init(size_t threadCount);
+                ThreadPool();
+
+            public:
+                ~ThreadPool();
+
+                static std::shared_ptr<ThreadPool> create(size_t threadCount);
+
+                size_t getThreadCount() const;
+                void setThreadCount(size_t);
+
+                //! Create a new task queue.
+                std::shared_ptr<TaskQueue> createQueue();
+
+                //! Split the given number of rows into bands and run them in
+                //! parallel. When this is called from a task, the bands are shared
+                //! with the idle threads of the same pool and the calling thread
+                //! also runs bands, so it never waits on a task that has not
+                //! started. Otherwise the rows are processed on the calling thread.
+                //! No threads are created.
+                static void parallel(size_t count, size_t byteCount, const std::function<void(size_t, size_t)>&);
+
+            private:
+                void _notify();
+                void _run(size_t index);
+
+                DJV_PRIVATE();
+
+                friend class TaskQueue;
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/IOThreadPoolInline.h>
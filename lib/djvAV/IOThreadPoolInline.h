@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            template<typename T>
+            inline std::future<T> TaskQueue::add(TaskPriority priority, const std::function<T(void)>& value)
+            {
+                auto task = std::make_shared<std::packaged_task<T(void)> >(value);
+                auto out = task->get_future();
+                _add(
+                    priority,
+                    [task]
+                    {
+                        (*task)();
+                    });
+                return out;
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
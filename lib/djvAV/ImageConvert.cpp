@@ -4,6 +4,7 @@
 
 #include <djvAV/ImageConvert.h>
 
+#include <djvAV/IOThreadPool.h>
 #include <djvAV/OpenGLMesh.h>
 #include <djvAV/OpenGLOffscreenBuffer.h>
 #include <djvAV/OpenGLShader.h>
@@ -13,10 +14,24 @@
 #include <djvAV/TriangleMesh.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/Memory.h>
 #include <djvCore/ResourceSystem.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_IMAGE_CONVERT_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif // __AVX2__
+
+#include <cstring>
+
 using namespace djv::Core;
 
 namespace djv
@@ -25,8 +40,222 @@ namespace djv
     {
         namespace Image
         {
+            namespace
+            {
+                // The following functions convert the components of a scanline
+                // where the input and output types have the same channels. The
+                // vectorized loops give the same results as the scalar pixel
+                // conversions for values inside of the data type range.
+
+                void convertU8F32(const void* in, void* out, size_t size)
+                {
+                    const U8_T* inP = reinterpret_cast<const U8_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    size_t i = 0;
+#if defined(__AVX2__)
+                    const __m256 scale256 = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(inP + i));
+                        _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), scale256));
+                    }
+#endif // __AVX2__
+#if defined(DJV_IMAGE_CONVERT_SSE2)
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(U8Range.getMax()));
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                        _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+                        _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+                        _mm_storeu_ps(outP + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+                        _mm_storeu_ps(outP + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+                    }
+#endif // DJV_IMAGE_CONVERT_SSE2
+                    for (; i < size; ++i)
+                    {
+                        convert_U8_F32(inP[i], outP[i]);
+                    }
+                }
+
+                void convertF32U8(const void* in, void* out, size_t size)
+                {
+                    const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                    U8_T* outP = reinterpret_cast<U8_T*>(out);
+                    size_t i = 0;
+#if defined(__AVX2__)
+                    const __m256 scale256 = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                    const __m256 zero256 = _mm256_setzero_ps();
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        const __m256i a = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(
+                            _mm256_mul_ps(_mm256_loadu_ps(inP + i), scale256), zero256), scale256));
+                        const __m256i b = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(
+                            _mm256_mul_ps(_mm256_loadu_ps(inP + i + 8), scale256), zero256), scale256));
+                        const __m256i ab = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_packus_epi16(_mm256_castsi256_si128(ab), _mm256_extracti128_si256(ab, 1)));
+                    }
+#endif // __AVX2__
+#if defined(DJV_IMAGE_CONVERT_SSE2)
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(U8Range.getMax()));
+                    const __m128 zero = _mm_setzero_ps();
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        __m128i v[4];
+                        for (size_t j = 0; j < 4; ++j)
+                        {
+                            v[j] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(
+                                _mm_mul_ps(_mm_loadu_ps(inP + i + j * 4), scale), zero), scale));
+                        }
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+                    }
+#endif // DJV_IMAGE_CONVERT_SSE2
+                    for (; i < size; ++i)
+                    {
+                        convert_F32_U8(inP[i], outP[i]);
+                    }
+                }
+
+                void convertU8U16(const void* in, void* out, size_t size)
+                {
+                    const U8_T* inP = reinterpret_cast<const U8_T*>(in);
+                    U16_T* outP = reinterpret_cast<U16_T*>(out);
+                    size_t i = 0;
+#if defined(DJV_IMAGE_CONVERT_SSE2)
+                    const __m128i zero = _mm_setzero_si128();
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_unpacklo_epi8(zero, v));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i + 8), _mm_unpackhi_epi8(zero, v));
+                    }
+#endif // DJV_IMAGE_CONVERT_SSE2
+                    for (; i < size; ++i)
+                    {
+                        convert_U8_U16(inP[i], outP[i]);
+                    }
+                }
+
+                void convertU16U8(const void* in, void* out, size_t size)
+                {
+                    const U16_T* inP = reinterpret_cast<const U16_T*>(in);
+                    U8_T* outP = reinterpret_cast<U8_T*>(out);
+                    size_t i = 0;
+#if defined(DJV_IMAGE_CONVERT_SSE2)
+                    for (; i + 16 <= size; i += 16)
+                    {
+                        const __m128i a = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i)), 8);
+                        const __m128i b = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i + 8)), 8);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_packus_epi16(a, b));
+                    }
+#endif // DJV_IMAGE_CONVERT_SSE2
+                    for (; i < size; ++i)
+                    {
+                        convert_U16_U8(inP[i], outP[i]);
+                    }
+                }
+
+                void convertU16F32(const void* in, void* out, size_t size)
+                {
+                    const U16_T* inP = reinterpret_cast<const U16_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    size_t i = 0;
+#if defined(DJV_IMAGE_CONVERT_SSE2)
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(U16Range.getMax()));
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                        _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), scale));
+                        _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), scale));
+                    }
+#endif // DJV_IMAGE_CONVERT_SSE2
+                    for (; i < size; ++i)
+                    {
+                        convert_U16_F32(inP[i], outP[i]);
+                    }
+                }
+
+                void convertF32U16(const void* in, void* out, size_t size)
+                {
+                    const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                    U16_T* outP = reinterpret_cast<U16_T*>(out);
+                    size_t i = 0;
+#if defined(DJV_IMAGE_CONVERT_SSE2)
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(U16Range.getMax()));
+                    const __m128 zero = _mm_setzero_ps();
+                    const __m128i bias32 = _mm_set1_epi32(0x8000);
+                    const __m128i bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        // There is no unsigned 32-bit to 16-bit pack in SSE2, so
+                        // the values are biased into the signed range and back.
+                        const __m128i a = _mm_sub_epi32(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(
+                            _mm_mul_ps(_mm_loadu_ps(inP + i), scale), zero), scale)), bias32);
+                        const __m128i b = _mm_sub_epi32(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(
+                            _mm_mul_ps(_mm_loadu_ps(inP + i + 4), scale), zero), scale)), bias32);
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP + i),
+                            _mm_xor_si128(_mm_packs_epi32(a, b), bias16));
+                    }
+#endif // DJV_IMAGE_CONVERT_SSE2
+                    for (; i < size; ++i)
+                    {
+                        convert_F32_U16(inP[i], outP[i]);
+                    }
+                }
+
+                ConvertFunction getComponentFunction(DataType in, DataType out)
+                {
+                    ConvertFunction result;
+                    switch (in)
+                    {
+                    case DataType::U8:
+                        switch (out)
+                        {
+                        case DataType::U16: result = convertU8U16; break;
+                        case DataType::F32: result = convertU8F32; break;
+                        default: break;
+                        }
+                        break;
+                    case DataType::U16:
+                        switch (out)
+                        {
+                        case DataType::U8:  result = convertU16U8;  break;
+                        case DataType::F32: result = convertU16F32; break;
+                        default: break;
+                        }
+                        break;
+                    case DataType::F32:
+                        switch (out)
+                        {
+                        case DataType::U8:  result = convertF32U8;  break;
+                        case DataType::U16: result = convertF32U16; break;
+                        default: break;
+                        }
+                        break;
+                    default: break;
+                    }
+                    return result;
+                }
+
+                size_t getWordSize(Type value)
+                {
+                    // The 10-bit data is packed into 32-bit words.
+                    return Type::RGB_U10 == value ? 4 : getByteCount(getDataType(value));
+                }
+
+            } // namespace
+
             struct Convert::Private
             {
+                bool openGL = false;
                 Size size;
                 Mirror mirror;
                 std::shared_ptr<OpenGL::OffscreenBuffer> offscreenBuffer;
@@ -40,10 +269,14 @@ namespace djv
             void Convert::_init(const std::shared_ptr<ResourceSystem>& resourceSystem)
             {
                 DJV_PRIVATE_PTR();
-                const FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
-                p.shader = AV::OpenGL::Shader::create(Render::Shader::create(
-                    FileSystem::Path(shaderPath, "djvAVImageConvertVertex.glsl"),
-                    FileSystem::Path(shaderPath, "djvAVImageConvertFragment.glsl")));
+                p.openGL = glfwGetCurrentContext() != nullptr;
+                if (p.openGL)
+                {
+                    const FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
+                    p.shader = AV::OpenGL::Shader::create(Render::Shader::create(
+                        FileSystem::Path(shaderPath, "djvAVImageConvertVertex.glsl"),
+                        FileSystem::Path(shaderPath, "djvAVImageConvertFragment.glsl")));
+                }
             }
 
             Convert::Convert() :
@@ -60,9 +293,31 @@ namespace djv
                 return out;
             }
 
+            bool Convert::isOpenGL() const
+            {
+                return _p->openGL;
+            }
+
             void Convert::process(const Data& data, const Info& info, Data& out)
             {
                 DJV_PRIVATE_PTR();
+                if (!p.openGL)
+                {
+                    // Like the OpenGL path, the output data is written with the
+                    // given information.
+                    if (info == out.getInfo())
+                    {
+                        convert(data, out);
+                    }
+                    else
+                    {
+                        auto tmp = Data::create(info);
+                        convert(data, *tmp);
+                        memcpy(out.getData(), tmp->getData(), std::min(tmp->getDataByteCount(), out.getDataByteCount()));
+                    }
+                    return;
+                }
+
                 bool create = !p.offscreenBuffer;
                 create |= p.offscreenBuffer && info.size != p.offscreenBuffer->getSize();
                 create |= p.offscreenBuffer && info.type != p.offscreenBuffer->getColorType();
@@ -150,6 +405,133 @@ namespace djv
                     out.getData());
             }
 
+            ConvertFunction getCPUConvertFunction(Type inType, Type outType)
+            {
+                ConvertFunction result;
+                if (inType == outType)
+                {
+                    const size_t byteCount = getByteCount(outType);
+                    result = [byteCount](const void* in, void* out, size_t size)
+                    {
+                        memcpy(out, in, size * byteCount);
+                    };
+                }
+                else if (getChannels(inType) == getChannels(outType) &&
+                    inType != Type::RGB_U10 &&
+                    outType != Type::RGB_U10)
+                {
+                    if (auto function = getComponentFunction(getDataType(inType), getDataType(outType)))
+                    {
+                        const size_t channelCount = static_cast<size_t>(getChannelCount(inType));
+                        result = [function, channelCount](const void* in, void* out, size_t size)
+                        {
+                            function(in, out, size * channelCount);
+                        };
+                    }
+                }
+                if (!result)
+                {
+                    result = getConvertFunction(inType, outType);
+                }
+                return result;
+            }
+
+            void convert(const Data& in, Data& out)
+            {
+                const Info& inInfo = in.getInfo();
+                const Info& outInfo = out.getInfo();
+                if (!inInfo.isValid() || !outInfo.isValid())
+                    return;
+
+                const uint16_t w = outInfo.size.w;
+                const uint16_t h = outInfo.size.h;
+                const bool mirrorX = inInfo.layout.mirror.x != outInfo.layout.mirror.x;
+                const bool mirrorY = inInfo.layout.mirror.y != outInfo.layout.mirror.y;
+
+                // Map the output columns and rows to the input.
+                std::vector<uint16_t> xMap;
+                if (mirrorX || inInfo.size.w != w)
+                {
+                    xMap.resize(w);
+                    for (uint16_t x = 0; x < w; ++x)
+                    {
+                        const uint16_t x2 = static_cast<uint16_t>((x * 2 + 1) * static_cast<size_t>(inInfo.size.w) / (w * 2));
+                        xMap[x] = mirrorX ? (inInfo.size.w - 1 - x2) : x2;
+                    }
+                }
+                std::vector<uint16_t> yMap(h);
+                for (uint16_t y = 0; y < h; ++y)
+                {
+                    const uint16_t y2 = static_cast<uint16_t>((y * 2 + 1) * static_cast<size_t>(inInfo.size.h) / (h * 2));
+                    yMap[y] = mirrorY ? (inInfo.size.h - 1 - y2) : y2;
+                }
+
+                const size_t inPixelByteCount = getByteCount(inInfo.type);
+                const size_t outPixelByteCount = getByteCount(outInfo.type);
+                const size_t inWordSize = getWordSize(inInfo.type);
+                const size_t outWordSize = getWordSize(outInfo.type);
+                const bool inEndian = inInfo.layout.endian != Memory::getEndian() && inWordSize > 1;
+                const bool outEndian = outInfo.layout.endian != Memory::getEndian() && outWordSize > 1;
+
+                const auto function = getCPUConvertFunction(inInfo.type, outInfo.type);
+                if (!function)
+                    return;
+
+                const uint8_t* inData = in.getData();
+                const size_t inScanlineByteCount = in.getScanlineByteCount();
+                uint8_t* outData = out.getData();
+                const size_t outScanlineByteCount = out.getScanlineByteCount();
+                auto convertScanlines = [&](uint16_t y0, uint16_t y1)
+                {
+                    std::vector<uint8_t> tmp;
+                    if (xMap.size() || inEndian)
+                    {
+                        tmp.resize(w * inPixelByteCount);
+                    }
+                    for (uint16_t y = y0; y < y1; ++y)
+                    {
+                        const uint8_t* inP = inData + yMap[y] * inScanlineByteCount;
+                        if (xMap.size())
+                        {
+                            for (uint16_t x = 0; x < w; ++x)
+                            {
+                                memcpy(tmp.data() + x * inPixelByteCount, inP + xMap[x] * inPixelByteCount, inPixelByteCount);
+                            }
+                            inP = tmp.data();
+                        }
+                        if (inEndian)
+                        {
+                            const size_t wordCount = w * inPixelByteCount / inWordSize;
+                            if (inP == tmp.data())
+                            {
+                                Memory::endian(tmp.data(), wordCount, inWordSize);
+                            }
+                            else
+                            {
+                                Memory::endian(inP, tmp.data(), wordCount, inWordSize);
+                            }
+                            inP = tmp.data();
+                        }
+                        uint8_t* outP = outData + y * outScanlineByteCount;
+                        function(inP, outP, w);
+                        if (outEndian)
+                        {
+                            Memory::endian(outP, w * outPixelByteCount / outWordSize, outWordSize);
+                        }
+                    }
+                };
+
+                // Split the scanlines across the idle threads of the I/O pool
+                // when this is called from one of its tasks.
+                IO::ThreadPool::parallel(
+                    h,
+                    outInfo.getDataByteCount(),
+                    [&convertScanlines](size_t y0, size_t y1)
+                    {
+                        convertScanlines(static_cast<uint16_t>(y0), static_cast<uint16_t>(y1));
+                    });
+            }
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
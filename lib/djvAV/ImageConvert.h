@@ -19,6 +19,10 @@ namespace djv
         namespace Image
         {
             //! This class provides image data conversion.
+            //!
+            //! If there is a current OpenGL context when the converter is
+            //! created the conversion is done with OpenGL, otherwise it is done
+            //! on the CPU.
             class Convert
             {
                 DJV_NON_COPYABLE(Convert);
@@ -30,13 +34,14 @@ namespace djv
             public:
                 ~Convert();
 
-                //! Note that this function requires an OpenGL context.
                 //! Throws:
                 //! - OpenGL::ShaderError
                 //! - Render::ShaderError
                 static std::shared_ptr<Convert> create(const std::shared_ptr<Core::ResourceSystem>&);
 
-                //! Note that this function requires an OpenGL context.
+                //! Get whether the conversion is done with OpenGL.
+                bool isOpenGL() const;
+
                 //! Throws:
                 //! - OpenGL::OffscreenBufferError
                 void process(const Data&, const Info&, Data&);
@@ -45,6 +50,16 @@ namespace djv
                 DJV_PRIVATE();
             };
 
+            //! Get a function for converting scanlines on the CPU. This uses
+            //! vectorized code where available, otherwise it is the same as
+            //! getConvertFunction().
+            ConvertFunction getCPUConvertFunction(Type, Type);
+
+            //! Convert image data on the CPU. This handles all of the image
+            //! types, mirroring, endian, and scanline alignment. If the sizes
+            //! are different the output is nearest neighbor sampled.
+            void convert(const Data&, Data&);
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
@@ -19,24 +19,19 @@ namespace djv
                 _pixelByteCount = info.getPixelByteCount();
                 _scanlineByteCount = info.getScanlineByteCount();
                 _dataByteCount = info.getDataByteCount();
-#if defined(DJV_MMAP)
-                _fileIO = fileIO;
-                if (_fileIO)
+                if (fileIO &&
+                    fileIO->isMemoryMapped() &&
+                    _dataByteCount <= static_cast<size_t>(fileIO->mmapEnd() - fileIO->mmapP()))
                 {
+                    _fileIO = fileIO;
                     _p = _fileIO->mmapP();
+                    _fileIO->seek(_dataByteCount);
                 }
                 else if (_dataByteCount)
                 {
                     _data = new uint8_t[_dataByteCount];
                     _p = _data;
                 }
-#else // DJV_MMAP
-                if (_dataByteCount)
-                {
-                    _data = new uint8_t[_dataByteCount];
-                    _p = _data;
-                }
-#endif // DJV_MMAP
             }
 
             Data::~Data()
@@ -44,51 +39,44 @@ namespace djv
                 delete[] _data;
             }
 
-#if defined(DJV_MMAP)
             std::shared_ptr<Data> Data::create(const Info& info, const std::shared_ptr<Core::FileSystem::FileIO>& fileIO)
             {
                 auto out = std::shared_ptr<Data>(new Data);
                 out->_init(info, fileIO);
                 return out;
             }
-#else // DJV_MMAP
-            std::shared_ptr<Data> Data::create(const Info& info)
-            {
-                auto out = std::shared_ptr<Data>(new Data);
-                out->_init(info, nullptr);
-                return out;
-            }
-#endif // DJV_MMAP
 
             size_t Data::getDataByteCount() const
             {
-#if defined(DJV_MMAP)
-                return _fileIO ? (_fileIO->getSize() - _fileIO->getPos()) : _dataByteCount;
-#else
                 return _dataByteCount;
-#endif // DJV_MMAP
             }
 
             void Data::zero()
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    _data = new uint8_t[_dataByteCount];
+                    _p = _data;
+                    _fileIO.reset();
+                }
                 memset(_data, 0, _dataByteCount);
             }
 
-#if defined(DJV_MMAP)
+            bool Data::isMemoryMapped() const
+            {
+                return _fileIO != nullptr;
+            }
+
             void Data::detach()
             {
                 if (_fileIO)
                 {
                     _data = new uint8_t[_dataByteCount];
-                    memcpy(_data, _fileIO->mmapP(), std::min(_fileIO->getSize() - _fileIO->getPos(), _dataByteCount));
+                    memcpy(_data, _p, _dataByteCount);
                     _p = _data;
                     _fileIO.reset();
                 }
             }
-#endif // DJV_MMAP
 
             bool Data::operator == (const Data& other) const
             {
@@ -114,11 +114,10 @@ namespace djv
             public:
                 ~Data();
 
-#if defined(DJV_MMAP)
+                //! Create new image data. If the file I/O is memory mapped and
+                //! contains enough data from the current position, the image data
+                //! references the memory map instead of allocating a copy.
                 static std::shared_ptr<Data> create(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>& = nullptr);
-#else // DJV_MMAP
-                static std::shared_ptr<Data> create(const Info&);
-#endif // DJV_MMAP
 
                 Core::UID getUID() const;
 
@@ -147,9 +146,14 @@ namespace djv
 
                 void zero();
 
-#if defined(DJV_MMAP)
+                //! Get whether the image data references a memory map.
+                bool isMemoryMapped() const;
+
+                //! Copy memory mapped image data so that it no longer references
+                //! the memory map. This must be called before the image data is
+                //! modified or shared with other threads, the non-const data
+                //! pointers are not valid for memory mapped image data.
                 void detach();
-#endif // DJV_MMAP
 
                 bool operator == (const Data&) const;
                 bool operator != (const Data&) const;
@@ -162,9 +166,7 @@ namespace djv
                 size_t _dataByteCount = 0;
                 uint8_t* _data = nullptr;
                 const uint8_t* _p = nullptr;
-#if defined(DJV_MMAP)
                 std::shared_ptr<Core::FileSystem::FileIO> _fileIO;
-#endif // DJV_MMAP
             };
 
         } // namespace Image
@@ -225,25 +225,19 @@ namespace djv
 
             inline uint8_t* Data::getData()
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                DJV_ASSERT(!_fileIO);
                 return _data;
             }
 
             inline uint8_t* Data::getData(uint16_t y)
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                DJV_ASSERT(!_fileIO);
                 return _data + y * _scanlineByteCount;
             }
 
             inline uint8_t* Data::getData(uint16_t x, uint16_t y)
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                DJV_ASSERT(!_fileIO);
                 return _data + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
 
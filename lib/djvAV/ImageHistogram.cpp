@@ -0,0 +1,357 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ImageHistogram.h>
+
+#include <djvAV/ImageConvert.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_IMAGE_HISTOGRAM_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t taskByteCountMin = 256 * Memory::kilobyte;
+
+                //! Approximate log2() with a polynomial for the mantissa, which is
+                //! much faster than log2f() and accurate enough for binning.
+                const float log2Coefficients[] =
+                {
+                    2.8882704548164776201F,
+                    -2.52074962577807006663F,
+                    1.48116647521213171641F,
+                    -0.465725644288844778798F,
+                    0.0596515482674574969533F
+                };
+
+                float log2Approx(float value)
+                {
+                    int32_t bits = 0;
+                    memcpy(&bits, &value, sizeof(float));
+                    const float e = static_cast<float>(((bits >> 23) & 0xff) - 127);
+                    bits = (bits & 0x007fffff) | 0x3f800000;
+                    float m = 0.F;
+                    memcpy(&m, &bits, sizeof(float));
+                    const float* c = log2Coefficients;
+                    const float p = c[0] + m * (c[1] + m * (c[2] + m * (c[3] + m * c[4])));
+                    return e + p * (m - 1.F);
+                }
+
+#if defined(DJV_IMAGE_HISTOGRAM_SSE2)
+                __m128 log2Approx(__m128 value)
+                {
+                    const __m128i bits = _mm_castps_si128(value);
+                    const __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(
+                        _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff)),
+                        _mm_set1_epi32(127)));
+                    const __m128 m = _mm_castsi128_ps(_mm_or_si128(
+                        _mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                        _mm_set1_epi32(0x3f800000)));
+                    const float* c = log2Coefficients;
+                    __m128 p = _mm_set1_ps(c[4]);
+                    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(c[3]));
+                    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(c[2]));
+                    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(c[1]));
+                    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(c[0]));
+                    return _mm_add_ps(e, _mm_mul_ps(p, _mm_sub_ps(m, _mm_set1_ps(1.F))));
+                }
+#endif // DJV_IMAGE_HISTOGRAM_SSE2
+
+                //! This class maps values to bins.
+                class BinMap
+                {
+                public:
+                    BinMap(const HistogramOptions& options, size_t binCount) :
+                        _min(options.range.getMin()),
+                        _binMax(static_cast<float>(binCount - 1)),
+                        _scale(options.scale)
+                    {
+                        const float size = options.range.getMax() - _min;
+                        if (size > 0.F)
+                        {
+                            switch (_scale)
+                            {
+                            case HistogramScale::Linear: _mul = binCount / size; break;
+                            case HistogramScale::Log:    _mul = binCount / log2Approx(1.F + size); break;
+                            default: break;
+                            }
+                        }
+                    }
+
+                    //! Get the bin for a value. NaNs are counted in the first bin.
+                    uint32_t operator () (float value) const
+                    {
+                        float v = value - _min;
+                        if (HistogramScale::Log == _scale)
+                        {
+                            v = v > 0.F ? log2Approx(1.F + v) : 0.F;
+                        }
+                        v *= _mul;
+                        return static_cast<uint32_t>(v > 0.F ? std::min(v, _binMax) : 0.F);
+                    }
+
+                    //! Get the bins for a list of values.
+                    void operator () (const F32_T* in, uint32_t* out, size_t size) const
+                    {
+                        size_t i = 0;
+#if defined(DJV_IMAGE_HISTOGRAM_SSE2)
+                        // The maximum of a NaN and zero is zero, so NaNs are
+                        // counted in the first bin like the scalar version.
+                        const __m128 min = _mm_set1_ps(_min);
+                        const __m128 mul = _mm_set1_ps(_mul);
+                        const __m128 zero = _mm_setzero_ps();
+                        const __m128 one = _mm_set1_ps(1.F);
+                        const __m128 binMax = _mm_set1_ps(_binMax);
+                        const bool log = HistogramScale::Log == _scale;
+                        for (; i + 4 <= size; i += 4)
+                        {
+                            __m128 v = _mm_sub_ps(_mm_loadu_ps(in + i), min);
+                            if (log)
+                            {
+                                v = log2Approx(_mm_add_ps(_mm_max_ps(v, zero), one));
+                            }
+                            v = _mm_mul_ps(v, mul);
+                            _mm_storeu_si128(
+                                reinterpret_cast<__m128i*>(out + i),
+                                _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, zero), binMax)));
+                        }
+#endif // DJV_IMAGE_HISTOGRAM_SSE2
+                        for (; i < size; ++i)
+                        {
+                            out[i] = (*this)(in[i]);
+                        }
+                    }
+
+                private:
+                    float _min = 0.F;
+                    float _mul = 0.F;
+                    float _binMax = 0.F;
+                    HistogramScale _scale = HistogramScale::Linear;
+                };
+
+                //! Create a lookup table from integer values to bins.
+                std::vector<uint16_t> getIntLUT(size_t size, const BinMap& binMap)
+                {
+                    std::vector<uint16_t> out(size);
+                    const float max = static_cast<float>(size - 1);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        out[i] = static_cast<uint16_t>(binMap(i / max));
+                    }
+                    return out;
+                }
+
+                //! Create a lookup table from every half float bit pattern to bins.
+                std::vector<uint16_t> getF16LUT(const BinMap& binMap)
+                {
+                    std::vector<uint16_t> out(65536);
+                    F16_T value;
+                    for (size_t i = 0; i < out.size(); ++i)
+                    {
+                        value.setBits(static_cast<unsigned short>(i));
+                        out[i] = static_cast<uint16_t>(binMap(static_cast<float>(value)));
+                    }
+                    return out;
+                }
+
+                template<typename T>
+                void countLUT(const T* in, size_t width, uint8_t channelCount, const uint16_t* lut, Histogram& out)
+                {
+                    const size_t size = width * channelCount;
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        size_t* bins = out.getBins(c);
+                        for (size_t i = c; i < size; i += channelCount)
+                        {
+                            ++bins[lut[in[i]]];
+                        }
+                    }
+                }
+
+                void countU10(const U10_S* in, size_t width, const uint16_t* lut, Histogram& out)
+                {
+                    size_t* r = out.getBins(0);
+                    size_t* g = out.getBins(1);
+                    size_t* b = out.getBins(2);
+                    for (size_t i = 0; i < width; ++i, ++in)
+                    {
+                        ++r[lut[in->r]];
+                        ++g[lut[in->g]];
+                        ++b[lut[in->b]];
+                    }
+                }
+
+                void countIndices(const uint32_t* in, size_t width, uint8_t channelCount, Histogram& out)
+                {
+                    const size_t size = width * channelCount;
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        size_t* bins = out.getBins(c);
+                        for (size_t i = c; i < size; i += channelCount)
+                        {
+                            ++bins[in[i]];
+                        }
+                    }
+                }
+
+            } // namespace
+
+            Histogram::Histogram()
+            {}
+
+            Histogram::Histogram(uint8_t channelCount, size_t binCount) :
+                _channelCount(channelCount),
+                _binCount(binCount),
+                _bins(channelCount * binCount, 0)
+            {}
+
+            size_t Histogram::getMax() const
+            {
+                size_t out = 0;
+                for (const auto i : _bins)
+                {
+                    out = std::max(out, i);
+                }
+                return out;
+            }
+
+            void Histogram::add(const Histogram& value)
+            {
+                if (value._bins.size() == _bins.size())
+                {
+                    for (size_t i = 0; i < _bins.size(); ++i)
+                    {
+                        _bins[i] += value._bins[i];
+                    }
+                }
+            }
+
+            Histogram histogram(const Data& in, const HistogramOptions& options)
+            {
+                const Info& info = in.getInfo();
+                const uint8_t channelCount = getChannelCount(info.type);
+                const size_t binCount = Math::clamp(options.binCount, static_cast<size_t>(1), histogramBinCountMax);
+                Histogram out(channelCount, binCount);
+                if (!info.isValid())
+                    return out;
+
+                // Byte swapped data is converted first. The order of the scanlines
+                // does not matter, so mirrored data is used as is.
+                const DataType dataType = getDataType(info.type);
+                const Data* src = &in;
+                std::shared_ptr<Data> srcTmp;
+                if (info.layout.endian != Memory::getEndian() && getByteCount(dataType) > 1)
+                {
+                    srcTmp = Data::create(Info(info.size, info.type));
+                    convert(in, *srcTmp);
+                    src = srcTmp.get();
+                }
+
+                const BinMap binMap(options, binCount);
+                std::vector<uint16_t> lut;
+                switch (dataType)
+                {
+                case DataType::U8:  lut = getIntLUT(static_cast<size_t>(U8Range.getMax()) + 1, binMap); break;
+                case DataType::U10: lut = getIntLUT(static_cast<size_t>(U10Range.getMax()) + 1, binMap); break;
+                case DataType::U16: lut = getIntLUT(static_cast<size_t>(U16Range.getMax()) + 1, binMap); break;
+                case DataType::F16: lut = getF16LUT(binMap); break;
+                default: break;
+                }
+
+                // Count the bands of scanlines in parallel with separate bins.
+                const size_t width = info.size.w;
+                const size_t height = info.size.h;
+                const uint8_t* data = src->getData();
+                const size_t scanlineByteCount = src->getScanlineByteCount();
+                const auto function = [&](size_t y0, size_t y1)
+                {
+                    Histogram out(channelCount, binCount);
+                    std::vector<uint32_t> indices;
+                    std::vector<F32_T> values;
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        const uint8_t* p = data + y * scanlineByteCount;
+                        switch (dataType)
+                        {
+                        case DataType::U8:
+                            countLUT(reinterpret_cast<const U8_T*>(p), width, channelCount, lut.data(), out);
+                            break;
+                        case DataType::U10:
+                            countU10(reinterpret_cast<const U10_S*>(p), width, lut.data(), out);
+                            break;
+                        case DataType::U16:
+                            countLUT(reinterpret_cast<const U16_T*>(p), width, channelCount, lut.data(), out);
+                            break;
+                        case DataType::F16:
+                            countLUT(reinterpret_cast<const uint16_t*>(p), width, channelCount, lut.data(), out);
+                            break;
+                        case DataType::U32:
+                        {
+                            const size_t size = width * channelCount;
+                            const U32_T* in = reinterpret_cast<const U32_T*>(p);
+                            values.resize(size);
+                            for (size_t i = 0; i < size; ++i)
+                            {
+                                values[i] = in[i] / static_cast<float>(U32Range.getMax());
+                            }
+                            indices.resize(size);
+                            binMap(values.data(), indices.data(), size);
+                            countIndices(indices.data(), width, channelCount, out);
+                            break;
+                        }
+                        case DataType::F32:
+                            indices.resize(width * channelCount);
+                            binMap(reinterpret_cast<const F32_T*>(p), indices.data(), indices.size());
+                            countIndices(indices.data(), width, channelCount, out);
+                            break;
+                        default: break;
+                        }
+                    }
+                    return out;
+                };
+                const size_t threadCount = std::min(
+                    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                    std::max(height * scanlineByteCount / taskByteCountMin, static_cast<size_t>(1)));
+                if (threadCount > 1)
+                {
+                    std::vector<std::future<Histogram> > futures;
+                    const size_t rows = (height + threadCount - 1) / threadCount;
+                    for (size_t y = 0; y < height; y += rows)
+                    {
+                        futures.push_back(std::async(std::launch::async, function, y, std::min(y + rows, height)));
+                    }
+                    for (auto& i : futures)
+                    {
+                        out.add(i.get());
+                    }
+                }
+                else
+                {
+                    out = function(0, height);
+                }
+                return out;
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
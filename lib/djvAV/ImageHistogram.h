@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This enumeration provides how values are mapped to histogram bins.
+            enum class HistogramScale
+            {
+                Linear,
+                Log,
+
+                Count,
+                First = Linear
+            };
+            DJV_ENUM_HELPERS(HistogramScale);
+
+            //! This constant provides the maximum number of histogram bins.
+            const size_t histogramBinCountMax = 65536;
+
+            //! This class provides histogram options.
+            class HistogramOptions
+            {
+            public:
+                HistogramOptions();
+
+                //! The number of bins, up to histogramBinCountMax.
+                size_t binCount = 256;
+
+                //! The range of values that are counted. Integer values are
+                //! normalized to 0-1 first, and values outside of the range are
+                //! counted in the first and last bins.
+                Core::FloatRange range = Core::FloatRange(0.F, 1.F);
+
+                //! With the logarithmic scale the bins are spaced by log2(1 + value),
+                //! which gives more bins to the darker values of high dynamic range
+                //! images.
+                HistogramScale scale = HistogramScale::Linear;
+
+                bool operator == (const HistogramOptions&) const;
+                bool operator != (const HistogramOptions&) const;
+            };
+
+            //! This class provides the histogram of an image, with a separate set
+            //! of bins for each channel.
+            class Histogram
+            {
+            public:
+                Histogram();
+                Histogram(uint8_t channelCount, size_t binCount);
+
+                uint8_t getChannelCount() const;
+                size_t getBinCount() const;
+
+                //! Get the bins for a channel.
+                const size_t* getBins(uint8_t channel) const;
+                size_t* getBins(uint8_t channel);
+
+                //! Get the largest bin of all of the channels.
+                size_t getMax() const;
+
+                //! Add the bins of another histogram with the same size.
+                void add(const Histogram&);
+
+                bool operator == (const Histogram&) const;
+                bool operator != (const Histogram&) const;
+
+            private:
+                uint8_t _channelCount = 0;
+                size_t _binCount = 0;
+                std::vector<size_t> _bins;
+            };
+
+            //! Compute the histogram of image data on the CPU.
+            //!
+            //! The scanlines are split into bands that are counted in parallel,
+            //! each with its own bins, and the bins are added together at the end.
+            //! Values of 8, 10, 16-bit, and half float images are mapped to bins
+            //! with a lookup table.
+            Histogram histogram(const Data&, const HistogramOptions& = HistogramOptions());
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/ImageHistogramInline.h>
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            inline HistogramOptions::HistogramOptions()
+            {}
+
+            inline bool HistogramOptions::operator == (const HistogramOptions& other) const
+            {
+                return
+                    binCount == other.binCount &&
+                    range == other.range &&
+                    scale == other.scale;
+            }
+
+            inline bool HistogramOptions::operator != (const HistogramOptions& other) const
+            {
+                return !(*this == other);
+            }
+
+            inline uint8_t Histogram::getChannelCount() const
+            {
+                return _channelCount;
+            }
+
+            inline size_t Histogram::getBinCount() const
+            {
+                return _binCount;
+            }
+
+            inline const size_t* Histogram::getBins(uint8_t channel) const
+            {
+                return _bins.data() + channel * _binCount;
+            }
+
+            inline size_t* Histogram::getBins(uint8_t channel)
+            {
+                return _bins.data() + channel * _binCount;
+            }
+
+            inline bool Histogram::operator == (const Histogram& other) const
+            {
+                return
+                    _channelCount == other._channelCount &&
+                    _binCount == other._binCount &&
+                    _bins == other._bins;
+            }
+
+            inline bool Histogram::operator != (const Histogram& other) const
+            {
+                return !(*this == other);
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ImageResample.h>
+
+#include <djvAV/IOThreadPool.h>
+#include <djvAV/ImageConvert.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_IMAGE_RESAMPLE_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include <algorithm>
+#include <cmath>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                float getSupport(ResampleFilter value)
+                {
+                    const float data[] =
+                    {
+                        .5F,
+                        1.F,
+                        3.F
+                    };
+                    DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(ResampleFilter::Count));
+                    return data[static_cast<size_t>(value)];
+                }
+
+                float sinc(float value)
+                {
+                    value *= Math::pi;
+                    return sinf(value) / value;
+                }
+
+                float getWeight(ResampleFilter filter, float value)
+                {
+                    float out = 0.F;
+                    switch (filter)
+                    {
+                    case ResampleFilter::Box:
+                        out = value >= -.5F && value < .5F ? 1.F : 0.F;
+                        break;
+                    case ResampleFilter::Bilinear:
+                        value = fabsf(value);
+                        out = value < 1.F ? (1.F - value) : 0.F;
+                        break;
+                    case ResampleFilter::Lanczos3:
+                        value = fabsf(value);
+                        if (value < .000001F)
+                        {
+                            out = 1.F;
+                        }
+                        else if (value < 3.F)
+                        {
+                            out = sinc(value) * sinc(value / 3.F);
+                        }
+                        break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                //! This struct provides the input pixels and weights that contribute
+                //! to each output pixel.
+                struct Contributions
+                {
+                    std::vector<size_t> start;
+                    std::vector<size_t> count;
+                    std::vector<float> weights;
+                    size_t maxCount = 0;
+                };
+
+                Contributions getContributions(size_t inSize, size_t outSize, ResampleFilter filter)
+                {
+                    Contributions out;
+                    const float scale = inSize / static_cast<float>(outSize);
+                    const float filterScale = std::max(scale, 1.F);
+                    const float support = getSupport(filter) * filterScale;
+                    out.maxCount = static_cast<size_t>(ceilf(support * 2.F)) + 2;
+                    out.start.resize(outSize);
+                    out.count.resize(outSize);
+                    out.weights.resize(outSize * out.maxCount);
+                    for (size_t i = 0; i < outSize; ++i)
+                    {
+                        const float center = (i + .5F) * scale;
+                        const int start = std::max(static_cast<int>(floorf(center - support)), 0);
+                        const int end = std::min(static_cast<int>(ceilf(center + support)), static_cast<int>(inSize));
+                        float* weights = out.weights.data() + i * out.maxCount;
+                        size_t count = 0;
+                        float total = 0.F;
+                        for (int j = start; j < end && count < out.maxCount; ++j, ++count)
+                        {
+                            const float weight = getWeight(filter, (j + .5F - center) / filterScale);
+                            weights[count] = weight;
+                            total += weight;
+                        }
+                        if (total != 0.F)
+                        {
+                            for (size_t j = 0; j < count; ++j)
+                            {
+                                weights[j] /= total;
+                            }
+                            out.start[i] = static_cast<size_t>(start);
+                            out.count[i] = count;
+                        }
+                        else
+                        {
+                            // Use the nearest pixel.
+                            weights[0] = 1.F;
+                            out.start[i] = Math::clamp(static_cast<size_t>(center), static_cast<size_t>(0), inSize - 1);
+                            out.count[i] = 1;
+                        }
+                    }
+                    return out;
+                }
+
+                void multiplyAdd(const float* in, float value, float* out, size_t size)
+                {
+                    size_t i = 0;
+#if defined(DJV_IMAGE_RESAMPLE_SSE2)
+                    const __m128 v = _mm_set1_ps(value);
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), v)));
+                    }
+#endif // DJV_IMAGE_RESAMPLE_SSE2
+                    for (; i < size; ++i)
+                    {
+                        out[i] += in[i] * value;
+                    }
+                }
+
+            } // namespace
+
+            void resample(const Data& in, Data& out, ResampleFilter filter)
+            {
+                const Info& inInfo = in.getInfo();
+                const Info& outInfo = out.getInfo();
+                if (!inInfo.isValid() || !outInfo.isValid())
+                    return;
+
+                // Mirrored and byte swapped data is converted before and after
+                // resampling.
+                const Data* src = &in;
+                std::shared_ptr<Data> srcTmp;
+                if (inInfo.layout.mirror != Mirror() || inInfo.layout.endian != Memory::getEndian())
+                {
+                    srcTmp = Data::create(Info(inInfo.size, inInfo.type));
+                    convert(in, *srcTmp);
+                    src = srcTmp.get();
+                }
+                Data* dst = &out;
+                std::shared_ptr<Data> dstTmp;
+                if (outInfo.layout.mirror != Mirror() || outInfo.layout.endian != Memory::getEndian())
+                {
+                    dstTmp = Data::create(Info(outInfo.size, outInfo.type));
+                    dst = dstTmp.get();
+                }
+
+                // The pixels are filtered as floating point with the channels of
+                // the output.
+                const size_t channelCount = getChannelCount(outInfo.type);
+                const Type floatType = getFloatType(static_cast<uint8_t>(channelCount), 32);
+                const auto inFunction = getCPUConvertFunction(inInfo.type, floatType);
+                const auto outFunction = getCPUConvertFunction(floatType, outInfo.type);
+                if (!inFunction || !outFunction)
+                    return;
+
+                const size_t inW = inInfo.size.w;
+                const size_t inH = inInfo.size.h;
+                const size_t outW = outInfo.size.w;
+                const size_t outH = outInfo.size.h;
+                const auto xContributions = getContributions(inW, outW, filter);
+                const auto yContributions = getContributions(inH, outH, filter);
+
+                // Filter the scanlines horizontally. The scanlines are split
+                // across the idle threads of the I/O pool when this is called
+                // from one of its tasks.
+                std::vector<float> tmp(outW * inH * channelCount);
+                const uint8_t* inData = src->getData();
+                const size_t inScanlineByteCount = src->getScanlineByteCount();
+                IO::ThreadPool::parallel(
+                    inH,
+                    inH * inScanlineByteCount,
+                    [&](size_t y0, size_t y1)
+                    {
+                        std::vector<float> scanline(inW * channelCount);
+                        for (size_t y = y0; y < y1; ++y)
+                        {
+                            inFunction(inData + y * inScanlineByteCount, scanline.data(), inW);
+                            float* tmpP = tmp.data() + y * outW * channelCount;
+                            for (size_t x = 0; x < outW; ++x, tmpP += channelCount)
+                            {
+                                const float* scanlineP = scanline.data() + xContributions.start[x] * channelCount;
+                                const float* weights = xContributions.weights.data() + x * xContributions.maxCount;
+                                float sum[4] = { 0.F, 0.F, 0.F, 0.F };
+                                for (size_t i = 0; i < xContributions.count[x]; ++i, scanlineP += channelCount)
+                                {
+                                    for (size_t c = 0; c < channelCount; ++c)
+                                    {
+                                        sum[c] += scanlineP[c] * weights[i];
+                                    }
+                                }
+                                for (size_t c = 0; c < channelCount; ++c)
+                                {
+                                    tmpP[c] = sum[c];
+                                }
+                            }
+                        }
+                    });
+
+                // Filter the columns vertically and convert to the output type.
+                const bool clamp = isIntType(outInfo.type);
+                uint8_t* outData = dst->getData();
+                const size_t outScanlineByteCount = dst->getScanlineByteCount();
+                IO::ThreadPool::parallel(
+                    outH,
+                    tmp.size() * sizeof(float),
+                    [&](size_t y0, size_t y1)
+                    {
+                        const size_t size = outW * channelCount;
+                        std::vector<float> scanline(size);
+                        for (size_t y = y0; y < y1; ++y)
+                        {
+                            std::fill(scanline.begin(), scanline.end(), 0.F);
+                            const float* weights = yContributions.weights.data() + y * yContributions.maxCount;
+                            for (size_t i = 0; i < yContributions.count[y]; ++i)
+                            {
+                                multiplyAdd(tmp.data() + (yContributions.start[y] + i) * size, weights[i], scanline.data(), size);
+                            }
+                            if (clamp)
+                            {
+                                for (auto& i : scanline)
+                                {
+                                    i = Math::clamp(i, 0.F, 1.F);
+                                }
+                            }
+                            outFunction(scanline.data(), outData + y * outScanlineByteCount, outW);
+                        }
+                    });
+
+                if (dstTmp)
+                {
+                    convert(*dstTmp, out);
+                }
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
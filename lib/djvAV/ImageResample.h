@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This enumeration provides the resampling filters.
+            enum class ResampleFilter
+            {
+                Box,
+                Bilinear,
+                Lanczos3,
+
+                Count,
+                First = Box
+            };
+            DJV_ENUM_HELPERS(ResampleFilter);
+
+            //! Resample image data on the CPU. The size, type, and layout of the
+            //! output are taken from the output data.
+            //!
+            //! When the image is made smaller the filter is widened to cover all of
+            //! the input pixels, so the box filter averages the area of each output
+            //! pixel. The horizontal and vertical scales are independent, which
+            //! allows for non-square pixels.
+            void resample(const Data&, Data&, ResampleFilter = ResampleFilter::Bilinear);
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ImageScope.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ImageConvert.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_IMAGE_SCOPE_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t taskByteCountMin = 256 * Memory::kilobyte;
+
+                //! Rec. 709 luma coefficients.
+                const float kr = .2126F;
+                const float kg = .7152F;
+                const float kb = .0722F;
+
+                //! Rec. 709 chroma scales.
+                const float cbScale = 1.8556F;
+                const float crScale = 1.5748F;
+
+                //! This struct maps values to scope rows or columns.
+                struct Map
+                {
+                    Map(float offset, float mul, size_t size) :
+                        offset(offset),
+                        mul(mul),
+                        max(static_cast<float>(size - 1))
+                    {}
+
+                    //! Values outside of the scope, and NaNs, are clamped.
+                    int32_t operator () (float value) const
+                    {
+                        const float v = (value - offset) * mul;
+                        return static_cast<int32_t>(v > 0.F ? std::min(v, max) : 0.F);
+                    }
+
+#if defined(DJV_IMAGE_SCOPE_SSE2)
+                    __m128i operator () (__m128 value) const
+                    {
+                        const __m128 v = _mm_mul_ps(_mm_sub_ps(value, _mm_set1_ps(offset)), _mm_set1_ps(mul));
+                        return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(max)));
+                    }
+#endif // DJV_IMAGE_SCOPE_SSE2
+
+                    float offset = 0.F;
+                    float mul = 0.F;
+                    float max = 0.F;
+                };
+
+                //! Get the scope rows or columns for a list of RGBA pixels. The
+                //! number of pixels must be a multiple of four.
+                void getIndices(
+                    const F32_T* in,
+                    size_t size,
+                    ScopeType type,
+                    const Map& map0,
+                    const Map& map1,
+                    int32_t* out0,
+                    int32_t* out1,
+                    int32_t* out2)
+                {
+#if defined(DJV_IMAGE_SCOPE_SSE2)
+                    const __m128 krV = _mm_set1_ps(kr);
+                    const __m128 kgV = _mm_set1_ps(kg);
+                    const __m128 kbV = _mm_set1_ps(kb);
+                    for (size_t i = 0; i < size; i += 4, in += 16)
+                    {
+                        // Transpose four pixels into four channels.
+                        __m128 r = _mm_loadu_ps(in);
+                        __m128 g = _mm_loadu_ps(in + 4);
+                        __m128 b = _mm_loadu_ps(in + 8);
+                        __m128 a = _mm_loadu_ps(in + 12);
+                        _MM_TRANSPOSE4_PS(r, g, b, a);
+                        switch (type)
+                        {
+                        case ScopeType::Waveform:
+                        {
+                            const __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r, krV), _mm_mul_ps(g, kgV)), _mm_mul_ps(b, kbV));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out0 + i), map0(y));
+                            break;
+                        }
+                        case ScopeType::RGBParade:
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out0 + i), map0(r));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out1 + i), map0(g));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out2 + i), map0(b));
+                            break;
+                        case ScopeType::Vectorscope:
+                        {
+                            const __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r, krV), _mm_mul_ps(g, kgV)), _mm_mul_ps(b, kbV));
+                            const __m128 cb = _mm_div_ps(_mm_sub_ps(b, y), _mm_set1_ps(cbScale));
+                            const __m128 cr = _mm_div_ps(_mm_sub_ps(r, y), _mm_set1_ps(crScale));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out0 + i), map0(cb));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out1 + i), map1(cr));
+                            break;
+                        }
+                        default: break;
+                        }
+                    }
+#else // DJV_IMAGE_SCOPE_SSE2
+                    for (size_t i = 0; i < size; ++i, in += 4)
+                    {
+                        const float r = in[0];
+                        const float g = in[1];
+                        const float b = in[2];
+                        switch (type)
+                        {
+                        case ScopeType::Waveform:
+                            out0[i] = map0(r * kr + g * kg + b * kb);
+                            break;
+                        case ScopeType::RGBParade:
+                            out0[i] = map0(r);
+                            out1[i] = map0(g);
+                            out2[i] = map0(b);
+                            break;
+                        case ScopeType::Vectorscope:
+                        {
+                            const float y = r * kr + g * kg + b * kb;
+                            out0[i] = map0((b - y) / cbScale);
+                            out1[i] = map1((r - y) / crScale);
+                            break;
+                        }
+                        default: break;
+                        }
+                    }
+#endif // DJV_IMAGE_SCOPE_SSE2
+                }
+
+                //! Get the color of a vectorscope position, with a luma of one half.
+                void getVectorscopeColor(float cb, float cr, uint8_t* out)
+                {
+                    const float y = .5F;
+                    const float r = y + cr * crScale;
+                    const float b = y + cb * cbScale;
+                    const float g = (y - r * kr - b * kb) / kg;
+                    out[0] = static_cast<uint8_t>(Math::clamp(r, 0.F, 1.F) * 255.F);
+                    out[1] = static_cast<uint8_t>(Math::clamp(g, 0.F, 1.F) * 255.F);
+                    out[2] = static_cast<uint8_t>(Math::clamp(b, 0.F, 1.F) * 255.F);
+                }
+
+            } // namespace
+
+            std::shared_ptr<Image> scope(const Data& in, ScopeType type, const ScopeOptions& options)
+            {
+                const Size& size = options.size;
+                auto out = Image::create(Info(size, Type::RGBA_U8));
+                out->zero();
+                const Info& info = in.getInfo();
+                if (!info.isValid() || !out->isValid() || (ScopeType::RGBParade == type && size.w < 3))
+                    return out;
+
+                // Byte swapped data is converted first.
+                const Data* src = &in;
+                std::shared_ptr<Data> srcTmp;
+                if (info.layout.endian != Memory::getEndian() && getByteCount(getDataType(info.type)) > 1)
+                {
+                    srcTmp = Data::create(Info(info.size, info.type, Layout(info.layout.mirror)));
+                    convert(in, *srcTmp);
+                    src = srcTmp.get();
+                }
+                const auto convertFunction = getCPUConvertFunction(info.type, Type::RGBA_F32);
+                if (!convertFunction)
+                    return out;
+
+                // Map the input columns to the scope columns. The parade has a
+                // section for each channel.
+                const size_t subsample = std::max(options.subsample, static_cast<uint16_t>(1));
+                const size_t sampleW = (info.size.w + subsample - 1) / subsample;
+                const size_t sampleH = (info.size.h + subsample - 1) / subsample;
+                const size_t sectionW = ScopeType::RGBParade == type ? size.w / 3 : size.w;
+                std::vector<int32_t> xMap(sampleW);
+                for (size_t x = 0; x < sampleW; ++x)
+                {
+                    const size_t x2 = x * subsample * sectionW / info.size.w;
+                    xMap[x] = static_cast<int32_t>(info.layout.mirror.x ? (sectionW - 1 - x2) : x2);
+                }
+                const float rangeSize = options.range.getMax() - options.range.getMin();
+                const Map map0 = ScopeType::Vectorscope == type ?
+                    Map(-.5F, size.w, size.w) :
+                    Map(options.range.getMax(), rangeSize > 0.F ? (-size.h / rangeSize) : 0.F, size.h);
+                const Map map1(.5F, -size.h, size.h);
+
+                // Count the bands of scanlines in parallel with separate counts.
+                const uint8_t* data = src->getData();
+                const size_t scanlineByteCount = src->getScanlineByteCount();
+                const size_t pixelByteCount = src->getPixelByteCount();
+                const auto function = [&](size_t y0, size_t y1)
+                {
+                    std::vector<uint32_t> counts(size.w * size.h, 0);
+                    const size_t paddedW = (sampleW + 3) / 4 * 4;
+                    std::vector<uint8_t> pixels(subsample > 1 ? sampleW * pixelByteCount : 0);
+                    std::vector<F32_T> rgba(paddedW * 4, 0.F);
+                    std::vector<int32_t> indices(paddedW * 3);
+                    int32_t* out0 = indices.data();
+                    int32_t* out1 = out0 + paddedW;
+                    int32_t* out2 = out1 + paddedW;
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        const uint8_t* p = data + y * subsample * scanlineByteCount;
+                        if (subsample > 1)
+                        {
+                            for (size_t x = 0; x < sampleW; ++x)
+                            {
+                                memcpy(pixels.data() + x * pixelByteCount, p + x * subsample * pixelByteCount, pixelByteCount);
+                            }
+                            p = pixels.data();
+                        }
+                        convertFunction(p, rgba.data(), sampleW);
+                        getIndices(rgba.data(), paddedW, type, map0, map1, out0, out1, out2);
+                        switch (type)
+                        {
+                        case ScopeType::Waveform:
+                            for (size_t x = 0; x < sampleW; ++x)
+                            {
+                                ++counts[out0[x] * size.w + xMap[x]];
+                            }
+                            break;
+                        case ScopeType::RGBParade:
+                            for (size_t x = 0; x < sampleW; ++x)
+                            {
+                                ++counts[out0[x] * size.w + xMap[x]];
+                                ++counts[out1[x] * size.w + xMap[x] + sectionW];
+                                ++counts[out2[x] * size.w + xMap[x] + sectionW * 2];
+                            }
+                            break;
+                        case ScopeType::Vectorscope:
+                            for (size_t x = 0; x < sampleW; ++x)
+                            {
+                                ++counts[out1[x] * size.w + out0[x]];
+                            }
+                            break;
+                        default: break;
+                        }
+                    }
+                    return counts;
+                };
+                std::vector<uint32_t> counts;
+                const size_t threadCount = std::min(
+                    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                    std::max(sampleH * sampleW * pixelByteCount / taskByteCountMin, static_cast<size_t>(1)));
+                if (threadCount > 1)
+                {
+                    std::vector<std::future<std::vector<uint32_t> > > futures;
+                    const size_t rows = (sampleH + threadCount - 1) / threadCount;
+                    for (size_t y = 0; y < sampleH; y += rows)
+                    {
+                        futures.push_back(std::async(std::launch::async, function, y, std::min(y + rows, sampleH)));
+                    }
+                    counts = futures[0].get();
+                    for (size_t i = 1; i < futures.size(); ++i)
+                    {
+                        const auto tmp = futures[i].get();
+                        for (size_t j = 0; j < counts.size(); ++j)
+                        {
+                            counts[j] += tmp[j];
+                        }
+                    }
+                }
+                else
+                {
+                    counts = function(0, sampleH);
+                }
+
+                // Convert the counts to densities.
+                uint32_t max = 0;
+                for (const auto i : counts)
+                {
+                    max = std::max(max, i);
+                }
+                if (0 == max)
+                    return out;
+
+                // The maximum count grows with the image size, so the densities
+                // are computed per cell rather than with a table of every count.
+                const float logMax = logf(1.F + max);
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    uint8_t* p = out->getData(y);
+                    const uint32_t* c = counts.data() + y * size.w;
+                    for (uint16_t x = 0; x < size.w; ++x, p += 4, ++c)
+                    {
+                        switch (type)
+                        {
+                        case ScopeType::Waveform:
+                            p[0] = p[1] = p[2] = 255;
+                            break;
+                        case ScopeType::RGBParade:
+                        {
+                            const size_t section = std::min(x / sectionW, static_cast<size_t>(2));
+                            p[0] = 0 == section ? 255 : 0;
+                            p[1] = 1 == section ? 255 : 0;
+                            p[2] = 2 == section ? 255 : 0;
+                            break;
+                        }
+                        case ScopeType::Vectorscope:
+                            getVectorscopeColor((x + .5F) / size.w - .5F, .5F - (y + .5F) / size.h, p);
+                            break;
+                        default: break;
+                        }
+                        p[3] = *c ? static_cast<uint8_t>(logf(1.F + *c) / logMax * 255.F) : 0;
+                    }
+                }
+                return out;
+            }
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        ScopeType,
+        DJV_TEXT("av_image_scope_type_waveform"),
+        DJV_TEXT("av_image_scope_type_rgb_parade"),
+        DJV_TEXT("av_image_scope_type_vectorscope"));
+
+} // namespace djv
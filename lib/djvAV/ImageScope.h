@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            class Image;
+
+            //! This enumeration provides the scope types.
+            enum class ScopeType
+            {
+                Waveform,
+                RGBParade,
+                Vectorscope,
+
+                Count,
+                First = Waveform
+            };
+            DJV_ENUM_HELPERS(ScopeType);
+
+            //! This class provides scope options.
+            class ScopeOptions
+            {
+            public:
+                ScopeOptions();
+
+                //! The size of the scope image.
+                Size size = Size(256, 256);
+
+                //! Only use every nth pixel horizontally and vertically.
+                uint16_t subsample = 1;
+
+                //! The range of values shown by the waveforms. Values outside of
+                //! the range are clamped to the top and bottom of the scope.
+                Core::FloatRange range = Core::FloatRange(0.F, 1.F);
+
+                bool operator == (const ScopeOptions&) const;
+                bool operator != (const ScopeOptions&) const;
+            };
+
+            //! Compute a scope of image data on the CPU.
+            //!
+            //! The result is an RGBA_U8 image where the alpha is the density of
+            //! the pixels, on a logarithmic scale. The waveforms show the Rec. 709
+            //! luma or the red, green, and blue channels side by side, for each
+            //! column of the image. The vectorscope shows the Rec. 709 chroma with
+            //! blue-difference to the right and red-difference to the top.
+            //!
+            //! The scanlines are converted to floating point, so all image types
+            //! are supported, and are counted in parallel.
+            std::shared_ptr<Image> scope(const Data&, ScopeType, const ScopeOptions& = ScopeOptions());
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::ScopeType);
+
+} // namespace djv
+
+#include <djvAV/ImageScopeInline.h>
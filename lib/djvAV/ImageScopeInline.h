@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            inline ScopeOptions::ScopeOptions()
+            {}
+
+            inline bool ScopeOptions::operator == (const ScopeOptions& other) const
+            {
+                return
+                    size == other.size &&
+                    subsample == other.subsample &&
+                    range == other.range;
+            }
+
+            inline bool ScopeOptions::operator != (const ScopeOptions& other) const
+            {
+                return !(*this == other);
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -70,7 +70,7 @@ namespace djv
                     const uint16_t h = data->getHeight();
                     const AV::Image::Type type = data->getType();
                     const uint8_t c = getChannelCount(type);
-                    const uint8_t* p = data->getData();
+                    const uint8_t* p = static_cast<const Data&>(*data).getData();
                     out = Color(type);
                     switch (getDataType(type))
                     {
@@ -60,6 +60,7 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -67,6 +68,7 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string& fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string& fileName) override;
+                    bool _hasProxySupport() const override;
 
                 private:
                     class File;
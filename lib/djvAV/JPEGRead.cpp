@@ -66,12 +66,13 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -81,6 +82,11 @@ namespace djv
                     return _open(fileName, f);
                 }
 
+                bool Read::_hasProxySupport() const
+                {
+                    return true;
+                }
+
                 namespace
                 {
                     bool jpegScanline(
@@ -179,6 +185,7 @@ namespace djv
 
                     bool jpegOpen(
                         FILE*                   f,
+                        unsigned int            scaleDenom,
                         jpeg_decompress_struct* jpeg,
                         JPEGErrorStruct*        error)
                     {
@@ -192,6 +199,12 @@ namespace djv
                         {
                             return false;
                         }
+
+                        // Proxy images are decoded with DCT scaling, which skips
+                        // most of the inverse DCT work.
+                        jpeg->scale_num = 1;
+                        jpeg->scale_denom = scaleDenom;
+
                         if (!jpeg_start_decompress(jpeg))
                         {
                             return false;
@@ -226,7 +239,11 @@ namespace djv
                             arg(fileName).
                             arg(_textSystem->getText(DJV_TEXT("error_file_open"))));
                     }
-                    if (!jpegOpen(f->f, &f->jpeg, &f->jpegError))
+                    if (!jpegOpen(
+                        f->f,
+                        static_cast<unsigned int>(getProxyDenominator(_options.proxyScale)),
+                        &f->jpeg,
+                        &f->jpegError))
                     {
                         std::vector<std::string> messages;
                         messages.push_back(String::Format("{0}: {1}").
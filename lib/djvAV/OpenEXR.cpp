@@ -4,6 +4,8 @@
 
 #include <djvAV/OpenEXR.h>
 
+#include <djvCore/Cache.h>
+#include <djvCore/FileInfo.h>
 #include <djvCore/Time.h>
 
 #include <ImfDoubleAttribute.h>
@@ -13,6 +15,10 @@
 #include <ImfStandardAttributes.h>
 #include <ImfThreading.h>
 
+#include <limits>
+#include <mutex>
+#include <sstream>
+
 using namespace djv::Core;
 
 namespace djv
@@ -1005,9 +1011,85 @@ namespace djv
                         glm::ivec2(channel.xSampling, channel.ySampling));
                 }
 
+                namespace
+                {
+                    std::string getLayerCacheKey(const std::string& fileName, size_t layer)
+                    {
+                        const FileSystem::FileInfo fileInfo(fileName);
+                        std::stringstream ss;
+                        ss << layer << ':' << fileInfo.getSize() << ':' << fileInfo.getTime() << ':' << fileName;
+                        return ss.str();
+                    }
+
+                } // namespace
+
+                struct LayerCache::Private
+                {
+                    mutable std::mutex mutex;
+                    mutable Memory::Cache<std::string, std::shared_ptr<Image::Image> > cache;
+                };
+
+                LayerCache::LayerCache() :
+                    _p(new Private)
+                {
+                    _p->cache.setMax(std::numeric_limits<size_t>::max());
+                }
+
+                LayerCache::~LayerCache()
+                {}
+
+                std::shared_ptr<LayerCache> LayerCache::create()
+                {
+                    return std::shared_ptr<LayerCache>(new LayerCache);
+                }
+
+                size_t LayerCache::getMaxByteCount() const
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    return p.cache.getMaxByteCount();
+                }
+
+                void LayerCache::setMaxByteCount(size_t value)
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.cache.setMaxByteCount(value);
+                }
+
+                size_t LayerCache::getByteCount() const
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    return p.cache.getByteCount();
+                }
+
+                bool LayerCache::get(const std::string& fileName, size_t layer, std::shared_ptr<Image::Image>& value) const
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    return p.cache.get(getLayerCacheKey(fileName, layer), value);
+                }
+
+                void LayerCache::add(const std::string& fileName, size_t layer, const std::shared_ptr<Image::Image>& value)
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.cache.add(getLayerCacheKey(fileName, layer), value, value->getDataByteCount());
+                }
+
+                void LayerCache::clear()
+                {
+                    DJV_PRIVATE_PTR();
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.cache.clear();
+                }
+
                 struct Plugin::Private
                 {
                     Options options;
+                    std::shared_ptr<LayerCache> layerCache;
+                    size_t cacheMaxByteCount = 0;
                 };
 
                 Plugin::Plugin() :
@@ -1018,6 +1100,8 @@ namespace djv
                 {
                     auto out = std::shared_ptr<Plugin>(new Plugin);
                     Imf::setGlobalThreadCount(out->_p->options.threadCount);
+                    out->_p->layerCache = LayerCache::create();
+                    out->_p->layerCache->setMaxByteCount(out->_p->options.layerCacheByteCount);
                     out->_init(
                         pluginName,
                         DJV_TEXT("plugin_openexr_io"),
@@ -1036,11 +1120,18 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     fromJSON(value, p.options);
                     Imf::setGlobalThreadCount(p.options.threadCount);
+
+                    // The layers depend on the channel grouping option.
+                    p.layerCache->clear();
+                    if (!p.cacheMaxByteCount)
+                    {
+                        p.layerCache->setMaxByteCount(p.options.layerCacheByteCount);
+                    }
                 }
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _p->options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _p->layerCache, _threadPool, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info& info, const WriteOptions& options) const
@@ -1048,6 +1139,23 @@ namespace djv
                     return Write::create(fileInfo, info, options, _p->options, _textSystem, _resourceSystem, _logSystem);
                 }
 
+                bool Plugin::hasCache() const
+                {
+                    return _p->options.layerCache;
+                }
+
+                size_t Plugin::getCacheByteCount() const
+                {
+                    return _p->layerCache->getByteCount();
+                }
+
+                void Plugin::setCacheMaxByteCount(size_t value)
+                {
+                    DJV_PRIVATE_PTR();
+                    p.cacheMaxByteCount = value;
+                    p.layerCache->setMaxByteCount(value ? value : p.options.layerCacheByteCount);
+                }
+
             } // namespace OpenEXR
         } // namespace IO
     } // namespace AV
@@ -1091,6 +1199,9 @@ namespace djv
                 out.AddMember("Compression", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
             }
             out.AddMember("DWACompressionLevel", toJSON(value.dwaCompressionLevel, allocator), allocator);
+            out.AddMember("MemoryMap", toJSON(value.memoryMap, allocator), allocator);
+            out.AddMember("LayerCache", toJSON(value.layerCache, allocator), allocator);
+            out.AddMember("LayerCacheByteCount", toJSON(value.layerCacheByteCount, allocator), allocator);
         }
         return out;
     }
@@ -1119,6 +1230,18 @@ namespace djv
                 {
                     fromJSON(i.value, out.dwaCompressionLevel);
                 }
+                else if (0 == strcmp("MemoryMap", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.memoryMap);
+                }
+                else if (0 == strcmp("LayerCache", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.layerCache);
+                }
+                else if (0 == strcmp("LayerCacheByteCount", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.layerCacheByteCount);
+                }
             }
         }
         else
@@ -7,6 +7,7 @@
 #include <djvAV/SequenceIO.h>
 
 #include <djvCore/BBox.h>
+#include <djvCore/Memory.h>
 
 #include <ImathBox.h>
 #include <ImfChannelList.h>
@@ -128,9 +129,42 @@ namespace djv
                     Channels    channels            = Channels::Known;
                     Compression compression         = Compression::None;
                     float       dwaCompressionLevel = 45.F;
+                    bool        memoryMap           = false; //!< Read files with memory mapping
+                    bool        layerCache          = true; //!< Read all of the layers at once and cache them
+                    size_t      layerCacheByteCount = Core::Memory::gigabyte; //!< Used when the I/O system has no cache budget
                 };
 
-                //! This class provides a memory-mapped input stream.
+                //! This class provides a cache for the layers that are read along
+                //! with the current layer, so that switching layers does not read
+                //! the files again. The cache is shared by the readers and is
+                //! thread safe. Entries are keyed by the file size and modification
+                //! time so that they are not used after the file changes.
+                class LayerCache
+                {
+                    DJV_NON_COPYABLE(LayerCache);
+
+                protected:
+                    LayerCache();
+
+                public:
+                    ~LayerCache();
+
+                    static std::shared_ptr<LayerCache> create();
+
+                    size_t getMaxByteCount() const;
+                    void setMaxByteCount(size_t);
+                    size_t getByteCount() const;
+
+                    bool get(const std::string& fileName, size_t layer, std::shared_ptr<Image::Image>&) const;
+                    void add(const std::string& fileName, size_t layer, const std::shared_ptr<Image::Image>&);
+                    void clear();
+
+                private:
+                    DJV_PRIVATE();
+                };
+
+                //! This class provides a memory-mapped input stream. If the file
+                //! cannot be memory mapped it is read normally instead.
                 class MemoryMappedIStream : public Imf::IStream
                 {
                     DJV_NON_COPYABLE(MemoryMappedIStream);
@@ -164,6 +198,8 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<LayerCache>&,
+                        const std::shared_ptr<ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -171,10 +207,15 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string& fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string& fileName) override;
+                    bool _hasProxySupport() const override;
 
                 private:
                     struct File;
                     Info _open(const std::string&, File&);
+                    void _readLayers(
+                        File&,
+                        const std::vector<size_t>& layers,
+                        const std::vector<std::shared_ptr<Image::Image> >&);
 
                     DJV_PRIVATE();
                 };
@@ -225,6 +266,10 @@ namespace djv
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
                     std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info&, const WriteOptions&) const override;
 
+                    bool hasCache() const override;
+                    size_t getCacheByteCount() const override;
+                    void setCacheMaxByteCount(size_t) override;
+
                 private:
                     DJV_PRIVATE();
                 };
@@ -6,13 +6,17 @@
 
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
 #include <ImfChannelList.h>
+#include <ImfCompressor.h>
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
 #include <ImfRgbaYca.h>
+#include <ImfTileDescription.h>
+#include <ImfTiledInputFile.h>
 
 using namespace djv::Core;
 
@@ -24,10 +28,9 @@ namespace djv
         {
             namespace OpenEXR
             {
-#if defined(DJV_MMAP)
                 struct MemoryMappedIStream::Private
                 {
-                    FileSystem::FileIO  f;
+                    std::shared_ptr<FileSystem::FileIO> f;
                     uint64_t            size    = 0;
                     uint64_t            pos     = 0;
                     char*               p       = nullptr;
@@ -38,9 +41,10 @@ namespace djv
                     _p(new Private)
                 {
                     DJV_PRIVATE_PTR();
-                    p.f.open(fileName, FileSystem::FileIO::Mode::Read);
-                    p.size = p.f.getSize();
-                    p.p = (char*)(p.f.mmapP());
+                    p.f = FileSystem::FileIO::create();
+                    p.f->open(fileName, FileSystem::FileIO::Mode::Read, true);
+                    p.size = p.f->getSize();
+                    p.p = (char*)(p.f->mmapP());
                 }
 
                 MemoryMappedIStream::~MemoryMappedIStream()
@@ -48,7 +52,7 @@ namespace djv
 
                 bool MemoryMappedIStream::isMemoryMapped() const
                 {
-                    return true;
+                    return _p->f->isMemoryMapped();
                 }
 
                 char* MemoryMappedIStream::readMemoryMapped(int n)
@@ -70,7 +74,15 @@ namespace djv
                         throw FileSystem::Error("Error reading OpenEXR file.");
                     if (p.pos + n > p.size)
                         throw FileSystem::Error("Error reading OpenEXR file.");
-                    memcpy(c, p.p + p.pos, n);
+                    if (p.p)
+                    {
+                        memcpy(c, p.p + p.pos, n);
+                    }
+                    else
+                    {
+                        p.f->setPos(p.pos);
+                        p.f->read(c, n);
+                    }
                     p.pos += n;
                     return p.pos < p.size;
                 }
@@ -84,7 +96,23 @@ namespace djv
                 {
                     _p->pos = pos;
                 }
-#endif // DJV_MMAP
+
+                namespace
+                {
+                    //! \todo Should this be configurable?
+                    const size_t bandByteCountMax = 64 * Memory::megabyte;
+
+                    uint16_t getLevelSize(int size, int level, Imf::LevelRoundingMode roundingMode)
+                    {
+                        int out = size >> level;
+                        if (Imf::ROUND_UP == roundingMode && (out << level) < size)
+                        {
+                            ++out;
+                        }
+                        return static_cast<uint16_t>(std::max(out, 1));
+                    }
+
+                } // namespace
 
                 struct Read::File
                 {
@@ -99,11 +127,13 @@ namespace djv
                     BBox2i                               intersectedWindow;
                     std::vector<OpenEXR::Layer>          layers;
                     bool                                 fast              = false;
+                    int                                  mipLevel          = 0;
                 };
 
                 struct Read::Private
                 {
                     Options options;
+                    std::shared_ptr<LayerCache> layerCache;
                 };
 
                 Read::Read() :
@@ -119,13 +149,16 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<LayerCache>& layerCache,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_p->layerCache = layerCache;
+                    out->_init(fileInfo, readOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -135,80 +168,288 @@ namespace djv
                     return _open(fileName, f);
                 }
 
+                bool Read::_hasProxySupport() const
+                {
+                    return true;
+                }
+
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string& fileName)
                 {
+                    std::shared_ptr<Image::Image> out;
+                    const auto& layerCache = _p->layerCache;
+                    const bool layerCacheEnabled =
+                        _p->options.layerCache &&
+                        layerCache &&
+                        ProxyScale::None == _options.proxyScale;
+                    if (layerCacheEnabled && layerCache->get(fileName, _options.layer, out))
+                    {
+                        return out;
+                    }
                     File f;
                     Info info = _open(fileName, f);
-                    Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)];
-                    std::shared_ptr<Image::Image> out = Image::Image::create(imageInfo);
+                    const size_t layer = std::min(_options.layer, info.video.size() - 1);
+                    Image::Info imageInfo = info.video[layer];
+                    out = Image::Image::create(imageInfo);
                     out->setPluginName(pluginName);
                     out->setTags(info.tags);
                     const size_t channels = Image::getChannelCount(imageInfo.type);
                     const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
                     const size_t cb = channels * channelByteCount;
                     const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                    if (f.fast)
+                    if (f.mipLevel > 0)
                     {
+                        // Read the proxy image from a mipmap level of a tiled file.
+                        std::unique_ptr<MemoryMappedIStream> s;
+                        std::unique_ptr<Imf::TiledInputFile> tiledFile;
+                        if (_p->options.memoryMap)
+                        {
+                            s.reset(new MemoryMappedIStream(fileName.c_str()));
+                            tiledFile.reset(new Imf::TiledInputFile(*s.get()));
+                        }
+                        else
+                        {
+                            tiledFile.reset(new Imf::TiledInputFile(fileName.c_str()));
+                        }
+                        const Imath::Box2i dataWindow = tiledFile->dataWindowForLevel(f.mipLevel, f.mipLevel);
                         Imf::FrameBuffer frameBuffer;
                         for (size_t c = 0; c < channels; ++c)
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
+                            const std::string& name = f.layers[layer].channels[c].name;
                             frameBuffer.insert(
                                 name.c_str(),
                                 Imf::Slice(
                                     toImf(Image::getDataType(imageInfo.type)),
-                                    (char*)out->getData() + (c * channelByteCount),
+                                    (char*)out->getData() - (dataWindow.min.x * cb) - (dataWindow.min.y * scb) + (c * channelByteCount),
                                     cb,
                                     scb,
-                                    sampling.x,
-                                    sampling.y,
+                                    1,
+                                    1,
                                     0.F));
                         }
-                        f.f->setFrameBuffer(frameBuffer);
-                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
+                        tiledFile->setFrameBuffer(frameBuffer);
+                        tiledFile->readTiles(
+                            0, tiledFile->numXTiles(f.mipLevel) - 1,
+                            0, tiledFile->numYTiles(f.mipLevel) - 1,
+                            f.mipLevel, f.mipLevel);
+                    }
+                    else if (_options.proxyScale != ProxyScale::None)
+                    {
+                        // Read the proxy image by skipping scanlines and pixels.
+                        // Only the line blocks that contain a proxy scanline are
+                        // read, and each of them is only decompressed once.
+                        const int denominator = static_cast<int>(getProxyDenominator(_options.proxyScale));
+                        const auto& header = f.f->header();
+                        const int blockHeight = header.hasTileDescription() ?
+                            static_cast<int>(header.tileDescription().ySize) :
+                            Imf::numLinesInBuffer(header.compression());
+                        const size_t ys = f.dataWindow.w() * cb;
+                        std::vector<char> buf(blockHeight * ys);
+                        int blockMin = 0;
+                        int blockMax = -1;
+                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        {
+                            uint8_t* p = out->getData() + y * scb;
+                            const int fileY = f.displayWindow.min.y + y * denominator;
+                            if (fileY >= f.intersectedWindow.min.y && fileY <= f.intersectedWindow.max.y)
+                            {
+                                if (fileY > blockMax)
+                                {
+                                    blockMin = f.dataWindow.min.y + (fileY - f.dataWindow.min.y) / blockHeight * blockHeight;
+                                    blockMax = std::min(blockMin + blockHeight - 1, f.intersectedWindow.max.y);
+                                    blockMin = std::max(blockMin, f.intersectedWindow.min.y);
+                                    Imf::FrameBuffer frameBuffer;
+                                    for (size_t c = 0; c < channels; ++c)
+                                    {
+                                        const std::string& name = f.layers[layer].channels[c].name;
+                                        const glm::ivec2& sampling = f.layers[layer].channels[c].sampling;
+                                        frameBuffer.insert(
+                                            name.c_str(),
+                                            Imf::Slice(
+                                                toImf(Image::getDataType(imageInfo.type)),
+                                                buf.data() - (f.dataWindow.min.x * cb) - (blockMin * ys) + (c * channelByteCount),
+                                                cb,
+                                                ys,
+                                                sampling.x,
+                                                sampling.y,
+                                                0.F));
+                                    }
+                                    f.f->setFrameBuffer(frameBuffer);
+                                    f.f->readPixels(blockMin, blockMax);
+                                }
+                                const char* line = buf.data() + (fileY - blockMin) * ys;
+                                for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += cb)
+                                {
+                                    const int fileX = f.displayWindow.min.x + x * denominator;
+                                    if (fileX >= f.intersectedWindow.min.x && fileX <= f.intersectedWindow.max.x)
+                                    {
+                                        memcpy(p, line + (fileX - f.dataWindow.min.x) * cb, cb);
+                                    }
+                                    else
+                                    {
+                                        memset(p, 0, cb);
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                memset(p, 0, scb);
+                            }
+                        }
                     }
                     else
+                    {
+                        // Read the other layers in the same pass when the layer cache
+                        // is enabled so that each line block is only decompressed once.
+                        std::vector<size_t> layers;
+                        std::vector<std::shared_ptr<Image::Image> > images;
+                        for (size_t i = 0; i < info.video.size(); ++i)
+                        {
+                            if (i == layer)
+                            {
+                                layers.push_back(i);
+                                images.push_back(out);
+                            }
+                            else if (layerCacheEnabled)
+                            {
+                                auto image = Image::Image::create(info.video[i]);
+                                image->setPluginName(pluginName);
+                                image->setTags(info.tags);
+                                layers.push_back(i);
+                                images.push_back(image);
+                            }
+                        }
+                        _readLayers(f, layers, images);
+                        if (layerCacheEnabled && images.size() > 1)
+                        {
+                            for (size_t i = 0; i < layers.size(); ++i)
+                            {
+                                layerCache->add(fileName, layers[i], images[i]);
+                            }
+                        }
+                    }
+                    return out;
+                }
+
+                void Read::_readLayers(
+                    File& f,
+                    const std::vector<size_t>& layers,
+                    const std::vector<std::shared_ptr<Image::Image> >& images)
+                {
+                    struct Layer
+                    {
+                        const OpenEXR::Layer* layer = nullptr;
+                        std::shared_ptr<Image::Image> image;
+                        Image::DataType dataType = Image::DataType::None;
+                        size_t channelByteCount = 0;
+                        size_t cb = 0;
+                        size_t scb = 0;
+                        std::vector<char> buf;
+                    };
+                    std::vector<Layer> data;
+                    for (size_t i = 0; i < layers.size(); ++i)
+                    {
+                        Layer layer;
+                        layer.layer = &f.layers[layers[i]];
+                        layer.image = images[i];
+                        const Image::Type type = images[i]->getType();
+                        layer.dataType = Image::getDataType(type);
+                        layer.channelByteCount = Image::getByteCount(layer.dataType);
+                        layer.cb = Image::getChannelCount(type) * layer.channelByteCount;
+                        layer.scb = images[i]->getWidth() * layer.cb;
+                        data.push_back(std::move(layer));
+                    }
+
+                    if (f.fast)
                     {
                         Imf::FrameBuffer frameBuffer;
-                        std::vector<char> buf(f.dataWindow.w() * cb);
-                        for (int c = 0; c < channels; ++c)
+                        for (const auto& i : data)
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    buf.data() - (f.dataWindow.min.x * cb) + (c * channelByteCount),
-                                    cb,
-                                    0,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
+                            for (size_t c = 0; c < i.layer->channels.size(); ++c)
+                            {
+                                const std::string& name = i.layer->channels[c].name;
+                                const glm::ivec2& sampling = i.layer->channels[c].sampling;
+                                frameBuffer.insert(
+                                    name.c_str(),
+                                    Imf::Slice(
+                                        toImf(i.dataType),
+                                        (char*)i.image->getData() + (c * i.channelByteCount),
+                                        i.cb,
+                                        i.scb,
+                                        sampling.x,
+                                        sampling.y,
+                                        0.F));
+                            }
                         }
                         f.f->setFrameBuffer(frameBuffer);
-                        for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
+                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
+                        return;
+                    }
+
+                    // Read the scanlines in bands so that OpenEXR can decode the
+                    // line blocks of each band in parallel with its thread pool.
+                    size_t bufScanlineByteCount = 0;
+                    for (const auto& i : data)
+                    {
+                        bufScanlineByteCount += f.dataWindow.w() * i.cb;
+                    }
+                    const int bandHeight = std::min(
+                        std::max(static_cast<int>(bandByteCountMax / bufScanlineByteCount), 1),
+                        std::max(f.intersectedWindow.h(), 1));
+                    for (auto& i : data)
+                    {
+                        i.buf.resize(bandHeight * f.dataWindow.w() * i.cb);
+                    }
+                    int bandMin = 0;
+                    int bandMax = -1;
+                    for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
+                    {
+                        const bool intersected = y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y;
+                        if (intersected && y > bandMax)
                         {
-                            uint8_t* p = out->getData() + ((y - f.displayWindow.min.y) * scb);
-                            uint8_t* end = p + scb;
-                            if (y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
+                            bandMin = y;
+                            bandMax = std::min(y + bandHeight - 1, f.intersectedWindow.max.y);
+                            Imf::FrameBuffer frameBuffer;
+                            for (auto& i : data)
                             {
-                                size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * cb;
+                                const size_t ys = f.dataWindow.w() * i.cb;
+                                for (size_t c = 0; c < i.layer->channels.size(); ++c)
+                                {
+                                    const std::string& name = i.layer->channels[c].name;
+                                    const glm::ivec2& sampling = i.layer->channels[c].sampling;
+                                    frameBuffer.insert(
+                                        name.c_str(),
+                                        Imf::Slice(
+                                            toImf(i.dataType),
+                                            i.buf.data() - (f.dataWindow.min.x * i.cb) - (bandMin * ys) + (c * i.channelByteCount),
+                                            i.cb,
+                                            ys,
+                                            sampling.x,
+                                            sampling.y,
+                                            0.F));
+                                }
+                            }
+                            f.f->setFrameBuffer(frameBuffer);
+                            f.f->readPixels(bandMin, bandMax);
+                        }
+                        for (auto& i : data)
+                        {
+                            uint8_t* p = i.image->getData() + ((y - f.displayWindow.min.y) * i.scb);
+                            uint8_t* end = p + i.scb;
+                            if (intersected)
+                            {
+                                size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * i.cb;
                                 memset(p, 0, size);
                                 p += size;
-                                size = f.intersectedWindow.w() * cb;
-                                f.f->readPixels(y, y);
+                                size = f.intersectedWindow.w() * i.cb;
                                 memcpy(
                                     p,
-                                    buf.data() + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * cb,
+                                    i.buf.data() + (y - bandMin) * f.dataWindow.w() * i.cb + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * i.cb,
                                     size);
                                 p += size;
                             }
                             memset(p, 0, end - p);
                         }
                     }
-                    return out;
                 }
 
                 Info Read::_open(const std::string& fileName, File& f)
@@ -218,12 +459,15 @@ namespace djv
                     Info out;
 
                     // Open the file.
-#if defined(DJV_MMAP)
-                    f.s.reset(new MemoryMappedIStream(fileName.c_str()));
-                    f.f.reset(new Imf::InputFile(*f.s.get()));
-#else // DJV_MMAP
-                    f.f.reset(new Imf::InputFile(fileName.c_str()));
-#endif // DJV_MMAP
+                    if (p.options.memoryMap)
+                    {
+                        f.s.reset(new MemoryMappedIStream(fileName.c_str()));
+                        f.f.reset(new Imf::InputFile(*f.s.get()));
+                    }
+                    else
+                    {
+                        f.f.reset(new Imf::InputFile(fileName.c_str()));
+                    }
 
                     // Get the display and data windows.
                     f.displayWindow = fromImath(f.f->header().displayWindow());
@@ -270,6 +514,34 @@ namespace djv
                         }
                     }
 
+                    // Proxy images are read from a mipmap level when the file has
+                    // them, otherwise by skipping scanlines.
+                    if (_options.proxyScale != ProxyScale::None)
+                    {
+                        Image::Size size = getProxySize(
+                            Image::Size(f.displayWindow.w(), f.displayWindow.h()),
+                            _options.proxyScale);
+                        const auto& header = f.f->header();
+                        const int level = static_cast<int>(_options.proxyScale);
+                        if (f.fast &&
+                            header.hasTileDescription() &&
+                            (std::max(f.dataWindow.w(), f.dataWindow.h()) >> level) > 0)
+                        {
+                            const auto& tileDescription = header.tileDescription();
+                            if (Imf::MIPMAP_LEVELS == tileDescription.mode ||
+                                Imf::RIPMAP_LEVELS == tileDescription.mode)
+                            {
+                                f.mipLevel = level;
+                                size.w = getLevelSize(f.dataWindow.w(), level, tileDescription.roundingMode);
+                                size.h = getLevelSize(f.dataWindow.h(), level, tileDescription.roundingMode);
+                            }
+                        }
+                        for (auto& i : out.video)
+                        {
+                            i.size = size;
+                        }
+                    }
+
                     return out;
                 }
 
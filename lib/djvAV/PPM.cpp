@@ -126,7 +126,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info& info, const WriteOptions& options) const
@@ -147,6 +147,7 @@ namespace djv
             const std::string& s = ss.str();
             out.AddMember("Data", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
         }
+        out.AddMember("MemoryMap", toJSON(value.memoryMap, allocator), allocator);
         return out;
     }
 
@@ -161,6 +162,10 @@ namespace djv
                     std::stringstream ss(i.value.GetString());
                     ss >> out.data;
                 }
+                else if (0 == strcmp("MemoryMap", i.name.GetString()))
+                {
+                    fromJSON(i.value, out.memoryMap);
+                }
             }
         }
         else
@@ -36,7 +36,8 @@ namespace djv
                 //! This struct provides the PPM file I/O options.
                 struct Options
                 {
-                    Data data = Data::Binary;
+                    Data data      = Data::Binary;
+                    bool memoryMap = false; //!< Read binary images with memory mapping
                 };
 
                 //! Get the number of bytes in a scanline.
@@ -73,6 +74,8 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const Options&,
+                        const std::shared_ptr<ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -83,6 +86,8 @@ namespace djv
 
                 private:
                     Info _open(const std::string&, const std::shared_ptr<Core::FileSystem::FileIO>&, Data&);
+
+                    DJV_PRIVATE();
                 };
                 
                 //! This class provides the PPM file writer.
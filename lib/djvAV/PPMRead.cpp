@@ -19,7 +19,13 @@ namespace djv
         {
             namespace PPM
             {
-                Read::Read()
+                struct Read::Private
+                {
+                    Options options;
+                };
+
+                Read::Read() :
+                    _p(new Private)
                 {}
 
                 Read::~Read()
@@ -30,12 +36,15 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_p->options = options;
+                    out->_init(fileInfo, readOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -69,18 +78,20 @@ namespace djv
                     }
                     case Data::Binary:
                     {
-#if defined(DJV_MMAP)
-                        out = Image::Image::create(imageInfo, io);
-#else // DJV_MMAP
+                        // Images that need byte swapping are copied, otherwise the
+                        // image data can reference the memory map directly.
                         bool convertEndian = false;
                         if (imageInfo.layout.endian != Memory::getEndian())
                         {
-                            convertEndian = true;
+                            convertEndian = Image::getByteCount(Image::getDataType(imageInfo.type)) > 1;
                             imageInfo.layout.endian = Memory::getEndian();
                         }
-                        out = Image::Image::create(imageInfo);
+                        out = Image::Image::create(imageInfo, !convertEndian ? io : nullptr);
                         out->setPluginName(pluginName);
-                        io->read(out->getData(), out->getDataByteCount());
+                        if (!out->isMemoryMapped())
+                        {
+                            io->read(out->getData(), out->getDataByteCount());
+                        }
                         if (convertEndian)
                         {
                             const size_t dataByteCount = out->getDataByteCount();
@@ -95,7 +106,6 @@ namespace djv
                                 default: break;                            
                             }
                         }
-#endif // DJV_MMAP
                         break;
                     }
                     default: break;
@@ -105,7 +115,7 @@ namespace djv
 
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<FileSystem::FileIO>& io, Data& data)
                 {
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    io->open(fileName, FileSystem::FileIO::Mode::Read, _p->options.memoryMap);
 
                     char magic[] = { 0, 0, 0 };
                     io->read(magic, 2);
@@ -496,10 +496,9 @@ namespace djv
 
             } // namespace
 
-            void convert(const void * in, Type inType, void * out, Type outType, size_t size)
+            ConvertFunction getConvertFunction(Type inType, Type outType)
             {
-                typedef std::function<void(const void *, void *, size_t)> Function;
-                static const std::map<Type, std::map<Type, Function> > functions =
+                static const std::map<Type, std::map<Type, ConvertFunction> > functions =
                 {
                     CONVERT_MAP(L_U8),
                     CONVERT_MAP(L_U16),
@@ -523,17 +522,22 @@ namespace djv
                     CONVERT_MAP(RGBA_F16),
                     CONVERT_MAP(RGBA_F32)
                 };
-                Function function;
+                ConvertFunction out;
                 const auto i = functions.find(inType);
                 if (i != functions.end())
                 {
                     const auto j = i->second.find(outType);
                     if (j != i->second.end())
                     {
-                        function = j->second;
+                        out = j->second;
                     }
                 }
-                if (function)
+                return out;
+            }
+
+            void convert(const void * in, Type inType, void * out, Type outType, size_t size)
+            {
+                if (const auto function = getConvertFunction(inType, outType))
                 {
                     function(in, out, size);
                 }
@@ -12,6 +12,7 @@
 
 #include <OpenEXR/half.h>
 
+#include <functional>
 #include <limits>
 
 namespace djv
@@ -203,6 +204,14 @@ namespace djv
             void convert_F32_F16(F32_T, F16_T&);
             void convert_F32_F32(F32_T, F32_T&);
 
+            //! This typedef provides a function for converting pixels.
+            typedef std::function<void(const void *, void *, size_t)> ConvertFunction;
+
+            //! Get the function for converting pixels from one type to another.
+            //! This is useful for converting many scanlines without looking up
+            //! the function each time.
+            ConvertFunction getConvertFunction(Type, Type);
+
             void convert(const void *, Type, void *, Type, size_t);
 
         } // namespace Image
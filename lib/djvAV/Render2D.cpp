@@ -29,6 +29,10 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/perpendicular.hpp>
 
+#include <cstring>
+#include <limits>
+#include <set>
+
 using namespace djv::Core;
 namespace _OCIO = OCIO_NAMESPACE;
 
@@ -38,6 +42,111 @@ namespace djv
     {
         namespace Render2D
         {
+            namespace
+            {
+                //! The clipping rectangle used while recording draw lists.
+                const BBox2f unclipped(
+                    glm::vec2(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()),
+                    glm::vec2(std::numeric_limits<float>::max(), std::numeric_limits<float>::max()));
+
+                BBox2f transform(const BBox2f& value, const glm::mat3x3& m)
+                {
+                    const glm::vec3 pts[] =
+                    {
+                        m * glm::vec3(value.min.x, value.min.y, 1.F),
+                        m * glm::vec3(value.max.x, value.min.y, 1.F),
+                        m * glm::vec3(value.max.x, value.max.y, 1.F),
+                        m * glm::vec3(value.min.x, value.max.y, 1.F)
+                    };
+                    BBox2f out(glm::vec2(pts[0].x, pts[0].y));
+                    for (size_t i = 1; i < 4; ++i)
+                    {
+                        out.expand(glm::vec2(pts[i].x, pts[i].y));
+                    }
+                    return out;
+                }
+
+                //! Get the area of the frame buffer that is kept by the scissor
+                //! test for a clipping rectangle.
+                BBox2f getScissorRect(const BBox2f& value, const Image::Size& size)
+                {
+                    const BBox2f rect = flip(value, size);
+                    return flip(BBox2f(
+                        static_cast<float>(static_cast<GLint>(rect.min.x)),
+                        static_cast<float>(static_cast<GLint>(rect.min.y)),
+                        static_cast<float>(static_cast<GLsizei>(rect.w())),
+                        static_cast<float>(static_cast<GLsizei>(rect.h()))), size);
+                }
+
+                bool isTriangles(GLenum value)
+                {
+                    return GL_TRIANGLES == value || GL_TRIANGLE_STRIP == value;
+                }
+
+                //! Get the number of vertices needed to draw a primitive as
+                //! separate triangles.
+                size_t getTrianglesSize(const Primitive& value)
+                {
+                    size_t out = value.vaoSize;
+                    if (GL_TRIANGLE_STRIP == value.type)
+                    {
+                        out = value.vaoSize > 2 ? (value.vaoSize - 2) * 3 : 0;
+                    }
+                    return out;
+                }
+
+                //! This struct provides a group of primitives that are drawn
+                //! with a single draw call.
+                struct Batch
+                {
+                    std::shared_ptr<Primitive> primitive;
+                    BBox2f clipRect;
+                    BBox2f scissorRect;
+                    BBox2f bbox;
+                    size_t count         = 0;
+                    GLenum type          = GL_TRIANGLES;
+                    size_t vaoOffset     = 0;
+                    size_t vaoSize       = 0;
+                    size_t trianglesSize = 0;
+                    size_t vaoCursor     = 0;
+                };
+
+                const size_t batchNone = std::numeric_limits<size_t>::max();
+
+            } // namespace
+
+            struct DrawList::Private
+            {
+                std::vector<std::shared_ptr<Primitive> > primitives;
+                std::vector<uint8_t> vboData;
+                BBox2f bbox = BBox2f(0.F, 0.F, 0.F, 0.F);
+                std::vector<uint64_t> atlasIDs;
+                std::vector<std::pair<UID, GLuint> > dynamicTextures;
+                std::vector<size_t> colorSpaces;
+            };
+
+            DrawList::DrawList() :
+                _p(new Private)
+            {}
+
+            DrawList::~DrawList()
+            {}
+
+            const BBox2f& DrawList::getBBox() const
+            {
+                return _p->bbox;
+            }
+
+            size_t DrawList::getPrimitivesCount() const
+            {
+                return _p->primitives.size();
+            }
+
+            size_t DrawList::getVertexCount() const
+            {
+                return _p->vboData.size() / AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
+            }
+
             struct Render::Private
             {
                 Render* system = nullptr;
@@ -46,8 +155,15 @@ namespace djv
                 bool                                                textLCDRendering    = true;
 
                 BBox2f                                              viewport;
+                std::vector<BBox2f>                                 frameRects;
                 std::vector<std::shared_ptr<Primitive> >            primitives;
                 size_t                                              primitivesCount     = 0;
+                size_t                                              drawCallsCount      = 0;
+                size_t                                              stateChangesCount   = 0;
+                std::vector<Batch>                                  batches;
+                std::vector<size_t>                                 primitiveBatches;
+                std::vector<uint8_t>                                batchVBOData;
+                size_t                                              batchVBODataSize    = 0;
                 PrimitiveData                                       primitiveData;
                 std::shared_ptr<OpenGL::TextureAtlas>               textureAtlas;
                 std::map<UID, uint64_t>                             textureIDs;
@@ -69,10 +185,32 @@ namespace djv
                 std::shared_ptr<OpenGL::Shader>                     shader;
                 GLint                                               mvpLoc              = 0;
 
+                bool                                                recording           = false;
+                size_t                                              recordPrimitives    = 0;
+                size_t                                              recordVBODataSize   = 0;
+                std::list<BBox2f>                                   recordClipRects;
+                BBox2f                                              recordClipRect;
+                std::list<glm::mat3x3>                              recordTransforms;
+                float                                               recordColorMult     = 1.F;
+                float                                               recordAlphaMult     = 1.F;
+                std::set<uint64_t>                                  recordAtlasIDs;
+                std::map<UID, GLuint>                               recordDynamicTextures;
+                std::set<size_t>                                    recordColorSpaces;
+
                 std::shared_ptr<Time::Timer>                        statsTimer;
 
                 void vboDataSizeUpdate(size_t);
 
+                //! Add a primitive, merging it with the previous primitive
+                //! when possible.
+                void addPrimitive(const std::shared_ptr<Primitive>&);
+
+                //! Group the primitives into batches that can be drawn
+                //! together. Primitives are only moved past other primitives
+                //! they don't overlap, so the result looks the same as drawing
+                //! them in order.
+                void batchesUpdate(const Image::Size&);
+
                 void drawImage(
                     const std::shared_ptr<Image::Image>&,
                     const glm::vec2& pos,
@@ -150,6 +288,8 @@ namespace djv
                         DJV_PRIVATE_PTR();
                         std::stringstream ss;
                         ss << "Primitives: " << p.primitivesCount << "\n";
+                        ss << "Draw calls: " << p.drawCallsCount << "\n";
+                        ss << "State changes: " << p.stateChangesCount << "\n";
                         ss << "Texture atlas: " << p.textureAtlas->getPercentageUsed() << "%\n";
                         ss << "Texture IDs: " << p.textureIDs.size() << "%\n";
                         ss << "Glyph texture IDs: " << p.glyphTextureIDs.size() << "\n";
@@ -183,6 +323,14 @@ namespace djv
                 _size = size;
                 _currentClipRect = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
                 p.viewport = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+                p.frameRects.clear();
+            }
+
+            void Render::beginFrame(const Image::Size& size, const std::vector<BBox2f>& rects)
+            {
+                DJV_PRIVATE_PTR();
+                beginFrame(size);
+                p.frameRects = rects;
             }
 
             void Render::endFrame()
@@ -238,13 +386,30 @@ namespace djv
                     static_cast<GLint>(p.viewport.min.y),
                     static_cast<GLsizei>(p.viewport.w()),
                     static_cast<GLsizei>(p.viewport.h()));
-                glScissor(
-                    static_cast<GLint>(p.viewport.min.x),
-                    static_cast<GLint>(p.viewport.min.y),
-                    static_cast<GLsizei>(p.viewport.w()),
-                    static_cast<GLsizei>(p.viewport.h()));
                 glClearColor(0.F, 0.F, 0.F, 0.F);
-                glClear(GL_COLOR_BUFFER_BIT);
+                if (p.frameRects.empty())
+                {
+                    glScissor(
+                        static_cast<GLint>(p.viewport.min.x),
+                        static_cast<GLint>(p.viewport.min.y),
+                        static_cast<GLsizei>(p.viewport.w()),
+                        static_cast<GLsizei>(p.viewport.h()));
+                    glClear(GL_COLOR_BUFFER_BIT);
+                }
+                else
+                {
+                    // Only clear the areas being updated.
+                    for (const auto& i : p.frameRects)
+                    {
+                        const BBox2f rect = flip(i, _size);
+                        glScissor(
+                            static_cast<GLint>(rect.min.x),
+                            static_cast<GLint>(rect.min.y),
+                            static_cast<GLsizei>(rect.w()),
+                            static_cast<GLsizei>(rect.h()));
+                        glClear(GL_COLOR_BUFFER_BIT);
+                    }
+                }
 
                 const auto viewMatrix = glm::ortho(
                     p.viewport.min.x,
@@ -261,23 +426,29 @@ namespace djv
                     glBindTexture(GL_TEXTURE_2D, atlasTextures[i]);
                 }
 
+                p.batchesUpdate(_size);
+
                 const size_t vertexByteCount = AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
-                if (!p.vbo || p.vboDataSize / vertexByteCount > p.vbo->getSize())
+                if (!p.vbo || p.batchVBODataSize / vertexByteCount > p.vbo->getSize())
                 {
-                    p.vbo = OpenGL::VBO::create(p.vboDataSize / vertexByteCount, OpenGL::VBOType::Pos2_F32_UV_U16);
+                    p.vbo = OpenGL::VBO::create(p.batchVBODataSize / vertexByteCount, OpenGL::VBOType::Pos2_F32_UV_U16);
                     p.vao = OpenGL::VAO::create(p.vbo->getType(), p.vbo->getID());
                 }
-                p.vbo->copy(p.vboData, 0, p.vboDataSize);
+                p.vbo->copy(p.batchVBOData, 0, p.batchVBODataSize);
                 p.vao->bind();
 
                 BBox2f currentClipRect(0.F, 0.F, 0.F, 0.F);
                 AlphaBlend currentAlphaBlend = AlphaBlend::Straight;
                 bool currentTextLCDRendering = false;
+                std::shared_ptr<Primitive> currentPrimitive;
+                p.drawCallsCount = 0;
+                p.stateChangesCount = 0;
                 glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
                 glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-                for (const auto& primitive : p.primitives)
+                for (const auto& batch : p.batches)
                 {
-                    const BBox2f clipRect = flip(primitive->clipRect, _size);
+                    const auto& primitive = batch.primitive;
+                    const BBox2f clipRect = flip(batch.clipRect, _size);
                     if (clipRect != currentClipRect)
                     {
                         currentClipRect = clipRect;
@@ -286,10 +457,12 @@ namespace djv
                             static_cast<GLint>(currentClipRect.min.y),
                             static_cast<GLsizei>(currentClipRect.w()),
                             static_cast<GLsizei>(currentClipRect.h()));
+                        ++p.stateChangesCount;
                     }
                     if (primitive->alphaBlend != currentAlphaBlend)
                     {
                         currentAlphaBlend = primitive->alphaBlend;
+                        ++p.stateChangesCount;
                         switch (currentAlphaBlend)
                         {
                         case AlphaBlend::None:
@@ -312,28 +485,36 @@ namespace djv
                             glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
                         }
                     }
-                    primitive->bind(p.primitiveData, p.shader);
+                    if (!currentPrimitive || !primitive->isSameState(*currentPrimitive))
+                    {
+                        currentPrimitive = primitive;
+                        primitive->bind(p.primitiveData, p.shader);
+                        ++p.stateChangesCount;
+                    }
                     if (currentTextLCDRendering)
                     {
                         p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaR));
                         glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_TRUE);
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
+                        p.vao->draw(batch.type, batch.vaoOffset, batch.vaoSize);
                         p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaG));
                         glColorMask(GL_FALSE, GL_TRUE, GL_FALSE, GL_FALSE);
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
+                        p.vao->draw(batch.type, batch.vaoOffset, batch.vaoSize);
                         p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaB));
                         glColorMask(GL_FALSE, GL_FALSE, GL_TRUE, GL_FALSE);
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
+                        p.vao->draw(batch.type, batch.vaoOffset, batch.vaoSize);
+                        p.drawCallsCount += 3;
                     }
                     else
                     {
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
+                        p.vao->draw(batch.type, batch.vaoOffset, batch.vaoSize);
+                        ++p.drawCallsCount;
                     }
                 }
                 glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
                 _clipRects.clear();
                 p.primitives.clear();
+                p.batches.clear();
                 p.vboDataSize = 0;
                 while (p.dynamicTextureCache.size() > dynamicTextureCacheMax)
                 {
@@ -660,6 +841,10 @@ namespace djv
                                     id = p.textureAtlas->addItem(glyph->imageData, item);
                                     p.glyphTextureIDs[uid] = id;
                                 }
+                                if (p.recording)
+                                {
+                                    p.recordAtlasIDs.insert(id);
+                                }
 
                                 if (!primitive || item.textureIndex != textureIndex)
                                 {
@@ -1045,11 +1230,173 @@ namespace djv
                 }
             }
 
+            void Render::beginDrawList()
+            {
+                DJV_PRIVATE_PTR();
+                p.recording = true;
+                p.recordPrimitives = p.primitives.size();
+                p.recordVBODataSize = p.vboDataSize;
+                p.recordClipRects = _clipRects;
+                p.recordClipRect = _currentClipRect;
+                p.recordColorMult = _colorMult;
+                p.recordAlphaMult = _alphaMult;
+                p.recordTransforms = _transforms;
+                _clipRects = { unclipped };
+                _currentClipRect = unclipped;
+                _transforms.clear();
+                setColorMult(1.F);
+                setAlphaMult(1.F);
+            }
+
+            std::shared_ptr<DrawList> Render::endDrawList()
+            {
+                DJV_PRIVATE_PTR();
+                auto out = std::shared_ptr<DrawList>(new DrawList);
+
+                // Move the recorded primitives and vertices to the list.
+                const size_t vertexByteCount = AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
+                const size_t vaoOffset = p.recordVBODataSize / vertexByteCount;
+                for (size_t i = p.recordPrimitives; i < p.primitives.size(); ++i)
+                {
+                    auto primitive = p.primitives[i];
+                    primitive->vaoOffset -= vaoOffset;
+                    out->_p->primitives.push_back(primitive);
+                }
+                out->_p->vboData.assign(
+                    p.vboData.begin() + p.recordVBODataSize,
+                    p.vboData.begin() + p.vboDataSize);
+                const size_t vertexCount = out->_p->vboData.size() / vertexByteCount;
+                const VBOVertex* pData = reinterpret_cast<const VBOVertex*>(out->_p->vboData.data());
+                for (size_t i = 0; i < vertexCount; ++i, ++pData)
+                {
+                    const glm::vec2 v(pData->vx, pData->vy);
+                    if (0 == i)
+                    {
+                        out->_p->bbox = BBox2f(v);
+                    }
+                    else
+                    {
+                        out->_p->bbox.expand(v);
+                    }
+                }
+                out->_p->atlasIDs.assign(p.recordAtlasIDs.begin(), p.recordAtlasIDs.end());
+                out->_p->dynamicTextures.assign(p.recordDynamicTextures.begin(), p.recordDynamicTextures.end());
+                out->_p->colorSpaces.assign(p.recordColorSpaces.begin(), p.recordColorSpaces.end());
+                p.primitives.resize(p.recordPrimitives);
+                p.vboDataSize = p.recordVBODataSize;
+
+                p.recording = false;
+                p.recordAtlasIDs.clear();
+                p.recordDynamicTextures.clear();
+                p.recordColorSpaces.clear();
+                _clipRects = p.recordClipRects;
+                _currentClipRect = p.recordClipRect;
+                _transforms = p.recordTransforms;
+                setColorMult(p.recordColorMult);
+                setAlphaMult(p.recordAlphaMult);
+                return out;
+            }
+
+            bool Render::drawList(const std::shared_ptr<DrawList>& value)
+            {
+                DJV_PRIVATE_PTR();
+                const auto& list = *value->_p;
+
+                // Check that the textures are still available.
+                for (const auto i : list.atlasIDs)
+                {
+                    OpenGL::TextureAtlasItem item;
+                    if (!p.textureAtlas->getItem(i, item))
+                    {
+                        return false;
+                    }
+                }
+                for (const auto& i : list.dynamicTextures)
+                {
+                    const auto j = p.dynamicTextureCache.find(i.first);
+                    if (j == p.dynamicTextureCache.end() || j->second->getID() != i.second)
+                    {
+                        return false;
+                    }
+                }
+#if !defined(DJV_OPENGL_ES2)
+                for (const auto i : list.colorSpaces)
+                {
+                    bool found = false;
+                    for (const auto& j : p.colorSpaceCache)
+                    {
+                        if (i == j.second.id)
+                        {
+                            found = true;
+                            break;
+                        }
+                    }
+                    if (!found)
+                    {
+                        return false;
+                    }
+                }
+#endif // DJV_OPENGL_ES2
+
+                const glm::mat3x3& m = _getCurrentTransform();
+                if (list.primitives.size() && transform(list.bbox, m).intersects(_currentClipRect))
+                {
+                    // Copy the vertices, they only need to be transformed.
+                    const size_t vertexByteCount = AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
+                    const size_t vaoOffset = p.vboDataSize / vertexByteCount;
+                    const size_t vboDataOffset = p.vboDataSize;
+                    const size_t vertexCount = list.vboData.size() / vertexByteCount;
+                    p.vboDataSizeUpdate(vertexCount);
+                    memcpy(&p.vboData[vboDataOffset], list.vboData.data(), list.vboData.size());
+                    if (m != _identity)
+                    {
+                        VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataOffset]);
+                        for (size_t i = 0; i < vertexCount; ++i, ++pData)
+                        {
+                            const glm::vec3 v = m * glm::vec3(pData->vx, pData->vy, 1.F);
+                            pData->vx = v.x;
+                            pData->vy = v.y;
+                        }
+                    }
+
+                    for (const auto& i : list.primitives)
+                    {
+                        BBox2f clipRect = _currentClipRect;
+                        if (i->clipRect != unclipped)
+                        {
+                            clipRect = clipRect.intersect(transform(i->clipRect, m));
+                        }
+                        if (clipRect.isValid())
+                        {
+                            auto primitive = i->copy();
+                            primitive->clipRect = clipRect;
+                            primitive->color[0] *= _colorMult;
+                            primitive->color[1] *= _colorMult;
+                            primitive->color[2] *= _colorMult;
+                            primitive->color[3] *= _alphaMult;
+                            primitive->vaoOffset += vaoOffset;
+                            p.addPrimitive(primitive);
+                        }
+                    }
+                }
+                return true;
+            }
+
             size_t Render::getPrimitivesCount() const
             {
                 return _p->primitivesCount;
             }
 
+            size_t Render::getDrawCallsCount() const
+            {
+                return _p->drawCallsCount;
+            }
+
+            size_t Render::getStateChangesCount() const
+            {
+                return _p->stateChangesCount;
+            }
+
             float Render::getTextureAtlasPercentage() const
             {
                 return _p->textureAtlas->getPercentageUsed();
@@ -1090,6 +1437,150 @@ namespace djv
                 }
             }
 
+            void Render::Private::addPrimitive(const std::shared_ptr<Primitive>& value)
+            {
+                // Only triangles can be merged, and not with primitives that
+                // are being recorded to a draw list.
+                if (primitives.size() > (recording ? recordPrimitives : 0))
+                {
+                    auto& prev = primitives.back();
+                    if (GL_TRIANGLES == prev->type &&
+                        GL_TRIANGLES == value->type &&
+                        prev->vaoOffset + prev->vaoSize == value->vaoOffset &&
+                        prev->clipRect == value->clipRect &&
+                        prev->isSameState(*value))
+                    {
+                        prev->vaoSize += value->vaoSize;
+                        return;
+                    }
+                }
+                primitives.push_back(value);
+            }
+
+            void Render::Private::batchesUpdate(const Image::Size& size)
+            {
+                const size_t vertexByteCount = AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
+                const BBox2f frameRect(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+                batches.clear();
+                primitiveBatches.resize(primitives.size());
+                for (size_t i = 0; i < primitives.size(); ++i)
+                {
+                    const auto& primitive = primitives[i];
+                    primitiveBatches[i] = batchNone;
+
+                    // Get the area of the frame buffer drawn by the primitive.
+                    if (!primitive->vaoSize)
+                        continue;
+                    const VBOVertex* pData = reinterpret_cast<const VBOVertex*>(&vboData[primitive->vaoOffset * vertexByteCount]);
+                    BBox2f bbox(glm::vec2(pData->vx, pData->vy));
+                    ++pData;
+                    for (size_t j = 1; j < primitive->vaoSize; ++j, ++pData)
+                    {
+                        bbox.expand(glm::vec2(pData->vx, pData->vy));
+                    }
+                    const BBox2f scissorRect = getScissorRect(primitive->clipRect, size);
+                    const BBox2f drawRect = bbox.intersect(scissorRect);
+                    if (!drawRect.isValid())
+                        continue;
+
+                    // Primitives that are not clipped can be drawn with any
+                    // clipping rectangle that contains them.
+                    const bool clipped = !scissorRect.contains(bbox);
+                    const BBox2f& clipRect = clipped ? primitive->clipRect : frameRect;
+
+                    // Search for a batch with the same state. Stop at the
+                    // first batch that overlaps the primitive, since the
+                    // primitive must be drawn after it.
+                    size_t batch = batchNone;
+                    for (size_t j = batches.size(), k = 0; j > 0 && k < batchSearchMax; --j, ++k)
+                    {
+                        const auto& b = batches[j - 1];
+                        if (isTriangles(b.primitive->type) &&
+                            isTriangles(primitive->type) &&
+                            (b.clipRect == clipRect || (!clipped && b.scissorRect.contains(bbox))) &&
+                            b.primitive->isSameState(*primitive))
+                        {
+                            batch = j - 1;
+                            break;
+                        }
+                        if (b.bbox.intersects(drawRect))
+                            break;
+                    }
+                    if (batch != batchNone)
+                    {
+                        auto& b = batches[batch];
+                        b.bbox.expand(drawRect);
+                        ++b.count;
+                        b.vaoSize += primitive->vaoSize;
+                        b.trianglesSize += getTrianglesSize(*primitive);
+                    }
+                    else
+                    {
+                        Batch b;
+                        b.primitive = primitive;
+                        b.clipRect = clipRect;
+                        b.scissorRect = getScissorRect(clipRect, size);
+                        b.bbox = drawRect;
+                        b.count = 1;
+                        b.vaoSize = primitive->vaoSize;
+                        b.trianglesSize = getTrianglesSize(*primitive);
+                        batch = batches.size();
+                        batches.push_back(b);
+                    }
+                    primitiveBatches[i] = batch;
+                }
+
+                // Batches of more than one primitive are drawn as separate
+                // triangles.
+                size_t vaoOffset = 0;
+                for (auto& i : batches)
+                {
+                    if (i.count > 1)
+                    {
+                        i.type = GL_TRIANGLES;
+                        i.vaoSize = i.trianglesSize;
+                    }
+                    else
+                    {
+                        i.type = i.primitive->type;
+                    }
+                    i.vaoOffset = vaoOffset;
+                    i.vaoCursor = vaoOffset;
+                    vaoOffset += i.vaoSize;
+                }
+
+                // Copy the vertices in batch order.
+                batchVBODataSize = vaoOffset * vertexByteCount;
+                if (batchVBODataSize > batchVBOData.size())
+                {
+                    batchVBOData.resize(batchVBODataSize);
+                }
+                for (size_t i = 0; i < primitives.size(); ++i)
+                {
+                    if (batchNone == primitiveBatches[i])
+                        continue;
+                    const auto& primitive = primitives[i];
+                    auto& batch = batches[primitiveBatches[i]];
+                    const uint8_t* in = &vboData[primitive->vaoOffset * vertexByteCount];
+                    uint8_t* out = &batchVBOData[batch.vaoCursor * vertexByteCount];
+                    if (GL_TRIANGLES == batch.type && GL_TRIANGLE_STRIP == primitive->type)
+                    {
+                        // Each triangle of a strip is three consecutive vertices.
+                        for (size_t j = 2; j < primitive->vaoSize; ++j)
+                        {
+                            memcpy(out, in + (j - 2) * vertexByteCount, 3 * vertexByteCount);
+                            out += 3 * vertexByteCount;
+                        }
+                        batch.vaoCursor += getTrianglesSize(*primitive);
+                    }
+                    else
+                    {
+                        memcpy(out, in, primitive->vaoSize * vertexByteCount);
+                        batch.vaoCursor += primitive->vaoSize;
+                    }
+                }
+            }
+
             void Render::Private::drawImage(
                 const std::shared_ptr<Image::Image>& image,
                 const glm::vec2& pos,
@@ -1183,7 +1674,12 @@ namespace djv
                         }
                         if (!textureAtlas->getItem(id, item))
                         {
-                            textureIDs[uid] = textureAtlas->addItem(image, item);
+                            id = textureAtlas->addItem(image, item);
+                            textureIDs[uid] = id;
+                        }
+                        if (recording)
+                        {
+                            recordAtlasIDs.insert(id);
                         }
                         primitive->atlasIndex = item.textureIndex;
                         if (info.layout.mirror.x)
@@ -1232,6 +1728,10 @@ namespace djv
                             dynamicTextureCache[uid] = texture;
                             primitive->textureID = texture->getID();
                         }
+                        if (recording)
+                        {
+                            recordDynamicTextures[uid] = primitive->textureID;
+                        }
                         if (info.layout.mirror.x)
                         {
                             textureU[0] = 1.F;
@@ -1307,6 +1807,10 @@ namespace djv
                             }
                         }
                         primitive->colorSpace = colorSpaceData.id;
+                        if (recording && colorSpaceData.lut3D)
+                        {
+                            recordColorSpaces.insert(colorSpaceData.id);
+                        }
                         primitive->colorSpaceTextureID = colorSpaceData.lut3D ? colorSpaceData.lut3D->getID() : 0;
                     }
 #endif // DJV_OPENGL_ES2
@@ -28,6 +28,32 @@ namespace djv
         //! This namespace provides rendering functionality.
         namespace Render2D
         {
+            class Render;
+
+            //! This class provides a list of primitives that can be drawn
+            //! again without being tessellated.
+            class DrawList
+            {
+                DJV_NON_COPYABLE(DrawList);
+
+            protected:
+                DrawList();
+
+            public:
+                ~DrawList();
+
+                //! Get the bounding box of the primitives.
+                const Core::BBox2f& getBBox() const;
+
+                size_t getPrimitivesCount() const;
+                size_t getVertexCount() const;
+
+            private:
+                DJV_PRIVATE();
+
+                friend class Render;
+            };
+
             //! This class provides a 2D render system.
             class Render : public Core::ISystem
             {
@@ -46,6 +72,12 @@ namespace djv
                 ///@{
 
                 void beginFrame(const Image::Size&);
+
+                //! Begin a frame that only updates the given areas of the frame
+                //! buffer. The rest of the frame buffer is kept from the
+                //! previous frame.
+                void beginFrame(const Image::Size&, const std::vector<Core::BBox2f>&);
+
                 void endFrame();
 
                 ///@}
@@ -137,10 +169,32 @@ namespace djv
 
                 ///@}
 
+                //! \name Draw Lists
+                //! The primitives drawn between beginDrawList() and
+                //! endDrawList() are recorded instead of being drawn. They are
+                //! recorded without the transform or clipping rectangle, and
+                //! with color and alpha multipliers of one. When the list is
+                //! drawn the vertices are transformed by the current transform,
+                //! and the current clipping rectangle and multipliers are
+                //! applied.
+                ///@{
+
+                void beginDrawList();
+                std::shared_ptr<DrawList> endDrawList();
+
+                //! Draw a list. Returns false if the list uses textures that
+                //! are no longer available, in which case it needs to be
+                //! recorded again.
+                bool drawList(const std::shared_ptr<DrawList>&);
+
+                ///@}
+
                 //! \name Diagnostics
                 ///@{
 
                 size_t getPrimitivesCount() const;
+                size_t getDrawCallsCount() const;
+                size_t getStateChangesCount() const;
                 float getTextureAtlasPercentage() const;
                 size_t getDynamicTextureCount() const;
                 size_t getVBOSize() const;
@@ -4,6 +4,8 @@
 
 #include <djvAV/Render2DPrivate.h>
 
+#include <typeinfo>
+
 using namespace djv::Core;
 
 namespace djv
@@ -15,12 +17,41 @@ namespace djv
             Primitive::~Primitive()
             {}
 
+            std::shared_ptr<Primitive> Primitive::copy() const
+            {
+                return std::make_shared<Primitive>(*this);
+            }
+
+            bool Primitive::isSameState(const Primitive& other) const
+            {
+                return
+                    typeid(*this) == typeid(other) &&
+                    color[0] == other.color[0] &&
+                    color[1] == other.color[1] &&
+                    color[2] == other.color[2] &&
+                    color[3] == other.color[3] &&
+                    alphaBlend == other.alphaBlend &&
+                    textLCDRendering == other.textLCDRendering;
+            }
+
             void Primitive::bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader)
             {
                 shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::SolidColor));
                 shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
             }
 
+            std::shared_ptr<Primitive> TextPrimitive::copy() const
+            {
+                return std::make_shared<TextPrimitive>(*this);
+            }
+
+            bool TextPrimitive::isSameState(const Primitive& other) const
+            {
+                return
+                    Primitive::isSameState(other) &&
+                    atlasIndex == static_cast<const TextPrimitive&>(other).atlasIndex;
+            }
+
             void TextPrimitive::bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader)
             {
                 if (!textLCDRendering)
@@ -31,6 +62,41 @@ namespace djv
                 shader->setUniform(data.textureSamplerLoc, static_cast<int>(atlasIndex));
             }
 
+            std::shared_ptr<Primitive> ImagePrimitive::copy() const
+            {
+                return std::make_shared<ImagePrimitive>(*this);
+            }
+
+            bool ImagePrimitive::isSameState(const Primitive& other) const
+            {
+                if (!Primitive::isSameState(other))
+                    return false;
+                const auto& image = static_cast<const ImagePrimitive&>(other);
+                return
+                    colorMode == image.colorMode &&
+                    imageChannels == image.imageChannels &&
+#if !defined(DJV_OPENGL_ES2)
+                    colorSpace == image.colorSpace &&
+                    colorSpaceTextureID == image.colorSpaceTextureID &&
+#endif // DJV_OPENGL_ES2
+                    colorMatrixEnabled == image.colorMatrixEnabled &&
+                    (!colorMatrixEnabled || colorMatrix == image.colorMatrix) &&
+                    colorInvert == image.colorInvert &&
+                    levelsEnabled == image.levelsEnabled &&
+                    (!levelsEnabled || levels == image.levels) &&
+                    exposureEnabled == image.exposureEnabled &&
+                    (!exposureEnabled || (
+                        exposureV == image.exposureV &&
+                        exposureD == image.exposureD &&
+                        exposureK == image.exposureK &&
+                        exposureF == image.exposureF)) &&
+                    softClip == image.softClip &&
+                    imageChannelDisplay == image.imageChannelDisplay &&
+                    imageCache == image.imageCache &&
+                    atlasIndex == image.atlasIndex &&
+                    textureID == image.textureID;
+            }
+
             void ImagePrimitive::bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader)
             {
                 shader->setUniform(data.colorModeLoc, static_cast<int>(colorMode));
@@ -84,12 +150,32 @@ namespace djv
                 }
             }
 
+            std::shared_ptr<Primitive> ShadowPrimitive::copy() const
+            {
+                return std::make_shared<ShadowPrimitive>(*this);
+            }
+
             void ShadowPrimitive::bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader)
             {
                 shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::Shadow));
                 shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
             }
 
+            std::shared_ptr<Primitive> TexturePrimitive::copy() const
+            {
+                return std::make_shared<TexturePrimitive>(*this);
+            }
+
+            bool TexturePrimitive::isSameState(const Primitive& other) const
+            {
+                if (!Primitive::isSameState(other))
+                    return false;
+                const auto& texture = static_cast<const TexturePrimitive&>(other);
+                return
+                    textureID == texture.textureID &&
+                    target == texture.target;
+            }
+
             void TexturePrimitive::bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader)
             {
                 shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::ColorAndTexture));
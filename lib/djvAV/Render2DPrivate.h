@@ -22,6 +22,7 @@ namespace djv
             const uint16_t textureAtlasSize       = 8192;
             const size_t   dynamicTextureCount    = 16;
             const size_t   dynamicTextureCacheMax = 16;
+            const size_t   batchSearchMax         = 64;
 #if !defined(DJV_OPENGL_ES2)
             const size_t   lut3DSize              = 32;
             const size_t   colorSpaceCacheMax     = 32;
@@ -88,6 +89,12 @@ namespace djv
                 AlphaBlend   alphaBlend         = AlphaBlend::Straight;
                 bool         textLCDRendering   = false;
 
+                virtual std::shared_ptr<Primitive> copy() const;
+
+                //! Get whether the primitive uses the same state as another
+                //! primitive, so that they can be drawn together.
+                virtual bool isSameState(const Primitive&) const;
+
                 virtual void bind(const PrimitiveData&, const std::shared_ptr<OpenGL::Shader>&);
             };
 
@@ -97,6 +104,8 @@ namespace djv
             public:
                 uint8_t atlasIndex = 0;
 
+                std::shared_ptr<Primitive> copy() const override;
+                bool isSameState(const Primitive&) const override;
                 void bind(const PrimitiveData&, const std::shared_ptr<OpenGL::Shader>&) override;
             };
 
@@ -126,6 +135,8 @@ namespace djv
                 uint8_t             atlasIndex          = 0;
                 GLuint              textureID           = 0;
 
+                std::shared_ptr<Primitive> copy() const override;
+                bool isSameState(const Primitive&) const override;
                 void bind(const PrimitiveData&, const std::shared_ptr<OpenGL::Shader>&) override;
             };
 
@@ -133,6 +144,7 @@ namespace djv
             class ShadowPrimitive : public Primitive
             {
             public:
+                std::shared_ptr<Primitive> copy() const override;
                 void bind(const PrimitiveData&, const std::shared_ptr<OpenGL::Shader>&) override;
             };
 
@@ -143,6 +155,8 @@ namespace djv
                 GLuint textureID    = 0;
                 GLenum target       = GL_TEXTURE_2D;
 
+                std::shared_ptr<Primitive> copy() const override;
+                bool isSameState(const Primitive&) const override;
                 void bind(const PrimitiveData&, const std::shared_ptr<OpenGL::Shader>&) override;
             };
 
@@ -5,21 +5,18 @@
 #include <djvAV/SequenceIO.h>
 
 #include <djvAV/ImageConvert.h>
+#include <djvAV/ImageResample.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/LogSystem.h>
-#include <djvCore/OS.h>
 #include <djvCore/Path.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
 #include <future>
 
 using namespace djv::Core;
@@ -47,7 +44,9 @@ namespace djv
             {
                 Frame::Number frame = Frame::invalid;
                 std::promise<Info> infoPromise;
-                std::vector<std::future<Future> > cacheFutures;
+                std::shared_ptr<ThreadPool> threadPool;
+                std::shared_ptr<TaskQueue> taskQueue;
+                std::map<Frame::Index, std::future<Future> > cacheFutures;
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
                 Frame::Number seek = Frame::invalid;
@@ -59,12 +58,21 @@ namespace djv
             void ISequenceRead::_init(
                 const FileSystem::FileInfo& fileInfo,
                 const ReadOptions& options,
+                const std::shared_ptr<ThreadPool>& threadPool,
                 const std::shared_ptr<TextSystem>& textSystem,
                 const std::shared_ptr<ResourceSystem>& resourceSystem,
                 const std::shared_ptr<LogSystem>& logSystem)
             {
                 IRead::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _speed = Time::fromSpeed(Time::getDefaultSpeed());
+
+                // Frames are read by the shared thread pool. A private pool is
+                // only created when the reader is used without the I/O system,
+                // and it is owned by the reader so that it is not destroyed by
+                // one of its own threads.
+                _p->threadPool = threadPool ? threadPool : ThreadPool::create(_threadCount);
+                _p->taskQueue = _p->threadPool->createQueue();
+
                 _p->running = true;
                 _p->thread = std::thread(
                     [this]
@@ -96,6 +104,14 @@ namespace djv
                     {
                         info = _readInfo(fileName);
                         info.fileName = _fileInfo.getFileName();
+                        if (_options.proxyScale != ProxyScale::None && !_hasProxySupport())
+                        {
+                            for (auto& i : info.video)
+                            {
+                                i.size = getProxySize(i.size, _options.proxyScale);
+                                i.layout = Image::Layout();
+                            }
+                        }
                         p.infoPromise.set_value(info);
                     }
                     catch (const std::exception&)
@@ -106,6 +122,7 @@ namespace djv
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 _videoQueue.setFinished(true);
                                 _audioQueue.setFinished(true);
+                                _queueCV.notify_all();
                             }
                             p.running = false;
                             p.infoPromise.set_exception(std::current_exception());
@@ -141,12 +158,25 @@ namespace djv
                         {
                             _cache.clear();
                         }
+                        size_t cacheRequiredByteCount = 0;
                         if (info.video.size() && _options.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].getDataByteCount();
+                            // Use the average size of the cached images since the
+                            // images in a sequence are not necessarily the same size.
+                            const size_t cacheCount = _cache.getCount();
+                            const size_t dataByteCount = cacheCount ?
+                                (_cache.getTotalByteCount() / cacheCount) :
+                                info.video[_options.layer].getDataByteCount();
+                            const size_t sequenceSize = info.videoSequence.getFrameCount();
                             _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
-                            _cache.setSequenceSize(info.videoSequence.getFrameCount());
+                            _cache.setMaxByteCount(cacheMaxByteCount);
+                            _cache.setSequenceSize(sequenceSize);
                             _cache.setInOutPoints(inOutPoints);
+                            if (sequenceSize > 1)
+                            {
+                                const auto range = inOutPoints.getRange(sequenceSize);
+                                cacheRequiredByteCount = (range.getMax() - range.getMin() + 1) * dataByteCount;
+                            }
                         }
                         else
                         {
@@ -172,6 +202,7 @@ namespace djv
                                     p.direction = _direction;
                                     _videoQueue.setFinished(false);
                                     _videoQueue.clearFrames();
+                                    p.taskQueue->cancel(TaskPriority::Cache);
                                 }
                                 if (p.seek != Frame::invalid)
                                 {
@@ -179,6 +210,7 @@ namespace djv
                                     p.seek = Frame::invalid;
                                     _videoQueue.setFinished(false);
                                     _videoQueue.clearFrames();
+                                    p.taskQueue->cancel(TaskPriority::Cache);
                                 }
                             }
                         }
@@ -217,6 +249,8 @@ namespace djv
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 _cacheByteCount = cacheByteCount;
+                                _cacheRequiredByteCount = cacheRequiredByteCount;
+                                _cacheStats = _cache.getStats();
                                 _cacheSequence = cacheSequence;
                                 _cachedFrames = std::move(cachedFrames);
                             }
@@ -260,6 +294,11 @@ namespace djv
                 return _sequence.getFrameCount() > 1;
             }
 
+            bool ISequenceRead::_hasProxySupport() const
+            {
+                return false;
+            }
+
             void ISequenceRead::_finish()
             {
                 DJV_PRIVATE_PTR();
@@ -269,6 +308,18 @@ namespace djv
                     //! \todo How do we safely detach the thread here so we don't block?
                     p.thread.join();
                 }
+
+                // Cancel the pending cache requests and wait for the ones that
+                // are still running, since they reference this object.
+                p.taskQueue->cancel();
+                for (auto& i : p.cacheFutures)
+                {
+                    if (i.second.valid())
+                    {
+                        i.second.wait();
+                    }
+                }
+                p.cacheFutures.clear();
             }
 
             bool ISequenceRead::_hasWork() const
@@ -285,10 +336,10 @@ namespace djv
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName, TaskPriority priority)
             {
-                return std::async(
-                    std::launch::async,
+                return _p->taskQueue->add<Future>(
+                    priority,
                     [this, i, fileName]
                     {
                         Future out;
@@ -296,6 +347,24 @@ namespace djv
                         try
                         {
                             out.image = _readImage(fileName);
+
+                            // Memory mapped images are detached before they are
+                            // added to the cache and shared with other threads.
+                            if (out.image)
+                            {
+                                out.image->detach();
+                            }
+                            if (out.image && _options.proxyScale != ProxyScale::None && !_hasProxySupport())
+                            {
+                                auto info = out.image->getInfo();
+                                info.size = getProxySize(info.size, _options.proxyScale);
+                                info.layout = Image::Layout();
+                                auto image = Image::Image::create(info);
+                                image->setPluginName(out.image->getPluginName());
+                                image->setTags(out.image->getTags());
+                                Image::resample(*out.image, *image, Image::ResampleFilter::Box);
+                                out.image = image;
+                            }
                         }
                         catch (const std::exception& e)
                         {
@@ -331,13 +400,13 @@ namespace djv
                             {
                                 const Frame::Number frameNumber = _sequence.getFrame(p.frame);
                                 const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                futures.push_back(_getFuture(p.frame, fileName, TaskPriority::Queue));
                             }
                         }
                         else
                         {
                             const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            futures.push_back(_getFuture(p.frame, fileName, TaskPriority::Queue));
                         }
                     }
 
@@ -371,9 +440,6 @@ namespace djv
                     images.push_back(std::make_pair(result.frame, result.image));
                     if (cacheEnabled)
                     {
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
                         _cache.add(result.frame, result.image);
                     }
                 }
@@ -389,12 +455,14 @@ namespace djv
                         }
                         _videoQueue.addFrame(VideoFrame(i.first, i.second));
                     }
+                    _queueCV.notify_all();
                 }
 
                 if (Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceFrameCount))
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
                     _videoQueue.setFinished(true);
+                    _queueCV.notify_all();
                 }
 
                 return futures.size();
@@ -420,6 +488,13 @@ namespace djv
                     _cache.setDirection(p.direction);
                     _cache.setCurrentFrame(frame);
                     const size_t readBehind = _cache.getReadBehind();
+
+                    // Stop requesting frames once the byte budget would be exceeded,
+                    // otherwise the frames at the end of the cache would be evicted
+                    // and read again in a loop.
+                    const size_t cacheCount = _cache.getCount();
+                    const size_t frameByteCount = cacheCount ? (_cache.getTotalByteCount() / cacheCount) : 0;
+                    const size_t maxByteCount = _cache.getMaxByteCount();
                     switch (p.direction)
                     {
                     case Direction::Forward:
@@ -433,12 +508,25 @@ namespace djv
                             }
                         }
                         const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
+                        size_t byteCount = 0;
                         for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (_cache.contains(frame))
                             {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                byteCount += _cache.getByteCount(frame);
+                            }
+                            else
+                            {
+                                byteCount += frameByteCount;
+                                if (maxByteCount && byteCount > maxByteCount)
+                                {
+                                    break;
+                                }
+                                if (p.cacheFutures.find(frame) == p.cacheFutures.end())
+                                {
+                                    const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
+                                    p.cacheFutures[frame] = _getFuture(frame, fileName, TaskPriority::Cache);
+                                }
                             }
                             ++frame;
                             if (frame > range.getMax())
@@ -459,12 +547,25 @@ namespace djv
                             }
                         }
                         const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
+                        size_t byteCount = 0;
                         for (Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (_cache.contains(frame))
                             {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                byteCount += _cache.getByteCount(frame);
+                            }
+                            else
+                            {
+                                byteCount += frameByteCount;
+                                if (maxByteCount && byteCount > maxByteCount)
+                                {
+                                    break;
+                                }
+                                if (p.cacheFutures.find(frame) == p.cacheFutures.end())
+                                {
+                                    const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
+                                    p.cacheFutures[frame] = _getFuture(frame, fileName, TaskPriority::Cache);
+                                }
                             }
                             --frame;
                             if (frame < range.getMin())
@@ -482,14 +583,18 @@ namespace djv
                 auto i = p.cacheFutures.begin();
                 while (i != p.cacheFutures.end())
                 {
-                    if (i->valid() &&
-                        i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    if (i->second.valid() &&
+                        i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        const auto result = i->get();
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        try
+                        {
+                            const auto result = i->second.get();
+                            _cache.add(result.frame, result.image);
+                        }
+                        catch (const std::future_error&)
+                        {
+                            // The request was cancelled.
+                        }
                         i = p.cacheFutures.erase(i);
                     }
                     else
@@ -503,7 +608,6 @@ namespace djv
             {
                 FileSystem::FileInfo fileInfo;
                 Frame::Number frameNumber = Frame::invalid;
-                GLFWwindow * glfwWindow = nullptr;
                 std::shared_ptr<Image::Convert> convert;
                 std::thread thread;
                 std::atomic<bool> running;
@@ -537,27 +641,6 @@ namespace djv
                     }
                 }
 
-#if defined(DJV_OPENGL_ES2)
-                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-#else // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
-                {
-                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-                }
-                p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
-                if (!p.glfwWindow)
-                {
-                    throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
-                }
-
                 p.running = true;
                 p.thread = std::thread(
                     [this]
@@ -565,16 +648,8 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     try
                     {
-                        glfwMakeContextCurrent(p.glfwWindow);
-#if defined(DJV_OPENGL_ES2)
-                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
-#else
-                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-#endif
-                        {
-                            throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
-                        }
-
+                        // There is no OpenGL context on this thread so the
+                        // images are converted on the CPU.
                         p.convert = Image::Convert::create(_resourceSystem);
 
                         const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
@@ -713,10 +788,6 @@ namespace djv
                     //! \todo How do we safely detach the thread here so we don't block?
                     p.thread.join();
                 }
-                if (p.glfwWindow)
-                {
-                    glfwDestroyWindow(p.glfwWindow);
-                }
             }
 
             ISequencePlugin::~ISequencePlugin()
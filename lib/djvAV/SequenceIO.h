@@ -23,6 +23,7 @@ namespace djv
                 void _init(
                     const Core::FileSystem::FileInfo&,
                     const ReadOptions&,
+                    const std::shared_ptr<ThreadPool>&,
                     const std::shared_ptr<Core::TextSystem>&,
                     const std::shared_ptr<Core::ResourceSystem>&,
                     const std::shared_ptr<Core::LogSystem>&);
@@ -39,6 +40,12 @@ namespace djv
             protected:
                 virtual Info _readInfo(const std::string& fileName) = 0;
                 virtual std::shared_ptr<Image::Image> _readImage(const std::string& fileName) = 0;
+
+                //! Get whether the reader decodes proxy images itself. Otherwise the
+                //! information is adjusted to the proxy size and the images are
+                //! resampled after reading.
+                virtual bool _hasProxySupport() const;
+
                 void _finish();
 
                 Core::Math::Rational _speed;
@@ -48,7 +55,7 @@ namespace djv
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName);
+                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName, TaskPriority);
                 size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
                 void _readCache(size_t count, const AV::IO::InOutPoints&);
 
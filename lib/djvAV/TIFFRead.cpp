@@ -6,9 +6,13 @@
 
 #include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -33,6 +37,7 @@ namespace djv
                     ::TIFF * f           = nullptr;
                     bool     compression = false;
                     bool     palette     = false;
+                    bool     contiguous  = true;
                     uint16 * colormap[3] = { nullptr, nullptr, nullptr };
                 };
 
@@ -47,12 +52,13 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -69,6 +75,61 @@ namespace djv
                     const auto info = _open(fileName, f);
                     out = Image::Image::create(info.video[0]);
                     out->setPluginName(pluginName);
+
+                    // Compressed strips are decoded in parallel by the idle threads
+                    // of the pool. The calling thread uses the open handle, the other
+                    // threads open their own since a handle cannot be shared.
+                    const uint32 stripCount = TIFFNumberOfStrips(f.f);
+                    uint32 rowsPerStrip = 0;
+                    TIFFGetFieldDefaulted(f.f, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+                    const size_t scanlineByteCount = out->getScanlineByteCount();
+                    if (f.compression &&
+                        f.contiguous &&
+                        !TIFFIsTiled(f.f) &&
+                        stripCount > 1 &&
+                        rowsPerStrip > 0 &&
+                        static_cast<size_t>(TIFFScanlineSize(f.f)) == scanlineByteCount)
+                    {
+                        const uint16_t h = info.video[0].size.h;
+                        const auto threadID = std::this_thread::get_id();
+                        ::TIFF* tiff = f.f;
+                        std::atomic<bool> valid(true);
+                        ThreadPool::parallel(
+                            stripCount,
+                            out->getDataByteCount(),
+                            [fileName, out, h, rowsPerStrip, scanlineByteCount, threadID, tiff, &valid](size_t strip0, size_t strip1)
+                            {
+                                File f;
+                                if (std::this_thread::get_id() != threadID)
+                                {
+                                    f.f = TIFFOpen(fileName.data(), "r");
+                                    if (!f.f)
+                                    {
+                                        valid = false;
+                                        return;
+                                    }
+                                }
+                                ::TIFF* t = f.f ? f.f : tiff;
+                                for (size_t strip = strip0; strip < strip1; ++strip)
+                                {
+                                    const uint32 y = static_cast<uint32>(strip) * rowsPerStrip;
+                                    const uint32 rows = std::min(rowsPerStrip, h - y);
+                                    if (TIFFReadEncodedStrip(t, static_cast<uint32>(strip), out->getData(y), rows * scanlineByteCount) == -1)
+                                    {
+                                        valid = false;
+                                        return;
+                                    }
+                                }
+                            });
+                        if (!valid)
+                        {
+                            throw FileSystem::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
+                        }
+                        return out;
+                    }
+
                     for (uint16_t y = 0; y < info.video[0].size.h; ++y)
                     {
                         if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
@@ -165,6 +226,7 @@ namespace djv
 
                     f.compression = compression != COMPRESSION_NONE;
                     f.palette = PHOTOMETRIC_PALETTE == photometric;
+                    f.contiguous = channels != PLANARCONFIG_SEPARATE;
 
                     AV::Tags tags;
                     char * tag = 0;
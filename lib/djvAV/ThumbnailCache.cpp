@@ -0,0 +1,650 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ThumbnailCache.h>
+
+#include <djvAV/IO.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/StringFormat.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            const std::string fileMagic      = "djvthumbnail";
+            const std::string fileExtension  = ".djvthumbnail";
+            const std::string indexMagic     = "djvthumbnailindex";
+            const std::string indexFileName  = "index.djvthumbnailindex";
+            const uint32_t    fileVersion    = 1;
+
+            //! When the cache is too large, entries are removed until it is below
+            //! this fraction of the maximum size, so that the cache is not pruned
+            //! again for every new entry.
+            const float pruneFraction = .9F;
+
+            enum class EntryType : uint8_t
+            {
+                Info,
+                Image
+            };
+
+            struct Entry
+            {
+                size_t   byteCount = 0;
+                uint64_t time      = 0;
+            };
+
+            size_t getHash(const std::string& key)
+            {
+                return std::hash<std::string>()(key);
+            }
+
+            std::string getEntryFileName(size_t hash)
+            {
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(sizeof(size_t) * 2) << hash;
+                ss << fileExtension;
+                return ss.str();
+            }
+
+            void writeU64(FileSystem::FileIO& io, uint64_t value)
+            {
+                io.writeU32(static_cast<uint32_t>(value & 0xffffffff));
+                io.writeU32(static_cast<uint32_t>(value >> 32));
+            }
+
+            uint64_t readU64(FileSystem::FileIO& io)
+            {
+                uint32_t value[2] = { 0, 0 };
+                io.readU32(value, 2);
+                return static_cast<uint64_t>(value[0]) | (static_cast<uint64_t>(value[1]) << 32);
+            }
+
+            void writeString(FileSystem::FileIO& io, const std::string& value)
+            {
+                io.writeU32(static_cast<uint32_t>(value.size()));
+                io.write(value);
+            }
+
+            std::string readString(FileSystem::FileIO& io)
+            {
+                uint32_t size = 0;
+                io.readU32(&size);
+                if (size > io.getSize() - io.getPos())
+                {
+                    //! \todo How can we translate this?
+                    throw FileSystem::Error(String::Format("{0}: Cannot read the string.").arg(io.getFileName()));
+                }
+                std::string out(size, 0);
+                if (size)
+                {
+                    io.read(&out[0], size);
+                }
+                return out;
+            }
+
+            void writeTags(FileSystem::FileIO& io, const Tags& value)
+            {
+                io.writeU32(static_cast<uint32_t>(value.getCount()));
+                for (const auto& i : value.getTags())
+                {
+                    writeString(io, i.first);
+                    writeString(io, i.second);
+                }
+            }
+
+            Tags readTags(FileSystem::FileIO& io)
+            {
+                Tags out;
+                uint32_t count = 0;
+                io.readU32(&count);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const std::string key = readString(io);
+                    out.setTag(key, readString(io));
+                }
+                return out;
+            }
+
+            void writeImageInfo(FileSystem::FileIO& io, const Image::Info& value)
+            {
+                writeString(io, value.name);
+                io.writeU16(value.size.w);
+                io.writeU16(value.size.h);
+                io.writeF32(value.pixelAspectRatio);
+                io.writeU8(static_cast<uint8_t>(value.type));
+                io.writeU8(value.layout.mirror.x);
+                io.writeU8(value.layout.mirror.y);
+                io.writeU8(static_cast<uint8_t>(value.layout.alignment));
+                io.writeU8(static_cast<uint8_t>(value.layout.endian));
+                writeString(io, value.codec);
+            }
+
+            Image::Info readImageInfo(FileSystem::FileIO& io)
+            {
+                Image::Info out;
+                out.name = readString(io);
+                io.readU16(&out.size.w);
+                io.readU16(&out.size.h);
+                io.readF32(&out.pixelAspectRatio);
+                uint8_t data[5] = { 0, 0, 0, 0, 0 };
+                io.readU8(data, 5);
+                out.type = static_cast<Image::Type>(data[0]);
+                out.layout.mirror.x = data[1] != 0;
+                out.layout.mirror.y = data[2] != 0;
+                out.layout.alignment = data[3];
+                out.layout.endian = static_cast<Memory::Endian>(data[4]);
+                out.codec = readString(io);
+                return out;
+            }
+
+            void writeAudioInfo(FileSystem::FileIO& io, const Audio::Info& value)
+            {
+                writeString(io, value.name);
+                io.writeU8(value.channelCount);
+                io.writeU8(static_cast<uint8_t>(value.type));
+                io.writeU32(static_cast<uint32_t>(value.sampleRate));
+                writeU64(io, value.sampleCount);
+                writeString(io, value.codec);
+            }
+
+            Audio::Info readAudioInfo(FileSystem::FileIO& io)
+            {
+                Audio::Info out;
+                out.name = readString(io);
+                io.readU8(&out.channelCount);
+                uint8_t type = 0;
+                io.readU8(&type);
+                out.type = static_cast<Audio::Type>(type);
+                uint32_t sampleRate = 0;
+                io.readU32(&sampleRate);
+                out.sampleRate = sampleRate;
+                out.sampleCount = static_cast<size_t>(readU64(io));
+                out.codec = readString(io);
+                return out;
+            }
+
+            void writeInfo(FileSystem::FileIO& io, const IO::Info& value)
+            {
+                writeString(io, value.fileName);
+                io.write32(value.videoSpeed.getNum());
+                io.write32(value.videoSpeed.getDen());
+                io.writeU32(static_cast<uint32_t>(value.videoSequence.getPad()));
+                const auto& ranges = value.videoSequence.getRanges();
+                io.writeU32(static_cast<uint32_t>(ranges.size()));
+                for (const auto& i : ranges)
+                {
+                    writeU64(io, static_cast<uint64_t>(i.getMin()));
+                    writeU64(io, static_cast<uint64_t>(i.getMax()));
+                }
+                io.writeU32(static_cast<uint32_t>(value.video.size()));
+                for (const auto& i : value.video)
+                {
+                    writeImageInfo(io, i);
+                }
+                writeAudioInfo(io, value.audio);
+                writeTags(io, value.tags);
+            }
+
+            IO::Info readInfo(FileSystem::FileIO& io)
+            {
+                IO::Info out;
+                out.fileName = readString(io);
+                int32_t speed[2] = { 0, 0 };
+                io.read32(speed, 2);
+                out.videoSpeed = Math::Rational(speed[0], speed[1]);
+                uint32_t pad = 0;
+                io.readU32(&pad);
+                uint32_t count = 0;
+                io.readU32(&count);
+                std::vector<Frame::Range> ranges;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const Frame::Number min = static_cast<Frame::Number>(readU64(io));
+                    const Frame::Number max = static_cast<Frame::Number>(readU64(io));
+                    ranges.push_back(Frame::Range(min, max));
+                }
+                out.videoSequence = Frame::Sequence(ranges, pad);
+                io.readU32(&count);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    out.video.push_back(readImageInfo(io));
+                }
+                out.audio = readAudioInfo(io);
+                out.tags = readTags(io);
+                return out;
+            }
+
+            //! Read the header of an entry file and check that it matches the key.
+            bool readHeader(FileSystem::FileIO& io, const std::string& key, EntryType type)
+            {
+                std::string magic(fileMagic.size(), 0);
+                io.read(&magic[0], magic.size());
+                uint32_t version = 0;
+                io.readU32(&version);
+                uint8_t entryType = 0;
+                io.readU8(&entryType);
+                return
+                    magic == fileMagic &&
+                    fileVersion == version &&
+                    static_cast<uint8_t>(type) == entryType &&
+                    readString(io) == key;
+            }
+
+            void writeHeader(FileSystem::FileIO& io, const std::string& key, EntryType type)
+            {
+                io.write(fileMagic);
+                io.writeU32(fileVersion);
+                io.writeU8(static_cast<uint8_t>(type));
+                writeString(io, key);
+            }
+
+        } // namespace
+
+        struct ThumbnailCache::Private
+        {
+            FileSystem::Path path;
+            size_t maxByteCount = 0;
+            std::unordered_map<size_t, Entry> entries;
+            size_t byteCount = 0;
+            uint64_t time = 0;
+            bool indexChanged = false;
+        };
+
+        void ThumbnailCache::_init(const FileSystem::Path& path, size_t maxByteCount)
+        {
+            DJV_PRIVATE_PTR();
+            p.path = path;
+            p.maxByteCount = maxByteCount;
+            _readIndex();
+        }
+
+        ThumbnailCache::ThumbnailCache() :
+            _p(new Private)
+        {}
+
+        ThumbnailCache::~ThumbnailCache()
+        {
+            try
+            {
+                writeIndex();
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+        std::shared_ptr<ThumbnailCache> ThumbnailCache::create(const FileSystem::Path& path, size_t maxByteCount)
+        {
+            auto out = std::shared_ptr<ThumbnailCache>(new ThumbnailCache);
+            out->_init(path, maxByteCount);
+            return out;
+        }
+
+        const FileSystem::Path& ThumbnailCache::getPath() const
+        {
+            return _p->path;
+        }
+
+        size_t ThumbnailCache::getMaxByteCount() const
+        {
+            return _p->maxByteCount;
+        }
+
+        size_t ThumbnailCache::getByteCount() const
+        {
+            return _p->byteCount;
+        }
+
+        size_t ThumbnailCache::getCount() const
+        {
+            return _p->entries.size();
+        }
+
+        float ThumbnailCache::getPercentageUsed() const
+        {
+            DJV_PRIVATE_PTR();
+            return p.maxByteCount > 0 ? (p.byteCount / static_cast<float>(p.maxByteCount) * 100.F) : 0.F;
+        }
+
+        bool ThumbnailCache::getInfo(const std::string& key, IO::Info& out)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t hash = getHash(key);
+            if (p.entries.find(hash) == p.entries.end())
+                return false;
+            bool found = false;
+            try
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(FileSystem::Path(p.path, getEntryFileName(hash)).get(), FileSystem::FileIO::Mode::Read);
+                if (readHeader(*io, key, EntryType::Info))
+                {
+                    out = readInfo(*io);
+                    found = true;
+                    _touch(hash);
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Remove entries that cannot be read.
+                _remove(hash);
+            }
+            return found;
+        }
+
+        void ThumbnailCache::addInfo(const std::string& key, const IO::Info& value)
+        {
+            DJV_PRIVATE_PTR();
+            _mkdir();
+            const size_t hash = getHash(key);
+            auto io = FileSystem::FileIO::create();
+            io->open(FileSystem::Path(p.path, getEntryFileName(hash)).get(), FileSystem::FileIO::Mode::Write);
+            writeHeader(*io, key, EntryType::Info);
+            writeInfo(*io, value);
+            _add(hash, io->getPos());
+        }
+
+        std::shared_ptr<Image::Image> ThumbnailCache::getImage(const std::string& key)
+        {
+            DJV_PRIVATE_PTR();
+            std::shared_ptr<Image::Image> out;
+            const size_t hash = getHash(key);
+            if (p.entries.find(hash) == p.entries.end())
+                return out;
+            try
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(FileSystem::Path(p.path, getEntryFileName(hash)).get(), FileSystem::FileIO::Mode::Read, true);
+                if (readHeader(*io, key, EntryType::Image))
+                {
+                    const auto info = readImageInfo(*io);
+                    const std::string pluginName = readString(*io);
+                    const auto tags = readTags(*io);
+                    uint32_t byteCount[2] = { 0, 0 };
+                    io->readU32(byteCount, 2);
+                    auto image = Image::Image::create(info);
+                    uLongf size = static_cast<uLongf>(image->getDataByteCount());
+                    if (byteCount[0] != size || byteCount[1] > io->getSize() - io->getPos())
+                    {
+                        //! \todo How can we translate this?
+                        throw FileSystem::Error(String::Format("{0}: Cannot read the image.").arg(io->getFileName()));
+                    }
+                    std::vector<uint8_t> buf;
+                    const uint8_t* data = nullptr;
+                    if (io->isMemoryMapped())
+                    {
+                        data = io->mmapP();
+                    }
+                    else
+                    {
+                        buf.resize(byteCount[1]);
+                        io->read(buf.data(), buf.size());
+                        data = buf.data();
+                    }
+                    if (uncompress(image->getData(), &size, data, byteCount[1]) != Z_OK || size != byteCount[0])
+                    {
+                        //! \todo How can we translate this?
+                        throw FileSystem::Error(String::Format("{0}: Cannot decompress the image.").arg(io->getFileName()));
+                    }
+                    image->setPluginName(pluginName);
+                    image->setTags(tags);
+                    out = image;
+                    _touch(hash);
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Remove entries that cannot be read.
+                _remove(hash);
+            }
+            return out;
+        }
+
+        void ThumbnailCache::addImage(const std::string& key, const std::shared_ptr<Image::Image>& value)
+        {
+            DJV_PRIVATE_PTR();
+            _mkdir();
+            const size_t hash = getHash(key);
+            const std::string fileName = FileSystem::Path(p.path, getEntryFileName(hash)).get();
+
+            // Compress the image data.
+            const uLong byteCount = static_cast<uLong>(value->getDataByteCount());
+            uLongf compressedByteCount = compressBound(byteCount);
+            std::vector<uint8_t> buf(compressedByteCount);
+            if (compress(buf.data(), &compressedByteCount, value->getData(), byteCount) != Z_OK)
+            {
+                //! \todo How can we translate this?
+                throw FileSystem::Error(String::Format("{0}: Cannot compress the image.").arg(fileName));
+            }
+
+            auto io = FileSystem::FileIO::create();
+            io->open(fileName, FileSystem::FileIO::Mode::Write);
+            writeHeader(*io, key, EntryType::Image);
+            writeImageInfo(*io, value->getInfo());
+            writeString(*io, value->getPluginName());
+            writeTags(*io, value->getTags());
+            io->writeU32(static_cast<uint32_t>(byteCount));
+            io->writeU32(static_cast<uint32_t>(compressedByteCount));
+            io->write(buf.data(), compressedByteCount);
+            _add(hash, io->getPos());
+        }
+
+        void ThumbnailCache::writeIndex()
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.indexChanged)
+                return;
+            _mkdir();
+            std::vector<uint32_t> data;
+            data.reserve(p.entries.size() * 5);
+            for (const auto& i : p.entries)
+            {
+                const uint64_t hash = i.first;
+                data.push_back(static_cast<uint32_t>(hash & 0xffffffff));
+                data.push_back(static_cast<uint32_t>(hash >> 32));
+                data.push_back(static_cast<uint32_t>(i.second.byteCount));
+                data.push_back(static_cast<uint32_t>(i.second.time & 0xffffffff));
+                data.push_back(static_cast<uint32_t>(i.second.time >> 32));
+            }
+            auto io = FileSystem::FileIO::create();
+            io->open(FileSystem::Path(p.path, indexFileName).get(), FileSystem::FileIO::Mode::Write);
+            io->write(indexMagic);
+            io->writeU32(fileVersion);
+            writeU64(*io, p.time);
+            io->writeU32(static_cast<uint32_t>(p.entries.size()));
+            io->writeU32(data.data(), data.size());
+            p.indexChanged = false;
+        }
+
+        void ThumbnailCache::clear()
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<size_t> hashes;
+            for (const auto& i : p.entries)
+            {
+                hashes.push_back(i.first);
+            }
+            for (const auto i : hashes)
+            {
+                _remove(i);
+            }
+        }
+
+        void ThumbnailCache::_readIndex()
+        {
+            DJV_PRIVATE_PTR();
+            const FileSystem::Path indexPath(p.path, indexFileName);
+            bool valid = false;
+            if (FileSystem::FileInfo(indexPath).doesExist())
+            {
+                try
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(indexPath.get(), FileSystem::FileIO::Mode::Read, true);
+                    std::string magic(indexMagic.size(), 0);
+                    io->read(&magic[0], magic.size());
+                    uint32_t version = 0;
+                    io->readU32(&version);
+                    const uint64_t time = readU64(*io);
+                    uint32_t count = 0;
+                    io->readU32(&count);
+                    const size_t dataSize = static_cast<size_t>(count) * 5;
+                    if (magic == indexMagic &&
+                        fileVersion == version &&
+                        dataSize * sizeof(uint32_t) == io->getSize() - io->getPos())
+                    {
+                        // Read the entries directly from the memory map when possible.
+                        std::vector<uint32_t> buf;
+                        const uint32_t* data = nullptr;
+                        if (io->isMemoryMapped())
+                        {
+                            data = reinterpret_cast<const uint32_t*>(io->mmapP());
+                        }
+                        else
+                        {
+                            buf.resize(dataSize);
+                            io->readU32(buf.data(), buf.size());
+                            data = buf.data();
+                        }
+                        p.entries.reserve(count);
+                        for (size_t i = 0; i < dataSize; i += 5)
+                        {
+                            uint32_t tmp[5];
+                            memcpy(tmp, data + i, sizeof(tmp));
+                            Entry entry;
+                            entry.byteCount = tmp[2];
+                            entry.time = static_cast<uint64_t>(tmp[3]) | (static_cast<uint64_t>(tmp[4]) << 32);
+                            const uint64_t hash = static_cast<uint64_t>(tmp[0]) | (static_cast<uint64_t>(tmp[1]) << 32);
+                            p.entries[static_cast<size_t>(hash)] = entry;
+                            p.byteCount += entry.byteCount;
+                        }
+                        p.time = time;
+                        valid = true;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    p.entries.clear();
+                    p.byteCount = 0;
+                }
+            }
+            if (!valid && FileSystem::FileInfo(p.path).doesExist())
+            {
+                // Create the index again from the entry files.
+                FileSystem::DirectoryListOptions options;
+                options.fileExtensions.insert(fileExtension);
+                for (const auto& i : FileSystem::FileInfo::directoryList(p.path, options))
+                {
+                    const std::string fileName = i.getFileName(Frame::invalid, false);
+                    std::stringstream ss(fileName.substr(0, fileName.size() - fileExtension.size()));
+                    size_t hash = 0;
+                    ss >> std::hex >> hash;
+                    if (!ss.fail())
+                    {
+                        Entry entry;
+                        entry.byteCount = static_cast<size_t>(i.getSize());
+                        p.entries[hash] = entry;
+                        p.byteCount += entry.byteCount;
+                    }
+                }
+                p.indexChanged = true;
+            }
+        }
+
+        void ThumbnailCache::_mkdir()
+        {
+            DJV_PRIVATE_PTR();
+            if (!FileSystem::FileInfo(p.path).doesExist())
+            {
+                FileSystem::Path parent(p.path);
+                if (parent.cdUp() && !FileSystem::FileInfo(parent).doesExist())
+                {
+                    FileSystem::Path::mkdir(parent);
+                }
+                FileSystem::Path::mkdir(p.path);
+            }
+        }
+
+        void ThumbnailCache::_touch(size_t hash)
+        {
+            DJV_PRIVATE_PTR();
+            const auto i = p.entries.find(hash);
+            if (i != p.entries.end())
+            {
+                i->second.time = ++p.time;
+                p.indexChanged = true;
+            }
+        }
+
+        void ThumbnailCache::_add(size_t hash, size_t byteCount)
+        {
+            DJV_PRIVATE_PTR();
+            auto& entry = p.entries[hash];
+            p.byteCount -= entry.byteCount;
+            entry.byteCount = byteCount;
+            entry.time = ++p.time;
+            p.byteCount += byteCount;
+            p.indexChanged = true;
+            if (p.byteCount > p.maxByteCount)
+            {
+                _prune();
+            }
+        }
+
+        void ThumbnailCache::_remove(size_t hash)
+        {
+            DJV_PRIVATE_PTR();
+            const auto i = p.entries.find(hash);
+            if (i != p.entries.end())
+            {
+                p.byteCount -= i->second.byteCount;
+                p.entries.erase(i);
+                p.indexChanged = true;
+            }
+            try
+            {
+                const FileSystem::Path path(p.path, getEntryFileName(hash));
+                if (FileSystem::FileInfo(path).doesExist())
+                {
+                    FileSystem::Path::rm(path);
+                }
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+        void ThumbnailCache::_prune()
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::pair<uint64_t, size_t> > entries;
+            entries.reserve(p.entries.size());
+            for (const auto& i : p.entries)
+            {
+                entries.push_back(std::make_pair(i.second.time, i.first));
+            }
+            std::sort(entries.begin(), entries.end());
+            const size_t byteCount = static_cast<size_t>(p.maxByteCount * pruneFraction);
+            for (auto i = entries.begin(); i != entries.end() && p.byteCount > byteCount; ++i)
+            {
+                _remove(i->second);
+            }
+        }
+
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            class Path;
+
+        } // namespace FileSystem
+    } // namespace Core
+
+    namespace AV
+    {
+        namespace IO
+        {
+            class Info;
+
+        } // namespace IO
+
+        namespace Image
+        {
+            class Image;
+
+        } // namespace Image
+
+        //! This class provides a disk cache for thumbnail images and file
+        //! information, so they are available immediately the next time the
+        //! application runs.
+        //!
+        //! Each entry is stored in a separate file. The index of the entries is
+        //! read once with a memory map and kept in a hash table. When the cache
+        //! grows larger than the maximum size, the least recently used entries
+        //! are removed.
+        //!
+        //! The keys should identify the contents of the files (for example by
+        //! including the file size and time) so that changed files are not
+        //! found in the cache.
+        //!
+        //! \todo This class is not thread safe.
+        class ThumbnailCache
+        {
+            DJV_NON_COPYABLE(ThumbnailCache);
+
+        protected:
+            void _init(const Core::FileSystem::Path&, size_t maxByteCount);
+            ThumbnailCache();
+
+        public:
+            //! The index is written when the cache is destroyed.
+            ~ThumbnailCache();
+
+            //! Create a new disk cache. The directory, and its parent directory,
+            //! are created when the first entry is added.
+            static std::shared_ptr<ThumbnailCache> create(const Core::FileSystem::Path&, size_t maxByteCount);
+
+            const Core::FileSystem::Path& getPath() const;
+            size_t getMaxByteCount() const;
+            size_t getByteCount() const;
+            size_t getCount() const;
+            float getPercentageUsed() const;
+
+            //! \name File Information
+            ///@{
+
+            //! Get file information from the cache.
+            bool getInfo(const std::string& key, IO::Info&);
+
+            //! Add file information to the cache.
+            //! Throws:
+            //! - Core::FileSystem::Error
+            void addInfo(const std::string& key, const IO::Info&);
+
+            ///@}
+
+            //! \name Images
+            ///@{
+
+            //! Get an image from the cache. A null pointer is returned if the
+            //! image is not in the cache.
+            std::shared_ptr<Image::Image> getImage(const std::string& key);
+
+            //! Add an image to the cache. The image data is compressed.
+            //! Throws:
+            //! - Core::FileSystem::Error
+            void addImage(const std::string& key, const std::shared_ptr<Image::Image>&);
+
+            ///@}
+
+            //! Write the index if it has changed.
+            //! Throws:
+            //! - Core::FileSystem::Error
+            void writeIndex();
+
+            //! Remove all of the entries.
+            void clear();
+
+        private:
+            void _readIndex();
+            void _mkdir();
+            void _touch(size_t hash);
+            void _add(size_t hash, size_t byteCount);
+            void _remove(size_t hash);
+            void _prune();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace AV
+} // namespace djv
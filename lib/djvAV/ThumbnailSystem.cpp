@@ -5,22 +5,25 @@
 #include <djvAV/ThumbnailSystem.h>
 
 #include <djvAV/IOSystem.h>
+#include <djvAV/IOThreadPool.h>
 #include <djvAV/Image.h>
-#include <djvAV/ImageConvert.h>
+#include <djvAV/ImageResample.h>
+#include <djvAV/ThumbnailCache.h>
 
 #include <djvCore/Cache.h>
 #include <djvCore/Context.h>
 #include <djvCore/LogSystem.h>
-#include <djvCore/OS.h>
+#include <djvCore/Memory.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/Speed.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
+#include <rapidjson/writer.h>
 
 #include <atomic>
 #include <mutex>
+#include <sstream>
 #include <thread>
 
 using namespace djv::Core;
@@ -33,9 +36,11 @@ namespace djv
         {
             //! \todo Should this be configurable?
             const size_t infoProcessMax  = 4;
-            const size_t imageProcessMax = 4;
+            const size_t imageProcessMax = 16;
             const size_t infoCacheMax    = 1000;
             const size_t imageCacheMax   = 1000;
+            const size_t imageCacheMaxByteCount = 256 * Memory::megabyte;
+            const size_t diskCacheMaxByteCount  = 512 * Memory::megabyte;
 
             struct InfoRequest
             {
@@ -86,6 +91,7 @@ namespace djv
                     size(std::move(other.size)),
                     type(std::move(other.type)),
                     read(std::move(other.read)),
+                    resampleFuture(std::move(other.resampleFuture)),
                     promise(std::move(other.promise))
                 {}
 
@@ -101,6 +107,7 @@ namespace djv
                         size = std::move(other.size);
                         type = std::move(other.type);
                         read = std::move(other.read);
+                        resampleFuture = std::move(other.resampleFuture);
                         promise = std::move(other.promise);
                     }
                     return *this;
@@ -111,6 +118,7 @@ namespace djv
                 Image::Size size;
                 Image::Type type = Image::Type::None;
                 std::shared_ptr<IO::IRead> read;
+                std::future<std::shared_ptr<Image::Image> > resampleFuture;
                 std::promise<std::shared_ptr<Image::Image> > promise;
             };
 
@@ -118,6 +126,8 @@ namespace djv
             {
                 size_t out = 0;
                 Memory::hashCombine(out, fileInfo.getFileName());
+                Memory::hashCombine(out, fileInfo.getSize());
+                Memory::hashCombine(out, fileInfo.getTime());
                 return out;
             }
 
@@ -125,12 +135,55 @@ namespace djv
             {
                 size_t out = 0;
                 Memory::hashCombine(out, fileInfo.getFileName());
+                Memory::hashCombine(out, fileInfo.getSize());
+                Memory::hashCombine(out, fileInfo.getTime());
                 Memory::hashCombine(out, size.w);
                 Memory::hashCombine(out, size.h);
                 Memory::hashCombine(out, type);
                 return out;
             }
 
+            //! The disk cache keys identify the contents of the files and the
+            //! options used to read them, so that entries for changed files are
+            //! not used. Files that do not exist are not cached on disk.
+            std::string getDiskCacheKey(const FileSystem::FileInfo& fileInfo, size_t optionsKey)
+            {
+                std::stringstream ss;
+                if (fileInfo.doesExist())
+                {
+                    ss << fileInfo.getFileName() << " " << fileInfo.getSize() << " " << fileInfo.getTime() << " " << optionsKey;
+                }
+                return ss.str();
+            }
+
+            std::string getDiskCacheKey(const FileSystem::FileInfo& fileInfo, const Image::Size& size, Image::Type type, size_t optionsKey)
+            {
+                std::string out = getDiskCacheKey(fileInfo, optionsKey);
+                if (!out.empty())
+                {
+                    std::stringstream ss;
+                    ss << " " << size.w << " " << size.h << " " << static_cast<int>(type);
+                    out += ss.str();
+                }
+                return out;
+            }
+
+            size_t getOptionsKey(const std::shared_ptr<IO::System>& io)
+            {
+                size_t out = 0;
+                rapidjson::Document document;
+                for (const auto& i : io->getPluginNames())
+                {
+                    rapidjson::StringBuffer buffer;
+                    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+                    io->getOptions(i, document.GetAllocator()).Accept(writer);
+                    Memory::hashCombine(out, i);
+                    Memory::hashCombine(out, std::string(buffer.GetString()));
+                }
+                Memory::hashCombine(out, Time::getDefaultSpeed());
+                return out;
+            }
+
         } // namespace
         
         ThumbnailSystem::InfoFuture::InfoFuture()
@@ -169,10 +222,13 @@ namespace djv
             std::atomic<float> infoCachePercentage;
             Memory::Cache<size_t, std::shared_ptr<Image::Image> > imageCache;
             std::atomic<float> imageCachePercentage;
+            std::shared_ptr<ThumbnailCache> diskCache;
+            std::atomic<float> diskCachePercentage;
+            std::atomic<size_t> optionsKey;
             std::atomic<bool> clearCache;
             std::shared_ptr<ValueObserver<bool> > ioOptionsObserver;
 
-            GLFWwindow * glfwWindow = nullptr;
+            std::shared_ptr<IO::TaskQueue> taskQueue;
             std::shared_ptr<Time::Timer> statsTimer;
             std::thread thread;
             std::atomic<bool> running;
@@ -191,29 +247,18 @@ namespace djv
             p.infoCache.setMax(infoCacheMax);
             p.infoCachePercentage = 0.F;
             p.imageCache.setMax(imageCacheMax);
+            p.imageCache.setMaxByteCount(imageCacheMaxByteCount);
             p.imageCachePercentage = 0.F;
+            auto resourceSystem = context->getSystemT<ResourceSystem>();
+            p.diskCache = ThumbnailCache::create(
+                FileSystem::Path(resourceSystem->getPath(FileSystem::ResourcePath::Cache), "Thumbnails"),
+                diskCacheMaxByteCount);
+            p.diskCachePercentage = p.diskCache->getPercentageUsed();
+            p.optionsKey = getOptionsKey(p.io);
             p.clearCache = false;
 
-#if defined(DJV_OPENGL_ES2)
-            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-#else // DJV_OPENGL_ES2
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif // DJV_OPENGL_ES2
-            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-            if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
-            {
-                glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-            }
-            p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
-            if (!p.glfwWindow)
-            {
-                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
-            }
+            // The thumbnails are resampled by the I/O thread pool.
+            p.taskQueue = p.io->getThreadPool()->createQueue();
 
             p.statsTimer = Time::Timer::create(context);
             p.statsTimer->setRepeating(true);
@@ -225,32 +270,20 @@ namespace djv
                 std::stringstream ss;
                 {
                     ss << "Info cache: " << p.infoCachePercentage << "%\n";
-                    ss << "Image cache: " << p.imageCachePercentage << '%';
+                    ss << "Image cache: " << p.imageCachePercentage << "%\n";
+                    ss << "Disk cache: " << p.diskCachePercentage << '%';
                 }
                 _log(ss.str());
             });
 
             auto logSystem = context->getSystemT<LogSystem>();
-            auto resourceSystem = context->getSystemT<ResourceSystem>();
             p.running = true;
             p.thread = std::thread(
-                [this, resourceSystem, logSystem]
+                [this, logSystem]
             {
                 DJV_PRIVATE_PTR();
                 try
                 {
-                    glfwMakeContextCurrent(p.glfwWindow);
-#if defined(DJV_OPENGL_ES2)
-                    if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
-#else // DJV_OPENGL_ES2
-                    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-#endif // DJV_OPENGL_ES2
-                    {
-                        throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
-                    }
-
-                    auto convert = Image::Convert::create(resourceSystem);
-
                     const auto timeout = Time::getValue(Time::TimerValue::Medium);
                     while (p.running)
                     {
@@ -280,13 +313,30 @@ namespace djv
                                 imageRequests |= p.imageRequests.size() > 0;
                             }
                         }
+                        if (!infoRequests && !imageRequests)
+                        {
+                            // Write the disk cache index while there is nothing
+                            // else to do.
+                            try
+                            {
+                                p.diskCache->writeIndex();
+                            }
+                            catch (const std::exception& e)
+                            {
+                                logSystem->log("djv::AV::ThumbnailSystem", e.what(), LogLevel::Warning);
+                            }
+                        }
                         if (infoRequests)
                         {
                             _handleInfoRequests();
                         }
                         if (imageRequests)
                         {
-                            _handleImageRequests(convert);
+                            _handleImageRequests();
+                        }
+                        if (infoRequests || imageRequests)
+                        {
+                            _wake();
                         }
                     }
                 }
@@ -323,10 +373,6 @@ namespace djv
             {
                 p.thread.join();
             }
-            if (p.glfwWindow)
-            {
-                glfwDestroyWindow(p.glfwWindow);
-            }
         }
 
         std::shared_ptr<ThumbnailSystem> ThumbnailSystem::create(const std::shared_ptr<Core::Context>& context)
@@ -419,7 +465,9 @@ namespace djv
 
         void ThumbnailSystem::clearCache()
         {
-            _p->clearCache = true;
+            DJV_PRIVATE_PTR();
+            p.optionsKey = getOptionsKey(p.io);
+            p.clearCache = true;
         }
 
         void ThumbnailSystem::_handleInfoRequests()
@@ -444,7 +492,17 @@ namespace djv
                 }
                 const auto key = getInfoCacheKey(i.fileInfo);
                 IO::Info info;
-                const bool cached = p.infoCache.get(key, info);
+                bool cached = p.infoCache.get(key, info);
+                if (!cached)
+                {
+                    const std::string diskKey = getDiskCacheKey(i.fileInfo, p.optionsKey);
+                    if (!diskKey.empty() && p.diskCache->getInfo(diskKey, info))
+                    {
+                        cached = true;
+                        p.infoCache.add(key, info);
+                        p.infoCachePercentage = p.infoCache.getPercentageUsed();
+                    }
+                }
                 if (cached)
                 {
                     i.promise.set_value(info);
@@ -483,6 +541,7 @@ namespace djv
                         const auto info = i->infoFuture.get();
                         p.infoCache.add(getInfoCacheKey(i->fileInfo), info);
                         p.infoCachePercentage = p.infoCache.getPercentageUsed();
+                        _addDiskCache(i->fileInfo, info);
                         i->promise.set_value(info);
                     }
                     catch (const std::exception&)
@@ -505,7 +564,7 @@ namespace djv
             }
         }
 
-        void ThumbnailSystem::_handleImageRequests(const std::shared_ptr<Image::Convert>& convert)
+        void ThumbnailSystem::_handleImageRequests()
         {
             DJV_PRIVATE_PTR();
 
@@ -528,6 +587,19 @@ namespace djv
                 const auto key = getImageCacheKey(i.fileInfo, i.size, i.type);
                 std::shared_ptr<Image::Image> image;
                 p.imageCache.get(key, image);
+                if (!image)
+                {
+                    const std::string diskKey = getDiskCacheKey(i.fileInfo, i.size, i.type, p.optionsKey);
+                    if (!diskKey.empty())
+                    {
+                        image = p.diskCache->getImage(diskKey);
+                        if (image)
+                        {
+                            p.imageCache.add(key, image, image->getDataByteCount());
+                            p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                        }
+                    }
+                }
                 if (image)
                 {
                     i.promise.set_value(image);
@@ -536,8 +608,16 @@ namespace djv
                 {
                     try
                     {
-                        i.read = p.io->read(i.fileInfo);
-                        const auto info = i.read->getInfo().get();
+                        // When the file information is already known large images
+                        // are decoded at a reduced resolution.
+                        IO::ReadOptions options;
+                        IO::Info info;
+                        if (p.infoCache.get(getInfoCacheKey(i.fileInfo), info) && info.video.size())
+                        {
+                            options.proxyScale = IO::getProxyScale(info.video[0].size, i.size);
+                        }
+                        i.read = p.io->read(i.fileInfo, options);
+                        info = i.read->getInfo().get();
                         if (info.video.size() > 0)
                         {
                             p.pendingImageRequests.push_back(std::move(i));
@@ -565,6 +645,38 @@ namespace djv
             auto i = p.pendingImageRequests.begin();
             while (i != p.pendingImageRequests.end())
             {
+                if (i->resampleFuture.valid())
+                {
+                    if (i->resampleFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        try
+                        {
+                            const auto image = i->resampleFuture.get();
+                            p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image, image->getDataByteCount());
+                            p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                            _addDiskCache(i->fileInfo, i->size, i->type, image);
+                            i->promise.set_value(image);
+                        }
+                        catch (const std::exception&)
+                        {
+                            try
+                            {
+                                i->promise.set_exception(std::current_exception());
+                            }
+                            catch (const std::exception& e)
+                            {
+                                _log(e.what(), LogLevel::Error);
+                            }
+                        }
+                        i = p.pendingImageRequests.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                    continue;
+                }
+
                 std::shared_ptr<Image::Image> image;
                 bool finished = false;
                 {
@@ -581,6 +693,7 @@ namespace djv
                 }
                 if (image)
                 {
+                    i->read.reset();
                     try
                     {
                         Image::Size imageSize = image->getSize();
@@ -599,19 +712,28 @@ namespace djv
                                 size.h = static_cast<int>(size.w / imageAspect);
                             }
                             const auto type = i->type != Image::Type::None ? i->type : image->getType();
-                            auto info = Image::Info(size, type);
-#if defined(DJV_OPENGL_ES2)
-                            info.type = Image::Type::RGBA_U8;
-#endif // DJV_OPENGL_ES2
-                            auto tmp = Image::Image::create(info);
-                            tmp->setPluginName(image->getPluginName());
-                            tmp->setTags(image->getTags());
-                            convert->process(*image, info, *tmp);
-                            image = tmp;
+                            const auto info = Image::Info(size, type);
+
+                            // Resample the image on the thread pool so that multiple
+                            // thumbnails are created in parallel.
+                            i->resampleFuture = p.taskQueue->add<std::shared_ptr<Image::Image> >(
+                                IO::TaskPriority::Cache,
+                                [image, info]
+                                {
+                                    auto out = Image::Image::create(info);
+                                    out->setPluginName(image->getPluginName());
+                                    out->setTags(image->getTags());
+                                    Image::resample(*image, *out);
+                                    return out;
+                                });
+                        }
+                        else
+                        {
+                            p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image, image->getDataByteCount());
+                            p.imageCachePercentage = p.imageCache.getPercentageUsed();
+                            _addDiskCache(i->fileInfo, i->size, i->type, image);
+                            i->promise.set_value(image);
                         }
-                        p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image);
-                        p.imageCachePercentage = p.imageCache.getPercentageUsed();
-                        i->promise.set_value(image);
                     }
                     catch (const std::exception&)
                     {
@@ -629,7 +751,7 @@ namespace djv
                 {
                     i->promise.set_value(nullptr);
                 }
-                if (image || finished)
+                if ((image && !i->resampleFuture.valid()) || (!image && finished))
                 {
                     i = p.pendingImageRequests.erase(i);
                 }
@@ -640,5 +762,45 @@ namespace djv
             }
         }
 
+        void ThumbnailSystem::_addDiskCache(const FileSystem::FileInfo& fileInfo, const IO::Info& info)
+        {
+            DJV_PRIVATE_PTR();
+            const std::string key = getDiskCacheKey(fileInfo, p.optionsKey);
+            if (!key.empty())
+            {
+                try
+                {
+                    p.diskCache->addInfo(key, info);
+                    p.diskCachePercentage = p.diskCache->getPercentageUsed();
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), LogLevel::Warning);
+                }
+            }
+        }
+
+        void ThumbnailSystem::_addDiskCache(
+            const FileSystem::FileInfo& fileInfo,
+            const Image::Size& size,
+            Image::Type type,
+            const std::shared_ptr<Image::Image>& image)
+        {
+            DJV_PRIVATE_PTR();
+            const std::string key = getDiskCacheKey(fileInfo, size, type, p.optionsKey);
+            if (!key.empty())
+            {
+                try
+                {
+                    p.diskCache->addImage(key, image);
+                    p.diskCachePercentage = p.diskCache->getPercentageUsed();
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), LogLevel::Warning);
+                }
+            }
+        }
+
     } // namespace AV
 } // namespace djv
@@ -35,7 +35,6 @@ namespace djv
         {
             class Size;
             class Info;
-            class Convert;
             class Image;
             
         } // namespace Image
@@ -48,6 +47,9 @@ namespace djv
         };
         
         //! This class provides a system for generating thumbnail images from files.
+        //!
+        //! The thumbnails and file information are cached in memory and on disk,
+        //! so they are available immediately the next time the application runs.
         class ThumbnailSystem : public Core::ISystem
         {
             DJV_NON_COPYABLE(ThumbnailSystem);
@@ -103,12 +105,20 @@ namespace djv
             //! Get the image cache percentage used.
             float getImageCachePercentage() const;
 
-            //! Clear the cache.
+            //! Clear the memory cache. This is called when the I/O options change;
+            //! the disk cache keys include the options, so the disk cache does not
+            //! need to be cleared.
             void clearCache();
 
         private:
             void _handleInfoRequests();
-            void _handleImageRequests(const std::shared_ptr<Image::Convert>&);
+            void _handleImageRequests();
+            void _addDiskCache(const Core::FileSystem::FileInfo&, const IO::Info&);
+            void _addDiskCache(
+                const Core::FileSystem::FileInfo&,
+                const Image::Size&,
+                Image::Type,
+                const std::shared_ptr<Image::Image>&);
 
             DJV_PRIVATE();
         };
@@ -0,0 +1,567 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/WaveformSystem.h>
+
+#include <djvAV/AudioWaveform.h>
+#include <djvAV/IOSystem.h>
+
+#include <djvCore/Cache.h>
+#include <djvCore/Context.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
+#include <djvCore/ResourceSystem.h>
+#include <djvCore/Timer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t cacheMax              = 100;
+            const size_t diskCacheMaxByteCount = 128 * Memory::megabyte;
+            const float  chunkTimeMin          = 60.F;
+
+            //! When the disk cache is too large, entries are removed until it is
+            //! below this fraction of the maximum size.
+            const float pruneFraction = .9F;
+
+            const std::string fileExtension = ".djvwaveform";
+
+            struct DiskEntry
+            {
+                size_t   byteCount = 0;
+                uint64_t time      = 0;
+            };
+
+            struct Request
+            {
+                Request() :
+                    uid(createUID())
+                {}
+
+                Request(Request&& other) noexcept :
+                    uid(other.uid),
+                    fileInfo(other.fileInfo),
+                    promise(std::move(other.promise))
+                {}
+
+                ~Request()
+                {}
+
+                Request& operator = (Request&& other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        uid = other.uid;
+                        fileInfo = other.fileInfo;
+                        promise = std::move(other.promise);
+                    }
+                    return *this;
+                }
+
+                UID uid = 0;
+                FileSystem::FileInfo fileInfo;
+                std::promise<std::shared_ptr<Audio::Waveform> > promise;
+            };
+
+            //! The key identifies the contents of the file, so that the waveform
+            //! is created again when the file changes.
+            std::string getCacheKey(const FileSystem::FileInfo& fileInfo)
+            {
+                std::stringstream ss;
+                ss << fileInfo.getFileName() << " " << fileInfo.getSize() << " " << fileInfo.getTime();
+                return ss.str();
+            }
+
+            std::string getCacheFileName(const std::string& key)
+            {
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(sizeof(size_t) * 2) << std::hash<std::string>()(key);
+                ss << fileExtension;
+                return ss.str();
+            }
+
+            //! Compute the peaks for a range of samples with a separate reader,
+            //! so that ranges can be decoded in parallel.
+            std::vector<Audio::Peak> readPeaks(
+                const std::shared_ptr<IO::System>& io,
+                const FileSystem::FileInfo& fileInfo,
+                size_t sampleStart,
+                size_t sampleEnd,
+                const std::atomic<bool>& running)
+            {
+                IO::ReadOptions options;
+                options.video = false;
+                auto read = io->read(fileInfo, options);
+                read->getInfo().get();
+                if (sampleStart > 0)
+                {
+                    read->seek(sampleStart, IO::Direction::Forward);
+                }
+                Audio::PeakExtractor extractor;
+                const size_t sampleCount = sampleEnd - sampleStart;
+                while (running && extractor.getSampleCount() < sampleCount)
+                {
+                    std::shared_ptr<Audio::Data> data;
+                    bool finished = false;
+                    {
+                        // The timeout is used to check for cancellation.
+                        std::unique_lock<std::mutex> lock(read->getMutex());
+                        auto& queue = read->getAudioQueue();
+                        read->getQueueCV().wait_for(
+                            lock,
+                            Time::getTime(Time::TimerValue::Medium),
+                            [&queue]
+                            {
+                                return !queue.isEmpty() || queue.isFinished();
+                            });
+                        if (!queue.isEmpty())
+                        {
+                            data = queue.popFrame().audio;
+                        }
+                        else if (queue.isFinished())
+                        {
+                            finished = true;
+                        }
+                    }
+                    if (data)
+                    {
+                        // Trim the data at the end of the range.
+                        const size_t remaining = sampleCount - extractor.getSampleCount();
+                        if (data->getSampleCount() > remaining)
+                        {
+                            auto info = data->getInfo();
+                            info.sampleCount = remaining;
+                            auto tmp = Audio::Data::create(info);
+                            memcpy(tmp->getData(), data->getData(), tmp->getByteCount());
+                            data = tmp;
+                        }
+                        extractor.add(data);
+                    }
+                    else if (finished || !read->isRunning())
+                    {
+                        break;
+                    }
+                }
+                extractor.flush();
+                return extractor.getPeaks();
+            }
+
+        } // namespace
+
+        WaveformSystem::WaveformFuture::WaveformFuture()
+        {}
+
+        WaveformSystem::WaveformFuture::WaveformFuture(std::future<std::shared_ptr<Audio::Waveform> >& future, UID uid) :
+            future(std::move(future)),
+            uid(uid)
+        {}
+
+        struct WaveformSystem::Private
+        {
+            std::shared_ptr<IO::System> io;
+            std::shared_ptr<IO::TaskQueue> taskQueue;
+            FileSystem::Path cachePath;
+            std::unordered_map<std::string, DiskEntry> diskEntries;
+            size_t diskByteCount = 0;
+            uint64_t diskTime = 0;
+
+            std::list<Request> requests;
+            std::condition_variable requestCV;
+            std::mutex requestMutex;
+
+            Memory::Cache<std::string, std::shared_ptr<Audio::Waveform> > cache;
+            std::atomic<float> cachePercentage;
+            std::atomic<bool> clearCache;
+
+            std::shared_ptr<Time::Timer> statsTimer;
+            std::thread thread;
+            std::atomic<bool> running;
+        };
+
+        void WaveformSystem::_init(const std::shared_ptr<Core::Context>& context)
+        {
+            ISystem::_init("djv::AV::WaveformSystem", context);
+
+            DJV_PRIVATE_PTR();
+
+            p.io = context->getSystemT<IO::System>();
+            addDependency(p.io);
+            auto resourceSystem = context->getSystemT<ResourceSystem>();
+            p.cachePath = FileSystem::Path(resourceSystem->getPath(FileSystem::ResourcePath::Cache), "Waveforms");
+
+            // The files are decoded by the I/O thread pool.
+            p.taskQueue = p.io->getThreadPool()->createQueue();
+
+            p.cache.setMax(cacheMax);
+            p.cachePercentage = 0.F;
+            p.clearCache = false;
+
+            p.statsTimer = Time::Timer::create(context);
+            p.statsTimer->setRepeating(true);
+            p.statsTimer->start(
+                Time::getTime(Time::TimerValue::VerySlow),
+                [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+            {
+                DJV_PRIVATE_PTR();
+                std::stringstream ss;
+                ss << "Cache: " << p.cachePercentage << '%';
+                _log(ss.str());
+            });
+
+            auto logSystem = context->getSystemT<LogSystem>();
+            p.running = true;
+            p.thread = std::thread(
+                [this, logSystem]
+            {
+                DJV_PRIVATE_PTR();
+                try
+                {
+                    _readDiskCache();
+                    const auto timeout = Time::getValue(Time::TimerValue::Medium);
+                    while (p.running)
+                    {
+                        if (p.clearCache)
+                        {
+                            p.clearCache = false;
+                            p.cache.clear();
+                            p.cachePercentage = 0.F;
+                        }
+
+                        bool requests = false;
+                        {
+                            std::unique_lock<std::mutex> lock(p.requestMutex);
+                            requests = p.requestCV.wait_for(
+                                lock,
+                                std::chrono::milliseconds(timeout),
+                                [this]
+                            {
+                                return _p->requests.size();
+                            });
+                        }
+                        if (requests)
+                        {
+                            _handleRequests();
+                            _wake();
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    logSystem->log("djv::AV::WaveformSystem", e.what(), LogLevel::Error);
+                }
+            });
+        }
+
+        WaveformSystem::WaveformSystem() :
+            _p(new Private)
+        {}
+
+        WaveformSystem::~WaveformSystem()
+        {
+            DJV_PRIVATE_PTR();
+            p.running = false;
+            p.taskQueue->cancel();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
+        std::shared_ptr<WaveformSystem> WaveformSystem::create(const std::shared_ptr<Core::Context>& context)
+        {
+            auto out = std::shared_ptr<WaveformSystem>(new WaveformSystem);
+            out->_init(context);
+            return out;
+        }
+
+        WaveformSystem::WaveformFuture WaveformSystem::getWaveform(const FileSystem::FileInfo& fileInfo)
+        {
+            DJV_PRIVATE_PTR();
+            Request request;
+            request.fileInfo = fileInfo;
+            auto future = request.promise.get_future();
+            const UID uid = request.uid;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                p.requests.push_back(std::move(request));
+            }
+            p.requestCV.notify_one();
+            return WaveformFuture(future, uid);
+        }
+
+        void WaveformSystem::cancelWaveform(UID uid)
+        {
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            const auto i = std::find_if(
+                p.requests.begin(),
+                p.requests.end(),
+                [uid](const Request& value)
+            {
+                return value.uid == uid;
+            });
+            if (i != p.requests.end())
+            {
+                p.requests.erase(i);
+            }
+        }
+
+        float WaveformSystem::getCachePercentage() const
+        {
+            return _p->cachePercentage;
+        }
+
+        void WaveformSystem::clearCache()
+        {
+            _p->clearCache = true;
+        }
+
+        void WaveformSystem::_handleRequests()
+        {
+            DJV_PRIVATE_PTR();
+            while (p.running)
+            {
+                Request request;
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    if (p.requests.empty())
+                    {
+                        break;
+                    }
+                    request = std::move(p.requests.front());
+                    p.requests.pop_front();
+                }
+                try
+                {
+                    const std::string key = getCacheKey(request.fileInfo);
+                    std::shared_ptr<Audio::Waveform> waveform;
+                    if (!p.cache.get(key, waveform))
+                    {
+                        waveform = _readWaveform(request.fileInfo);
+                        if (waveform)
+                        {
+                            p.cache.add(key, waveform);
+                            p.cachePercentage = p.cache.getPercentageUsed();
+                        }
+                    }
+                    request.promise.set_value(waveform);
+                }
+                catch (const std::exception&)
+                {
+                    try
+                    {
+                        request.promise.set_exception(std::current_exception());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), LogLevel::Error);
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<Audio::Waveform> WaveformSystem::_readWaveform(const FileSystem::FileInfo& fileInfo)
+        {
+            DJV_PRIVATE_PTR();
+            std::shared_ptr<Audio::Waveform> out;
+
+            // Read the waveform from the disk cache.
+            const std::string key = getCacheKey(fileInfo);
+            const std::string cacheFileName = getCacheFileName(key);
+            const FileSystem::Path path(p.cachePath, cacheFileName);
+            const auto i = p.diskEntries.find(cacheFileName);
+            if (i != p.diskEntries.end())
+            {
+                try
+                {
+                    out = Audio::Waveform::read(path.get(), key);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), LogLevel::Warning);
+                }
+                if (out)
+                {
+                    i->second.time = ++p.diskTime;
+                    return out;
+                }
+            }
+
+            // Get the audio information, ignoring any video in the file.
+            IO::ReadOptions options;
+            options.video = false;
+            const auto info = p.io->read(fileInfo, options)->getInfo().get();
+            if (!info.audio.isValid() || 0 == info.audio.sampleRate || 0 == info.audio.sampleCount)
+            {
+                return out;
+            }
+
+            // Split the file into ranges that are decoded in parallel. Each range
+            // starts on a peak boundary so that the peaks line up. Half of the
+            // pool threads are left for playback.
+            const size_t sampleCount = info.audio.sampleCount;
+            const size_t threadCount = std::max(p.io->getThreadPool()->getThreadCount() / 2, static_cast<size_t>(1));
+            size_t chunkSampleCount = std::max(
+                (sampleCount + threadCount - 1) / threadCount,
+                static_cast<size_t>(info.audio.sampleRate * chunkTimeMin));
+            chunkSampleCount = (chunkSampleCount + Audio::waveformPeakSampleCount - 1) /
+                Audio::waveformPeakSampleCount * Audio::waveformPeakSampleCount;
+            out = Audio::Waveform::create(info.audio.sampleRate, sampleCount);
+            std::vector<std::future<bool> > futures;
+            for (size_t i = 0; i < sampleCount; i += chunkSampleCount)
+            {
+                const size_t sampleStart = i;
+                const size_t sampleEnd = std::min(i + chunkSampleCount, sampleCount);
+                auto io = p.io;
+                futures.push_back(p.taskQueue->add<bool>(
+                    IO::TaskPriority::Cache,
+                    [this, io, fileInfo, sampleStart, sampleEnd, out]
+                    {
+                        const auto peaks = readPeaks(io, fileInfo, sampleStart, sampleEnd, _p->running);
+                        out->setPeaks(sampleStart / Audio::waveformPeakSampleCount, peaks);
+                        return true;
+                    }));
+            }
+            // Wait for all of the ranges before returning, since the tasks
+            // reference this system.
+            std::exception_ptr exception;
+            for (auto& i : futures)
+            {
+                try
+                {
+                    i.get();
+                }
+                catch (const std::exception&)
+                {
+                    if (!exception)
+                    {
+                        exception = std::current_exception();
+                    }
+                }
+            }
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+            out->updateLevels();
+
+            // Write the waveform to the disk cache.
+            if (p.running)
+            {
+                try
+                {
+                    if (!FileSystem::FileInfo(p.cachePath).doesExist())
+                    {
+                        FileSystem::Path parent(p.cachePath);
+                        if (parent.cdUp() && !FileSystem::FileInfo(parent).doesExist())
+                        {
+                            FileSystem::Path::mkdir(parent);
+                        }
+                        FileSystem::Path::mkdir(p.cachePath);
+                    }
+                    out->write(path.get(), key);
+                    _addDiskCache(cacheFileName, static_cast<size_t>(FileSystem::FileInfo(path).getSize()));
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), LogLevel::Warning);
+                }
+            }
+            return out;
+        }
+
+        void WaveformSystem::_readDiskCache()
+        {
+            DJV_PRIVATE_PTR();
+            if (!FileSystem::FileInfo(p.cachePath).doesExist())
+                return;
+
+            // The files are ordered by their modification time, the entries
+            // that are read are then marked as the most recently used.
+            FileSystem::DirectoryListOptions options;
+            options.fileExtensions.insert(fileExtension);
+            auto fileInfos = FileSystem::FileInfo::directoryList(p.cachePath, options);
+            std::sort(
+                fileInfos.begin(),
+                fileInfos.end(),
+                [](const FileSystem::FileInfo& a, const FileSystem::FileInfo& b)
+                {
+                    return a.getTime() < b.getTime();
+                });
+            for (const auto& i : fileInfos)
+            {
+                DiskEntry entry;
+                entry.byteCount = static_cast<size_t>(i.getSize());
+                entry.time = ++p.diskTime;
+                p.diskEntries[i.getFileName(Frame::invalid, false)] = entry;
+                p.diskByteCount += entry.byteCount;
+            }
+            if (p.diskByteCount > diskCacheMaxByteCount)
+            {
+                _pruneDiskCache();
+            }
+        }
+
+        void WaveformSystem::_addDiskCache(const std::string& fileName, size_t byteCount)
+        {
+            DJV_PRIVATE_PTR();
+            auto& entry = p.diskEntries[fileName];
+            p.diskByteCount -= entry.byteCount;
+            entry.byteCount = byteCount;
+            entry.time = ++p.diskTime;
+            p.diskByteCount += byteCount;
+            if (p.diskByteCount > diskCacheMaxByteCount)
+            {
+                _pruneDiskCache();
+            }
+        }
+
+        void WaveformSystem::_pruneDiskCache()
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::pair<uint64_t, std::string> > entries;
+            entries.reserve(p.diskEntries.size());
+            for (const auto& i : p.diskEntries)
+            {
+                entries.push_back(std::make_pair(i.second.time, i.first));
+            }
+            std::sort(entries.begin(), entries.end());
+            const size_t byteCount = static_cast<size_t>(diskCacheMaxByteCount * pruneFraction);
+            for (auto i = entries.begin(); i != entries.end() && p.diskByteCount > byteCount; ++i)
+            {
+                const auto j = p.diskEntries.find(i->second);
+                p.diskByteCount -= j->second.byteCount;
+                p.diskEntries.erase(j);
+                try
+                {
+                    FileSystem::Path::rm(FileSystem::Path(p.cachePath, i->second));
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), LogLevel::Warning);
+                }
+            }
+        }
+
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/ISystem.h>
+#include <djvCore/UID.h>
+
+#include <future>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            class FileInfo;
+
+        } // namespace FileSystem
+    } // namespace Core
+
+    namespace AV
+    {
+        namespace Audio
+        {
+            class Waveform;
+
+        } // namespace Audio
+
+        //! This class provides a system for generating audio waveforms from files.
+        //!
+        //! The waveforms are cached in memory and on disk, so that a file is
+        //! only decoded the first time its waveform is requested. When the disk
+        //! cache grows larger than its maximum size, the least recently used
+        //! waveforms are removed.
+        class WaveformSystem : public Core::ISystem
+        {
+            DJV_NON_COPYABLE(WaveformSystem);
+
+        protected:
+            void _init(const std::shared_ptr<Core::Context>&);
+            WaveformSystem();
+
+        public:
+            ~WaveformSystem() override;
+
+            //! Create a new waveform system.
+            static std::shared_ptr<WaveformSystem> create(const std::shared_ptr<Core::Context>&);
+
+            //! This structure provides a waveform for a file.
+            struct WaveformFuture
+            {
+                WaveformFuture();
+                WaveformFuture(std::future<std::shared_ptr<Audio::Waveform> >&, Core::UID);
+                std::future<std::shared_ptr<Audio::Waveform> > future;
+                Core::UID uid = 0;
+            };
+
+            //! Get the waveform for the given file. A null pointer is returned
+            //! if the file does not have audio.
+            WaveformFuture getWaveform(const Core::FileSystem::FileInfo&);
+
+            //! Cancel a waveform.
+            void cancelWaveform(Core::UID);
+
+            //! Get the cache percentage used.
+            float getCachePercentage() const;
+
+            //! Clear the memory cache.
+            void clearCache();
+
+        private:
+            void _handleRequests();
+            std::shared_ptr<Audio::Waveform> _readWaveform(const Core::FileSystem::FileInfo&);
+            void _readDiskCache();
+            void _addDiskCache(const std::string& fileName, size_t byteCount);
+            void _pruneDiskCache();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace AV
+} // namespace djv
@@ -23,6 +23,10 @@
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/Timer.h>
+
+#include <condition_variable>
+#include <mutex>
 
 using namespace djv::Core;
 
@@ -35,12 +39,19 @@ namespace djv
             //! \todo Should this be configurable?
             const size_t frameRate = 60;
 
+            //! \todo Should this be configurable?
+            const std::chrono::seconds waitTimeoutMax(1);
+
         } // namespace
 
         struct Application::Private
         {
             bool running = false;
             int exit = 0;
+            std::vector<std::function<void(void)> > posted;
+            bool wakeRequest = false;
+            std::mutex mutex;
+            std::condition_variable cv;
         };
 
         void Application::_init(std::list<std::string>& args)
@@ -52,6 +63,16 @@ namespace djv
                 args.pop_front();
             }
             Context::_init(argv0);
+            setWakeCallback(
+                [this]
+                {
+                    DJV_PRIVATE_PTR();
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        p.wakeRequest = true;
+                    }
+                    p.cv.notify_one();
+                });
 
             // Parse the command line.
             auto logSystem = getSystemT<LogSystem>();
@@ -91,7 +112,9 @@ namespace djv
         {}
 
         Application::~Application()
-        {}
+        {
+            setWakeCallback(nullptr);
+        }
 
         std::shared_ptr<Application> Application::create(std::list<std::string>& args)
         {
@@ -103,24 +126,41 @@ namespace djv
         void Application::run()
         {
             DJV_PRIVATE_PTR();
-            auto time = std::chrono::steady_clock::now();
-            Time::Duration delta = Time::Duration::zero();
-            p.running = true;
-            while (p.running)
+            auto timerSystem = getSystemT<Time::TimerSystem>();
+            const auto frameTime = std::chrono::microseconds(1000000 / frameRate);
+            _setRunning(true);
+            while (_isRunning())
             {
+                const auto time = std::chrono::steady_clock::now();
+                _runPosted();
+
                 tick();
 
-                auto end = std::chrono::steady_clock::now();
-                delta = std::chrono::duration_cast<Time::Duration>(end - time);
-                while (delta < std::chrono::microseconds(1000000 / frameRate))
-                {
-                    end = std::chrono::steady_clock::now();
-                    delta = std::chrono::duration_cast<Time::Duration>(end - time);
-                }
-                time = end;
+                // Sleep until the next timer is due, work is posted, or the
+                // event loop is woken up. Ticks are no more frequent than the
+                // frame rate.
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.cv.wait_until(
+                    lock,
+                    std::min(std::max(timerSystem->getNextDeadline(), time + frameTime), time + waitTimeoutMax),
+                    [&p]
+                    {
+                        return !p.running || p.posted.size() > 0 || p.wakeRequest;
+                    });
+                p.wakeRequest = false;
             }
         }
 
+        void Application::post(const std::function<void(void)>& value)
+        {
+            DJV_PRIVATE_PTR();
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.posted.push_back(value);
+            }
+            wake();
+        }
+
         int Application::getExitCode() const
         {
             return _p->exit;
@@ -129,8 +169,12 @@ namespace djv
         void Application::exit(int value)
         {
             DJV_PRIVATE_PTR();
-            p.running = false;
-            p.exit = value;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.running = false;
+                p.exit = value;
+            }
+            wake();
         }
 
         std::list<std::string> Application::args(int argc, char** argv)
@@ -230,12 +274,33 @@ namespace djv
 
         bool Application::_isRunning() const
         {
-            return _p->running;
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.running;
         }
 
         void Application::_setRunning(bool value)
         {
-            _p->running = value;
+            DJV_PRIVATE_PTR();
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.running = value;
+            }
+            wake();
+        }
+
+        void Application::_runPosted()
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::function<void(void)> > posted;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                posted.swap(p.posted);
+            }
+            for (const auto& i : posted)
+            {
+                i();
+            }
         }
 
         void Application::_printVersion()
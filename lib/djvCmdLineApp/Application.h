@@ -8,6 +8,8 @@
 
 #include <djvCore/Context.h>
 
+#include <functional>
+
 struct GLFWwindow;
 
 #if defined(DJV_PLATFORM_WINDOWS)
@@ -27,6 +29,10 @@ namespace djv
         };
 
         //! This class provides a command-line application.
+        //!
+        //! The event loop sleeps until the next timer is due, work is posted,
+        //! or it is woken up with Core::Context::wake(), instead of ticking
+        //! continuously.
         class Application : public Core::Context
         {
             DJV_NON_COPYABLE(Application);
@@ -42,7 +48,13 @@ namespace djv
 
             virtual void run();
 
+            //! Call a function on the event loop thread. This function is thread
+            //! safe and wakes up the event loop.
+            void post(const std::function<void(void)>&);
+
             int getExitCode() const;
+
+            //! Exit the event loop. This function is thread safe.
             void exit(int);
 
             static std::list<std::string> args(int, char**);
@@ -57,6 +69,9 @@ namespace djv
             bool _isRunning() const;
             void _setRunning(bool);
 
+            //! Call the functions that have been posted to the event loop.
+            void _runPosted();
+
         private:
             void _printVersion();
 
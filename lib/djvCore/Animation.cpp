@@ -150,6 +150,25 @@ namespace djv
                 return out;
             }
 
+            bool System::isActive() const
+            {
+                DJV_PRIVATE_PTR();
+                for (const auto& i : { &p.animations, &p.newAnimations })
+                {
+                    for (const auto& j : *i)
+                    {
+                        if (auto animation = j.lock())
+                        {
+                            if (animation->isActive())
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                }
+                return false;
+            }
+
             void System::tick()
             {
                 DJV_PRIVATE_PTR();
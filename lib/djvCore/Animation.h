@@ -112,6 +112,11 @@ namespace djv
 
                 static std::shared_ptr<System> create(const std::shared_ptr<Context>&);
 
+                //! Get whether any animations are running. The application
+                //! event loop uses this to decide whether it can wait for
+                //! events.
+                bool isActive() const;
+
                 void tick() override;
 
             private:
@@ -6,7 +6,12 @@
 
 #include <djvCore/Core.h>
 
-#include <map>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace djv
@@ -15,10 +20,17 @@ namespace djv
     {
         namespace Memory
         {
-            //! This class provides a cache.
+            //! This class provides a least recently used cache.
+            //!
+            //! The entries are kept in a list ordered by use, and a hash map
+            //! provides constant time lookup of the list entries. Adding, getting,
+            //! removing, and evicting entries are all constant time operations.
+            //!
+            //! The capacity can be limited by the number of entries and optionally
+            //! by the total byte count of the entries.
             //!
             //! \todo Return an iterator from get() instead of a value.
-            template<typename T, typename U>
+            template<typename T, typename U, typename H = std::hash<T> >
             class Cache
             {
             public:
@@ -28,31 +40,113 @@ namespace djv
                 size_t getMax() const;
                 void setMax(size_t);
 
+                //! Get the maximum byte count. A value of zero means the byte count
+                //! is not limited.
+                size_t getMaxByteCount() const;
+                void setMaxByteCount(size_t);
+
                 ///@}
 
                 //! \name Cache Contents
                 ///@{
 
                 size_t getSize() const;
+                size_t getByteCount() const;
                 float getPercentageUsed() const;
                 bool contains(const T& key) const;
+
+                //! Get a value from the cache and mark it as the most recently used.
                 bool get(const T& key, U& value) const;
-                void add(const T& key, const U& value);
+
+                //! Add a value to the cache. The byte count is only used when the
+                //! maximum byte count is set.
+                void add(const T& key, const U& value, size_t byteCount = 0);
+
                 void remove(const T& key);
                 void clear();
 
+                //! Get the keys sorted in ascending order.
                 std::vector<T> getKeys() const;
+
+                //! Get the values sorted by key in ascending order.
                 std::vector<U> getValues() const;
 
                 ///@}
 
             private:
+                struct Entry
+                {
+                    T      key;
+                    U      value;
+                    size_t byteCount;
+                };
+                typedef std::list<Entry> List;
+
+                void _erase(typename List::iterator);
                 void _maxUpdate();
+                std::vector<typename List::const_iterator> _getSorted() const;
 
                 size_t _max = 10000;
-                std::map<T, U> _map;
-                mutable std::map<T, int64_t> _counts;
-                mutable int64_t _counter = 0;
+                size_t _maxByteCount = 0;
+                size_t _byteCount = 0;
+                mutable List _list;
+                std::unordered_map<T, typename List::iterator, H> _map;
+            };
+
+            //! This class provides a thread safe least recently used cache.
+            //!
+            //! The cache is split into shards that are selected by the key hash,
+            //! each with its own mutex, so that threads accessing different keys
+            //! rarely contend for the same lock. The maximum size and byte count
+            //! are divided evenly between the shards, so the least recently used
+            //! order is only kept within each shard.
+            template<typename T, typename U, typename H = std::hash<T> >
+            class ShardedCache
+            {
+                DJV_NON_COPYABLE(ShardedCache);
+
+            public:
+                explicit ShardedCache(size_t shardCount = 16);
+
+                //! \name Cache Maximum Size
+                ///@{
+
+                size_t getMax() const;
+                void setMax(size_t);
+
+                size_t getMaxByteCount() const;
+                void setMaxByteCount(size_t);
+
+                ///@}
+
+                //! \name Cache Contents
+                ///@{
+
+                size_t getSize() const;
+                size_t getByteCount() const;
+                float getPercentageUsed() const;
+                bool contains(const T& key) const;
+                bool get(const T& key, U& value) const;
+                void add(const T& key, const U& value, size_t byteCount = 0);
+                void remove(const T& key);
+                void clear();
+
+                ///@}
+
+            private:
+                struct Shard
+                {
+                    mutable std::mutex mutex;
+                    Cache<T, U, H> cache;
+                };
+
+                Shard& _getShard(const T& key);
+                const Shard& _getShard(const T& key) const;
+
+                std::atomic<size_t> _max;
+                std::atomic<size_t> _maxByteCount;
+                std::vector<std::unique_ptr<Shard> > _shards;
+                H _hash;
             };
 
         } // namespace Memory
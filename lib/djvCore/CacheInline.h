@@ -3,6 +3,7 @@
 // All rights reserved.
 
 #include <algorithm>
+#include <iterator>
 
 namespace djv
 {
@@ -10,137 +11,308 @@ namespace djv
     {
         namespace Memory
         {
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getMax() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getMax() const
             {
                 return _max;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::setMax(size_t value)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::setMax(size_t value)
             {
                 _max = value;
                 _maxUpdate();
             }
 
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getSize() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getMaxByteCount() const
+            {
+                return _maxByteCount;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::setMaxByteCount(size_t value)
+            {
+                _maxByteCount = value;
+                _maxUpdate();
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getSize() const
             {
                 return _map.size();
             }
 
-            template<typename T, typename U>
-            inline float Cache<T, U>::getPercentageUsed() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getByteCount() const
             {
-                return _map.size() / static_cast<float>(_max) * 100.F;
+                return _byteCount;
+            }
+
+            template<typename T, typename U, typename H>
+            inline float Cache<T, U, H>::getPercentageUsed() const
+            {
+                float out = _max ? (_map.size() / static_cast<float>(_max) * 100.F) : 0.F;
+                if (_maxByteCount)
+                {
+                    out = std::max(out, _byteCount / static_cast<float>(_maxByteCount) * 100.F);
+                }
+                return out;
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::contains(const T& key) const
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::contains(const T& key) const
             {
                 return _map.find(key) != _map.end();
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::get(const T& key, U& value) const
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::get(const T& key, U& value) const
             {
-                auto i = _map.find(key);
+                const auto i = _map.find(key);
                 if (i != _map.end())
                 {
-                    value = i->second;
-                    auto j = _counts.find(key);
-                    if (j != _counts.end())
-                    {
-                        ++_counter;
-                        j->second = _counter;
-                    }
+                    value = i->second->value;
+                    _list.splice(_list.begin(), _list, i->second);
                     return true;
                 }
-                return i != _map.end();
+                return false;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::add(const T& key, const U& value)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::add(const T& key, const U& value, size_t byteCount)
             {
-                _map[key] = value;
-                ++_counter;
-                _counts[key] = _counter;
+                const auto i = _map.find(key);
+                if (i != _map.end())
+                {
+                    _byteCount -= i->second->byteCount;
+                    i->second->value = value;
+                    i->second->byteCount = byteCount;
+                    _list.splice(_list.begin(), _list, i->second);
+                }
+                else
+                {
+                    _list.push_front(Entry({ key, value, byteCount }));
+                    _map[key] = _list.begin();
+                }
+                _byteCount += byteCount;
                 _maxUpdate();
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::remove(const T& key)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::remove(const T& key)
             {
                 const auto i = _map.find(key);
                 if (i != _map.end())
                 {
-                    _map.erase(i);
-                }
-                const auto j = _counts.find(key);
-                if (j != _counts.end())
-                {
-                    _counts.erase(j);
+                    _erase(i->second);
                 }
-                _maxUpdate();
             }
             
-            template<typename T, typename U>
-            inline void Cache<T, U>::clear()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::clear()
             {
                 _map.clear();
+                _list.clear();
+                _byteCount = 0;
             }
 
-            template<typename T, typename U>
-            inline std::vector<T> Cache<T, U>::getKeys() const
+            template<typename T, typename U, typename H>
+            inline std::vector<T> Cache<T, U, H>::getKeys() const
             {
                 std::vector<T> out;
-                for (const auto& i : _map)
+                for (const auto& i : _getSorted())
                 {
-                    out.push_back(i.first);
+                    out.push_back(i->key);
                 }
                 return out;
             }
 
-            template<typename T, typename U>
-            inline std::vector<U> Cache<T, U>::getValues() const
+            template<typename T, typename U, typename H>
+            inline std::vector<U> Cache<T, U, H>::getValues() const
             {
                 std::vector<U> out;
-                for (const auto& i : _map)
+                for (const auto& i : _getSorted())
                 {
-                    out.push_back(i.second);
+                    out.push_back(i->value);
                 }
                 return out;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::_maxUpdate()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::_erase(typename List::iterator i)
+            {
+                _byteCount -= i->byteCount;
+                _map.erase(i->key);
+                _list.erase(i);
+            }
+
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::_maxUpdate()
             {
-                if (_map.size() > _max)
+                while (_list.size() &&
+                    (_map.size() > _max || (_maxByteCount && _byteCount > _maxByteCount)))
                 {
-                    std::map<int64_t, T> sorted;
-                    for (const auto& i : _counts)
-                    {
-                        sorted[i.second] = i.first;
-                    }
-                    while (_map.size() > _max)
+                    _erase(std::prev(_list.end()));
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline std::vector<typename Cache<T, U, H>::List::const_iterator> Cache<T, U, H>::_getSorted() const
+            {
+                std::vector<typename List::const_iterator> out;
+                out.reserve(_list.size());
+                for (auto i = _list.cbegin(); i != _list.cend(); ++i)
+                {
+                    out.push_back(i);
+                }
+                std::sort(
+                    out.begin(),
+                    out.end(),
+                    [](const typename List::const_iterator& a, const typename List::const_iterator& b)
                     {
-                        auto begin = sorted.begin();
-                        auto i = _map.find(begin->second);
-                        if (i != _map.end())
-                        {
-                            _map.erase(i);
-                        }
-                        auto j = _counts.find(begin->second);
-                        if (j != _counts.end())
-                        {
-                            _counts.erase(j);
-                        }
-                        sorted.erase(begin);
-                    }
+                        return a->key < b->key;
+                    });
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline ShardedCache<T, U, H>::ShardedCache(size_t shardCount) :
+                _max(10000),
+                _maxByteCount(0)
+            {
+                for (size_t i = 0; i < std::max(shardCount, static_cast<size_t>(1)); ++i)
+                {
+                    _shards.push_back(std::unique_ptr<Shard>(new Shard));
+                }
+                setMax(_max);
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedCache<T, U, H>::getMax() const
+            {
+                return _max;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedCache<T, U, H>::setMax(size_t value)
+            {
+                _max = value;
+                const size_t shardMax = (value + _shards.size() - 1) / _shards.size();
+                for (auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i->mutex);
+                    i->cache.setMax(shardMax);
                 }
             }
 
+            template<typename T, typename U, typename H>
+            inline size_t ShardedCache<T, U, H>::getMaxByteCount() const
+            {
+                return _maxByteCount;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedCache<T, U, H>::setMaxByteCount(size_t value)
+            {
+                _maxByteCount = value;
+                const size_t shardMaxByteCount = (value + _shards.size() - 1) / _shards.size();
+                for (auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i->mutex);
+                    i->cache.setMaxByteCount(shardMaxByteCount);
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedCache<T, U, H>::getSize() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i->mutex);
+                    out += i->cache.getSize();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedCache<T, U, H>::getByteCount() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i->mutex);
+                    out += i->cache.getByteCount();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline float ShardedCache<T, U, H>::getPercentageUsed() const
+            {
+                float out = _max ? (getSize() / static_cast<float>(_max) * 100.F) : 0.F;
+                if (_maxByteCount)
+                {
+                    out = std::max(out, getByteCount() / static_cast<float>(_maxByteCount) * 100.F);
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool ShardedCache<T, U, H>::contains(const T& key) const
+            {
+                const auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                return shard.cache.contains(key);
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool ShardedCache<T, U, H>::get(const T& key, U& value) const
+            {
+                const auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                return shard.cache.get(key, value);
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedCache<T, U, H>::add(const T& key, const U& value, size_t byteCount)
+            {
+                auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.cache.add(key, value, byteCount);
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedCache<T, U, H>::remove(const T& key)
+            {
+                auto& shard = _getShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.cache.remove(key);
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedCache<T, U, H>::clear()
+            {
+                for (auto& i : _shards)
+                {
+                    std::lock_guard<std::mutex> lock(i->mutex);
+                    i->cache.clear();
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline typename ShardedCache<T, U, H>::Shard& ShardedCache<T, U, H>::_getShard(const T& key)
+            {
+                return *_shards[_hash(key) % _shards.size()];
+            }
+
+            template<typename T, typename U, typename H>
+            inline const typename ShardedCache<T, U, H>::Shard& ShardedCache<T, U, H>::_getShard(const T& key) const
+            {
+                return *_shards[_hash(key) % _shards.size()];
+            }
+
         } // namespace Memory
     } // namespace Core
 } // namespace djv
-
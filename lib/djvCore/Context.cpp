@@ -149,6 +149,21 @@ namespace djv
             }
         }
                 
+        void Context::wake()
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            if (_wakeCallback)
+            {
+                _wakeCallback();
+            }
+        }
+
+        void Context::setWakeCallback(const std::function<void(void)>& value)
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _wakeCallback = value;
+        }
+
         void Context::tick()
         {
             if (_logSystemOrderInit)
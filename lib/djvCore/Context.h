@@ -8,8 +8,10 @@
 #include <djvCore/Time.h>
 
 #include <chrono>
+#include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -77,6 +79,19 @@ namespace djv
             //! Get the system tick times.
             const std::vector<std::pair<std::string, Time::Duration> >& getSystemTickTimes() const;
 
+            //! \name Wake Up
+            ///@{
+
+            //! Wake up the application event loop when it is waiting for
+            //! events. This function is thread safe, so it can be called when
+            //! worker threads have new results.
+            void wake();
+
+            //! Set the callback used to wake up the application event loop.
+            void setWakeCallback(const std::function<void(void)>&);
+
+            ///@}
+
         protected:
             void _addSystem(const std::shared_ptr<ISystemBase> &);
 
@@ -91,6 +106,8 @@ namespace djv
             std::shared_ptr<ResourceSystem> _resourceSystem;
             std::shared_ptr<LogSystem> _logSystem;
             std::shared_ptr<TextSystem> _textSystem;
+            std::mutex _wakeMutex;
+            std::function<void(void)> _wakeCallback;
             std::vector<std::shared_ptr<ISystemBase> > _systems;
             bool _logSystemOrderInit = true;
             size_t _tickCount = 0;
@@ -39,6 +39,8 @@ namespace djv
                 std::future<std::pair<std::vector<FileInfo>, std::vector<std::string> > > future;
                 std::shared_ptr<Time::Timer> futureTimer;
                 std::shared_ptr<DirectoryWatcher> directoryWatcher;
+                std::set<std::string> changes;
+                std::shared_ptr<std::map<std::string, uint64_t> > frameSizes;
             };
 
             void DirectoryModel::_init(const std::shared_ptr<Context>& context)
@@ -65,12 +67,23 @@ namespace djv
                 p.directoryWatcher = DirectoryWatcher::create(context);
 
                 auto weak = std::weak_ptr<DirectoryModel>(shared_from_this());
-                p.directoryWatcher->setCallback(
-                    [weak]
+                p.directoryWatcher->setChangesCallback(
+                    [weak](const std::vector<DirectoryWatcher::Change>& value)
                 {
                     if (auto model = weak.lock())
                     {
-                        model->reload();
+                        // Apply the changes to the current directory contents,
+                        // unless the whole directory needs to be listed again.
+                        for (const auto& i : value)
+                        {
+                            if (DirectoryWatcher::ChangeType::Reset == i.type)
+                            {
+                                model->reload();
+                                return;
+                            }
+                            model->_p->changes.insert(i.fileName);
+                        }
+                        model->_changesUpdate();
                     }
                 });
             }
@@ -329,32 +342,86 @@ namespace djv
                 setFilter(std::string());
             }
 
+            DirectoryListOptions DirectoryModel::_getOptions() const
+            {
+                DJV_PRIVATE_PTR();
+                DirectoryListOptions out;
+                out.fileExtensions = p.fileExtensions;
+                out.fileSequences = p.fileSequences->get();
+                out.fileSequenceExtensions = p.fileSequenceExtensions;
+                out.showHidden = p.showHidden->get();
+                out.sort = p.sort->get();
+                out.reverseSort = p.reverseSort->get();
+                out.sortDirectoriesFirst = p.sortDirectoriesFirst->get();
+                out.filter = p.filter->get();
+                return out;
+            }
+
             void DirectoryModel::_pathUpdate()
             {
                 DJV_PRIVATE_PTR();
                 const Path path = p.path->get();
-                DirectoryListOptions options;
-                options.fileExtensions = p.fileExtensions;
-                options.fileSequences = p.fileSequences->get();
-                options.fileSequenceExtensions = p.fileSequenceExtensions;
-                options.showHidden = p.showHidden->get();
-                options.sort = p.sort->get();
-                options.reverseSort = p.reverseSort->get();
-                options.sortDirectoriesFirst = p.sortDirectoriesFirst->get();
-                options.filter = p.filter->get();
+                const DirectoryListOptions options = _getOptions();
+
+                // The new listing includes any changes that have not been
+                // applied yet.
+                p.changes.clear();
+                auto frameSizes = std::make_shared<std::map<std::string, uint64_t> >();
+                p.frameSizes = frameSizes;
+
                 p.future = std::async(
                     std::launch::async,
-                    [path, options]
+                    [path, options, frameSizes]
                 {
                     std::pair<std::vector<FileInfo>, std::vector<std::string> > out;
-                    out.first = FileInfo::directoryList(path, options);
+                    out.first = FileInfo::directoryList(path, options, frameSizes.get());
                     for (const auto& fileInfo : out.first)
                     {
                         out.second.push_back(fileInfo.getFileName(-1, false));
                     }
                     return out;
                 });
+                _futureUpdate();
+
+                p.directoryWatcher->setPath(p.path->get());
+            }
 
+            void DirectoryModel::_changesUpdate()
+            {
+                DJV_PRIVATE_PTR();
+
+                // The changes are applied after the current listing or update
+                // has finished.
+                if (p.future.valid() || p.changes.empty())
+                    return;
+
+                const Path path = p.path->get();
+                const DirectoryListOptions options = _getOptions();
+                const std::vector<std::string> fileNames(p.changes.begin(), p.changes.end());
+                p.changes.clear();
+                auto list = p.fileInfo->get();
+                auto frameSizes = p.frameSizes;
+                p.future = std::async(
+                    std::launch::async,
+                    [path, options, fileNames, list, frameSizes]
+                {
+                    std::pair<std::vector<FileInfo>, std::vector<std::string> > out;
+                    out.first = list;
+                    FileInfo::directoryListUpdate(out.first, path, fileNames, options, frameSizes.get());
+                    for (const auto& fileInfo : out.first)
+                    {
+                        out.second.push_back(fileInfo.getFileName(-1, false));
+                    }
+                    return out;
+                });
+                _futureUpdate();
+            }
+
+            void DirectoryModel::_futureUpdate()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.futureTimer->isActive())
+                    return;
                 p.futureTimer->start(
                     Time::getTime(Time::TimerValue::Medium),
                     [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
@@ -363,15 +430,17 @@ namespace djv
                     if (p.future.valid() &&
                         p.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        p.futureTimer->stop();
-
                         const auto& out = p.future.get();
                         p.fileInfo->setIfChanged(out.first);
                         p.fileNames->setIfChanged(out.second);
+
+                        _changesUpdate();
+                        if (!p.future.valid())
+                        {
+                            p.futureTimer->stop();
+                        }
                     }
                 });
-
-                p.directoryWatcher->setPath(p.path->get());
             }
 
         } // namespace FileSystem
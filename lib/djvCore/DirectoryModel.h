@@ -96,7 +96,10 @@ namespace djv
                 ///@}
 
             private:
+                DirectoryListOptions _getOptions() const;
                 void _pathUpdate();
+                void _changesUpdate();
+                void _futureUpdate();
 
                 DJV_PRIVATE();
             };
@@ -8,6 +8,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace djv
 {
@@ -38,6 +40,28 @@ namespace djv
 
                 void setCallback(const std::function<void(void)>&);
 
+                //! This enumeration provides the types of changes.
+                enum class ChangeType
+                {
+                    Created,  //!< A file was created
+                    Deleted,  //!< A file was deleted
+                    Modified, //!< A file was modified
+                    Reset     //!< The whole directory has changed
+                };
+
+                //! This struct provides a change to a file in the directory.
+                struct Change
+                {
+                    ChangeType  type = ChangeType::Modified;
+                    std::string fileName;
+                };
+
+                //! Set the callback for the changes. The changes are combined over
+                //! a short interval so that there is only one change for each file.
+                //! Platforms that cannot provide the changes to each file use a
+                //! single reset change instead.
+                void setChangesCallback(const std::function<void(const std::vector<Change>&)>&);
+
             private:
                 DJV_PRIVATE();
             };
@@ -7,9 +7,9 @@
 #include <djvCore/Context.h>
 #include <djvCore/Timer.h>
 
-#include <ctime>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 
 #if defined(DJV_PLATFORM_MACOS)
 #include <CoreServices/CoreServices.h>
@@ -31,6 +31,89 @@ namespace djv
         {
             namespace
             {
+                //! \todo Should this be configurable?
+                const size_t changesMax = 10000;
+
+                //! This class combines the changes to each file.
+                class ChangeList
+                {
+                public:
+                    void add(DirectoryWatcher::ChangeType type, const std::string& fileName)
+                    {
+                        if (_reset)
+                            return;
+                        if (DirectoryWatcher::ChangeType::Reset == type || _changes.size() >= changesMax)
+                        {
+                            // Too many changes are replaced with a single reset.
+                            clear();
+                            _reset = true;
+                            DirectoryWatcher::Change change;
+                            change.type = DirectoryWatcher::ChangeType::Reset;
+                            _changes.push_back(change);
+                            return;
+                        }
+                        const auto i = _index.find(fileName);
+                        if (i == _index.end())
+                        {
+                            _index[fileName] = _changes.size();
+                            DirectoryWatcher::Change change;
+                            change.type = type;
+                            change.fileName = fileName;
+                            _changes.push_back(change);
+                        }
+                        else
+                        {
+                            // A file that is created and then modified is still a
+                            // new file, and a file that is deleted and then created
+                            // has been modified.
+                            auto& change = _changes[i->second];
+                            if (DirectoryWatcher::ChangeType::Deleted == change.type &&
+                                DirectoryWatcher::ChangeType::Created == type)
+                            {
+                                change.type = DirectoryWatcher::ChangeType::Modified;
+                            }
+                            else if (!(DirectoryWatcher::ChangeType::Created == change.type &&
+                                DirectoryWatcher::ChangeType::Modified == type))
+                            {
+                                change.type = type;
+                            }
+                        }
+                    }
+
+                    void add(const ChangeList& value)
+                    {
+                        for (const auto& i : value._changes)
+                        {
+                            add(i.type, i.fileName);
+                        }
+                    }
+
+                    bool isEmpty() const
+                    {
+                        return _changes.empty();
+                    }
+
+                    std::vector<DirectoryWatcher::Change> take()
+                    {
+                        std::vector<DirectoryWatcher::Change> out;
+                        std::swap(out, _changes);
+                        clear();
+                        return out;
+                    }
+
+                    void clear()
+                    {
+                        _changes.clear();
+                        _index.clear();
+                        _reset = false;
+                    }
+
+                private:
+                    std::vector<DirectoryWatcher::Change> _changes;
+                    std::unordered_map<std::string, size_t> _index;
+                    bool _reset = false;
+                };
+
 #if defined(DJV_PLATFORM_MACOS)
                 class Notify
                 {
@@ -63,18 +146,19 @@ namespace djv
                         }
                     }
                                         
-                    ::time_t poll()
+                    //! The file names are not available, so any change resets the
+                    //! directory.
+                    void poll(ChangeList& changes)
                     {
                         struct kevent eventData[1];
                         timespec _timeout;
                         _timeout.tv_sec = 0;
                         _timeout.tv_nsec = Time::getValue(Time::TimerValue::Medium) * 1000000;
                         int eventCount = ::kevent(_kq, _eventsToMonitor, 1, eventData, 1, &_timeout);
-                        if (eventCount)
+                        if (eventCount > 0)
                         {
-                            _lastModified = time(nullptr);
+                            changes.add(DirectoryWatcher::ChangeType::Reset, std::string());
                         }
-                        return _lastModified;
                     }
                     
                 private:
@@ -82,7 +166,6 @@ namespace djv
                     int _kq = 0;
                     int _fd = 0;
                     struct kevent _eventsToMonitor[1];
-                    ::time_t _lastModified = 0;
                 };
 
 #else // DJV_PLATFORM_MACOS
@@ -96,15 +179,25 @@ namespace djv
                         _fd = ::inotify_init1(IN_NONBLOCK);
                         if (_fd)
                         {
-                            _wd = ::inotify_add_watch(_fd, _path.get().c_str(), IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB);
+                            _wd = ::inotify_add_watch(
+                                _fd,
+                                _path.get().c_str(),
+                                IN_CREATE |
+                                IN_DELETE |
+                                IN_MODIFY |
+                                IN_ATTRIB |
+                                IN_CLOSE_WRITE |
+                                IN_MOVED_FROM |
+                                IN_MOVED_TO |
+                                IN_DELETE_SELF |
+                                IN_MOVE_SELF);
                         }
                     }
 
                     Notify(Notify&& other) noexcept :
                         _path(other._path),
                         _fd(other._fd),
-                        _wd(other._wd),
-                        _lastModified(other._lastModified)
+                        _wd(other._wd)
                     {}
                     
                     ~Notify()
@@ -128,43 +221,56 @@ namespace djv
                             _path = other._path;
                             _fd = other._fd;
                             _wd = other._wd;
-                            _lastModified = other._lastModified;
                         }
                         return *this;
                     }
                                         
-                    ::time_t poll()
+                    void poll(ChangeList& changes)
                     {
                         if (_fd && _wd)
                         {
+                            // Read all of the pending events.
                             static const size_t bufferSize = 1024 * (sizeof(::inotify_event) + 16);
                             char buffer[bufferSize];
-                            const int length = ::read(_fd, buffer, bufferSize);
-                            int i = 0;
-                            while (i < length)
+                            int length = 0;
+                            while ((length = ::read(_fd, buffer, bufferSize)) > 0)
                             {
-                                ::inotify_event* event = (::inotify_event*)&buffer[i];
-                                if (event->len)
+                                int i = 0;
+                                while (i < length)
                                 {
-                                    if (event->mask & IN_CREATE ||
-                                        event->mask & IN_DELETE ||
-                                        event->mask & IN_MODIFY)
+                                    ::inotify_event* event = (::inotify_event*)&buffer[i];
+                                    if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF))
+                                    {
+                                        // Events have been lost, or the directory itself
+                                        // has changed.
+                                        changes.add(DirectoryWatcher::ChangeType::Reset, std::string());
+                                    }
+                                    else if (event->len)
                                     {
-                                        _lastModified = time(nullptr);
-                                        break;
+                                        const std::string fileName(event->name);
+                                        if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                                        {
+                                            changes.add(DirectoryWatcher::ChangeType::Created, fileName);
+                                        }
+                                        else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                                        {
+                                            changes.add(DirectoryWatcher::ChangeType::Deleted, fileName);
+                                        }
+                                        else if (event->mask & (IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE))
+                                        {
+                                            changes.add(DirectoryWatcher::ChangeType::Modified, fileName);
+                                        }
                                     }
+                                    i += sizeof(::inotify_event) + event->len;
                                 }
-                                i += sizeof(::inotify_event) + event->len;
                             }
                         }
-                        return _lastModified;
                     }
                     
                 private:
                     Path _path;
                     int _fd = 0;
                     int _wd = 0;
-                    ::time_t _lastModified = 0;
                 };
 #endif // DJV_PLATFORM_MACOS
 
@@ -176,10 +282,10 @@ namespace djv
                 bool running = false;
                 std::thread thread;
                 std::timed_mutex mutex;
-                ::time_t lastModified = 0;
-                ::time_t threadModified = 0;
+                ChangeList changes;
                 std::shared_ptr<Time::Timer> timer;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<Change>&)> changesCallback;
             };
 
             void DirectoryWatcher::_init(const std::shared_ptr<Context>& context)
@@ -194,7 +300,7 @@ namespace djv
                     Path path;
                     bool pathInit = false;
                     std::unique_ptr<Notify> notify;
-                    ::time_t lastModified = 0;                    
+                    ChangeList changes;
                     bool running = true;
                     while (running)
                     {
@@ -207,10 +313,13 @@ namespace djv
                                 running = p.running;
                                 if (path != p.path)
                                 {
+                                    // Discard the changes from the previous path.
                                     path = p.path;
                                     pathInit = true;
+                                    changes.clear();
                                 }
-                                p.threadModified = lastModified;                                                        
+                                p.changes.add(changes);
+                                changes.clear();
                                 p.mutex.unlock();
                             }
                         }
@@ -230,7 +339,7 @@ namespace djv
                         if (notify)
                         {
                             // Poll for events.
-                            lastModified = notify->poll();
+                            notify->poll(changes);
                         }
                         
                         std::this_thread::sleep_for(timeout);
@@ -245,20 +354,26 @@ namespace djv
                 {
                     if (auto watcher = weak.lock())
                     {
+                        // The changes that have been collected since the last
+                        // timeout are handled together.
                         auto & p = *watcher->_p;
+                        std::vector<Change> changes;
                         if (p.mutex.try_lock_for(timeout))
                         {
-                            if (p.threadModified != p.lastModified)
-                            {                            
-                                p.lastModified = p.threadModified;
-                                
-                                if (p.callback)
-                                {
-                                    p.callback();
-                                }
-                            }
+                            changes = p.changes.take();
                             p.mutex.unlock();
                         }
+                        if (changes.size())
+                        {
+                            if (p.callback)
+                            {
+                                p.callback();
+                            }
+                            if (p.changesCallback)
+                            {
+                                p.changesCallback(changes);
+                            }
+                        }
                     }
                 });
             }
@@ -290,7 +405,13 @@ namespace djv
 
             void DirectoryWatcher::setPath(const Path& value)
             {
-                _p->path = value;
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::timed_mutex> lock(p.mutex);
+                if (value != p.path)
+                {
+                    p.path = value;
+                    p.changes.clear();
+                }
             }
 
             void DirectoryWatcher::setCallback(const std::function<void(void)>& value)
@@ -298,6 +419,11 @@ namespace djv
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<Change>&)>& value)
+            {
+                _p->changesCallback = value;
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
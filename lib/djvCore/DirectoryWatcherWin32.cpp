@@ -34,11 +34,13 @@ namespace djv
             {
                 Path path;
                 bool changed = false;
+                bool reset = false;
                 std::condition_variable changedCV;
                 std::mutex mutex;
                 std::thread thread;
                 std::atomic<bool> running = true;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<Change>&)> changesCallback;
                 std::shared_ptr<Time::Timer> timer;
             };
 
@@ -117,8 +119,11 @@ namespace djv
                             case WAIT_OBJECT_0:
                                 FindNextChangeNotification(changeHandle);
                                 {
+                                    // The change notification does not provide the file
+                                    // names, so the whole directory is reset.
                                     std::lock_guard<std::mutex> lock(p.mutex);
                                     p.changed = true;
+                                    p.reset = true;
                                 }
                                 break;
                             }
@@ -142,6 +147,7 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     bool changed = false;
+                    bool reset = false;
                     {
                         std::unique_lock<std::mutex> lock(p.mutex);
                         if (p.changedCV.wait_for(
@@ -154,12 +160,20 @@ namespace djv
                         {
                             changed = true;
                             p.changed = false;
+                            reset = p.reset;
+                            p.reset = false;
                         }
                     }
                     if (changed && p.callback)
                     {
                         p.callback();
                     }
+                    if (reset && p.changesCallback)
+                    {
+                        Change change;
+                        change.type = ChangeType::Reset;
+                        p.changesCallback({ change });
+                    }
                 });
             }
 
@@ -198,6 +212,7 @@ namespace djv
                     std::lock_guard<std::mutex> lock(p.mutex);
                     p.path = value;
                     p.changed = true;
+                    p.reset = false;
                 }
                 if (p.callback)
                 {
@@ -210,6 +225,11 @@ namespace djv
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<Change>&)>& value)
+            {
+                _p->changesCallback = value;
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
@@ -39,17 +39,17 @@ namespace djv
 
             std::string FileIO::readContents(const std::shared_ptr<FileIO>& io)
             {
-#ifdef DJV_MMAP
-                const uint8_t * p = io->mmapP();
-                const uint8_t * end = io->mmapEnd();
-                return std::string(reinterpret_cast<const char *>(p), end - p);
-#else // DJV_MMAP
+                if (io->isMemoryMapped())
+                {
+                    const uint8_t * p = io->mmapP();
+                    const uint8_t * end = io->mmapEnd();
+                    return std::string(reinterpret_cast<const char *>(p), end - p);
+                }
                 const size_t fileSize = io->getSize();
                 std::string out;
                 out.resize(fileSize);
                 io->read(reinterpret_cast<void*>(&out[0]), fileSize);
                 return out;
-#endif // DJV_MMAP
             }
 
             void FileIO::readWord(const std::shared_ptr<FileIO>& io, char * out, size_t maxLen)
@@ -9,17 +9,7 @@
 #include <memory>
 
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif // WIN32_LEAN_AND_MEAN
-#ifndef NOMINMAX
-#define NOMINMAX
-#endif // NOMINMAX
-#include <windows.h>
-#else // DJV_MMAP
 #include <stdio.h>
-#endif // DJV_MMAP
 #endif // DJV_PLATFORM_WINDOWS
 
 namespace djv
@@ -52,10 +42,12 @@ namespace djv
                     First = Read
                 };
 
-                //! Open the file.
+                //! Open the file. Files opened for reading can optionally be
+                //! memory mapped, if the file cannot be mapped it is read
+                //! normally instead.
                 //! Throws:
                 //! - Error
-                void open(const std::string& fileName, Mode);
+                void open(const std::string& fileName, Mode, bool memoryMap = false);
 
                 //! Open a temporary file.
                 //! Throws:
@@ -133,15 +125,20 @@ namespace djv
                 ///@}
 
                 //! \name Memory Mapping
+                //! The memory mapping is read-only and remains valid until the
+                //! file is closed. Accessing the mapping after the file has been
+                //! truncated by another process is an error (SIGBUS on Unix), so
+                //! data that outlives the read should be copied.
                 ///@{
 
-#if defined(DJV_MMAP)
+                //! Get whether the file is memory mapped.
+                bool isMemoryMapped() const;
+
                 //! Get the current memory-map position.
                 const uint8_t * mmapP() const;
 
                 //! Get a pointer to the end of the memory-map.
                 const uint8_t * mmapEnd() const;
-#endif // DJV_MMAP
 
                 ///@}
 
@@ -196,26 +193,13 @@ namespace djv
                 size_t          _size               = 0;
                 bool            _endianConversion   = false;
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                HANDLE          _f                  = INVALID_HANDLE_VALUE;
-#else // DJV_MMAP
                 FILE*           _f                  = nullptr;
-#endif // DJV_MMAP
-#if defined(DJV_MMAP)
-                void *          _mmap               = nullptr;
-                const uint8_t * _mmapStart          = nullptr;
-                const uint8_t * _mmapEnd            = nullptr;
-                const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
 #else // DJV_PLATFORM_WINDOWS
                 int             _f                  = -1;
-#if defined(DJV_MMAP)
-                void *          _mmap               = reinterpret_cast<void *>(-1);
+#endif //DJV_PLATFORM_WINDOWS
                 const uint8_t * _mmapStart          = nullptr;
                 const uint8_t * _mmapEnd            = nullptr;
                 const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
-#endif //DJV_PLATFORM_WINDOWS
             };
 
         } // namespace FileSystem
@@ -14,13 +14,9 @@ namespace djv
             inline bool FileIO::isOpen() const
             {
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                return _f != INVALID_HANDLE_VALUE;
-#else // DJV_MMAP
-                return _f != nullptr;
-#endif // DJV_MMAP
+                return _f != nullptr || _mmapStart != nullptr;
 #else // DJV_PLATFORM_WINDOWS
-                return _f != -1;
+                return _f != -1 || _mmapStart != nullptr;
 #endif //DJV_PLATFORM_WINDOWS
             }
 
@@ -41,24 +37,16 @@ namespace djv
 
             inline bool FileIO::isEOF() const
             {
-#if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                return
-                    _f == INVALID_HANDLE_VALUE ||
-                    (_size ? _pos >= _size : true);
-#else // DJV_MMAP
-                return
-                    !_f ||
-                    (_size ? _pos >= _size : true);
-#endif // DJV_MMAP
-#else // DJV_PLATFORM_WINDOWS
                 return
-                    -1 == _f ||
+                    !isOpen() ||
                     (_size ? _pos >= _size : true);
-#endif //DJV_PLATFORM_WINDOWS
             }
 
-#if defined(DJV_MMAP)
+            inline bool FileIO::isMemoryMapped() const
+            {
+                return _mmapStart != nullptr;
+            }
+
             inline const uint8_t * FileIO::mmapP() const
             {
                 return _mmapP;
@@ -68,7 +56,6 @@ namespace djv
             {
                 return _mmapEnd;
             }
-#endif // DJV_MMAP
 
             inline bool FileIO::hasEndianConversion() const
             {
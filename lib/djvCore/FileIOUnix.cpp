@@ -115,7 +115,7 @@ namespace djv
             
             } // namespace
                         
-            void FileIO::open(const std::string& fileName, Mode mode)
+            void FileIO::open(const std::string& fileName, Mode mode, bool memoryMap)
             {
                 close();
 
@@ -159,21 +159,23 @@ namespace djv
                 _pos      = 0;
                 _size     = info.st_size;
 
-#if defined(DJV_MMAP)
-                // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
+                // Memory mapping. The mapping is private and read-only so that it
+                // is never written back to the file. The mapping remains valid
+                // after the file descriptor is closed, so the descriptor is not
+                // kept open while the mapping is in use.
+                if (memoryMap && Mode::Read == _mode && _size > 0)
                 {
-                    _mmap = mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
-                    madvise(_mmap, _size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
-                    if (_mmap == (void *) - 1)
+                    void* p = mmap(0, _size, PROT_READ, MAP_PRIVATE, _f, 0);
+                    if (p != MAP_FAILED)
                     {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                        madvise(p, _size, MADV_SEQUENTIAL);
+                        _mmapStart = reinterpret_cast<const uint8_t *>(p);
+                        _mmapEnd   = _mmapStart + _size;
+                        _mmapP     = _mmapStart;
+                        ::close(_f);
+                        _f = -1;
                     }
-                    _mmapStart = reinterpret_cast<const uint8_t *>(_mmap);
-                    _mmapEnd   = _mmapStart + _size;
-                    _mmapP     = _mmapStart;
                 }
-#endif // DJV_MMAP
             }
             
             void FileIO::openTemp()
@@ -210,10 +212,9 @@ namespace djv
                 bool out = true;
                 
                 _fileName = std::string();
-#if defined(DJV_MMAP)
-                if (_mmap != (void *) - 1)
+                if (_mmapStart)
                 {
-                    int r = munmap(_mmap, _size);
+                    int r = munmap(const_cast<uint8_t*>(_mmapStart), _size);
                     if (-1 == r)
                     {
                         out = false;
@@ -222,11 +223,10 @@ namespace djv
                             *error = getErrorMessage(ErrorType::CloseMemoryMap, _fileName);
                         }
                     }
-                    _mmap = (void *)-1;
+                    _mmapStart = nullptr;
                 }
-                _mmapStart = 0;
-                _mmapEnd   = 0;
-#endif // DJV_MMAP
+                _mmapEnd = nullptr;
+                _mmapP   = nullptr;
                 if (_f != -1)
                 {
                     int r = ::close(_f);
@@ -254,32 +254,35 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t* mmapP = _mmapP + size * wordSize;
-                    if (mmapP > _mmapEnd)
+                    if (_mmapStart)
                     {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(_mmapP, in, size, wordSize);
+                        const uint8_t* mmapP = _mmapP + size * wordSize;
+                        if (mmapP > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(_mmapP, in, size, wordSize);
+                        }
+                        else
+                        {
+                            memcpy(in, _mmapP, size * wordSize);
+                        }
+                        _mmapP = mmapP;
                     }
                     else
                     {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = mmapP;
-#else // DJV_MMAP
-                    const size_t r = ::read(_f, in, size * wordSize);
-                    if (r != size * wordSize)
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(in, size, wordSize);
+                        const size_t r = ::read(_f, in, size * wordSize);
+                        if (r != size * wordSize)
+                        {
+                            throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(in, size, wordSize);
+                        }
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -324,25 +327,19 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    if (!seek)
+                    if (_mmapStart)
                     {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + in;
-                    }
-                    else
-                    {
-                        _mmapP += in;
-                    }
-                    if (_mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        const uint8_t* mmapP = !seek ? (_mmapStart + in) : (_mmapP + in);
+                        if (mmapP > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        }
+                        _mmapP = mmapP;
                     }
-#else // DJV_MMAP
-                    if (::lseek(_f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t) - 1)
+                    else if (::lseek(_f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t) - 1)
                     {
                         throw Error(getErrorMessage(ErrorType::Seek, _fileName));
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::Write:
@@ -101,77 +101,10 @@ namespace djv
                 
             } // namespace
             
-            void FileIO::open(const std::string& fileName, Mode mode)
+            void FileIO::open(const std::string& fileName, Mode mode, bool memoryMap)
             {
                 close();
 
-#if defined(DJV_MMAP)
-                // Open the file.
-                DWORD desiredAccess = 0;
-                DWORD shareMode = 0;
-                DWORD disposition = 0;
-                DWORD flags =
-                    //FILE_ATTRIBUTE_NORMAL;
-                    FILE_FLAG_SEQUENTIAL_SCAN;
-                switch (mode)
-                {
-                case Mode::Read:
-                    desiredAccess = GENERIC_READ;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                case Mode::Write:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::ReadWrite:
-                    desiredAccess = GENERIC_READ | GENERIC_WRITE;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::Append:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                default: break;
-                }
-                try
-                {
-                    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
-                    _f = CreateFileW(utf16.from_bytes(fileName).c_str(), desiredAccess, shareMode, 0, disposition, flags, 0);
-                }
-                catch (const std::exception&)
-                {
-                    _f = INVALID_HANDLE_VALUE;
-                }
-                if (INVALID_HANDLE_VALUE == _f)
-                {
-                    throw Error(getErrorMessage(ErrorType::Open, fileName));
-                }
-                _fileName = fileName;
-                _mode = mode;
-                _pos = 0;
-                _size = GetFileSize(_f, 0);
-
-                // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
-                {
-                    _mmap = CreateFileMapping(_f, 0, PAGE_READONLY, 0, 0, 0);
-                    if (!_mmap)
-                    {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
-                    }
-
-                    _mmapStart = reinterpret_cast<const uint8_t *>(MapViewOfFile(_mmap, FILE_MAP_READ, 0, 0, 0));
-                    if (!_mmapStart)
-                    {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
-                    }
-
-                    _mmapEnd = _mmapStart + _size;
-                    _mmapP = _mmapStart;
-                }
-#else // DJV_MMAP
                 std::string modeStr;
                 switch (mode)
                 {
@@ -206,7 +139,26 @@ namespace djv
                 {
                     throw Error(getErrorMessage(ErrorType::Open, fileName));
                 }
-#endif // DJV_MMAP
+
+                // Memory mapping. The view keeps the file open until it is
+                // unmapped, so the file and mapping handles are closed here.
+                if (memoryMap && Mode::Read == _mode && _size > 0)
+                {
+                    HANDLE f = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(_f)));
+                    HANDLE mapping = CreateFileMapping(f, 0, PAGE_READONLY, 0, 0, 0);
+                    if (mapping)
+                    {
+                        _mmapStart = reinterpret_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                        CloseHandle(mapping);
+                        if (_mmapStart)
+                        {
+                            _mmapEnd = _mmapStart + _size;
+                            _mmapP = _mmapStart;
+                            fclose(_f);
+                            _f = nullptr;
+                        }
+                    }
+                }
             }
 
             void FileIO::openTemp()
@@ -244,46 +196,26 @@ namespace djv
 
                 _fileName = std::string();
                 
-#if defined(DJV_MMAP)
-                if (_mmapStart != 0)
+                if (_mmapStart)
                 {
                     if (!::UnmapViewOfFile((void *)_mmapStart))
                     {
                         out = false;
                         if (error)
                         {
-                            *error = getErrorMessage(Error::CloseMemoryMap, _fileName);
-                        }
-                    }
-                    _mmapStart = 0;
-                }
-                if (_mmap != 0)
-                {
-                    if (!::CloseHandle(_mmap))
-                    {
-                        out = false;
-                        if (error)
-                        {
-                            *error = getErrorMessage(Error::Close, _fileName);
+                            *error = getErrorMessage(ErrorType::CloseMemoryMap, _fileName);
                         }
                     }
-                    _mmap = 0;
+                    _mmapStart = nullptr;
                 }
-                _mmapEnd = 0;
-                _mmapP   = 0;
+                _mmapEnd = nullptr;
+                _mmapP   = nullptr;
 
-                if (_f != INVALID_HANDLE_VALUE)
-                {
-                    CloseHandle(_f);
-                    _f = INVALID_HANDLE_VALUE;
-                }
-#else // DJV_MMAP
                 if (_f)
                 {
                     fclose(_f);
                     _f = nullptr;
                 }
-#endif // DJV_MMAP
 
                 _mode = Mode::First;
                 _pos  = 0;
@@ -298,37 +230,35 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t * p = _mmapP + size * wordSize;
-                    if (p > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
+                    if (_mmapStart)
                     {
-                        Memory::endian(_mmapP, in, size, wordSize);
+                        const uint8_t * p = _mmapP + size * wordSize;
+                        if (p > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(_mmapP, in, size, wordSize);
+                        }
+                        else
+                        {
+                            memcpy(in, _mmapP, size * wordSize);
+                        }
+                        _mmapP = p;
                     }
                     else
                     {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = p;
-#else // DJV_MMAP
-                    /*DWORD n;
-                    if (!::ReadFile(_f, in, static_cast<DWORD>(size * wordSize), &n, 0))
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }*/
-                    size_t r = fread(in, 1, size * wordSize, _f);
-                    if (r != size * wordSize)
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(in, size, wordSize);
+                        size_t r = fread(in, 1, size * wordSize, _f);
+                        if (r != size * wordSize)
+                        {
+                            throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(in, size, wordSize);
+                        }
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -387,35 +317,19 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    if (!seek)
+                    if (_mmapStart)
                     {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + value;
-                    }
-                    else
-                    {
-                        _mmapP += value;
-                    }
-                    if (_mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        const uint8_t* p = !seek ? (_mmapStart + value) : (_mmapP + value);
+                        if (p > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        }
+                        _mmapP = p;
                     }
-#else // DJV_MMAP
-                    /*LARGE_INTEGER v;
-                    v.QuadPart = value;
-                    if (!::SetFilePointerEx(
-                        _f,
-                        static_cast<LARGE_INTEGER>(v),
-                        0,
-                        !seek ? FILE_BEGIN : FILE_CURRENT))
-                    {
-                        throw Error(getErrorMessage(ErrorType::Seek, _fileName));
-                    }*/
-                    if (fseek(_f, value, !seek ? SEEK_SET : SEEK_CUR) != 0)
+                    else if (fseek(_f, value, !seek ? SEEK_SET : SEEK_CUR) != 0)
                     {
                         throw Error(getErrorMessage(ErrorType::Seek, _fileName));
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::Write:
@@ -4,6 +4,15 @@
 
 #include <djvCore/FileInfo.h>
 
+#include <djvCore/String.h>
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <regex>
+#include <thread>
+#include <unordered_map>
+
 //#pragma optimize("", off)
 
 namespace djv
@@ -12,6 +21,44 @@ namespace djv
     {
         namespace FileSystem
         {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t statTaskCountMin = 1000;
+
+                const size_t invalidIndex = static_cast<size_t>(-1);
+
+                std::string getSequenceKey(const Path& value)
+                {
+                    return value.getDirectoryName() + '\0' + value.getBaseName() + '\0' + value.getExtension();
+                }
+
+                bool containsFrames(const Frame::Sequence& sequence, const std::vector<Frame::Range>& ranges)
+                {
+                    for (const auto& range : ranges)
+                    {
+                        for (Frame::Number frame = range.getMin(); frame <= range.getMax(); ++frame)
+                        {
+                            bool found = false;
+                            for (const auto& i : sequence.getRanges())
+                            {
+                                if (frame >= i.getMin() && frame <= i.getMax())
+                                {
+                                    found = true;
+                                    break;
+                                }
+                            }
+                            if (!found)
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                    return ranges.size() > 0;
+                }
+
+            } // namespace
+
             std::string getFilePermissionsLabel(int in)
             {
                 const std::vector<std::string> data =
@@ -126,34 +173,472 @@ namespace djv
                 return out;
             }
 
-            void FileInfo::_fileSequence(FileInfo& fileInfo, const DirectoryListOptions& options, std::vector<FileInfo>& out)
+            void FileInfo::directoryListUpdate(
+                std::vector<FileInfo>& out,
+                const Path& path,
+                const std::vector<std::string>& fileNames,
+                const DirectoryListOptions& options,
+                std::map<std::string, uint64_t>* frameSizes)
             {
-                std::string extension = fileInfo.getPath().getExtension();
-                std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
-                const auto i = std::find(
-                    options.fileSequenceExtensions.begin(),
-                    options.fileSequenceExtensions.end(),
-                    extension);
-                if (options.fileSequences && i != options.fileSequenceExtensions.end())
-                {
-                    const size_t size = out.size();
-                    size_t j = 0;
-                    for (; j < size; ++j)
-                    {
-                        if (out[j].addToSequence(fileInfo))
+                const DirectoryListFilter filter(options);
+
+                // Index the listing so the items for the changes don't need to be
+                // searched for. Removed items are erased at the end.
+                std::map<std::string, size_t> fileIndex;
+                std::map<std::string, size_t> sequenceIndex;
+                std::vector<bool> removed(out.size(), false);
+                const auto addToIndex = [&out, &fileIndex, &sequenceIndex](size_t index)
+                {
+                    const auto& item = out[index];
+                    if (item._type != FileType::Sequence)
+                    {
+                        fileIndex[item._path.get()] = index;
+                    }
+                    if (item._type != FileType::Directory && !item._path.getNumber().empty())
+                    {
+                        sequenceIndex[getSequenceKey(item._path)] = index;
+                    }
+                };
+                for (size_t i = 0; i < out.size(); ++i)
+                {
+                    addToIndex(i);
+                }
+
+                std::set<size_t> statItems;
+                for (const auto& fileName : fileNames)
+                {
+                    FileInfo fileInfo(Path(path, fileName));
+                    std::vector<Frame::Range> ranges;
+                    size_t pad = 0;
+                    const bool sequence =
+                        options.fileSequences &&
+                        FileType::Directory != fileInfo._type &&
+                        _getSequenceRanges(options, fileInfo._path, ranges, pad);
+                    const bool filtered = filter.isFiltered(fileName, FileType::Directory == fileInfo._type, '.' == fileName[0]);
+
+                    // Find the item for the file, which is either the file itself
+                    // or the file sequence it belongs to.
+                    size_t sequenceItem = invalidIndex;
+                    if (sequence)
+                    {
+                        const auto i = sequenceIndex.find(getSequenceKey(fileInfo._path));
+                        if (i != sequenceIndex.end() && !removed[i->second])
+                        {
+                            sequenceItem = i->second;
+                        }
+                    }
+                    size_t item = invalidIndex;
+                    if (sequenceItem != invalidIndex &&
+                        (FileType::Sequence == out[sequenceItem]._type || out[sequenceItem]._path == fileInfo._path))
+                    {
+                        item = sequenceItem;
+                    }
+                    else
+                    {
+                        const auto i = fileIndex.find(fileInfo._path.get());
+                        if (i != fileIndex.end() &&
+                            !removed[i->second] &&
+                            out[i->second]._type != FileType::Sequence &&
+                            out[i->second]._path == fileInfo._path)
+                        {
+                            item = i->second;
+                        }
+                    }
+
+                    // A frame of a file sequence that has been modified only
+                    // updates the sequence information.
+                    if (item != invalidIndex &&
+                        FileType::Sequence == out[item]._type &&
+                        fileInfo._exists &&
+                        !filtered &&
+                        containsFrames(out[item]._sequence, ranges))
+                    {
+                        auto& i = out[item];
+                        if (frameSizes)
+                        {
+                            // The size of the sequence can only be updated if the
+                            // previous size of the frame is known.
+                            const auto j = frameSizes->find(fileInfo._path.get());
+                            if (j != frameSizes->end())
+                            {
+                                i._size = i._size - j->second + fileInfo._size;
+                            }
+                            (*frameSizes)[fileInfo._path.get()] = fileInfo._size;
+                        }
+                        i._user = std::max(i._user, fileInfo._user);
+                        i._time = std::max(i._time, fileInfo._time);
+                        continue;
+                    }
+
+                    // Remove the previous information for the file.
+                    if (item != invalidIndex)
+                    {
+                        auto& i = out[item];
+                        if (FileType::Sequence == i._type)
+                        {
+                            Frame::Sequence tmp = i._sequence;
+                            for (const auto& range : ranges)
+                            {
+                                for (Frame::Number frame = range.getMin(); frame <= range.getMax(); ++frame)
+                                {
+                                    tmp.remove(frame);
+                                }
+                            }
+                            if (tmp.getRanges() != i._sequence.getRanges())
+                            {
+                                // Subtract the size of the removed frame if it is
+                                // known, otherwise the sequence is stat'ed again
+                                // after the changes.
+                                bool sizeKnown = false;
+                                if (frameSizes)
+                                {
+                                    const auto j = frameSizes->find(fileInfo._path.get());
+                                    if (j != frameSizes->end())
+                                    {
+                                        i._size -= std::min(i._size, j->second);
+                                        frameSizes->erase(j);
+                                        sizeKnown = true;
+                                    }
+                                }
+                                switch (tmp.getFrameCount())
+                                {
+                                case 0:
+                                    removed[item] = true;
+                                    break;
+                                case 1:
+                                    // A single frame is no longer a file sequence.
+                                    i._path.setNumber(Frame::toString(tmp.getFrame(0), tmp.getPad()));
+                                    i.setPath(i._path);
+                                    addToIndex(item);
+                                    break;
+                                default:
+                                    i.setSequence(tmp);
+                                    if (!sizeKnown)
+                                    {
+                                        statItems.insert(item);
+                                    }
+                                    break;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            removed[item] = true;
+                        }
+                    }
+
+                    // Add the new information for the file.
+                    if (fileInfo._exists && !filtered)
+                    {
+                        size_t target = invalidIndex;
+                        if (sequence)
+                        {
+                            const auto i = sequenceIndex.find(getSequenceKey(fileInfo._path));
+                            if (i != sequenceIndex.end() && !removed[i->second])
+                            {
+                                target = i->second;
+                            }
+                        }
+                        if (target != invalidIndex)
+                        {
+                            // Extend the file sequence, or create a new one from a
+                            // single file.
+                            auto& i = out[target];
+                            Frame::Sequence tmp = i._sequence;
+                            if (i._type != FileType::Sequence)
+                            {
+                                std::vector<Frame::Range> fileRanges;
+                                size_t filePad = 0;
+                                _getSequenceRanges(options, i._path, fileRanges, filePad);
+                                tmp = Frame::Sequence(fileRanges, filePad);
+                                if (frameSizes)
+                                {
+                                    (*frameSizes)[i._path.get()] = i._size;
+                                }
+                            }
+                            for (const auto& range : ranges)
+                            {
+                                tmp.add(range);
+                            }
+                            tmp.setPad(std::max(tmp.getPad(), pad));
+                            i._type = FileType::Sequence;
+                            i.setSequence(tmp);
+                            i._size += fileInfo._size;
+                            i._user = std::max(i._user, fileInfo._user);
+                            i._time = std::max(i._time, fileInfo._time);
+                            if (frameSizes)
+                            {
+                                (*frameSizes)[fileInfo._path.get()] = fileInfo._size;
+                            }
+                        }
+                        else
                         {
-                            break;
+                            out.push_back(std::move(fileInfo));
+                            removed.push_back(false);
+                            addToIndex(out.size() - 1);
                         }
                     }
-                    if (size == j)
+                }
+
+                for (const auto i : statItems)
+                {
+                    if (!removed[i] && FileType::Sequence == out[i]._type)
+                    {
+                        out[i].stat();
+                    }
+                }
+                size_t j = 0;
+                for (size_t i = 0; i < out.size(); ++i)
+                {
+                    if (!removed[i])
                     {
-                        out.push_back(fileInfo);
+                        if (i != j)
+                        {
+                            out[j] = std::move(out[i]);
+                        }
+                        ++j;
+                    }
+                }
+                out.resize(j);
+
+                _sort(options, out);
+            }
+
+            struct FileInfo::DirectoryListFilter::Private
+            {
+                bool showHidden = false;
+                std::unique_ptr<std::regex> filter;
+                bool filterError = false;
+                std::vector<std::string> fileExtensions;
+            };
+
+            FileInfo::DirectoryListFilter::DirectoryListFilter(const DirectoryListOptions& options) :
+                _p(new Private)
+            {
+                DJV_PRIVATE_PTR();
+                p.showHidden = options.showHidden;
+                if (options.filter.size())
+                {
+                    try
+                    {
+                        p.filter.reset(new std::regex(options.filter, std::regex_constants::icase));
+                    }
+                    catch (const std::exception&)
+                    {
+                        // An invalid expression does not match any files.
+                        p.filterError = true;
+                    }
+                }
+                for (const auto& i : options.fileExtensions)
+                {
+                    p.fileExtensions.push_back(String::toLower(i));
+                }
+            }
+
+            FileInfo::DirectoryListFilter::~DirectoryListFilter()
+            {}
+
+            bool FileInfo::DirectoryListFilter::isFiltered(const std::string& fileName, bool directory, bool hidden) const
+            {
+                DJV_PRIVATE_PTR();
+                if (fileName.empty() ||
+                    (1 == fileName.size() && '.' == fileName[0]) ||
+                    (2 == fileName.size() && '.' == fileName[0] && '.' == fileName[1]))
+                {
+                    return true;
+                }
+                if (hidden && !p.showHidden)
+                {
+                    return true;
+                }
+                if (p.filterError || (p.filter && !std::regex_search(fileName, *p.filter)))
+                {
+                    return true;
+                }
+                if (!directory && p.fileExtensions.size())
+                {
+                    // Compare the end of the file name without case.
+                    for (const auto& i : p.fileExtensions)
+                    {
+                        const size_t size = i.size();
+                        if (fileName.size() >= size &&
+                            std::equal(
+                                i.begin(),
+                                i.end(),
+                                fileName.end() - size,
+                                [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); }))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            void FileInfo::_stat(std::vector<FileInfo>& value)
+            {
+                // Split the files across threads when there are enough of them.
+                const size_t size = value.size();
+                const auto statFiles = [&value](size_t i0, size_t i1)
+                {
+                    for (size_t i = i0; i < i1; ++i)
+                    {
+                        value[i].stat();
+                    }
+                };
+                const size_t threadCount = std::min(
+                    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                    std::max(size / statTaskCountMin, static_cast<size_t>(1)));
+                if (threadCount > 1)
+                {
+                    std::vector<std::future<void> > futures;
+                    const size_t count = (size + threadCount - 1) / threadCount;
+                    for (size_t i = 0; i < size; i += count)
+                    {
+                        futures.push_back(std::async(std::launch::async, statFiles, i, std::min(i + count, size)));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
                     }
                 }
                 else
                 {
-                    out.push_back(fileInfo);
+                    statFiles(0, size);
+                }
+            }
+
+            bool FileInfo::_getSequenceRanges(
+                const DirectoryListOptions& options,
+                const Path& path,
+                std::vector<Frame::Range>& ranges,
+                size_t& pad)
+            {
+                const std::string& number = path.getNumber();
+                if (number.empty())
+                    return false;
+                const std::string extension = String::toLower(path.getExtension());
+                if (options.fileSequenceExtensions.find(extension) == options.fileSequenceExtensions.end())
+                    return false;
+
+                // Parse the frame numbers, with a fast path for plain numbers.
+                if (number.size() <= 9 &&
+                    std::all_of(number.begin(), number.end(), [](char c) { return c >= '0' && c <= '9'; }))
+                {
+                    Frame::Number frame = 0;
+                    for (const auto c : number)
+                    {
+                        frame = frame * 10 + (c - '0');
+                    }
+                    ranges.push_back(Frame::Range(frame));
+                    pad = number.size() >= 2 && '0' == number[0] ? number.size() : 0;
+                }
+                else
+                {
+                    const Frame::Sequence tmp = _parseSequence(number);
+                    if (!tmp.isValid())
+                        return false;
+                    ranges = tmp.getRanges();
+                    pad = tmp.getPad();
+                }
+                return true;
+            }
+
+            void FileInfo::_fileSequences(
+                const DirectoryListOptions& options,
+                std::vector<FileInfo>& out,
+                std::map<std::string, uint64_t>* frameSizes)
+            {
+                if (!options.fileSequences)
+                    return;
+
+                // Group the files by directory, base name, and extension with a
+                // hash table, and collect the frames for each group.
+                struct Group
+                {
+                    size_t index = 0;
+                    size_t count = 0;
+                    std::vector<Frame::Range> ranges;
+                    size_t pad = 0;
+                };
+                std::unordered_map<std::string, size_t> groupIndex;
+                std::vector<Group> groups;
+                std::vector<FileInfo> list;
+                list.reserve(out.size());
+                for (auto& i : out)
+                {
+                    std::vector<Frame::Range> ranges;
+                    size_t pad = 0;
+                    if (!_getSequenceRanges(options, i._path, ranges, pad))
+                    {
+                        list.push_back(std::move(i));
+                        continue;
+                    }
+                    if (frameSizes)
+                    {
+                        (*frameSizes)[i._path.get()] = i._size;
+                    }
+
+                    const std::string key =
+                        i._path.getDirectoryName() + '\0' +
+                        i._path.getBaseName() + '\0' +
+                        i._path.getExtension();
+                    const auto j = groupIndex.find(key);
+                    if (j == groupIndex.end())
+                    {
+                        groupIndex[key] = groups.size();
+                        Group group;
+                        group.index = list.size();
+                        group.count = 1;
+                        group.ranges = std::move(ranges);
+                        group.pad = pad;
+                        groups.push_back(std::move(group));
+                        list.push_back(std::move(i));
+                    }
+                    else
+                    {
+                        auto& group = groups[j->second];
+                        auto& fileInfo = list[group.index];
+                        ++group.count;
+                        group.ranges.insert(group.ranges.end(), ranges.begin(), ranges.end());
+                        group.pad = std::max(group.pad, pad);
+                        fileInfo._size += i._size;
+                        fileInfo._user = std::max(fileInfo._user, i._user);
+                        fileInfo._time = std::max(fileInfo._time, i._time);
+                    }
+                }
+
+                // Create the sequences from the sorted frames. Files without any
+                // other frames are left as single files.
+                for (auto& group : groups)
+                {
+                    if (group.count < 2)
+                    {
+                        if (frameSizes)
+                        {
+                            frameSizes->erase(list[group.index]._path.get());
+                        }
+                        continue;
+                    }
+                    std::sort(
+                        group.ranges.begin(),
+                        group.ranges.end(),
+                        [](const Frame::Range& a, const Frame::Range& b)
+                    {
+                        return a.getMin() < b.getMin();
+                    });
+                    Frame::Sequence sequence;
+                    for (const auto& range : group.ranges)
+                    {
+                        sequence.add(range);
+                    }
+                    sequence.setPad(group.pad);
+                    auto& fileInfo = list[group.index];
+                    fileInfo._type = FileType::Sequence;
+                    fileInfo.setSequence(sequence);
                 }
+                out = std::move(list);
             }
 
             void FileInfo::_sort(const DirectoryListOptions& options, std::vector<FileInfo>& out)
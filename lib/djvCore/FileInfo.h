@@ -8,6 +8,8 @@
 #include <djvCore/Path.h>
 #include <djvCore/RapidJSON.h>
 
+#include <map>
+#include <memory>
 #include <set>
 
 #include <sys/types.h>
@@ -142,7 +144,29 @@ namespace djv
                 static bool isSequenceWildcard(const std::string&);
 
                 //! Get the contents of the given directory.
-                static std::vector<FileInfo> directoryList(const Path& path, const DirectoryListOptions& options = DirectoryListOptions());
+                //! \param frameSizes The sizes of the file sequence frames, which
+                //! can be passed to directoryListUpdate().
+                static std::vector<FileInfo> directoryList(
+                    const Path& path,
+                    const DirectoryListOptions& options = DirectoryListOptions(),
+                    std::map<std::string, uint64_t>* frameSizes = nullptr);
+
+                //! Update the contents of a directory listing for the given files,
+                //! which is faster than listing the directory again when only a
+                //! few of the files have changed. Files are added to, or removed
+                //! from, the matching file sequences.
+                //! \param fileNames The names of the files relative to the directory.
+                //! \param frameSizes The sizes of the file sequence frames from
+                //! directoryList() and the previous updates. This is used to
+                //! update the size of a file sequence when one of its frames
+                //! changes, instead of getting the information for all of the
+                //! frames.
+                static void directoryListUpdate(
+                    std::vector<FileInfo>&,
+                    const Path& path,
+                    const std::vector<std::string>& fileNames,
+                    const DirectoryListOptions& options = DirectoryListOptions(),
+                    std::map<std::string, uint64_t>* frameSizes = nullptr);
 
                 //! Get the file sequence for the given file.
                 static FileInfo getFileSequence(const Path&, const std::set<std::string>& extensions);
@@ -156,8 +180,25 @@ namespace djv
                 explicit operator std::string() const;
 
             private:
+                //! This class provides the directory listing filters, which are
+                //! prepared once for each listing instead of once for each file.
+                class DirectoryListFilter
+                {
+                public:
+                    explicit DirectoryListFilter(const DirectoryListOptions&);
+                    ~DirectoryListFilter();
+
+                    //! Get whether the file is removed from the listing.
+                    bool isFiltered(const std::string& fileName, bool directory, bool hidden) const;
+
+                private:
+                    DJV_PRIVATE();
+                };
+
                 static Frame::Sequence _parseSequence(const std::string&);
-                static void _fileSequence(FileInfo&, const DirectoryListOptions&, std::vector<FileInfo>&);
+                static bool _getSequenceRanges(const DirectoryListOptions&, const Path&, std::vector<Frame::Range>&, size_t& pad);
+                static void _stat(std::vector<FileInfo>&);
+                static void _fileSequences(const DirectoryListOptions&, std::vector<FileInfo>&, std::map<std::string, uint64_t>* frameSizes);
                 static void _sort(const DirectoryListOptions&, std::vector<FileInfo>&);
                 
                 Path            _path;
@@ -6,6 +6,8 @@
 
 #include <djvCore/Memory.h>
 
+#include <iterator>
+
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <dirent.h>
@@ -53,11 +55,11 @@ namespace djv
                         }
                         exists       = true;
                         size        += info.st_size;
-                        user         = std::min(_user, static_cast<uid_t>(info.st_uid));
+                        user         = std::max(user, static_cast<uid_t>(info.st_uid));
                         permissions |= (info.st_mode & S_IRUSR) ? static_cast<int>(FilePermissions::Read)  : 0;
                         permissions |= (info.st_mode & S_IWUSR) ? static_cast<int>(FilePermissions::Write) : 0;
                         permissions |= (info.st_mode & S_IXUSR) ? static_cast<int>(FilePermissions::Exec)  : 0;
-                        time         = std::max(_time, info.st_mtime);
+                        time         = std::max(time, info.st_mtime);
                     }
                     _exists      = exists;
                     _size        = size;
@@ -88,61 +90,47 @@ namespace djv
                 return true;
             }
 
-            std::vector<FileInfo> FileInfo::directoryList(const Path& value, const DirectoryListOptions& options)
+            std::vector<FileInfo> FileInfo::directoryList(
+                const Path& value,
+                const DirectoryListOptions& options,
+                std::map<std::string, uint64_t>* frameSizes)
             {
                 std::vector<FileInfo> out;
                 
-                // List the directory contents.
+                // List the directory contents. The file type from the directory
+                // entry is used for filtering, so only the files that are kept
+                // need to be stat'ed.
+                const DirectoryListFilter filter(options);
+                std::vector<FileInfo> list;
                 if (auto dir = opendir(value.get().c_str()))
                 {
                     dirent* de = nullptr;
                     while ((de = readdir(dir)))
                     {
-                        FileInfo fileInfo(Path(value, de->d_name));
-                        
-                        const std::string fileName = fileInfo.getFileName(-1, false);
-                        
-                        bool filter = false;
-                        if (fileName.size() > 0 && '.' == fileName[0])
-                        {
-                            filter = !options.showHidden;
-                        }
-                        if (fileName.size() == 1 && '.' == fileName[0])
-                        {
-                            filter = true;
-                        }
-                        if (fileName.size() == 2 && '.' == fileName[0] && '.' == fileName[1])
-                        {
-                            filter = true;
-                        }
-                        if (options.filter.size() && !String::match(fileName, options.filter))
+                        const std::string fileName(de->d_name);
+                        const bool hidden = '.' == fileName[0];
+                        if (DT_UNKNOWN == de->d_type || DT_LNK == de->d_type)
                         {
-                            filter = true;
-                        }
-                        if (!filter && !(de->d_type & DT_DIR) && options.fileExtensions.size())
-                        {
-                            bool match = false;
-                            for (const auto& i : options.fileExtensions)
-                            {
-                                if (String::match(fileName, '\\' + i + '$'))
-                                {
-                                    match = true;
-                                    break;
-                                }
-                            }
-                            if (!match)
+                            // Links, and file systems that do not provide the file
+                            // type, need to be stat'ed to find the directories.
+                            FileInfo fileInfo(Path(value, fileName));
+                            if (!filter.isFiltered(fileName, FileType::Directory == fileInfo.getType(), hidden))
                             {
-                                filter = true;
+                                out.push_back(std::move(fileInfo));
                             }
                         }
-
-                        if (!filter)
+                        else if (!filter.isFiltered(fileName, DT_DIR == de->d_type, hidden))
                         {
-                            _fileSequence(fileInfo, options, out);
+                            list.push_back(FileInfo(Path(value, fileName), false));
                         }
                     }
                     closedir(dir);
                 }
+                _stat(list);
+                out.insert(out.end(), std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
+
+                // Group the file sequences.
+                _fileSequences(options, out, frameSizes);
                     
                 // Sort the items.
                 _sort(options, out);
@@ -60,11 +60,11 @@ namespace djv
                         }
                         exists       = true;
                         size        += info.st_size;
-                        user         = std::min(_user, static_cast<uid_t>(info.st_uid));
+                        user         = std::max(user, static_cast<uid_t>(info.st_uid));
                         permissions |= (info.st_mode & _S_IREAD)  ? static_cast<int>(FilePermissions::Read)  : 0;
                         permissions |= (info.st_mode & _S_IWRITE) ? static_cast<int>(FilePermissions::Write) : 0;
                         permissions |= (info.st_mode & _S_IEXEC)  ? static_cast<int>(FilePermissions::Exec)  : 0;
-                        time         = std::max(_time, info.st_mtime);
+                        time         = std::max(time, info.st_mtime);
                     }
                     _exists      = exists;
                     _size        = size;
@@ -195,7 +195,10 @@ namespace djv
 
             } // namespace
 
-            std::vector<FileInfo> FileInfo::directoryList(const Path& value, const DirectoryListOptions& options)
+            std::vector<FileInfo> FileInfo::directoryList(
+                const Path& value,
+                const DirectoryListOptions& options,
+                std::map<std::string, uint64_t>* frameSizes)
             {
                 std::vector<FileInfo> out;
                 if (!value.isEmpty())
@@ -207,7 +210,10 @@ namespace djv
                     memcpy(pathBuf, path.c_str(), size * sizeof(WCHAR));
                     pathBuf[size++] = 0;
 
-                    // List the directory contents.
+                    // List the directory contents. Only the files that are kept
+                    // need to be stat'ed.
+                    const DirectoryListFilter filter(options);
+                    std::vector<FileInfo> list;
                     std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
                     WIN32_FIND_DATAW ffd;
                     HANDLE hFind = FindFirstFileW(pathBuf, &ffd);
@@ -218,45 +224,12 @@ namespace djv
                             do
                             {
                                 const std::string fileName = utf16.to_bytes(ffd.cFileName);
-
-                                bool filter = false;
-                                if (ffd.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN)
-                                {
-                                    filter = !options.showHidden;
-                                }
-                                if (fileName.size() == 1 && '.' == fileName[0])
-                                {
-                                    filter = true;
-                                }
-                                if (fileName.size() == 2 && '.' == fileName[0] && '.' == fileName[1])
+                                if (!filter.isFiltered(
+                                    fileName,
+                                    (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0,
+                                    (ffd.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN) != 0))
                                 {
-                                    filter = true;
-                                }
-                                if (options.filter.size() && !String::match(fileName, options.filter))
-                                {
-                                    filter = true;
-                                }
-                                if (!filter && !(ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && options.fileExtensions.size())
-                                {
-                                    bool match = false;
-                                    for (const auto& i : options.fileExtensions)
-                                    {
-                                        if (String::match(fileName, '\\' + i + '$'))
-                                        {
-                                            match = true;
-                                            break;
-                                        }
-                                    }
-                                    if (!match)
-                                    {
-                                        filter = true;
-                                    }
-                                }
-
-                                if (!filter)
-                                {
-                                    FileInfo fileInfo(Path(value, fileName));
-                                    _fileSequence(fileInfo, options, out);
+                                    list.push_back(FileInfo(Path(value, fileName), false));
                                 }
                             } while (FindNextFileW(hFind, &ffd) != 0);
                         }
@@ -265,6 +238,11 @@ namespace djv
                             //! \bug How should we handle this error?
                         }
                         FindClose(hFind);
+                        _stat(list);
+                        out = std::move(list);
+
+                        // Group the file sequences.
+                        _fileSequences(options, out, frameSizes);
                     }
                     else if (value.isServer())
                     {
@@ -17,6 +17,19 @@ namespace djv
         {
             void Sequence::add(const Range& value)
             {
+                // Ranges that are added in ascending order can only touch the
+                // last range, so they are appended without searching.
+                if (_ranges.empty() || value.getMin() > _ranges.back().getMax() + 1)
+                {
+                    _ranges.push_back(value);
+                    return;
+                }
+                else if (value.getMin() >= _ranges.back().getMin())
+                {
+                    _ranges.back() = Range(_ranges.back().getMin(), std::max(_ranges.back().getMax(), value.getMax()));
+                    return;
+                }
+
                 Range newRange(value);
                 auto i = _ranges.begin();
                 while (i != _ranges.end())
@@ -46,6 +59,27 @@ namespace djv
                     ;
                 _ranges.insert(i, newRange);
             }
+
+            void Sequence::remove(Number value)
+            {
+                for (auto i = _ranges.begin(); i != _ranges.end(); ++i)
+                {
+                    if (i->contains(value))
+                    {
+                        const Range range = *i;
+                        i = _ranges.erase(i);
+                        if (value < range.getMax())
+                        {
+                            i = _ranges.insert(i, Range(value + 1, range.getMax()));
+                        }
+                        if (value > range.getMin())
+                        {
+                            _ranges.insert(i, Range(range.getMin(), value - 1));
+                        }
+                        break;
+                    }
+                }
+            }
             
             Sequence fromFrames(const std::vector<Number> & frames)
             {
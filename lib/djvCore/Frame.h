@@ -46,6 +46,9 @@ namespace djv
                 const std::vector<Range>& getRanges() const;
                 void add(const Range&);
 
+                //! Remove a frame, splitting the range that contains it.
+                void remove(Number);
+
                 bool isValid() const;
 
                 ///@}
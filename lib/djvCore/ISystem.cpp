@@ -24,6 +24,7 @@ namespace djv
             ++systemCount;
             _name = name;
             _context = context;
+            _wakeContext = context.get();
             context->_addSystem(std::dynamic_pointer_cast<ISystemBase>(shared_from_this()));
         }
 
@@ -46,6 +47,11 @@ namespace djv
             // Default implementation does nothing.
         }
 
+        void ISystemBase::_wake()
+        {
+            _wakeContext->wake();
+        }
+
         void ISystem::_init(const std::string& name, const std::shared_ptr<Context>& context)
         {
             ISystemBase::_init(name, context);
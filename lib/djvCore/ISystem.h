@@ -47,9 +47,17 @@ namespace djv
             //! Override this function to do work each frame.
             virtual void tick();
 
+        protected:
+            //! Wake up the application event loop. This function is thread
+            //! safe, so it can be called from worker threads.
+            void _wake();
+
         private:
             std::string _name;
             std::weak_ptr<Context> _context;
+            // A plain pointer is used so that worker threads never hold the
+            // last reference to the context.
+            Context* _wakeContext = nullptr;
             std::vector<std::shared_ptr<ISystemBase> > _dependencies;
         };
 
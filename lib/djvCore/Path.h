@@ -27,6 +27,7 @@ namespace djv
                 Documents,
                 LogFile,
                 SettingsFile,
+                Cache,
                 Audio,
                 Fonts,
                 Icons,
@@ -166,6 +167,11 @@ namespace djv
                 //! - std::exception
                 static void rmdir(const Path&);
 
+                //! Remove a file.
+                //! Throws:
+                //! - std::exception
+                static void rm(const Path&);
+
                 //! Get the absolute path.
                 //! Throws:
                 //! - std::exception
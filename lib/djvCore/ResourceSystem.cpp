@@ -150,6 +150,31 @@ namespace djv
             Path settingsFile(documents, applicationName + ".json");
             p.paths[ResourcePath::SettingsFile] = settingsFile;
 
+            // The cache directory is created when it is first used. On Linux the
+            // XDG cache directory is used, unless the documents path has been
+            // set explicitly.
+            Path cache(documents, "Cache");
+#if defined(DJV_PLATFORM_LINUX)
+            if (OS::getEnv("DJV_DOCUMENTS_PATH").empty())
+            {
+                Path xdgCache;
+                env = OS::getEnv("XDG_CACHE_HOME");
+                if (!env.empty())
+                {
+                    xdgCache = Path(env);
+                }
+                else
+                {
+                    xdgCache = Path(OS::getPath(OS::DirectoryShortcut::Home), ".cache");
+                }
+                if (FileInfo(xdgCache).doesExist())
+                {
+                    cache = Path(xdgCache, "DJV");
+                }
+            }
+#endif // DJV_PLATFORM_LINUX
+            p.paths[ResourcePath::Cache] = cache;
+
             Path testPath = p.paths[ResourcePath::Application];
             testPath.append("djvCore.en.text");
             if (FileInfo(testPath).doesExist())
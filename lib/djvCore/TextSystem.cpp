@@ -403,18 +403,11 @@ namespace djv
                 
                 auto fileIO = FileSystem::FileIO::create();
                 fileIO->open(path.get(), FileSystem::FileIO::Mode::Read);
-                size_t bufSize = 0;
-#if defined(DJV_MMAP)
-                const char* bufP = reinterpret_cast<const char*>(fileIO->mmapP());
-                const char* bufEnd = reinterpret_cast<const char*>(fileIO->mmapEnd());
-                bufSize = bufEnd - bufP;
-#else // DJV_MMAP
                 std::vector<char> buf;
-                bufSize = fileIO->getSize();
+                const size_t bufSize = fileIO->getSize();
                 buf.resize(bufSize);
                 fileIO->read(buf.data(), bufSize);
                 const char* bufP = buf.data();
-#endif // DJV_MMAP
 
                 // Parse the JSON.
                 rapidjson::Document document;
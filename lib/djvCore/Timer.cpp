@@ -7,6 +7,7 @@
 #include <djvCore/Context.h>
 
 #include <algorithm>
+#include <queue>
 
 namespace djv
 {
@@ -33,12 +34,30 @@ namespace djv
                 return Duration(std::chrono::duration_cast<Duration>(std::chrono::milliseconds(getValue(value))));
             }
 
-            void Timer::_init(const std::shared_ptr<Context>& context)
+            namespace
             {
-                if (auto system = context->getSystemT<TimerSystem>())
+                //! \todo Should this be configurable?
+                const size_t heapCompactSize = 1024;
+
+                //! This struct provides a scheduled timer. Restarting or stopping
+                //! a timer changes its ID, which invalidates the previous entries.
+                struct Entry
                 {
-                    system->_addTimer(shared_from_this());
-                }
+                    TimePoint deadline;
+                    size_t id;
+                    std::weak_ptr<Timer> timer;
+
+                    bool operator > (const Entry& other) const
+                    {
+                        return deadline > other.deadline;
+                    }
+                };
+
+            } // namespace
+
+            void Timer::_init(const std::shared_ptr<Context>& context)
+            {
+                _system = context->getSystemT<TimerSystem>();
             }
 
             std::shared_ptr<Timer> Timer::create(const std::shared_ptr<Context>& context)
@@ -61,38 +80,57 @@ namespace djv
                 _timeout  = value;
                 _callback = callback;
                 _start    = std::chrono::steady_clock::now();
+                ++_id;
+                if (auto system = _system.lock())
+                {
+                    system->_addTimer(shared_from_this());
+                }
             }
 
             void Timer::stop()
             {
                 _active = false;
+                ++_id;
             }
 
-            void Timer::_tick()
+            bool Timer::_tick()
             {
                 _time = std::chrono::steady_clock::now();
-                if (_time >= (_start + _timeout))
+                if (_time < _getDeadline())
+                    return true;
+                const auto v = std::chrono::duration_cast<Duration>(_time - _start);
+                if (_repeating)
                 {
-                    if (_callback)
-                    {
-                        const auto v = std::chrono::duration_cast<Duration>(_time - _start);
-                        _callback(_time, v);
-                    }
-                    if (_repeating)
-                    {
-                        _start = _time;
-                    }
-                    else
-                    {
-                        _active = false;
-                    }
+                    _start = _time;
+                }
+                else
+                {
+                    _active = false;
                 }
+                const size_t id = _id;
+                if (_callback)
+                {
+                    _callback(_time, v);
+                }
+
+                // The timer needs to be scheduled again if it is repeating and
+                // was not restarted or stopped by the callback.
+                return _active && id == _id;
             }
 
             struct TimerSystem::Private
             {
-                std::vector<std::weak_ptr<Timer> > timers;
-                std::vector<std::weak_ptr<Timer> > newTimers;
+                std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > heap;
+
+                bool isValid(const Entry& entry) const
+                {
+                    bool out = false;
+                    if (auto timer = entry.timer.lock())
+                    {
+                        out = timer->isActive() && entry.id == timer->_id;
+                    }
+                    return out;
+                }
             };
 
             void TimerSystem::_init(const std::shared_ptr<Context>& context)
@@ -117,29 +155,64 @@ namespace djv
             void TimerSystem::tick()
             {
                 DJV_PRIVATE_PTR();
-                p.timers.insert(p.timers.end(), p.newTimers.begin(), p.newTimers.end());
-                p.newTimers.clear();
-                auto i = p.timers.begin();
-                while (i != p.timers.end())
+
+                // Remove the timers that are due before calling them, so timers
+                // started by the callbacks are not called until the next tick.
+                const auto now = std::chrono::steady_clock::now();
+                std::vector<Entry> entries;
+                while (!p.heap.empty() && p.heap.top().deadline <= now)
                 {
-                    if (auto timer = i->lock())
+                    entries.push_back(p.heap.top());
+                    p.heap.pop();
+                }
+                for (const auto& i : entries)
+                {
+                    if (p.isValid(i))
                     {
-                        if (timer->isActive())
+                        if (auto timer = i.timer.lock())
                         {
-                            timer->_tick();
+                            if (timer->_tick())
+                            {
+                                p.heap.push({ timer->_getDeadline(), timer->_id, timer });
+                            }
                         }
-                        ++i;
-                    }
-                    else
-                    {
-                        i = p.timers.erase(i);
                     }
                 }
             }
 
-            void TimerSystem::_addTimer(const std::weak_ptr<Timer>& value)
+            TimePoint TimerSystem::getNextDeadline()
+            {
+                DJV_PRIVATE_PTR();
+                while (!p.heap.empty() && !p.isValid(p.heap.top()))
+                {
+                    p.heap.pop();
+                }
+                return !p.heap.empty() ? p.heap.top().deadline : TimePoint::max();
+            }
+
+            void TimerSystem::_addTimer(const std::shared_ptr<Timer>& value)
             {
-                _p->newTimers.push_back(value);
+                DJV_PRIVATE_PTR();
+
+                // Timers that are restarted often leave entries behind, so remove
+                // them when the heap gets large.
+                if (p.heap.size() >= heapCompactSize)
+                {
+                    std::vector<Entry> entries;
+                    while (!p.heap.empty())
+                    {
+                        if (p.isValid(p.heap.top()))
+                        {
+                            entries.push_back(p.heap.top());
+                        }
+                        p.heap.pop();
+                    }
+                    for (const auto& i : entries)
+                    {
+                        p.heap.push(i);
+                    }
+                }
+                p.heap.push({ value->_getDeadline(), value->_id, value });
             }
 
         } // namespace Time
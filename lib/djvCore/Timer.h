@@ -36,6 +36,9 @@ namespace djv
             Duration getTime(TimerValue);
 
             //! This class provides a timer.
+            //!
+            //! Timers are scheduled with the timer system when they are started,
+            //! and only called when their deadline has passed.
             class Timer : public std::enable_shared_from_this<Timer>
             {
                 DJV_NON_COPYABLE(Timer);
@@ -66,10 +69,13 @@ namespace djv
                 void stop();
 
             private:
-                void _tick();
+                Time::TimePoint _getDeadline() const;
+                bool _tick();
 
+                std::weak_ptr<TimerSystem> _system;
                 bool _repeating = false;
                 bool _active = false;
+                size_t _id = 0;
                 Duration _timeout = Duration::zero();
                 std::function<void(const std::chrono::steady_clock::time_point&, const Duration&)> _callback;
                 Time::TimePoint _time;
@@ -79,6 +85,10 @@ namespace djv
             };
 
             //! This class provides the system that manages timers.
+            //!
+            //! The active timers are kept in a heap ordered by their deadlines,
+            //! so ticking only visits the timers that are due and event loops can
+            //! sleep until the next deadline.
             class TimerSystem : public ISystemBase
             {
                 DJV_NON_COPYABLE(TimerSystem);
@@ -93,8 +103,12 @@ namespace djv
 
                 void tick() override;
 
+                //! Get the deadline of the next timer. If there are no active
+                //! timers Time::TimePoint::max() is returned.
+                Time::TimePoint getNextDeadline();
+
             private:
-                void _addTimer(const std::weak_ptr<Timer>&);
+                void _addTimer(const std::shared_ptr<Timer>&);
 
                 DJV_PRIVATE();
 
@@ -21,6 +21,11 @@ namespace djv
                 return _active;
             }
 
+            inline Time::TimePoint Timer::_getDeadline() const
+            {
+                return _start + _timeout;
+            }
+
         } // namespace Time
     } // namespace Core
 } // namespace djv
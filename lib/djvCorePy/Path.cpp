@@ -25,6 +25,7 @@ void wrapPath(pybind11::module& m)
         .value("Documents", FileSystem::ResourcePath::Documents)
         .value("LogFile", FileSystem::ResourcePath::LogFile)
         .value("SettingsFile", FileSystem::ResourcePath::SettingsFile)
+        .value("Cache", FileSystem::ResourcePath::Cache)
         .value("Audio", FileSystem::ResourcePath::Audio)
         .value("Fonts", FileSystem::ResourcePath::Fonts)
         .value("Icons", FileSystem::ResourcePath::Icons)
@@ -61,6 +62,7 @@ void wrapPath(pybind11::module& m)
         .def_static("splitDir", &FileSystem::Path::splitDir)
         .def_static("joinDirs", &FileSystem::Path::joinDirs)
         .def_static("mkdir", &FileSystem::Path::mkdir)
+        .def_static("rm", &FileSystem::Path::rm)
         .def_static("getAbsolute", &FileSystem::Path::getAbsolute)
         .def_static("getCWD", &FileSystem::Path::getCWD)
         .def_static("getTemp", &FileSystem::Path::getTemp)
@@ -15,11 +15,14 @@
 #include <djvAV/IO.h>
 #include <djvAV/Render2D.h>
 
+#include <djvCore/Animation.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/Timer.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -29,6 +32,16 @@ namespace djv
 {
     namespace Desktop
     {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t frameRate = 60;
+
+            //! \todo Should this be configurable?
+            const std::chrono::milliseconds idleTimeoutMax(100);
+
+        } // namespace
+
         struct Application::Private
         {
             std::shared_ptr<EventSystem> eventSystem;
@@ -61,6 +74,13 @@ namespace djv
             auto avGLFWSystem = getSystemT<AV::GLFW::System>();
             auto glfwWindow = avGLFWSystem->getGLFWWindow();
             p.eventSystem = EventSystem::create(glfwWindow, shared_from_this());
+
+            // Worker threads wake up the event loop with an empty event.
+            setWakeCallback(
+                []
+                {
+                    glfwPostEmptyEvent();
+                });
         }
         
         Application::Application() :
@@ -68,7 +88,9 @@ namespace djv
         {}
         
         Application::~Application()
-        {}
+        {
+            setWakeCallback(nullptr);
+        }
 
         std::shared_ptr<Application> Application::create(std::list<std::string>& args)
         {
@@ -84,12 +106,37 @@ namespace djv
             if (auto glfwWindow = avGLFWSystem->getGLFWWindow())
             {
                 glfwShowWindow(glfwWindow);
+                auto timerSystem = getSystemT<Time::TimerSystem>();
+                auto animationSystem = getSystemT<Animation::System>();
+                const auto frameTime = std::chrono::microseconds(1000000 / frameRate);
                 _setRunning(true);
                 while (_isRunning() && glfwWindow && !glfwWindowShouldClose(glfwWindow))
                 {
-                    glfwPollEvents();
+                    const auto time = std::chrono::steady_clock::now();
+                    _runPosted();
                     tick();
-                    glfwSwapBuffers(glfwWindow);
+
+                    // While animations are running or widgets have pending
+                    // requests, run at the frame rate. Otherwise sleep until
+                    // the next timer is due. Worker threads wake up the loop
+                    // when they have results, and the idle timeout bounds the
+                    // latency for anything that is polled.
+                    auto deadline = time + frameTime;
+                    if ((!animationSystem || !animationSystem->isActive()) && p.eventSystem->isIdle())
+                    {
+                        deadline = std::min(
+                            std::max(timerSystem->getNextDeadline(), deadline),
+                            time + idleTimeoutMax);
+                    }
+                    const auto now = std::chrono::steady_clock::now();
+                    if (deadline > now)
+                    {
+                        glfwWaitEventsTimeout(std::chrono::duration<double>(deadline - now).count());
+                    }
+                    else
+                    {
+                        glfwPollEvents();
+                    }
                 }
             }
         }
@@ -67,6 +67,7 @@ namespace djv
             bool resizeRequest = true;
             glm::vec2 contentScale = glm::vec2(1.F, 1.F);
             bool redrawRequest = true;
+            bool swapRequest = true;
             std::shared_ptr<AV::Render2D::Render> render;
             std::shared_ptr<AV::OpenGL::OffscreenBuffer> offscreenBuffer;
 #if defined(DJV_OPENGL_ES2)
@@ -169,11 +170,20 @@ namespace djv
             glfwSetClipboardString(p.glfwWindow, value.c_str());
         }
 
+        bool EventSystem::isIdle() const
+        {
+            DJV_PRIVATE_PTR();
+            return !p.resizeRequest && !p.redrawRequest && !p.swapRequest && !_hasResizeOrRedrawRequest();
+        }
+
         void EventSystem::tick()
         {
             UI::EventSystem::tick();
             DJV_PRIVATE_PTR();
 
+            bool swap = p.swapRequest;
+            p.swapRequest = false;
+
             if (p.resizeRequest)
             {
                 const AV::Image::Size size(p.resize.x, p.resize.y);
@@ -204,6 +214,10 @@ namespace djv
 
             if (p.offscreenBuffer)
             {
+                // The whole frame is painted when the offscreen buffer has
+                // been created, otherwise only the areas of the widgets that
+                // need to be redrawn.
+                const bool fullRedraw = p.resizeRequest || p.redrawRequest;
                 bool resizeRequest = p.resizeRequest;
                 bool redrawRequest = p.redrawRequest;
                 p.resizeRequest = false;
@@ -215,49 +229,89 @@ namespace djv
                 }
 
                 const auto& size = p.offscreenBuffer->getSize();
+                const BBox2f frameRect(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
                 if (resizeRequest)
                 {
                     for (const auto& i : rootObject->getChildrenT<UI::Window>())
                     {
                         i->resize(glm::vec2(size.w, size.h));
 
+                        // Only update the widgets that have requested a resize,
+                        // and the widgets affected by them.
                         Event::InitLayout initLayout;
-                        _initLayoutRecursive(i, initLayout);
+                        _initLayoutUpdate(i, initLayout);
 
                         Event::PreLayout preLayout;
-                        _preLayoutRecursive(i, preLayout);
+                        _preLayoutUpdate(i, preLayout);
 
                         if (i->isVisible())
                         {
                             Event::Layout layout;
-                            _layoutRecursive(i, layout);
+                            _layoutUpdate(i, layout);
 
-                            Event::Clip clip(BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h)));
-                            _clipRecursive(i, clip);
+                            Event::Clip clip(frameRect);
+                            _clipUpdate(i, clip);
                         }
                     }
                 }
 
-                if (resizeRequest || redrawRequest)
+                std::vector<BBox2f> redrawRects = _getRedrawRects();
+                for (const auto& i : rootObject->getChildrenT<UI::Window>())
+                {
+                    redrawRequest |= _redrawRequest(i);
+                }
+                if (fullRedraw)
+                {
+                    redrawRects.clear();
+                    redrawRects.push_back(frameRect);
+                }
+                else
+                {
+                    auto i = redrawRects.begin();
+                    while (i != redrawRects.end())
+                    {
+                        *i = i->intersect(frameRect);
+                        if (i->isValid())
+                        {
+                            ++i;
+                        }
+                        else
+                        {
+                            i = redrawRects.erase(i);
+                        }
+                    }
+                }
+
+                if ((resizeRequest || redrawRequest) && redrawRects.size())
                 {
                     p.offscreenBuffer->bind();
-                    p.render->beginFrame(size);
+                    p.render->beginFrame(size, redrawRects);
                     for (const auto& i : rootObject->getChildrenT<UI::Window>())
                     {
                         if (i->isVisible())
                         {
-                            Event::Paint paintEvent(BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h)));
-                            Event::PaintOverlay paintOverlayEvent(BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h)));
-                            _paintRecursive(i, paintEvent, paintOverlayEvent);
+                            for (const auto& j : redrawRects)
+                            {
+                                Event::Paint paintEvent(j);
+                                Event::PaintOverlay paintOverlayEvent(j);
+                                _paintRecursive(i, paintEvent, paintOverlayEvent);
+                            }
                         }
                     }
                     p.render->endFrame();
 
                     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+                    swap = true;
                 }
             }
 
-            _redraw();
+            // Only copy the offscreen buffer to the window and swap when
+            // something has changed.
+            if (swap)
+            {
+                _redraw();
+                glfwSwapBuffers(p.glfwWindow);
+            }
         }
 
         void EventSystem::_pushClipRect(const Core::BBox2f& value)
@@ -476,7 +530,7 @@ namespace djv
             {
                 if (auto system = context->getSystemT<EventSystem>())
                 {
-                    system->_redraw();
+                    system->_p->swapRequest = true;
                 }
             }
         }
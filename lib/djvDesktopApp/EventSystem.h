@@ -37,6 +37,11 @@ namespace djv
             std::string getClipboard() const override;
             void setClipboard(const std::string&) override;
 
+            //! Get whether there are no pending resize, redraw, or buffer
+            //! swap requests. The application event loop waits for events
+            //! while the event system is idle.
+            bool isIdle() const;
+
             void tick() override;
 
         protected:
@@ -179,6 +179,18 @@ namespace djv
             return out;
         }
 
+        std::vector<BBox2f> EventSystem::_getRedrawRects() const
+        {
+            std::vector<BBox2f> out;
+            out.swap(Widget::_redrawRects);
+            return out;
+        }
+
+        bool EventSystem::_hasResizeOrRedrawRequest() const
+        {
+            return Widget::_resizeRequest || Widget::_redrawRequest;
+        }
+
         void EventSystem::_initLayoutRecursive(const std::shared_ptr<Widget>& widget, Event::InitLayout& event)
         {
             for (const auto& child : widget->getChildWidgets())
@@ -194,6 +206,7 @@ namespace djv
             {
                 _preLayoutRecursive(child, event);
             }
+            widget->_preLayoutDirty = false;
             widget->event(event);
         }
 
@@ -201,6 +214,7 @@ namespace djv
         {
             if (widget->isVisible())
             {
+                widget->_layoutDirty = false;
                 widget->event(event);
                 for (const auto& child : widget->getChildWidgets())
                 {
@@ -211,6 +225,7 @@ namespace djv
 
         void EventSystem::_clipRecursive(const std::shared_ptr<Widget>& widget, Event::Clip& event)
         {
+            widget->_clipDirty = false;
             widget->event(event);
             const BBox2f clipRect = event.getClipRect();
             for (const auto& child : widget->getChildWidgets())
@@ -221,6 +236,116 @@ namespace djv
             event.setClipRect(clipRect);
         }
 
+        void EventSystem::_initLayoutUpdate(const std::shared_ptr<Widget>& widget, Event::InitLayout& event)
+        {
+            if (widget->_childrenDirty)
+            {
+                for (const auto& child : widget->getChildWidgets())
+                {
+                    if (child->_preLayoutDirty || child->_childrenDirty)
+                    {
+                        _initLayoutUpdate(child, event);
+                    }
+                }
+            }
+            if (widget->_preLayoutDirty)
+            {
+                widget->event(event);
+            }
+        }
+
+        void EventSystem::_preLayoutUpdate(const std::shared_ptr<Widget>& widget, Event::PreLayout& event)
+        {
+            if (widget->_childrenDirty)
+            {
+                for (const auto& child : widget->getChildWidgets())
+                {
+                    if (child->_preLayoutDirty || child->_childrenDirty)
+                    {
+                        _preLayoutUpdate(child, event);
+                    }
+                }
+            }
+
+            // Changing the size hints marks the parent, which is handled
+            // after its children.
+            if (widget->_preLayoutDirty)
+            {
+                widget->_preLayoutDirty = false;
+                widget->event(event);
+            }
+        }
+
+        void EventSystem::_layoutUpdate(const std::shared_ptr<Widget>& widget, Event::Layout& event)
+        {
+            // Hidden widgets keep their requests until they are shown.
+            if (widget->isVisible())
+            {
+                if (widget->_layoutDirty)
+                {
+                    widget->_layoutDirty = false;
+                    widget->event(event);
+                }
+                if (widget->_childrenDirty)
+                {
+                    for (const auto& child : widget->getChildWidgets())
+                    {
+                        if (child->_layoutDirty || child->_childrenDirty)
+                        {
+                            _layoutUpdate(child, event);
+                        }
+                    }
+                }
+            }
+        }
+
+        void EventSystem::_clipUpdate(const std::shared_ptr<Widget>& widget, Event::Clip& event)
+        {
+            if (widget->_clipDirty)
+            {
+                // The clipping of the whole sub-tree depends on this widget.
+                _clipRecursive(widget, event);
+                _childrenDirtyUpdate(widget);
+            }
+            else if (widget->_childrenDirty)
+            {
+                const BBox2f clipRect = event.getClipRect();
+                for (const auto& child : widget->getChildWidgets())
+                {
+                    if (child->_clipDirty || child->_childrenDirty)
+                    {
+                        event.setClipRect(clipRect.intersect(child->getGeometry()));
+                        _clipUpdate(child, event);
+                    }
+                }
+                event.setClipRect(clipRect);
+                _childrenDirtyUpdate(widget, false);
+            }
+        }
+
+        void EventSystem::_childrenDirtyUpdate(const std::shared_ptr<Widget>& widget, bool recursive)
+        {
+            // The clip pass is the last one, so clear the children flags
+            // unless there are requests left (for example in hidden widgets).
+            if (widget->_childrenDirty)
+            {
+                bool childrenDirty = false;
+                for (const auto& child : widget->getChildWidgets())
+                {
+                    if (recursive)
+                    {
+                        _childrenDirtyUpdate(child);
+                    }
+                    childrenDirty |=
+                        child->_preLayoutDirty ||
+                        child->_layoutDirty ||
+                        child->_clipDirty ||
+                        child->_childrenDirty;
+                }
+                widget->_childrenDirty = childrenDirty;
+            }
+        }
+
         void EventSystem::_paintRecursive(
             const std::shared_ptr<Widget>& widget,
             Event::Paint& event,
@@ -233,7 +358,10 @@ namespace djv
                 widget->event(event);
                 for (const auto& child : widget->getChildWidgets())
                 {
+                    // Skip children that are outside of the area being painted.
                     const BBox2f childClipRect = clipRect.intersect(child->getGeometry());
+                    if (!childClipRect.isValid())
+                        continue;
                     event.setClipRect(childClipRect);
                     overlayEvent.setClipRect(childClipRect);
                     _paintRecursive(child, event, overlayEvent);
@@ -35,10 +35,32 @@ namespace djv
             bool _resizeRequest(const std::shared_ptr<Widget>&) const;
             bool _redrawRequest(const std::shared_ptr<Widget>&) const;
 
+            //! Get the areas of the widgets that need to be redrawn, and clear
+            //! them. Overlapping areas are merged.
+            std::vector<Core::BBox2f> _getRedrawRects() const;
+
+            //! Get whether any widgets have requested a resize or redraw,
+            //! without clearing the requests.
+            bool _hasResizeOrRedrawRequest() const;
+
+            //! \name Layout
+            //! The recursive functions send the events to every widget. The
+            //! update functions only send the events to widgets that have
+            //! requested a resize, widgets whose geometry changed, and the
+            //! parents of widgets whose size hints changed.
+            ///@{
+
             void _initLayoutRecursive(const std::shared_ptr<Widget>&, Core::Event::InitLayout&);
             void _preLayoutRecursive(const std::shared_ptr<Widget>&, Core::Event::PreLayout&);
             void _layoutRecursive(const std::shared_ptr<Widget>&, Core::Event::Layout&);
             void _clipRecursive(const std::shared_ptr<Widget>&, Core::Event::Clip&);
+            void _initLayoutUpdate(const std::shared_ptr<Widget>&, Core::Event::InitLayout&);
+            void _preLayoutUpdate(const std::shared_ptr<Widget>&, Core::Event::PreLayout&);
+            void _layoutUpdate(const std::shared_ptr<Widget>&, Core::Event::Layout&);
+            void _clipUpdate(const std::shared_ptr<Widget>&, Core::Event::Clip&);
+
+            ///@}
+
             void _paintRecursive(
                 const std::shared_ptr<Widget>&,
                 Core::Event::Paint&,
@@ -47,6 +69,8 @@ namespace djv
             void _initObject(const std::shared_ptr<Core::IObject>&) override;
 
         private:
+            void _childrenDirtyUpdate(const std::shared_ptr<Widget>&, bool recursive = true);
+
             DJV_PRIVATE();
         };
 
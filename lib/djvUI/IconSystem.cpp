@@ -176,6 +176,7 @@ namespace djv
                         if (p.newImageRequests.size() || p.pendingImageRequests.size())
                         {
                             _handleImageRequests();
+                            _wake();
                         }
                     }
                 }
@@ -11,6 +11,9 @@
 
 #include <djvCore/Context.h>
 
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
 //#pragma optimize("", off)
 
 using namespace djv::Core;
@@ -46,6 +49,8 @@ namespace djv
 
             std::vector<std::shared_ptr<AV::Font::Glyph> > glyphs;
             std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > glyphsFuture;
+            std::shared_ptr<AV::Render2D::DrawList> drawList;
+            AV::Image::Color drawListColor;
 
             bool labelMinimumSizeInit = true;
             std::weak_ptr<LabelSizeGroup> sizeGroup;
@@ -225,6 +230,13 @@ namespace djv
                 const glm::vec2 size(glm::max(p.textSize.x, p.sizeStringSize.x), p.fontMetrics.lineHeight);
                 const auto& style = _getStyle();
                 _labelMinimumSize = size + getMargin().getSize(style);
+
+                // Only the labels that change are laid out again, so update
+                // the group here instead of waiting for the parent.
+                if (auto sizeGroup = p.sizeGroup.lock())
+                {
+                    sizeGroup->calcMinimumSize();
+                }
             }
         }
 
@@ -308,9 +320,24 @@ namespace djv
                 //render->setFillColor(AV::Image::Color(1.F, 0.F, 0.F));
                 //render->drawRect(BBox2f(pos.x, pos.y, p.textSize.x, p.textSize.y));
 
-                render->setFillColor(style->getColor(p.textColorRole));
                 //! \bug Why the extra subtract by one here?
-                render->drawText(p.glyphs, glm::vec2(floorf(pos.x), floorf(pos.y + p.fontMetrics.ascender - 1.F)));
+                const glm::vec2 textPos(floorf(pos.x), floorf(pos.y + p.fontMetrics.ascender - 1.F));
+                render->pushTransform(glm::translate(glm::mat3x3(1.F), textPos));
+
+                // Record the text once and replay it until the glyphs or the
+                // color change.
+                const AV::Image::Color color = style->getColor(p.textColorRole);
+                if (!p.drawList || color != p.drawListColor || !render->drawList(p.drawList))
+                {
+                    render->beginDrawList();
+                    render->setFillColor(color);
+                    render->drawText(p.glyphs, glm::vec2(0.F, 0.F));
+                    p.drawList = render->endDrawList();
+                    p.drawListColor = color;
+                    render->drawList(p.drawList);
+                }
+
+                render->popTransform();
             }
         }
 
@@ -373,6 +400,7 @@ namespace djv
                 try
                 {
                     p.glyphs = p.glyphsFuture.get();
+                    p.drawList.reset();
                     _redraw();
                 }
                 catch (const std::exception& e)
@@ -389,6 +417,7 @@ namespace djv
             if (!p.text.size())
             {
                 p.glyphs.clear();
+                p.drawList.reset();
             }
             p.glyphsFuture = p.fontSystem->getGlyphs(p.text, p.fontInfo, p.elide);
         }
@@ -471,13 +500,13 @@ namespace djv
         void LabelSizeGroup::calcMinimumSize()
         {
             DJV_PRIVATE_PTR();
-            p.minimumSize = glm::vec2(0.F, 0.F);
+            glm::vec2 minimumSize(0.F, 0.F);
             auto i = p.labels.begin();
             while (i != p.labels.end())
             {
                 if (auto label = i->lock())
                 {
-                    p.minimumSize = glm::max(p.minimumSize, label->_labelMinimumSize);
+                    minimumSize = glm::max(minimumSize, label->_labelMinimumSize);
                     ++i;
                 }
                 else
@@ -485,6 +514,17 @@ namespace djv
                     i = p.labels.erase(i);
                 }
             }
+            if (minimumSize != p.minimumSize)
+            {
+                p.minimumSize = minimumSize;
+                for (const auto& j : p.labels)
+                {
+                    if (auto label = j.lock())
+                    {
+                        label->_resize();
+                    }
+                }
+            }
         }
 
     } // namespace UI
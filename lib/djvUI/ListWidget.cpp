@@ -4,9 +4,7 @@
 
 #include <djvUI/ListWidget.h>
 
-#include <djvUI/ButtonGroup.h>
 #include <djvUI/ListButton.h>
-#include <djvUI/RowLayout.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -37,11 +35,25 @@ namespace djv
         struct ListWidget::Private
         {
             std::vector<ListItem> items;
+            std::vector<bool> checked;
             std::string filter;
             std::vector<ColorRole> alternateRowsRoles = { ColorRole::None, ColorRole::None };
+            std::vector<size_t> rows;
+            float rowWidth = 0.F;
+            float rowHeight = 0.F;
+            std::pair<size_t, size_t> visibleRows = std::make_pair(0, 0);
+            ButtonType buttonType = ButtonType::Push;
             std::vector<std::shared_ptr<ListButton> > buttons;
-            std::shared_ptr<ButtonGroup> buttonGroup;
-            std::shared_ptr<VerticalLayout> layout;
+            std::vector<int> buttonItems;
+            std::vector<bool> buttonsInit;
+            std::shared_ptr<ListButton> sizeButton;
+            std::function<void(int)> pushCallback;
+            std::function<void(int, bool)> toggleCallback;
+            std::function<void(int)> radioCallback;
+            std::function<void(int)> exclusiveCallback;
+
+            int getChecked() const;
+            void setChecked(int, bool);
 
             static void initButton(const std::shared_ptr<ListButton>&, const ListItem&);
         };
@@ -53,11 +65,13 @@ namespace djv
             
             setClassName("djv::UI::ListWidget");
 
-            p.buttonGroup = ButtonGroup::create(buttonType);
+            p.buttonType = buttonType;
 
-            p.layout = VerticalLayout::create(context);
-            p.layout->setSpacing(MetricsRole::None);
-            addChild(p.layout);
+            // This button is not shown, it is used to find the size of the
+            // widest item.
+            p.sizeButton = ListButton::create(context);
+            p.sizeButton->hide();
+            addChild(p.sizeButton);
         }
 
         ListWidget::ListWidget() :
@@ -106,37 +120,39 @@ namespace djv
             {
                 p.items.clear();
                 _itemsUpdate();
+                _filterUpdate();
             }
         }
 
         int ListWidget::getChecked() const
         {
-            return _p->buttonGroup->getChecked();
+            return _p->getChecked();
         }
 
         void ListWidget::setChecked(int index, bool value)
         {
-            _p->buttonGroup->setChecked(index, value);
+            _p->setChecked(index, value);
+            _checkedUpdate();
         }
 
         void ListWidget::setPushCallback(const std::function<void(int)>& value)
         {
-            _p->buttonGroup->setPushCallback(value);
+            _p->pushCallback = value;
         }
 
         void ListWidget::setToggleCallback(const std::function<void(int, bool)>& value)
         {
-            _p->buttonGroup->setToggleCallback(value);
+            _p->toggleCallback = value;
         }
 
         void ListWidget::setRadioCallback(const std::function<void(int)>& value)
         {
-            _p->buttonGroup->setRadioCallback(value);
+            _p->radioCallback = value;
         }
 
         void ListWidget::setExclusiveCallback(const std::function<void(int)>& value)
         {
-            _p->buttonGroup->setExclusiveCallback(value);
+            _p->exclusiveCallback = value;
         }
 
         void ListWidget::setFilter(const std::string& value)
@@ -154,17 +170,68 @@ namespace djv
             if (value0 == p.alternateRowsRoles[0] && value1 == p.alternateRowsRoles[1])
                 return;
             p.alternateRowsRoles = { value0, value1 };
-            _filterUpdate();
+            _buttonsUpdate();
         }
 
         void ListWidget::_preLayoutEvent(Event::PreLayout& event)
         {
-            _setMinimumSize(_p->layout->getMinimumSize());
+            DJV_PRIVATE_PTR();
+
+            // The buttons have been through a pre-layout, so they can be
+            // shown.
+            for (size_t i = 0; i < p.buttonsInit.size(); ++i)
+            {
+                p.buttonsInit[i] = true;
+            }
+
+            // The row size is cached so that it does not change as the
+            // buttons are reused.
+            glm::vec2 size = p.sizeButton->getMinimumSize();
+            for (const auto& i : p.buttons)
+            {
+                if (i->isVisible())
+                {
+                    size = glm::max(size, i->getMinimumSize());
+                }
+            }
+            p.rowWidth = std::max(p.rowWidth, size.x);
+            p.rowHeight = std::max(p.rowHeight, size.y);
+            _setMinimumSize(glm::vec2(p.rowWidth, p.rowHeight * p.rows.size()));
         }
 
         void ListWidget::_layoutEvent(Event::Layout& event)
         {
-            _p->layout->setGeometry(getGeometry());
+            DJV_PRIVATE_PTR();
+
+            // Find the area that can be seen through the parents, for example
+            // the viewport of a scroll widget. The parents have already been
+            // laid out.
+            BBox2f g = getGeometry();
+            auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock());
+            while (parent && g.isValid())
+            {
+                g = g.intersect(parent->getGeometry());
+                parent = std::dynamic_pointer_cast<Widget>(parent->getParent().lock());
+            }
+            p.visibleRows = g.isValid() ? _getVisibleRows(g) : std::make_pair<size_t, size_t>(0, 0);
+            _buttonsUpdate();
+        }
+
+        void ListWidget::_clipEvent(Event::Clip& event)
+        {
+            DJV_PRIVATE_PTR();
+
+            // Lay out again if the visible area has grown without the
+            // geometry of the widget changing.
+            if (!isClipped())
+            {
+                const auto visibleRows = _getVisibleRows(getClipRect());
+                if (visibleRows.first < visibleRows.second &&
+                    (visibleRows.first < p.visibleRows.first || visibleRows.second > p.visibleRows.second))
+                {
+                    _resize();
+                }
+            }
         }
 
         void ListWidget::_keyPressEvent(Event::KeyPress& event)
@@ -173,94 +240,351 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (!event.isAccepted())
             {
-                const size_t size = p.items.size();
+                const size_t size = p.rows.size();
                 if (size > 0)
                 {
+                    const int checked = p.getChecked();
+                    size_t row = 0;
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        if (static_cast<int>(p.rows[i]) == checked)
+                        {
+                            row = i;
+                            break;
+                        }
+                    }
                     switch (event.getKey())
                     {
                     case GLFW_KEY_HOME:
                         event.accept();
-                        p.buttonGroup->getButtons()[0]->doClick();
+                        _click(static_cast<int>(p.rows[0]));
                         break;
                     case GLFW_KEY_END:
                         event.accept();
-                        p.buttonGroup->getButtons()[size - 1]->doClick();
+                        _click(static_cast<int>(p.rows[size - 1]));
                         break;
                     case GLFW_KEY_UP:
                         event.accept();
-                        p.buttonGroup->getButtons()[p.buttonGroup->getChecked() - 1]->doClick();
+                        if (row > 0)
+                        {
+                            _click(static_cast<int>(p.rows[row - 1]));
+                        }
                         break;
                     case GLFW_KEY_DOWN:
                         event.accept();
-                        p.buttonGroup->getButtons()[p.buttonGroup->getChecked() + 1]->doClick();
+                        if (row < size - 1)
+                        {
+                            _click(static_cast<int>(p.rows[row + 1]));
+                        }
                         break;
                     }
                 }
             }
         }
 
-        void ListWidget::_itemsUpdate()
+        void ListWidget::_initEvent(Event::Init& event)
         {
             DJV_PRIVATE_PTR();
-            if (auto context = getContext().lock())
+            if (event.getData().resize || event.getData().font)
             {
-                p.buttonGroup->clearButtons();
-                const size_t buttonsSize = p.buttons.size();
-                size_t i = 0;
-                for (; i < p.items.size() && i < buttonsSize; ++i)
+                p.rowWidth = 0.F;
+                p.rowHeight = 0.F;
+            }
+        }
+
+        std::pair<size_t, size_t> ListWidget::_getVisibleRows(const BBox2f& value) const
+        {
+            DJV_PRIVATE_PTR();
+            std::pair<size_t, size_t> out(0, 0);
+            const size_t size = p.rows.size();
+            if (p.rowHeight > 0.F)
+            {
+                const BBox2f& g = getGeometry();
+                const float first = floorf((value.min.y - g.min.y) / p.rowHeight);
+                const float last = ceilf((value.max.y - g.min.y) / p.rowHeight);
+                out.first = std::min(static_cast<size_t>(std::max(first, 0.F)), size);
+                out.second = std::min(static_cast<size_t>(std::max(last, 0.F)), size);
+            }
+            else
+            {
+                // Create a single button to find the row height.
+                out.second = std::min(size, static_cast<size_t>(1));
+            }
+            return out;
+        }
+
+        void ListWidget::_click(int index)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.pushCallback)
+            {
+                p.pushCallback(index);
+            }
+            switch (p.buttonType)
+            {
+            case ButtonType::Toggle:
+            {
+                const bool value = !p.checked[index];
+                p.checked[index] = value;
+                if (p.toggleCallback)
                 {
-                    p.initButton(p.buttons[i], p.items[i]);
+                    p.toggleCallback(index, value);
                 }
-                for (; i < p.items.size(); ++i)
+                break;
+            }
+            case ButtonType::Radio:
+                if (!p.checked[index])
                 {
-                    auto button = ListButton::create(context);
-                    p.initButton(button, p.items[i]);
-                    p.buttons.push_back(button);
-                    p.layout->addChild(button);
+                    p.setChecked(index, true);
+                    if (p.radioCallback)
+                    {
+                        p.radioCallback(index);
+                    }
                 }
-                for (; i < buttonsSize; ++i)
+                break;
+            case ButtonType::Exclusive:
+            {
+                const bool value = !p.checked[index];
+                p.setChecked(index, value);
+                if (p.exclusiveCallback)
                 {
-                    auto button = p.buttons.begin() + p.items.size();
-                    p.layout->removeChild(*button);
-                    p.buttons.erase(button);
+                    p.exclusiveCallback(value ? index : -1);
                 }
-                DJV_ASSERT(p.buttons.size() == p.items.size());
-                DJV_ASSERT(p.buttons.size() == p.layout->getChildWidgets().size());
-                std::vector<std::shared_ptr<Button::IButton> > iButtons;
-                for (const auto& i : p.buttons)
+                break;
+            }
+            default: break;
+            }
+            _checkedUpdate();
+        }
+
+        void ListWidget::_itemsUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            p.checked = std::vector<bool>(p.items.size(), false);
+            if (ButtonType::Radio == p.buttonType && p.items.size())
+            {
+                p.checked[0] = true;
+            }
+
+            // Use the item with the longest text to find the row width.
+            ListItem sizeItem;
+            size_t sizeItemLength = 0;
+            for (const auto& i : p.items)
+            {
+                const size_t length = i.text.size() + i.rightText.size();
+                if (length > sizeItemLength)
                 {
-                    iButtons.push_back(i);
+                    sizeItem = i;
+                    sizeItemLength = length;
                 }
-                p.buttonGroup->setButtons(iButtons);
             }
+            p.initButton(p.sizeButton, sizeItem);
+            p.rowWidth = 0.F;
+            p.rowHeight = 0.F;
         }
 
         void ListWidget::_filterUpdate()
         {
             DJV_PRIVATE_PTR();
-            const auto& buttons = p.buttonGroup->getButtons();
-            DJV_ASSERT(buttons.size() == p.items.size());
-            std::vector<int> indices;
-            for (int i = 0; i < static_cast<int>(p.items.size()); ++i)
+            p.rows.clear();
+            for (size_t i = 0; i < p.items.size(); ++i)
             {
                 const auto& item = p.items[i];
-                const bool match = String::match(item.text + " " + item.rightText, p.filter);
-                buttons[i]->setVisible(match);
-                if (match)
+                if (String::match(item.text + " " + item.rightText, p.filter))
+                {
+                    p.rows.push_back(i);
+                }
+            }
+            _resize();
+        }
+
+        void ListWidget::_buttonsUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            if (auto context = getContext().lock())
+            {
+                // Create more buttons if needed, they are reused for the
+                // visible rows.
+                const size_t first = std::min(p.visibleRows.first, p.rows.size());
+                const size_t count = std::min(p.visibleRows.second, p.rows.size()) - first;
+                auto weak = std::weak_ptr<ListWidget>(std::dynamic_pointer_cast<ListWidget>(shared_from_this()));
+                while (p.buttons.size() < count)
+                {
+                    const size_t index = p.buttons.size();
+                    auto button = ListButton::create(context);
+                    button->setButtonType(p.buttonType);
+                    button->setClickedCallback(
+                        [weak, index]
+                        {
+                            if (auto widget = weak.lock())
+                            {
+                                const int item = widget->_p->buttonItems[index];
+                                if (item != -1 && widget->_p->pushCallback)
+                                {
+                                    widget->_p->pushCallback(item);
+                                }
+                            }
+                        });
+                    button->setCheckedCallback(
+                        [weak, index](bool value)
+                        {
+                            if (auto widget = weak.lock())
+                            {
+                                const int item = widget->_p->buttonItems[index];
+                                if (item != -1)
+                                {
+                                    switch (widget->_p->buttonType)
+                                    {
+                                    case ButtonType::Toggle:
+                                        widget->_p->checked[item] = value;
+                                        if (widget->_p->toggleCallback)
+                                        {
+                                            widget->_p->toggleCallback(item, value);
+                                        }
+                                        break;
+                                    case ButtonType::Radio:
+                                        widget->_p->setChecked(item, true);
+                                        if (widget->_p->radioCallback)
+                                        {
+                                            widget->_p->radioCallback(item);
+                                        }
+                                        break;
+                                    case ButtonType::Exclusive:
+                                        widget->_p->setChecked(item, value);
+                                        if (widget->_p->exclusiveCallback)
+                                        {
+                                            widget->_p->exclusiveCallback(value ? item : -1);
+                                        }
+                                        break;
+                                    default: break;
+                                    }
+                                    widget->_checkedUpdate();
+                                }
+                            }
+                        });
+                    p.buttons.push_back(button);
+                    p.buttonItems.push_back(-1);
+                    p.buttonsInit.push_back(false);
+                    addChild(button);
+                }
+
+                // Keep the keyboard focus with the item rather than the button.
+                std::shared_ptr<ListButton> focusButton;
+                int focusItem = -1;
+                for (size_t i = 0; i < p.buttons.size(); ++i)
                 {
-                    if (item.colorRole != ColorRole::None)
+                    if (p.buttonItems[i] != -1 && p.buttons[i]->hasTextFocus())
                     {
-                        buttons[i]->setBackgroundRole(item.colorRole);
+                        focusButton = p.buttons[i];
+                        focusItem = p.buttonItems[i];
+                        break;
+                    }
+                }
+
+                // New buttons are not shown until they have been through a
+                // pre-layout, otherwise they would be drawn without a size.
+                bool init = false;
+                const BBox2f& g = getGeometry();
+                for (size_t i = 0; i < p.buttons.size(); ++i)
+                {
+                    const auto& button = p.buttons[i];
+                    if (i < count)
+                    {
+                        const size_t row = first + i;
+                        const size_t item = p.rows[row];
+                        p.initButton(button, p.items[item]);
+                        if (ColorRole::None == p.items[item].colorRole)
+                        {
+                            button->setBackgroundRole(p.alternateRowsRoles[row % 2]);
+                        }
+                        button->setChecked(p.checked[item]);
+                        button->setGeometry(BBox2f(g.min.x, g.min.y + p.rowHeight * row, g.w(), p.rowHeight));
+                        button->setVisible(p.buttonsInit[i]);
+                        init |= !p.buttonsInit[i];
+                        p.buttonItems[i] = static_cast<int>(item);
                     }
                     else
                     {
-                        buttons[i]->setBackgroundRole(
-                            (0 == indices.size() % 2) ?
-                            p.alternateRowsRoles[0] :
-                            p.alternateRowsRoles[1]);
+                        button->hide();
+                        p.buttonItems[i] = -1;
                     }
-                    indices.push_back(i);
                 }
+                if (init)
+                {
+                    _resize();
+                }
+
+                if (focusButton)
+                {
+                    bool found = false;
+                    for (size_t i = 0; i < p.buttons.size(); ++i)
+                    {
+                        if (focusItem == p.buttonItems[i] && p.buttons[i]->isVisible())
+                        {
+                            if (p.buttons[i] != focusButton)
+                            {
+                                p.buttons[i]->takeTextFocus();
+                            }
+                            found = true;
+                            break;
+                        }
+                    }
+                    if (!found)
+                    {
+                        focusButton->releaseTextFocus();
+                    }
+                }
+            }
+        }
+
+        void ListWidget::_checkedUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            for (size_t i = 0; i < p.buttons.size(); ++i)
+            {
+                const int item = p.buttonItems[i];
+                p.buttons[i]->setChecked(item != -1 ? p.checked[item] : false);
+            }
+        }
+
+        int ListWidget::Private::getChecked() const
+        {
+            for (size_t i = 0; i < checked.size(); ++i)
+            {
+                if (checked[i])
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+
+        void ListWidget::Private::setChecked(int index, bool value)
+        {
+            switch (buttonType)
+            {
+            case ButtonType::Toggle:
+                if (index >= 0 && index < static_cast<int>(checked.size()))
+                {
+                    checked[index] = value;
+                }
+                break;
+            case ButtonType::Radio:
+                if (value)
+                {
+                    for (size_t i = 0; i < checked.size(); ++i)
+                    {
+                        checked[i] = static_cast<int>(i) == index;
+                    }
+                }
+                break;
+            case ButtonType::Exclusive:
+                for (size_t i = 0; i < checked.size(); ++i)
+                {
+                    checked[i] = value && static_cast<int>(i) == index;
+                }
+                break;
+            default: break;
             }
         }
         
@@ -28,6 +28,10 @@ namespace djv
 
         //! This class provides a list widget.
         //!
+        //! Buttons are only created for the rows that are visible, for example
+        //! in the viewport of a scroll widget, and are reused as the list is
+        //! scrolled. All of the rows have the same height.
+        //!
         //! \todo Keep the current item visible in the scroll widget.
         class ListWidget : public Widget
         {
@@ -61,11 +65,21 @@ namespace djv
         protected:
             void _preLayoutEvent(Core::Event::PreLayout&) override;
             void _layoutEvent(Core::Event::Layout&) override;
+            void _clipEvent(Core::Event::Clip&) override;
             void _keyPressEvent(Core::Event::KeyPress&) override;
 
+            void _initEvent(Core::Event::Init&) override;
+
         private:
+            //! Get the first row and one past the last row that intersect
+            //! the given area.
+            std::pair<size_t, size_t> _getVisibleRows(const Core::BBox2f&) const;
+            void _click(int);
+
             void _itemsUpdate();
             void _filterUpdate();
+            void _buttonsUpdate();
+            void _checkedUpdate();
 
             DJV_PRIVATE();
         };
@@ -837,10 +837,12 @@ namespace djv
                 void _paintEvent(Event::Paint&) override;
 
                 void _childRemovedEvent(Event::ChildRemoved&) override;
+                void _updateEvent(Event::Update&) override;
 
             private:
                 std::map<std::shared_ptr<MenuPopupWidget>, glm::vec2> _widgetToPos;
                 std::map<std::shared_ptr<MenuPopupWidget>, std::weak_ptr<Button::Menu> > _widgetToButton;
+                std::map<std::shared_ptr<MenuPopupWidget>, BBox2f> _widgetToButtonGeometry;
                 std::map<std::shared_ptr<MenuPopupWidget>, Popup> _widgetToPopup;
             };
 
@@ -897,6 +899,7 @@ namespace djv
                     if (auto button = i.second.lock())
                     {
                         const auto& buttonBBox = button->getGeometry();
+                        _widgetToButtonGeometry[i.first] = buttonBBox;
                         const auto& minimumSize = i.first->getMinimumSize();
                         Popup popup = Popup::BelowRight;
                         auto j = _widgetToPopup.find(i.first);
@@ -953,6 +956,31 @@ namespace djv
                     {
                         _widgetToPopup.erase(k);
                     }
+                    const auto l = _widgetToButtonGeometry.find(widget);
+                    if (l != _widgetToButtonGeometry.end())
+                    {
+                        _widgetToButtonGeometry.erase(l);
+                    }
+                }
+            }
+
+            void MenuLayout::_updateEvent(Event::Update&)
+            {
+                // The buttons are not children of this widget, so follow them
+                // when they are moved by another layout.
+                if (!isVisible(true))
+                    return;
+                for (const auto& i : _widgetToButton)
+                {
+                    if (auto button = i.second.lock())
+                    {
+                        const auto j = _widgetToButtonGeometry.find(i.first);
+                        if (j == _widgetToButtonGeometry.end() || button->getGeometry() != j->second)
+                        {
+                            _resize();
+                            break;
+                        }
+                    }
                 }
             }
 
@@ -19,6 +19,7 @@ namespace djv
             struct Popup::Private
             {
                 std::weak_ptr<Widget> button;
+                BBox2f buttonGeometry = BBox2f(0.F, 0.F, 0.F, 0.F);
                 std::map<std::shared_ptr<IObject>, UI::Popup> popups;
             };
 
@@ -60,6 +61,7 @@ namespace djv
                 const BBox2f& g = getGeometry();
                 if (auto button = p.button.lock())
                 {
+                    p.buttonGeometry = button->getGeometry();
                     for (const auto& i : getChildWidgets())
                     {
                         const auto& buttonBBox = button->getGeometry();
@@ -110,6 +112,22 @@ namespace djv
                 }
             }
 
+            void Popup::_updateEvent(Event::Update&)
+            {
+                DJV_PRIVATE_PTR();
+                // The button is not a child of this widget, so follow it
+                // when it is moved by another layout.
+                if (!isVisible(true))
+                    return;
+                if (auto button = p.button.lock())
+                {
+                    if (button->getGeometry() != p.buttonGeometry)
+                    {
+                        _resize();
+                    }
+                }
+            }
+
         } // namespace Layout
     } // namespace UI
 } // namespace djv
@@ -35,6 +35,7 @@ namespace djv
                 void _paintEvent(Core::Event::Paint&) override;
 
                 void _childRemovedEvent(Core::Event::ChildRemoved&) override;
+                void _updateEvent(Core::Event::Update&) override;
 
             private:
                 DJV_PRIVATE();
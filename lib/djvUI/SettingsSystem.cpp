@@ -148,18 +148,11 @@ namespace djv
 
                         auto fileIO = FileSystem::FileIO::create();
                         fileIO->open(_settingsPath.get(), FileSystem::FileIO::Mode::Read);
-                        size_t bufSize = 0;
-#if defined(DJV_MMAP)
-                        const char * bufP = reinterpret_cast<const char *>(fileIO->mmapP());
-                        const char* bufEnd = reinterpret_cast<const char*>(fileIO->mmapEnd());
-                        bufSize = bufEnd - bufP;
-#else // DJV_MMAP
                         std::vector<char> buf;
-                        bufSize = fileIO->getSize();
+                        const size_t bufSize = fileIO->getSize();
                         buf.resize(bufSize);
                         fileIO->read(buf.data(), bufSize);
                         const char* bufP = buf.data();
-#endif // DJV_MMAP
 
                         rapidjson::ParseResult result = _document.Parse(bufP, bufSize);
                         if (!result)
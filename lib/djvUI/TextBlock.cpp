@@ -22,6 +22,22 @@ namespace djv
 {
     namespace UI
     {
+        namespace
+        {
+            typedef std::pair<AV::Font::FontInfo, float> TextCacheKey;
+
+            struct TextCacheKeyHash
+            {
+                std::size_t operator() (const TextCacheKey& value) const noexcept
+                {
+                    size_t hash = value.first.getHash();
+                    Memory::hashCombine(hash, value.second);
+                    return hash;
+                }
+            };
+
+        } // namespace
+
         struct TextBlock::Private
         {
             std::shared_ptr<AV::Font::System> fontSystem;
@@ -38,9 +54,8 @@ namespace djv
             AV::Font::Metrics fontMetrics;
             std::future<AV::Font::Metrics> fontMetricsFuture;
 
-            typedef std::pair<AV::Font::FontInfo, float> TextCacheKey;
             typedef std::pair<std::vector<AV::Font::TextLine>, glm::vec2> TextCacheValue;
-            Memory::Cache<TextCacheKey, TextCacheValue> textCache;
+            Memory::Cache<TextCacheKey, TextCacheValue, TextCacheKeyHash> textCache;
 
             BBox2f clipRect;
 
@@ -39,6 +39,9 @@ namespace djv
             const Time::Duration tooltipTimeout = std::chrono::milliseconds(500);
             const float tooltipHideDelta = 1.F;
 
+            //! \todo Should this be configurable?
+            const size_t redrawRectsMax = 16;
+
             size_t globalWidgetCount = 0;
 
             class DefaultTooltipWidget : public ITooltipWidget
@@ -93,6 +96,7 @@ namespace djv
         bool Widget::_tooltipsEnabled = true;
         bool Widget::_resizeRequest   = true;
         bool Widget::_redrawRequest   = true;
+        std::vector<BBox2f> Widget::_redrawRects;
 
         void Widget::_init(const std::shared_ptr<Context>& context)
         {
@@ -131,9 +135,14 @@ namespace djv
         {
             if (value == _visible)
                 return;
+            _redraw();
             _visible = value;
             _visibleInit = value;
+            _clipDirty = true;
             _resize();
+
+            // Hidden widgets are skipped by the parent layout.
+            _resizeParent();
         }
 
         void Widget::setOpacity(float value)
@@ -141,15 +150,24 @@ namespace djv
             if (value == _opacity)
                 return;
             _opacity = value;
-            _resize();
+            _resizeRequest = true;
+            _clipDirty = true;
+            _setParentsDirty();
+            _redraw();
         }
 
         void Widget::setGeometry(const BBox2f& value)
         {
             if (value == _geometry)
                 return;
+
+            // The new area is redrawn when the widget is clipped.
+            _redraw();
             _geometry = value;
-            _resize();
+            _resizeRequest = true;
+            _layoutDirty = true;
+            _clipDirty = true;
+            _setParentsDirty();
         }
 
         void Widget::setMargin(const Layout::Margin& value)
@@ -158,6 +176,9 @@ namespace djv
                 return;
             _margin = value;
             _resize();
+
+            // The margin is included in the parent's size hints.
+            _resizeParent();
         }
 
         void Widget::setHAlign(HAlign value)
@@ -517,9 +538,9 @@ namespace djv
                             }
                         }
                     }
+                    _redraw();
                     _clipped = newParent;
                     _clipRect = BBox2f(0.F, 0.F, 0.F, 0.F);
-                    _redraw();
                     break;
                 }
                 case Event::Type::ChildAdded:
@@ -533,6 +554,12 @@ namespace djv
                             _childWidgets.erase(i);
                         }
                         _childWidgets.push_back(widget);
+
+                        // The child needs to be clipped by the new parent, and
+                        // any pending layout requests it has are now reached
+                        // through this widget.
+                        widget->_clipDirty = true;
+                        _childrenDirty = true;
                     }
                     _resize();
                     break;
@@ -605,6 +632,8 @@ namespace djv
                 case Event::Type::Clip:
                 {
                     auto& clipEvent = static_cast<Event::Clip&>(event);
+                    const bool clipped = _clipped;
+                    const BBox2f clipRect = _clipRect;
                     if (auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock()))
                     {
                         _parentsVisible = parent->_visible && parent->_parentsVisible;
@@ -622,6 +651,16 @@ namespace djv
                         _clipped = false;
                         _clipRect = BBox2f(0.F, 0.F, 0.F, 0.F);
                     }
+                    if (clipped != _clipped || clipRect != _clipRect)
+                    {
+                        // Redraw both the area the widget is leaving and the
+                        // area it is moving to.
+                        if (!clipped)
+                        {
+                            _addRedrawRect(clipRect);
+                        }
+                        _redraw();
+                    }
                     if (_clipped)
                     {
                         for (auto& i : _pointerToTooltips)
@@ -872,12 +911,30 @@ namespace djv
             }
         }
 
+        void Widget::_resize()
+        {
+            _resizeRequest = true;
+            _preLayoutDirty = true;
+            _layoutDirty = true;
+            _redraw();
+            if (auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock()))
+            {
+                parent->_layoutDirty = true;
+            }
+            _setParentsDirty();
+        }
+
+        void Widget::_redraw()
+        {
+            _addRedrawRect(_getRedrawRect());
+        }
+
         void Widget::_setMinimumSize(const glm::vec2& value)
         {
             if (value == _minimumSize)
                 return;
             _minimumSize = value;
-            _resize();
+            _resizeParent();
         }
 
         void Widget::_setDesiredSize(const glm::vec2& value)
@@ -885,7 +942,84 @@ namespace djv
             if (value == _desiredSize)
                 return;
             _desiredSize = value;
-            _resize();
+            _resizeParent();
+        }
+
+        void Widget::_resizeParent()
+        {
+            _resizeRequest = true;
+            if (auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock()))
+            {
+                parent->_resize();
+            }
+        }
+
+        void Widget::_setParentsDirty()
+        {
+            // Stop at the first parent that is already marked, its parents
+            // have already been marked as well.
+            auto parent = std::dynamic_pointer_cast<Widget>(getParent().lock());
+            while (parent && !parent->_childrenDirty)
+            {
+                parent->_childrenDirty = true;
+                parent = std::dynamic_pointer_cast<Widget>(parent->getParent().lock());
+            }
+        }
+
+        BBox2f Widget::_getRedrawRect() const
+        {
+            BBox2f out(0.F, 0.F, 0.F, 0.F);
+            if (!_clipped)
+            {
+                // Widgets without a parent widget are not clipped, use the
+                // geometry instead.
+                out = _clipRect.isValid() ? _clipRect : _geometry;
+            }
+            return out;
+        }
+
+        void Widget::_addRedrawRect(const BBox2f& value)
+        {
+            _redrawRequest = true;
+            if (!value.isValid())
+                return;
+
+            // Round out to whole pixels so that the edges of the area are
+            // completely repainted.
+            BBox2f rect(
+                glm::vec2(floorf(value.min.x), floorf(value.min.y)),
+                glm::vec2(ceilf(value.max.x), ceilf(value.max.y)));
+
+            // Merge the rectangle with any that it overlaps, so that no area
+            // is painted twice.
+            bool merged = true;
+            while (merged)
+            {
+                merged = false;
+                for (auto i = _redrawRects.begin(); i != _redrawRects.end(); ++i)
+                {
+                    if (i->intersects(rect))
+                    {
+                        rect.expand(*i);
+                        _redrawRects.erase(i);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+            _redrawRects.push_back(rect);
+
+            // Collapse to a single rectangle when there are too many.
+            if (_redrawRects.size() > redrawRectsMax)
+            {
+                rect = _redrawRects[0];
+                for (const auto& i : _redrawRects)
+                {
+                    rect.expand(i);
+                }
+                _redrawRects.clear();
+                _redrawRects.push_back(rect);
+            }
         }
 
         std::string Widget::_getTooltipText() const
@@ -200,10 +200,14 @@ namespace djv
 
             ///@}
 
-            //! Call this function when the widget needs resizing.
+            //! Call this function when the widget needs resizing. The size
+            //! hints of the widget are computed again, and the widget and its
+            //! parent are laid out again. Other widgets are only laid out
+            //! again if their size hints or geometry change as a result.
             void _resize();
 
-            //! Call this function to redraw the widget.
+            //! Call this function to redraw the widget. Only the visible area
+            //! of the widget is painted again.
             void _redraw();
 
             //! Set the minimum size. This is computed and set in the pre-layout event.
@@ -220,6 +224,11 @@ namespace djv
             virtual std::shared_ptr<ITooltipWidget> _createTooltip(const glm::vec2& pos);
 
         private:
+            void _resizeParent();
+            void _setParentsDirty();
+            Core::BBox2f _getRedrawRect() const;
+            static void _addRedrawRect(const Core::BBox2f&);
+
             std::vector<std::shared_ptr<Widget> > _childWidgets;
 
             static std::chrono::steady_clock::time_point _updateTime;
@@ -261,6 +270,11 @@ namespace djv
 
             static bool         _resizeRequest;
             static bool         _redrawRequest;
+            static std::vector<Core::BBox2f> _redrawRects;
+            bool                _preLayoutDirty  = true;
+            bool                _layoutDirty     = true;
+            bool                _clipDirty       = true;
+            bool                _childrenDirty   = false;
 
             std::weak_ptr<EventSystem>              _eventSystem;
             std::shared_ptr<AV::Render2D::Render>   _render;
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvViewApp/Enum.h>
+
+#include <djvCore/ValueObserver.h>
+
+#include <functional>
+#include <future>
+
+namespace djv
+{
+    namespace Core
+    {
+        class Context;
+        class LogSystem;
+
+    } // namespace Core
+
+    namespace AV
+    {
+        namespace Image
+        {
+            class Image;
+
+        } // namespace Image
+    } // namespace AV
+
+    namespace ViewApp
+    {
+        class MediaWidget;
+
+        //! This class computes a value from the current image of the active
+        //! media on a separate thread.
+        //!
+        //! Images that arrive while the value is being computed replace each
+        //! other, so only the most recent one is used next. The value is also
+        //! computed again when playback stops.
+        template<typename T>
+        class ActiveImageTask : public std::enable_shared_from_this<ActiveImageTask<T> >
+        {
+            DJV_NON_COPYABLE(ActiveImageTask);
+
+        protected:
+            void _init(const std::string& name, const std::shared_ptr<Core::Context>&);
+            ActiveImageTask();
+
+        public:
+            //! The task callback is called on the main thread with the image and
+            //! whether the media is playing. It returns the function that
+            //! computes the value on the separate thread.
+            typedef std::function<std::function<T(void)>(const std::shared_ptr<AV::Image::Image>&, bool playback)> TaskCallback;
+
+            static std::shared_ptr<ActiveImageTask<T> > create(const std::string& name, const std::shared_ptr<Core::Context>&);
+
+            void setTaskCallback(const TaskCallback&);
+
+            //! Set the callback for the computed values. A default value is
+            //! given when there is no image.
+            void setValueCallback(const std::function<void(const T&)>&);
+
+            //! Compute the value again, for example when the options change.
+            void update();
+
+            //! Check whether the value has been computed. This should be called
+            //! from the update event of the widget.
+            void tick();
+
+        private:
+            void _setImage(const std::shared_ptr<AV::Image::Image>&);
+            void _setPlayback(bool);
+            void _start();
+
+            std::string _name;
+            std::shared_ptr<Core::LogSystem> _logSystem;
+            TaskCallback _taskCallback;
+            std::function<void(const T&)> _valueCallback;
+            std::shared_ptr<AV::Image::Image> _image;
+            bool _playback = false;
+            bool _changed = false;
+            std::future<T> _future;
+            std::shared_ptr<Core::ValueObserver<std::shared_ptr<MediaWidget> > > _activeWidgetObserver;
+            std::shared_ptr<Core::ValueObserver<std::shared_ptr<AV::Image::Image> > > _imageObserver;
+            std::shared_ptr<Core::ValueObserver<Playback> > _playbackObserver;
+        };
+
+    } // namespace ViewApp
+} // namespace djv
+
+#include <djvViewApp/ActiveImageTaskInline.h>
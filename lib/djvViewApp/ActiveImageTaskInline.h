@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvViewApp/Media.h>
+#include <djvViewApp/MediaWidget.h>
+#include <djvViewApp/WindowSystem.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/LogSystem.h>
+
+namespace djv
+{
+    namespace ViewApp
+    {
+        template<typename T>
+        inline void ActiveImageTask<T>::_init(const std::string& name, const std::shared_ptr<Core::Context>& context)
+        {
+            _name = name;
+            _logSystem = context->getSystemT<Core::LogSystem>();
+
+            auto weak = std::weak_ptr<ActiveImageTask<T> >(this->shared_from_this());
+            if (auto windowSystem = context->getSystemT<WindowSystem>())
+            {
+                _activeWidgetObserver = Core::ValueObserver<std::shared_ptr<MediaWidget> >::create(
+                    windowSystem->observeActiveWidget(),
+                    [weak](const std::shared_ptr<MediaWidget>& value)
+                    {
+                        if (auto task = weak.lock())
+                        {
+                            if (value)
+                            {
+                                task->_imageObserver = Core::ValueObserver<std::shared_ptr<AV::Image::Image> >::create(
+                                    value->getMedia()->observeCurrentImage(),
+                                    [weak](const std::shared_ptr<AV::Image::Image>& value)
+                                    {
+                                        if (auto task = weak.lock())
+                                        {
+                                            task->_setImage(value);
+                                        }
+                                    });
+                                task->_playbackObserver = Core::ValueObserver<Playback>::create(
+                                    value->getMedia()->observePlayback(),
+                                    [weak](Playback value)
+                                    {
+                                        if (auto task = weak.lock())
+                                        {
+                                            task->_setPlayback(value != Playback::Stop);
+                                        }
+                                    });
+                            }
+                            else
+                            {
+                                task->_imageObserver.reset();
+                                task->_playbackObserver.reset();
+                                task->_setImage(nullptr);
+                                task->_setPlayback(false);
+                            }
+                        }
+                    });
+            }
+        }
+
+        template<typename T>
+        inline ActiveImageTask<T>::ActiveImageTask()
+        {}
+
+        template<typename T>
+        inline std::shared_ptr<ActiveImageTask<T> > ActiveImageTask<T>::create(
+            const std::string& name,
+            const std::shared_ptr<Core::Context>& context)
+        {
+            auto out = std::shared_ptr<ActiveImageTask<T> >(new ActiveImageTask<T>);
+            out->_init(name, context);
+            return out;
+        }
+
+        template<typename T>
+        inline void ActiveImageTask<T>::setTaskCallback(const TaskCallback& value)
+        {
+            _taskCallback = value;
+            update();
+        }
+
+        template<typename T>
+        inline void ActiveImageTask<T>::setValueCallback(const std::function<void(const T&)>& value)
+        {
+            _valueCallback = value;
+        }
+
+        template<typename T>
+        inline void ActiveImageTask<T>::update()
+        {
+            _changed = true;
+            _start();
+        }
+
+        template<typename T>
+        inline void ActiveImageTask<T>::tick()
+        {
+            if (_future.valid() &&
+                _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                try
+                {
+                    const T value = _future.get();
+                    if (_valueCallback)
+                    {
+                        _valueCallback(value);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _logSystem->log(_name, e.what(), Core::LogLevel::Error);
+                }
+                _start();
+            }
+        }
+
+        template<typename T>
+        inline void ActiveImageTask<T>::_setImage(const std::shared_ptr<AV::Image::Image>& value)
+        {
+            if (value == _image)
+                return;
+            _image = value;
+            update();
+        }
+
+        template<typename T>
+        inline void ActiveImageTask<T>::_setPlayback(bool value)
+        {
+            if (value == _playback)
+                return;
+            _playback = value;
+            if (!value)
+            {
+                update();
+            }
+        }
+
+        template<typename T>
+        inline void ActiveImageTask<T>::_start()
+        {
+            if (_changed && !_future.valid() && _taskCallback)
+            {
+                _changed = false;
+                if (_image)
+                {
+                    _future = std::async(std::launch::async, _taskCallback(_image, _playback));
+                }
+                else if (_valueCallback)
+                {
+                    _valueCallback(T());
+                }
+            }
+        }
+
+    } // namespace ViewApp
+} // namespace djv
@@ -427,6 +427,18 @@ namespace djv
                 _lineGraphs["Primitives"] = UI::LineGraphWidget::create(context);
                 _lineGraphs["Primitives"]->setPrecision(0);
 
+                _labels["DrawCalls"] = UI::Label::create(context);
+                _labels["DrawCallsValue"] = UI::Label::create(context);
+                _labels["DrawCallsValue"]->setFontFamily(AV::Font::familyMono);
+                _lineGraphs["DrawCalls"] = UI::LineGraphWidget::create(context);
+                _lineGraphs["DrawCalls"]->setPrecision(0);
+
+                _labels["StateChanges"] = UI::Label::create(context);
+                _labels["StateChangesValue"] = UI::Label::create(context);
+                _labels["StateChangesValue"]->setFontFamily(AV::Font::familyMono);
+                _lineGraphs["StateChanges"] = UI::LineGraphWidget::create(context);
+                _lineGraphs["StateChanges"]->setPrecision(0);
+
                 _labels["TextureAtlas"] = UI::Label::create(context);
                 _labels["TextureAtlasValue"] = UI::Label::create(context);
                 _labels["TextureAtlasValue"]->setFontFamily(AV::Font::familyMono);
@@ -457,6 +469,16 @@ namespace djv
                 _layout->addChild(hLayout);
                 _layout->addChild(_lineGraphs["Primitives"]);
                 hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["DrawCalls"]);
+                hLayout->addChild(_labels["DrawCallsValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_lineGraphs["DrawCalls"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["StateChanges"]);
+                hLayout->addChild(_labels["StateChangesValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_lineGraphs["StateChanges"]);
+                hLayout = UI::HorizontalLayout::create(context);
                 hLayout->addChild(_labels["TextureAtlas"]);
                 hLayout->addChild(_labels["TextureAtlasValue"]);
                 _layout->addChild(hLayout);
@@ -501,11 +523,15 @@ namespace djv
             {
                 const auto& render = _getRender();
                 const size_t primitives = render->getPrimitivesCount();
+                const size_t drawCalls = render->getDrawCallsCount();
+                const size_t stateChanges = render->getStateChangesCount();
                 const float textureAtlasPercentage = render->getTextureAtlasPercentage();
                 const size_t dynamicTextureCount = render->getDynamicTextureCount();
                 const size_t vboSize = render->getVBOSize();
 
                 _lineGraphs["Primitives"]->addSample(primitives);
+                _lineGraphs["DrawCalls"]->addSample(drawCalls);
+                _lineGraphs["StateChanges"]->addSample(stateChanges);
                 _thermometerWidgets["TextureAtlas"]->setPercentage(textureAtlasPercentage);
                 _lineGraphs["DynamicTextureCount"]->addSample(dynamicTextureCount);
                 _lineGraphs["VBOSize"]->addSample(vboSize);
@@ -520,6 +546,26 @@ namespace djv
                     ss << primitives;
                     _labels["PrimitivesValue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_render_draw_calls")) << ":";
+                    _labels["DrawCalls"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << drawCalls;
+                    _labels["DrawCallsValue"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_render_state_changes")) << ":";
+                    _labels["StateChanges"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << stateChanges;
+                    _labels["StateChangesValue"]->setText(ss.str());
+                }
                 {
                     std::stringstream ss;
                     ss << _getText(DJV_TEXT("debug_render_texture_atlas")) << ":";
@@ -579,6 +625,8 @@ namespace djv
                 size_t _videoQueueCount = 0;
                 size_t _audioQueueMax = 0;
                 size_t _audioQueueCount = 0;
+                size_t _audioUnderrunCount = 0;
+                size_t _audioOverrunCount = 0;
                 std::map<std::string, std::shared_ptr<UI::Label> > _labels;
                 std::map<std::string, std::shared_ptr<UI::LineGraphWidget> > _lineGraphs;
                 std::shared_ptr<UI::VerticalLayout> _layout;
@@ -589,6 +637,8 @@ namespace djv
                 std::shared_ptr<ValueObserver<size_t> > _videoQueueCountObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueMaxObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueCountObserver;
+                std::shared_ptr<ValueObserver<size_t> > _audioUnderrunCountObserver;
+                std::shared_ptr<ValueObserver<size_t> > _audioOverrunCountObserver;
             };
 
             void MediaDebugWidget::_init(const std::shared_ptr<Context>& context)
@@ -609,6 +659,13 @@ namespace djv
                 _lineGraphs["AudioQueue"] = UI::LineGraphWidget::create(context);
                 _lineGraphs["AudioQueue"]->setPrecision(0);
 
+                _labels["AudioUnderruns"] = UI::Label::create(context);
+                _labels["AudioUnderrunsValue"] = UI::Label::create(context);
+                _labels["AudioUnderrunsValue"]->setFontFamily(AV::Font::familyMono);
+                _labels["AudioOverruns"] = UI::Label::create(context);
+                _labels["AudioOverrunsValue"] = UI::Label::create(context);
+                _labels["AudioOverrunsValue"]->setFontFamily(AV::Font::familyMono);
+
                 for (auto& i : _labels)
                 {
                     i.second->setTextHAlign(UI::TextHAlign::Left);
@@ -624,6 +681,14 @@ namespace djv
                 _layout->addChild(_lineGraphs["VideoQueue"]);
                 _layout->addChild(_labels["AudioQueue"]);
                 _layout->addChild(_lineGraphs["AudioQueue"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["AudioUnderruns"]);
+                hLayout->addChild(_labels["AudioUnderrunsValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["AudioOverruns"]);
+                hLayout->addChild(_labels["AudioOverrunsValue"]);
+                _layout->addChild(hLayout);
                 addChild(_layout);
 
                 auto weak = std::weak_ptr<MediaDebugWidget>(std::dynamic_pointer_cast<MediaDebugWidget>(shared_from_this()));
@@ -704,6 +769,26 @@ namespace djv
                                         widget->_widgetUpdate();
                                     }
                                 });
+                                widget->_audioUnderrunCountObserver = ValueObserver<size_t>::create(
+                                    value->observeAudioUnderrunCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioUnderrunCount = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
+                                widget->_audioOverrunCountObserver = ValueObserver<size_t>::create(
+                                    value->observeAudioOverrunCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioOverrunCount = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
                             }
                             else
                             {
@@ -713,12 +798,16 @@ namespace djv
                                 widget->_videoQueueCount = 0;
                                 widget->_audioQueueMax = 0;
                                 widget->_audioQueueCount = 0;
+                                widget->_audioUnderrunCount = 0;
+                                widget->_audioOverrunCount = 0;
                                 widget->_sequenceObserver.reset();
                                 widget->_currentFrameObserver.reset();
                                 widget->_videoQueueMaxObserver.reset();
                                 widget->_videoQueueCountObserver.reset();
                                 widget->_audioQueueMaxObserver.reset();
                                 widget->_audioQueueCountObserver.reset();
+                                widget->_audioUnderrunCountObserver.reset();
+                                widget->_audioOverrunCountObserver.reset();
                                 widget->_widgetUpdate();
                             }
                         }
@@ -776,6 +865,26 @@ namespace djv
                     ss << _currentFrame << " / " << _sequence.getFrameCount();
                     _labels["CurrentFrameValue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_audio_underruns")) << ":";
+                    _labels["AudioUnderruns"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _audioUnderrunCount;
+                    _labels["AudioUnderrunsValue"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_audio_overruns")) << ":";
+                    _labels["AudioOverruns"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _audioOverrunCount;
+                    _labels["AudioOverrunsValue"]->setText(ss.str());
+                }
             }
 
         } // namespace
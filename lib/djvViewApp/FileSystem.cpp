@@ -15,6 +15,7 @@
 #include <djvUIComponents/IOSettings.h>
 
 #include <djvUI/Action.h>
+#include <djvUI/ActionGroup.h>
 #include <djvUI/Menu.h>
 #include <djvUI/SettingsSystem.h>
 #include <djvUI/ShortcutData.h>
@@ -55,6 +56,7 @@ namespace djv
             std::shared_ptr<ValueSubject<std::shared_ptr<Media> > > currentMedia;
             std::shared_ptr<ValueSubject<float> > cachePercentage;
             std::map<std::string, std::shared_ptr<UI::Action> > actions;
+            std::shared_ptr<UI::ActionGroup> proxyScaleActionGroup;
             std::shared_ptr<UI::Menu> menu;
             std::shared_ptr<UI::FileBrowser::Dialog> fileBrowserDialog;
             Core::FileSystem::Path fileBrowserPath = Core::FileSystem::Path(".");
@@ -66,6 +68,7 @@ namespace djv
             std::shared_ptr<ValueObserver<size_t> > threadCountObserver;
             std::shared_ptr<ValueObserver<bool> > cacheEnabledObserver;
             std::shared_ptr<ValueObserver<int> > cacheMaxGBObserver;
+            std::shared_ptr<ValueObserver<AV::IO::ProxyScale> > proxyScaleObserver;
             std::shared_ptr<Time::Timer> cacheTimer;
 
             typedef std::pair<Core::FileSystem::FileInfo, std::string> FileInfoAndNumber;
@@ -106,6 +109,16 @@ namespace djv
             p.actions["Layers"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["NextLayer"] = UI::Action::create();
             p.actions["PrevLayer"] = UI::Action::create();
+            p.actions["ProxyFull"] = UI::Action::create();
+            p.actions["ProxyHalf"] = UI::Action::create();
+            p.actions["ProxyQuarter"] = UI::Action::create();
+            p.actions["ProxyEighth"] = UI::Action::create();
+            p.proxyScaleActionGroup = UI::ActionGroup::create(UI::ButtonType::Radio);
+            p.proxyScaleActionGroup->setActions({
+                p.actions["ProxyFull"],
+                p.actions["ProxyHalf"],
+                p.actions["ProxyQuarter"],
+                p.actions["ProxyEighth"] });
             //! \todo Implement me!
             //p.actions["8BitConversion"] = UI::Action::create();
             //p.actions["8BitConversion"]->setButtonType(UI::ButtonType::Toggle);
@@ -137,6 +150,11 @@ namespace djv
             p.menu->addAction(p.actions["PrevLayer"]);
             p.menu->addAction(p.actions["Layers"]);
             p.menu->addSeparator();
+            p.menu->addAction(p.actions["ProxyFull"]);
+            p.menu->addAction(p.actions["ProxyHalf"]);
+            p.menu->addAction(p.actions["ProxyQuarter"]);
+            p.menu->addAction(p.actions["ProxyEighth"]);
+            p.menu->addSeparator();
             //p.menu->addAction(p.actions["8BitConversion"]);
             //p.menu->addSeparator();
             p.menu->addAction(p.actions["Exit"]);
@@ -277,6 +295,18 @@ namespace djv
                     }
                 });
 
+            p.proxyScaleActionGroup->setRadioCallback(
+                [weak](int index)
+                {
+                    if (auto system = weak.lock())
+                    {
+                        if (auto media = system->_p->currentMedia->get())
+                        {
+                            media->setProxyScale(static_cast<AV::IO::ProxyScale>(index));
+                        }
+                    }
+                });
+
             p.actions["Layers"]->setCheckedCallback(
                 [weak, contextWeak](bool value)
                 {
@@ -349,10 +379,15 @@ namespace djv
             auto ioSettings = settingsSystem->getSettingsT<UI::Settings::IO>();
             p.threadCountObserver = ValueObserver<size_t>::create(
                 ioSettings->observeThreadCount(),
-                [weak](size_t value)
+                [weak, contextWeak](size_t value)
                 {
                     if (auto system = weak.lock())
                     {
+                        if (auto context = contextWeak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            io->setThreadCount(value);
+                        }
                         system->_p->threadCount = value;
                         const auto& media = system->_p->media->get();
                         for (const auto& i : media)
@@ -366,24 +401,20 @@ namespace djv
             p.cacheTimer->setRepeating(true);
             p.cacheTimer->start(
                 Time::getTime(Time::TimerValue::Medium),
-                [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                [weak, contextWeak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
                 {
-                    if (auto system = weak.lock())
+                    if (auto context = contextWeak.lock())
                     {
-                        size_t cacheMaxByteCount  = 0;
-                        size_t cacheByteCount = 0;
-                        for (const auto& i : system->_p->media->get())
+                        if (auto system = weak.lock())
                         {
-                            if (i->hasCache())
-                            {
-                                cacheMaxByteCount  += i->getCacheMaxByteCount();
-                                cacheByteCount += i->getCacheByteCount();
-                            }
+                            auto io = context->getSystemT<AV::IO::System>();
+                            const size_t cacheMaxByteCount = io->getCacheMaxByteCount();
+                            const size_t cacheByteCount = io->getCacheByteCount();
+                            const float percentage = cacheMaxByteCount ?
+                                (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
+                                0.F;
+                            system->_p->cachePercentage->setIfChanged(percentage);
                         }
-                        const float percentage = cacheMaxByteCount ?
-                            (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
-                            0.F;
-                        system->_p->cachePercentage->setIfChanged(percentage);
                     }
                 });
         }
@@ -610,6 +641,24 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.currentMedia->setIfChanged(media))
             {
+                if (media)
+                {
+                    auto weak = std::weak_ptr<FileSystem>(std::dynamic_pointer_cast<FileSystem>(shared_from_this()));
+                    p.proxyScaleObserver = ValueObserver<AV::IO::ProxyScale>::create(
+                        media->observeProxyScale(),
+                        [weak](AV::IO::ProxyScale value)
+                        {
+                            if (auto system = weak.lock())
+                            {
+                                system->_p->proxyScaleActionGroup->setChecked(static_cast<int>(value));
+                            }
+                        });
+                }
+                else
+                {
+                    p.proxyScaleObserver.reset();
+                    p.proxyScaleActionGroup->setChecked(0);
+                }
                 _actionsUpdate();
             }
         }
@@ -639,28 +688,27 @@ namespace djv
             p.actions["Prev"]->setEnabled(size > 1);
             p.actions["NextLayer"]->setEnabled(size > 0);
             p.actions["PrevLayer"]->setEnabled(size > 0);
+            p.actions["ProxyFull"]->setEnabled(size > 0);
+            p.actions["ProxyHalf"]->setEnabled(size > 0);
+            p.actions["ProxyQuarter"]->setEnabled(size > 0);
+            p.actions["ProxyEighth"]->setEnabled(size > 0);
         }
 
         void FileSystem::_cacheUpdate()
         {
             DJV_PRIVATE_PTR();
-            size_t cacheCount = 0;
-            const auto& media = p.media->get();
-            for (const auto& i : media)
+            if (auto context = getContext().lock())
             {
-                if (i->hasCache())
+                // The I/O system divides the cache between the media.
+                const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
+                const size_t cacheMaxByteCount = p.settings->observeCacheMaxGB()->get() * Memory::gigabyte;
+                auto io = context->getSystemT<AV::IO::System>();
+                io->setCacheMaxByteCount(cacheEnabled ? cacheMaxByteCount : 0);
+                for (const auto& i : p.media->get())
                 {
-                    ++cacheCount;
+                    i->setCacheEnabled(cacheEnabled);
                 }
             }
-            const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
-            const size_t cacheMaxByteCount = p.settings->observeCacheMaxGB()->get() * Memory::gigabyte;
-            const size_t mediaCacheSizeByteCount = cacheCount > 0 ? (cacheMaxByteCount / cacheCount) : 0;
-            for (const auto& i : media)
-            {
-                i->setCacheEnabled(cacheEnabled);
-                i->setCacheMaxByteCount(mediaCacheSizeByteCount);
-            }
         }
 
         void FileSystem::_showFileBrowserDialog()
@@ -793,6 +841,14 @@ namespace djv
                 p.actions["NextLayer"]->setTooltip(_getText(DJV_TEXT("menu_file_next_layer_tooltip")));
                 p.actions["PrevLayer"]->setText(_getText(DJV_TEXT("menu_file_previous_layer")));
                 p.actions["PrevLayer"]->setTooltip(_getText(DJV_TEXT("menu_file_previous_layer_tooltip")));
+                p.actions["ProxyFull"]->setText(_getText(DJV_TEXT("menu_file_proxy_full")));
+                p.actions["ProxyFull"]->setTooltip(_getText(DJV_TEXT("menu_file_proxy_full_tooltip")));
+                p.actions["ProxyHalf"]->setText(_getText(DJV_TEXT("menu_file_proxy_half")));
+                p.actions["ProxyHalf"]->setTooltip(_getText(DJV_TEXT("menu_file_proxy_half_tooltip")));
+                p.actions["ProxyQuarter"]->setText(_getText(DJV_TEXT("menu_file_proxy_quarter")));
+                p.actions["ProxyQuarter"]->setTooltip(_getText(DJV_TEXT("menu_file_proxy_quarter_tooltip")));
+                p.actions["ProxyEighth"]->setText(_getText(DJV_TEXT("menu_file_proxy_eighth")));
+                p.actions["ProxyEighth"]->setTooltip(_getText(DJV_TEXT("menu_file_proxy_eighth_tooltip")));
                 //p.actions["8BitConversion"]->setText(_getText(DJV_TEXT("8-bit_conversion")));
                 //p.actions["8BitConversion"]->setTooltip(_getText(DJV_TEXT("8-bit_conversion_tooltip")));
                 p.actions["Exit"]->setText(_getText(DJV_TEXT("menu_file_exit")));
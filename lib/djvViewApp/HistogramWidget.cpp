@@ -4,21 +4,256 @@
 
 #include <djvViewApp/HistogramWidget.h>
 
+#include <djvViewApp/ActiveImageTask.h>
+
+#include <djvUI/ComboBox.h>
+#include <djvUI/FloatEdit.h>
+#include <djvUI/FormLayout.h>
+#include <djvUI/RowLayout.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ImageHistogram.h>
+#include <djvAV/Render2D.h>
+
+#include <djvCore/Context.h>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace ViewApp
     {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t binCount = 256;
+
+            class GraphWidget : public UI::Widget
+            {
+                DJV_NON_COPYABLE(GraphWidget);
+
+            protected:
+                void _init(const std::shared_ptr<Context>&);
+                GraphWidget();
+
+            public:
+                ~GraphWidget() override;
+
+                static std::shared_ptr<GraphWidget> create(const std::shared_ptr<Context>&);
+
+                void setHistogram(const AV::Image::Histogram&);
+
+            protected:
+                void _preLayoutEvent(Event::PreLayout&) override;
+                void _paintEvent(Event::Paint&) override;
+
+            private:
+                AV::Image::Histogram _histogram;
+            };
+
+            void GraphWidget::_init(const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::ViewApp::HistogramWidget::GraphWidget");
+            }
+
+            GraphWidget::GraphWidget()
+            {}
+
+            GraphWidget::~GraphWidget()
+            {}
+
+            std::shared_ptr<GraphWidget> GraphWidget::create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<GraphWidget>(new GraphWidget);
+                out->_init(context);
+                return out;
+            }
+
+            void GraphWidget::setHistogram(const AV::Image::Histogram& value)
+            {
+                if (value == _histogram)
+                    return;
+                _histogram = value;
+                _redraw();
+            }
+
+            void GraphWidget::_preLayoutEvent(Event::PreLayout&)
+            {
+                const auto& style = _getStyle();
+                const float sw = style->getMetric(UI::MetricsRole::Swatch);
+                _setMinimumSize(glm::vec2(sw * 2.F, sw));
+            }
+
+            void GraphWidget::_paintEvent(Event::Paint&)
+            {
+                const auto& style = _getStyle();
+                const BBox2f& g = getMargin().bbox(getGeometry(), style);
+                const auto& render = _getRender();
+                render->setFillColor(style->getColor(UI::ColorRole::Trough));
+                render->drawRect(g);
+
+                // Draw each channel with one column per pixel. The column height
+                // is the largest of the bins it covers.
+                const size_t binCount = _histogram.getBinCount();
+                const size_t max = _histogram.getMax();
+                const size_t width = static_cast<size_t>(g.w());
+                if (binCount > 0 && max > 0 && width > 0)
+                {
+                    const uint8_t channelCount = _histogram.getChannelCount();
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        AV::Image::Color color = style->getColor(UI::ColorRole::Foreground);
+                        float alpha = .5F;
+                        switch (channelCount)
+                        {
+                        case 2:
+                            alpha = 0 == c ? .5F : .2F;
+                            break;
+                        case 3:
+                        case 4:
+                            switch (c)
+                            {
+                            case 0: color = AV::Image::Color(1.F, 0.F, 0.F); break;
+                            case 1: color = AV::Image::Color(0.F, 1.F, 0.F); break;
+                            case 2: color = AV::Image::Color(0.F, 0.F, 1.F); break;
+                            default: alpha = .2F; break;
+                            }
+                            break;
+                        default: break;
+                        }
+                        color.setF32(color.getF32(3) * alpha, 3);
+                        render->setFillColor(color);
+
+                        const size_t* bins = _histogram.getBins(c);
+                        std::vector<BBox2f> rects;
+                        for (size_t x = 0; x < width; ++x)
+                        {
+                            const size_t b0 = x * binCount / width;
+                            const size_t b1 = std::max((x + 1) * binCount / width, b0 + 1);
+                            size_t value = 0;
+                            for (size_t b = b0; b < b1 && b < binCount; ++b)
+                            {
+                                value = std::max(value, bins[b]);
+                            }
+                            if (value > 0)
+                            {
+                                const float h = std::max(value / static_cast<float>(max) * g.h(), 1.F);
+                                rects.emplace_back(BBox2f(g.min.x + x, g.max.y - h, 1.F, h));
+                            }
+                        }
+                        render->drawRects(rects);
+                    }
+                }
+            }
+
+        } // namespace
+
         struct HistogramWidget::Private
         {
+            AV::Image::HistogramOptions options;
+            std::shared_ptr<ActiveImageTask<AV::Image::Histogram> > histogramTask;
 
+            std::shared_ptr<GraphWidget> graphWidget;
+            std::shared_ptr<UI::ComboBox> scaleComboBox;
+            std::shared_ptr<UI::FloatEdit> rangeEdits[2];
+            std::shared_ptr<UI::FormLayout> formLayout;
         };
 
         void HistogramWidget::_init(const std::shared_ptr<Context>& context)
         {
             MDIWidget::_init(context);
+
+            DJV_PRIVATE_PTR();
             setClassName("djv::ViewApp::HistogramWidget");
+
+            p.options.binCount = binCount;
+
+            p.graphWidget = GraphWidget::create(context);
+            p.graphWidget->setShadowOverlay({ UI::Side::Top });
+
+            p.scaleComboBox = UI::ComboBox::create(context);
+            for (size_t i = 0; i < 2; ++i)
+            {
+                p.rangeEdits[i] = UI::FloatEdit::create(context);
+                p.rangeEdits[i]->setRange(FloatRange(-1000000.F, 1000000.F));
+                p.rangeEdits[i]->setSmallIncrement(.1F);
+                p.rangeEdits[i]->setLargeIncrement(1.F);
+            }
+
+            auto layout = UI::VerticalLayout::create(context);
+            layout->setMargin(UI::MetricsRole::MarginSmall);
+            layout->setSpacing(UI::MetricsRole::SpacingSmall);
+            layout->setBackgroundRole(UI::ColorRole::Background);
+            layout->addChild(p.graphWidget);
+            layout->setStretch(p.graphWidget, UI::RowStretch::Expand);
+            p.formLayout = UI::FormLayout::create(context);
+            p.formLayout->addChild(p.scaleComboBox);
+            p.formLayout->addChild(p.rangeEdits[0]);
+            p.formLayout->addChild(p.rangeEdits[1]);
+            layout->addChild(p.formLayout);
+            addChild(layout);
+
+            _widgetUpdate();
+
+            auto weak = std::weak_ptr<HistogramWidget>(std::dynamic_pointer_cast<HistogramWidget>(shared_from_this()));
+            p.scaleComboBox->setCallback(
+                [weak](int value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->options.scale = static_cast<AV::Image::HistogramScale>(value);
+                        widget->_p->histogramTask->update();
+                    }
+                });
+
+            p.rangeEdits[0]->setValueCallback(
+                [weak](float value, UI::TextEditReason)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        const float max = std::max(value, widget->_p->options.range.getMax());
+                        widget->_p->options.range = FloatRange(value, max);
+                        widget->_p->histogramTask->update();
+                        widget->_widgetUpdate();
+                    }
+                });
+
+            p.rangeEdits[1]->setValueCallback(
+                [weak](float value, UI::TextEditReason)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        const float min = std::min(value, widget->_p->options.range.getMin());
+                        widget->_p->options.range = FloatRange(min, value);
+                        widget->_p->histogramTask->update();
+                        widget->_widgetUpdate();
+                    }
+                });
+
+            p.histogramTask = ActiveImageTask<AV::Image::Histogram>::create("djv::ViewApp::HistogramWidget", context);
+            p.histogramTask->setValueCallback(
+                [weak](const AV::Image::Histogram& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->graphWidget->setHistogram(value);
+                    }
+                });
+            p.histogramTask->setTaskCallback(
+                [weak](const std::shared_ptr<AV::Image::Image>& image, bool)
+                {
+                    AV::Image::HistogramOptions options;
+                    if (auto widget = weak.lock())
+                    {
+                        options = widget->_p->options;
+                    }
+                    return std::function<AV::Image::Histogram(void)>(
+                        [image, options]
+                        {
+                            return AV::Image::histogram(*image, options);
+                        });
+                });
         }
 
         HistogramWidget::HistogramWidget() :
@@ -38,12 +273,38 @@ namespace djv
         void HistogramWidget::_initEvent(Event::Init & event)
         {
             MDIWidget::_initEvent(event);
+            DJV_PRIVATE_PTR();
             if (event.getData().text)
             {
-                setTitle(_getText(DJV_TEXT("Histogram")));
+                setTitle(_getText(DJV_TEXT("widget_histogram_title")));
+                p.formLayout->setText(p.scaleComboBox, _getText(DJV_TEXT("widget_histogram_scale")) + ":");
+                p.formLayout->setText(p.rangeEdits[0], _getText(DJV_TEXT("widget_histogram_range_min")) + ":");
+                p.formLayout->setText(p.rangeEdits[1], _getText(DJV_TEXT("widget_histogram_range_max")) + ":");
+                p.scaleComboBox->setTooltip(_getText(DJV_TEXT("widget_histogram_scale_tooltip")));
+                p.rangeEdits[0]->setTooltip(_getText(DJV_TEXT("widget_histogram_range_min_tooltip")));
+                p.rangeEdits[1]->setTooltip(_getText(DJV_TEXT("widget_histogram_range_max_tooltip")));
+                _widgetUpdate();
             }
         }
 
+        void HistogramWidget::_updateEvent(Event::Update& event)
+        {
+            MDIWidget::_updateEvent(event);
+            _p->histogramTask->tick();
+        }
+
+        void HistogramWidget::_widgetUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            p.scaleComboBox->setItems(
+                {
+                    _getText(DJV_TEXT("widget_histogram_scale_linear")),
+                    _getText(DJV_TEXT("widget_histogram_scale_log"))
+                });
+            p.scaleComboBox->setCurrentItem(static_cast<int>(p.options.scale));
+            p.rangeEdits[0]->setValue(p.options.range.getMin());
+            p.rangeEdits[1]->setValue(p.options.range.getMax());
+        }
+
     } // namespace ViewApp
 } // namespace djv
-
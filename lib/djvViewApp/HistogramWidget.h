@@ -11,6 +11,10 @@ namespace djv
     namespace ViewApp
     {
         //! This class provides the histogram widget.
+        //!
+        //! The histogram is computed on a separate thread for the current image
+        //! of the active media. When the images change faster than they can be
+        //! counted, only the most recent image is counted next.
         class HistogramWidget : public MDIWidget
         {
             DJV_NON_COPYABLE(HistogramWidget);
@@ -26,8 +30,11 @@ namespace djv
 
         protected:
             void _initEvent(Core::Event::Init &) override;
+            void _updateEvent(Core::Event::Update&) override;
 
         private:
+            void _widgetUpdate();
+
             DJV_PRIVATE();
         };
 
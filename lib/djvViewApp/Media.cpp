@@ -8,7 +8,9 @@
 #include <djvViewApp/EditSystem.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/AudioRingBuffer.h>
 #include <djvAV/AudioSystem.h>
+#include <djvAV/AudioTimeStretch.h>
 #include <djvAV/IOSystem.h>
 
 #include <djvCore/Context.h>
@@ -28,6 +30,9 @@ namespace djv
         {
             //! \todo Should this be configurable?
             const size_t audioBufferFrameCount = 256;
+            const float  audioRingBufferTime   = 1.F;
+            const float  audioScrubTime        = .1F;
+            const float  audioScrubFadeTime    = .005F;
             const size_t videoQueueSize        = 10;
             const size_t realSpeedFrameCount   = 30;
             
@@ -43,6 +48,7 @@ namespace djv
             AV::Audio::Info audioInfo;
             std::shared_ptr<ValueSubject<bool> > reload;
             std::shared_ptr<ValueSubject<std::pair<std::vector<AV::Image::Info>, int> > > layers;
+            std::shared_ptr<ValueSubject<AV::IO::ProxyScale> > proxyScale;
             std::shared_ptr<ValueSubject<Math::Rational> > speed;
             std::shared_ptr<ValueSubject<PlaybackSpeed> > playbackSpeed;
             std::shared_ptr<ValueSubject<Math::Rational> > defaultSpeed;
@@ -71,13 +77,22 @@ namespace djv
             std::shared_ptr<ValueSubject<size_t> > videoQueueCount;
             std::shared_ptr<ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<ValueSubject<size_t> > audioQueueCount;
+            std::shared_ptr<ValueSubject<size_t> > audioUnderrunCount;
+            std::shared_ptr<ValueSubject<size_t> > audioOverrunCount;
+            bool audioOverrun = false;
             std::shared_ptr<AV::IO::IRead> read;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
             std::unique_ptr<RtAudio> rtAudio;
+            std::shared_ptr<AV::Audio::RingBuffer> audioRingBuffer;
+            std::shared_ptr<AV::Audio::TimeStretch> audioTimeStretch;
+            bool audioScrub = false;
+            std::vector<std::shared_ptr<AV::Audio::Data> > audioScrubData;
+            size_t audioScrubSampleCount = 0;
+            std::atomic<float> audioVolume;
             std::shared_ptr<AV::Audio::Data> audioData;
             size_t audioDataSamplesOffset = 0;
-            size_t audioDataSamplesCount = 0;
+            std::atomic<size_t> audioDataSamplesCount;
             Frame::Index frameOffset = 0;
             Time::Duration currentTime = Time::Duration::zero();
             std::chrono::steady_clock::time_point playbackTime;
@@ -86,6 +101,7 @@ namespace djv
             Time::Duration playEveryFrameTime = Time::Duration::zero();
             std::shared_ptr<Time::Timer> playbackTimer;
             std::shared_ptr<Time::Timer> queueTimer;
+            bool queueIdle = false;
             std::shared_ptr<Time::Timer> realSpeedTimer;
             std::shared_ptr<Time::Timer> cacheTimer;
             std::shared_ptr<Time::Timer> debugTimer;
@@ -103,6 +119,7 @@ namespace djv
             p.reload = ValueSubject<bool>::create(false);
             p.layers = ValueSubject<std::pair<std::vector<AV::Image::Info>, int> >::create(
                 std::make_pair(std::vector<AV::Image::Info>(), 0));
+            p.proxyScale = ValueSubject<AV::IO::ProxyScale>::create(AV::IO::ProxyScale::None);
             p.speed = ValueSubject<Math::Rational>::create();
             p.playbackSpeed = ValueSubject<PlaybackSpeed>::create();
             p.defaultSpeed = ValueSubject<Math::Rational>::create();
@@ -128,6 +145,10 @@ namespace djv
             p.audioQueueMax = ValueSubject<size_t>::create();
             p.videoQueueCount = ValueSubject<size_t>::create();
             p.audioQueueCount = ValueSubject<size_t>::create();
+            p.audioUnderrunCount = ValueSubject<size_t>::create();
+            p.audioOverrunCount = ValueSubject<size_t>::create();
+            p.audioVolume = 1.F;
+            p.audioDataSamplesCount = 0;
 
             p.playbackTimer = Time::Timer::create(context);
             p.playbackTimer->setRepeating(true);
@@ -167,16 +188,6 @@ namespace djv
             }
 
             _open();
-
-            p.queueTimer->start(
-                Time::getTime(Time::TimerValue::VeryFast),
-                [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
-                {
-                    if (auto media = weak.lock())
-                    {
-                        media->_queueUpdate();
-                    }
-                });
         }
 
         Media::Media() :
@@ -267,6 +278,22 @@ namespace djv
             setLayer(layer);
         }
 
+        std::shared_ptr<IValueSubject<AV::IO::ProxyScale> > Media::observeProxyScale() const
+        {
+            return _p->proxyScale;
+        }
+
+        void Media::setProxyScale(AV::IO::ProxyScale value)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.proxyScale->setIfChanged(value))
+            {
+                // The frame cache belongs to the reader, so re-opening the file
+                // also replaces the cached frames with ones at the new scale.
+                _open();
+            }
+        }
+
         std::shared_ptr<IValueSubject<std::shared_ptr<AV::Image::Image> > > Media::observeCurrentImage() const
         {
             return _p->currentImage;
@@ -397,7 +424,14 @@ namespace djv
             if (p.currentFrame->setIfChanged(tmp))
             {
                 setPlayback(Playback::Stop);
+
+                // Read forward from the new frame, otherwise the grain would
+                // be reversed after playing backwards.
+                p.ioDirection = AV::IO::Direction::Forward;
                 _seek(p.currentFrame->get());
+
+                // Play a short grain of audio from the new frame.
+                p.audioScrub = _hasAudio() && !p.playEveryFrame->get();
             }
         }
 
@@ -598,12 +632,20 @@ namespace djv
 
         void Media::setVolume(float value)
         {
-            _p->volume->setIfChanged(Math::clamp(value, 0.F, 1.F));
+            DJV_PRIVATE_PTR();
+            if (p.volume->setIfChanged(Math::clamp(value, 0.F, 1.F)))
+            {
+                _volumeUpdate();
+            }
         }
 
         void Media::setMute(bool value)
         {
-            _p->mute->setIfChanged(value);
+            DJV_PRIVATE_PTR();
+            if (p.mute->setIfChanged(value))
+            {
+                _volumeUpdate();
+            }
         }
 
         std::shared_ptr<IValueSubject<size_t> > Media::observeThreadCount() const
@@ -623,12 +665,6 @@ namespace djv
             }
         }
 
-        bool Media::hasCache() const
-        {
-            DJV_PRIVATE_PTR();
-            return p.read ? p.read->hasCache() : false;
-        }
-
         size_t Media::getCacheMaxByteCount() const
         {
             return _p->cacheMaxByteCount;
@@ -739,17 +775,36 @@ namespace djv
             return _p->audioQueueCount;
         }
 
+        std::shared_ptr<IValueSubject<size_t> > Media::observeAudioUnderrunCount() const
+        {
+            return _p->audioUnderrunCount;
+        }
+
+        std::shared_ptr<IValueSubject<size_t> > Media::observeAudioOverrunCount() const
+        {
+            return _p->audioOverrunCount;
+        }
+
         bool Media::_hasAudio() const
         {
             DJV_PRIVATE_PTR();
             return p.audioInfo.isValid() && p.rtAudio;
         }
 
+        float Media::_getAudioSpeed() const
+        {
+            DJV_PRIVATE_PTR();
+            const float defaultSpeed = p.defaultSpeed->get().toFloat();
+            return defaultSpeed > 0.F ? (p.speed->get().toFloat() / defaultSpeed) : 1.F;
+        }
+
         bool Media::_isAudioEnabled() const
         {
             DJV_PRIVATE_PTR();
+            const float audioSpeed = _getAudioSpeed();
             return _hasAudio() &&
-                p.speed->get() == p.defaultSpeed->get() &&
+                audioSpeed >= AV::Audio::timeStretchSpeedMin &&
+                audioSpeed <= AV::Audio::timeStretchSpeedMax &&
                 !p.playEveryFrame->get();
         }
 
@@ -757,7 +812,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             return _isAudioEnabled() &&
-                Playback::Forward == p.playback->get();
+                p.playback->get() != Playback::Stop;
         }
 
         void Media::_open()
@@ -771,6 +826,7 @@ namespace djv
 
                     AV::IO::ReadOptions options;
                     options.layer = p.layers->get().second;
+                    options.proxyScale = p.proxyScale->get();
                     options.videoQueueSize = videoQueueSize;
                     auto io = context->getSystemT<AV::IO::System>();
                     p.read = io->read(p.fileInfo, options);
@@ -814,6 +870,10 @@ namespace djv
                         {
                             p.rtAudio->closeStream();
                         }
+                        p.audioRingBuffer = AV::Audio::RingBuffer::create(
+                            p.audioInfo,
+                            static_cast<size_t>(p.audioInfo.sampleRate * audioRingBufferTime));
+                        p.audioTimeStretch = AV::Audio::TimeStretch::create(p.audioInfo);
                         RtAudio::StreamParameters rtParameters;
                         auto audioSystem = context->getSystemT<AV::Audio::System>();
                         rtParameters.deviceId = audioSystem->getDefaultOutputDevice();
@@ -876,6 +936,10 @@ namespace djv
                                     size_t videoQueueCount = 0;
                                     size_t audioQueueMax   = 0;
                                     size_t audioQueueCount = 0;
+                                    if (auto ringBuffer = media->_p->audioRingBuffer)
+                                    {
+                                        media->_p->audioUnderrunCount->setIfChanged(ringBuffer->getUnderrunCount());
+                                    }
                                     {
                                         std::unique_lock<std::mutex> lock(media->_p->read->getMutex());
                                         if (lock.owns_lock())
@@ -1012,6 +1076,19 @@ namespace djv
                 p.realSpeedFrameCount = 0;
                 p.playEveryFrameTime = Time::Duration::zero();
                 _stopAudioStream();
+                if (p.audioRingBuffer)
+                {
+                    p.audioRingBuffer->clear();
+                }
+                if (p.audioTimeStretch)
+                {
+                    p.audioTimeStretch->clear();
+                    p.audioTimeStretch->setSpeed(_getAudioSpeed());
+                }
+                p.audioScrub = false;
+                p.audioScrubData.clear();
+                p.audioScrubSampleCount = 0;
+                _setQueueIdle(false);
             }
         }
 
@@ -1091,11 +1168,19 @@ namespace djv
                 {
                     if (p.audioDataSamplesCount)
                     {
-                        Frame::Index frame = p.frameOffset +
-                            Time::scale(
-                                p.audioDataSamplesCount,
-                                Math::Rational(1, static_cast<int>(p.audioInfo.sampleRate)),
-                                speed.swap());
+                        // The audio is time-stretched, so the samples that have
+                        // been played are in real time.
+                        const Frame::Index elapsed = Time::scale(
+                            p.audioDataSamplesCount,
+                            Math::Rational(1, static_cast<int>(p.audioInfo.sampleRate)),
+                            speed.swap());
+                        Frame::Index frame = Frame::invalid;
+                        switch (playback)
+                        {
+                        case Playback::Forward: frame = p.frameOffset + elapsed; break;
+                        case Playback::Reverse: frame = p.frameOffset - elapsed; break;
+                        default: break;
+                        }
                         _setCurrentFrame(frame);
                     }
                 }
@@ -1233,109 +1318,222 @@ namespace djv
                 }
 
                 // Update the audio queue.
-                if (_hasAudio() && !_hasAudioSyncPlayback())
+                if (_hasAudioSyncPlayback() && p.audioRingBuffer)
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
-                    auto& queue = p.read->getAudioQueue();
-                    while (queue.getCount() > queue.getMax())
+                    _audioRingBufferUpdate();
+                }
+                else if (p.audioScrub && p.audioRingBuffer)
+                {
+                    _audioScrubUpdate();
+                }
+                else if (_hasAudio())
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(p.read->getMutex());
+                        auto& queue = p.read->getAudioQueue();
+                        while (queue.getCount() > queue.getMax())
+                        {
+                            queue.popFrame();
+                        }
+                    }
+
+                    // Stop the stream once a scrubbing grain has played.
+                    if (Playback::Stop == playback &&
+                        p.rtAudio->isStreamRunning() &&
+                        p.audioRingBuffer &&
+                        0 == p.audioRingBuffer->getReadAvailable())
                     {
-                        queue.popFrame();
+                        _stopAudioStream();
                     }
                 }
+
+                // Poll the queues less often once playback is stopped and the
+                // current frame is shown, so an idle viewer does not keep the
+                // application event loop busy.
+                _setQueueIdle(
+                    Playback::Stop == playback &&
+                    !p.audioScrub &&
+                    !(p.rtAudio && p.rtAudio->isStreamRunning()) &&
+                    gotFrame &&
+                    frame.frame == p.currentFrame->get());
+            }
+        }
+
+        void Media::_setQueueIdle(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value != p.queueIdle || !p.queueTimer->isActive())
+            {
+                p.queueIdle = value;
+                auto weak = std::weak_ptr<Media>(std::dynamic_pointer_cast<Media>(shared_from_this()));
+                p.queueTimer->start(
+                    Time::getTime(value ? Time::TimerValue::Medium : Time::TimerValue::VeryFast),
+                    [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        if (auto media = weak.lock())
+                        {
+                            media->_queueUpdate();
+                        }
+                    });
             }
         }
         
-        int Media::_rtAudioCallback(
-            void* outputBuffer,
-            void* inputBuffer,
-            unsigned int nFrames,
-            double streamTime,
-            RtAudioStreamStatus status,
-            void* userData)
+        void Media::_volumeUpdate()
         {
-            Media* media = reinterpret_cast<Media*>(userData);
-            const auto& info = media->_p->audioInfo;
+            DJV_PRIVATE_PTR();
+            p.audioVolume = !p.mute->get() ? p.volume->get() : 0.F;
+        }
 
-            size_t outputSampleCount = static_cast<size_t>(nFrames);
-            size_t sampleCount = 0;
-            const size_t sampleByteCount = info.channelCount * AV::Audio::getByteCount(info.type);
-            const float volume = !media->_p->mute->get() ? media->_p->volume->get() : 0.F;
+        void Media::_audioRingBufferUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            auto& ringBuffer = p.audioRingBuffer;
+            const size_t sampleByteCount = p.audioInfo.channelCount * AV::Audio::getByteCount(p.audioInfo.type);
+            const bool timeStretch = p.audioTimeStretch && _getAudioSpeed() != 1.F;
+            while (ringBuffer->getWriteAvailable() > 0)
+            {
+                // Get the next audio frame from the read queue, passing it
+                // through the time-stretch when the speed is changed. The frames
+                // are released here rather than in the audio callback.
+                if (timeStretch && !p.audioData)
+                {
+                    p.audioData = p.audioTimeStretch->getOutput();
+                    p.audioDataSamplesOffset = 0;
+                }
+                if (!p.audioData)
+                {
+                    std::lock_guard<std::mutex> lock(p.read->getMutex());
+                    auto& queue = p.read->getAudioQueue();
+                    if (queue.isEmpty())
+                    {
+                        ringBuffer->setFinished(queue.isFinished());
+                        break;
+                    }
+                    auto audio = queue.popFrame().audio;
+                    if (timeStretch)
+                    {
+                        p.audioTimeStretch->addInput(audio);
+                        continue;
+                    }
+                    p.audioData = audio;
+                    p.audioDataSamplesOffset = 0;
+                }
 
-            if (media->_p->audioData)
+                // Copy as much of the frame as will fit into the ring buffer.
+                p.audioDataSamplesOffset += ringBuffer->write(
+                    p.audioData->getData() + p.audioDataSamplesOffset * sampleByteCount,
+                    p.audioData->getSampleCount() - p.audioDataSamplesOffset);
+                if (p.audioDataSamplesOffset >= p.audioData->getSampleCount())
+                {
+                    p.audioData.reset();
+                    p.audioDataSamplesOffset = 0;
+                }
+            }
+
+            // Count an overrun each time the ring buffer fills up while the
+            // reader has queued more audio than the queue maximum, so the
+            // queue is left undrained and the reader is held up.
+            bool overrun = false;
+            if (0 == ringBuffer->getWriteAvailable())
+            {
+                std::lock_guard<std::mutex> lock(p.read->getMutex());
+                const auto& queue = p.read->getAudioQueue();
+                overrun = queue.getCount() > queue.getMax();
+            }
+            if (overrun && !p.audioOverrun)
             {
-                sampleCount += media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset;
+                p.audioOverrunCount->setIfChanged(p.audioOverrunCount->get() + 1);
             }
+            p.audioOverrun = overrun;
+        }
 
-            // Get audio frames from the read queue.
-            std::vector<AV::IO::AudioFrame> frames;
+        void Media::_audioScrubUpdate()
+        {
+            DJV_PRIVATE_PTR();
+
+            // Collect the audio from the current frame.
+            const size_t sampleCount = static_cast<size_t>(p.audioInfo.sampleRate * audioScrubTime);
+            bool finished = false;
             {
-                std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
-                auto& queue = media->_p->read->getAudioQueue();
-                while (!queue.isEmpty() && sampleCount < outputSampleCount)
+                std::lock_guard<std::mutex> lock(p.read->getMutex());
+                auto& queue = p.read->getAudioQueue();
+                while (p.audioScrubSampleCount < sampleCount && !queue.isEmpty())
                 {
-                    auto frame = queue.getFrame();
-                    frames.push_back(frame);
-                    queue.popFrame();
-                    sampleCount += frame.audio->getSampleCount();
+                    auto audio = queue.popFrame().audio;
+                    p.audioScrubSampleCount += audio->getSampleCount();
+                    p.audioScrubData.push_back(audio);
                 }
+                finished = queue.isFinished();
             }
-
-            // Use the remaining data from the frame.
-            uint8_t* p = reinterpret_cast<uint8_t*>(outputBuffer);
-            if (media->_p->audioData)
+            if (p.audioScrubSampleCount < sampleCount && !finished)
+                return;
+
+            // Copy the audio into a grain and fade the ends to avoid clicks.
+            auto info = p.audioInfo;
+            info.type = AV::Audio::Type::F32;
+            info.sampleCount = std::min(p.audioScrubSampleCount, sampleCount);
+            auto grain = AV::Audio::Data::create(info);
+            const size_t channelCount = info.channelCount;
+            float* grainP = reinterpret_cast<float*>(grain->getData());
+            size_t offset = 0;
+            for (const auto& i : p.audioScrubData)
+            {
+                const auto data = AV::Audio::Data::convert(i, AV::Audio::Type::F32);
+                const size_t size = std::min(data->getSampleCount(), info.sampleCount - offset);
+                memcpy(grainP + offset * channelCount, data->getData(), size * channelCount * sizeof(float));
+                offset += size;
+            }
+            const size_t fadeCount = std::min(
+                static_cast<size_t>(p.audioInfo.sampleRate * audioScrubFadeTime),
+                info.sampleCount / 2);
+            for (size_t i = 0; i < fadeCount; ++i)
             {
-                const size_t size = std::min(
-                    media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset,
-                    outputSampleCount);
-                //memcpy(
-                //    p,
-                //    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                //    size * sampleByteCount);
-                AV::Audio::Data::volume(
-                    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                    p,
-                    volume,
-                    size,
-                    info.channelCount,
-                    info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset += size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
-                if (media->_p->audioDataSamplesOffset >= media->_p->audioData->getSampleCount())
+                const float v = i / static_cast<float>(fadeCount);
+                for (size_t c = 0; c < channelCount; ++c)
                 {
-                    media->_p->audioData.reset();
-                    media->_p->audioDataSamplesOffset = 0;
+                    grainP[i * channelCount + c] *= v;
+                    grainP[(info.sampleCount - 1 - i) * channelCount + c] *= v;
                 }
             }
+            p.audioScrub = false;
+            p.audioScrubData.clear();
+            p.audioScrubSampleCount = 0;
+
+            if (info.sampleCount > 0)
+            {
+                grain = AV::Audio::Data::convert(grain, p.audioInfo.type);
+                p.audioRingBuffer->write(grain->getData(), grain->getSampleCount());
+                p.audioRingBuffer->setFinished(true);
+                _startAudioStream();
+            }
+        }
 
-            // Process the frames.
-            for (const auto& i : frames)
+        int Media::_rtAudioCallback(
+            void* outputBuffer,
+            void* inputBuffer,
+            unsigned int nFrames,
+            double streamTime,
+            RtAudioStreamStatus status,
+            void* userData)
+        {
+            // This function runs on the real-time audio thread, so it only reads
+            // from the ring buffer and does not lock or allocate.
+            Media* media = reinterpret_cast<Media*>(userData);
+            const auto& info = media->_p->audioInfo;
+            const size_t sampleByteCount = info.channelCount * AV::Audio::getByteCount(info.type);
+            uint8_t* p = reinterpret_cast<uint8_t*>(outputBuffer);
+            size_t sampleCount = 0;
+            if (auto ringBuffer = media->_p->audioRingBuffer.get())
             {
-                media->_p->audioData = i.audio;
-                size_t size = std::min(i.audio->getSampleCount(), outputSampleCount);
-                //memcpy(
-                //    p,
-                //    i.audio->getData(),
-                //    size * sampleByteCount);
-                AV::Audio::Data::volume(
-                    i.audio->getData(),
-                    p,
-                    volume,
-                    size,
-                    info.channelCount,
-                    info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset = size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
+                sampleCount = ringBuffer->read(p, nFrames, media->_p->audioVolume);
+                media->_p->audioDataSamplesCount += sampleCount;
             }
 
-            const size_t zero = (nFrames * sampleByteCount) - (p - reinterpret_cast<uint8_t*>(outputBuffer));
+            const size_t zero = (nFrames - sampleCount) * sampleByteCount;
             if (zero)
             {
                 //! \todo Is this the correct way to clear the audio data?
-                memset(p, 0, zero);
+                memset(p + sampleCount * sampleByteCount, 0, zero);
             }
 
             return 0;
@@ -74,6 +74,15 @@ namespace djv
 
             ///@}
 
+            //! \name Proxy
+            ///@{
+
+            std::shared_ptr<Core::IValueSubject<AV::IO::ProxyScale> > observeProxyScale() const;
+
+            void setProxyScale(AV::IO::ProxyScale);
+
+            ///@}
+
             //! \name Image
             ///@{
 
@@ -140,7 +149,6 @@ namespace djv
             //! \name Memory Cache
             ///@{
 
-            bool hasCache() const;
             size_t getCacheMaxByteCount() const;
             size_t getCacheByteCount() const;
             std::shared_ptr<Core::IValueSubject<Core::Frame::Sequence> > observeCacheSequence() const;
@@ -182,10 +190,18 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<size_t> > observeVideoQueueCount() const;
             std::shared_ptr<Core::IValueSubject<size_t> > observeAudioQueueCount() const;
 
+            //! Observe the number of times the audio output ran out of samples.
+            std::shared_ptr<Core::IValueSubject<size_t> > observeAudioUnderrunCount() const;
+
+            //! Observe the number of times the audio read queue backed up past
+            //! its maximum because the ring buffer was full.
+            std::shared_ptr<Core::IValueSubject<size_t> > observeAudioOverrunCount() const;
+
             ///@}
 
         private:
             bool _hasAudio() const;
+            float _getAudioSpeed() const;
             bool _isAudioEnabled() const;
             bool _hasAudioSyncPlayback() const;
             void _open();
@@ -197,6 +213,10 @@ namespace djv
             void _startAudioStream();
             void _stopAudioStream();
             void _queueUpdate();
+            void _setQueueIdle(bool);
+            void _volumeUpdate();
+            void _audioRingBufferUpdate();
+            void _audioScrubUpdate();
 
             static int _rtAudioCallback(
                 void* outputBuffer,
@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvViewApp/ScopeWidget.h>
+
+#include <djvViewApp/ActiveImageTask.h>
+
+#include <djvUI/ComboBox.h>
+#include <djvUI/RowLayout.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/Render2D.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Math.h>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace ViewApp
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const uint16_t scopeSize = 256;
+
+            //! \todo Should this be configurable?
+            const uint16_t playbackSampleWidth = 1024;
+
+            class GraphWidget : public UI::Widget
+            {
+                DJV_NON_COPYABLE(GraphWidget);
+
+            protected:
+                void _init(const std::shared_ptr<Context>&);
+                GraphWidget();
+
+            public:
+                ~GraphWidget() override;
+
+                static std::shared_ptr<GraphWidget> create(const std::shared_ptr<Context>&);
+
+                void setScopeType(AV::Image::ScopeType);
+                void setImage(const std::shared_ptr<AV::Image::Image>&);
+
+            protected:
+                void _preLayoutEvent(Event::PreLayout&) override;
+                void _paintEvent(Event::Paint&) override;
+
+            private:
+                AV::Image::ScopeType _scopeType = AV::Image::ScopeType::First;
+                std::shared_ptr<AV::Image::Image> _image;
+            };
+
+            void GraphWidget::_init(const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::ViewApp::ScopeWidget::GraphWidget");
+            }
+
+            GraphWidget::GraphWidget()
+            {}
+
+            GraphWidget::~GraphWidget()
+            {}
+
+            std::shared_ptr<GraphWidget> GraphWidget::create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<GraphWidget>(new GraphWidget);
+                out->_init(context);
+                return out;
+            }
+
+            void GraphWidget::setScopeType(AV::Image::ScopeType value)
+            {
+                if (value == _scopeType)
+                    return;
+                _scopeType = value;
+                _resize();
+            }
+
+            void GraphWidget::setImage(const std::shared_ptr<AV::Image::Image>& value)
+            {
+                if (value == _image)
+                    return;
+                _image = value;
+                _redraw();
+            }
+
+            void GraphWidget::_preLayoutEvent(Event::PreLayout&)
+            {
+                const auto& style = _getStyle();
+                const float sw = style->getMetric(UI::MetricsRole::Swatch);
+                _setMinimumSize(AV::Image::ScopeType::Vectorscope == _scopeType ?
+                    glm::vec2(sw * 2.F, sw * 2.F) :
+                    glm::vec2(sw * 3.F, sw * 2.F));
+            }
+
+            void GraphWidget::_paintEvent(Event::Paint&)
+            {
+                const auto& style = _getStyle();
+                const BBox2f& g = getMargin().bbox(getGeometry(), style);
+                const auto& render = _getRender();
+                render->setFillColor(style->getColor(UI::ColorRole::Trough));
+                render->drawRect(g);
+
+                // The vectorscope is kept square.
+                BBox2f g2 = g;
+                if (AV::Image::ScopeType::Vectorscope == _scopeType)
+                {
+                    const float s = std::min(g.w(), g.h());
+                    const glm::vec2 c = g.getCenter();
+                    g2 = BBox2f(floorf(c.x - s / 2.F), floorf(c.y - s / 2.F), s, s);
+                }
+
+                // Draw the graticule.
+                const float b = style->getMetric(UI::MetricsRole::Border);
+                AV::Image::Color color = style->getColor(UI::ColorRole::Border);
+                render->setFillColor(color);
+                render->setLineWidth(b);
+                switch (_scopeType)
+                {
+                case AV::Image::ScopeType::Waveform:
+                case AV::Image::ScopeType::RGBParade:
+                {
+                    std::vector<BBox2f> rects;
+                    for (size_t i = 0; i <= 4; ++i)
+                    {
+                        const float y = floorf(g2.min.y + (g2.h() - b) * i / 4.F);
+                        rects.emplace_back(BBox2f(g2.min.x, y, g2.w(), b));
+                    }
+                    if (AV::Image::ScopeType::RGBParade == _scopeType)
+                    {
+                        for (size_t i = 1; i < 3; ++i)
+                        {
+                            const float x = floorf(g2.min.x + g2.w() * i / 3.F);
+                            rects.emplace_back(BBox2f(x, g2.min.y, b, g2.h()));
+                        }
+                    }
+                    render->drawRects(rects);
+                    break;
+                }
+                case AV::Image::ScopeType::Vectorscope:
+                {
+                    const glm::vec2 c = g2.getCenter();
+                    const float r = g2.w() / 2.F;
+                    render->drawRects(
+                        {
+                            BBox2f(g2.min.x, floorf(c.y), g2.w(), b),
+                            BBox2f(floorf(c.x), g2.min.y, b, g2.h())
+                        });
+                    std::vector<glm::vec2> points;
+                    const size_t facets = 64;
+                    for (size_t i = 0; i <= facets; ++i)
+                    {
+                        const float a = i / static_cast<float>(facets) * Math::pi2;
+                        points.emplace_back(glm::vec2(c.x + cosf(a) * r, c.y + sinf(a) * r));
+                    }
+                    render->drawPolyline(points);
+                    break;
+                }
+                default: break;
+                }
+
+                // Draw the scope image scaled to the graph.
+                if (_image)
+                {
+                    const AV::Image::Size& size = _image->getSize();
+                    glm::mat3x3 m(1.F);
+                    m = glm::translate(m, g2.min);
+                    m = glm::scale(m, glm::vec2(g2.w() / size.w, g2.h() / size.h));
+                    render->pushTransform(m);
+                    render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F));
+                    AV::Render2D::ImageOptions options;
+                    options.cache = AV::Render2D::ImageCache::Dynamic;
+                    render->drawImage(_image, glm::vec2(0.F, 0.F), options);
+                    render->popTransform();
+                }
+            }
+
+        } // namespace
+
+        struct ScopeWidget::Private
+        {
+            AV::Image::ScopeType scopeType = AV::Image::ScopeType::First;
+            std::shared_ptr<ActiveImageTask<std::shared_ptr<AV::Image::Image> > > scopeTask;
+
+            std::shared_ptr<GraphWidget> graphWidget;
+            std::shared_ptr<UI::ComboBox> scopeTypeComboBox;
+        };
+
+        void ScopeWidget::_init(AV::Image::ScopeType scopeType, const std::shared_ptr<Context>& context)
+        {
+            MDIWidget::_init(context);
+
+            DJV_PRIVATE_PTR();
+            setClassName("djv::ViewApp::ScopeWidget");
+
+            p.scopeType = scopeType;
+
+            p.graphWidget = GraphWidget::create(context);
+            p.graphWidget->setScopeType(scopeType);
+            p.graphWidget->setShadowOverlay({ UI::Side::Top });
+
+            p.scopeTypeComboBox = UI::ComboBox::create(context);
+
+            auto layout = UI::VerticalLayout::create(context);
+            layout->setMargin(UI::MetricsRole::MarginSmall);
+            layout->setSpacing(UI::MetricsRole::SpacingSmall);
+            layout->setBackgroundRole(UI::ColorRole::Background);
+            layout->addChild(p.graphWidget);
+            layout->setStretch(p.graphWidget, UI::RowStretch::Expand);
+            layout->addChild(p.scopeTypeComboBox);
+            addChild(layout);
+
+            _widgetUpdate();
+
+            auto weak = std::weak_ptr<ScopeWidget>(std::dynamic_pointer_cast<ScopeWidget>(shared_from_this()));
+            p.scopeTypeComboBox->setCallback(
+                [weak](int value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->setScopeType(static_cast<AV::Image::ScopeType>(value));
+                    }
+                });
+
+            p.scopeTask = ActiveImageTask<std::shared_ptr<AV::Image::Image> >::create("djv::ViewApp::ScopeWidget", context);
+            p.scopeTask->setValueCallback(
+                [weak](const std::shared_ptr<AV::Image::Image>& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->graphWidget->setImage(value);
+                    }
+                });
+            p.scopeTask->setTaskCallback(
+                [weak](const std::shared_ptr<AV::Image::Image>& image, bool playback)
+                {
+                    AV::Image::ScopeType scopeType = AV::Image::ScopeType::First;
+                    if (auto widget = weak.lock())
+                    {
+                        scopeType = widget->_p->scopeType;
+                    }
+                    AV::Image::ScopeOptions options;
+                    options.size = AV::Image::ScopeType::Vectorscope == scopeType ?
+                        AV::Image::Size(scopeSize, scopeSize) :
+                        AV::Image::Size(scopeSize * 2, scopeSize);
+                    if (playback)
+                    {
+                        // Subsample the image during playback, the scope is
+                        // computed again at full resolution when it stops.
+                        options.subsample = std::max(image->getWidth() / playbackSampleWidth, 1);
+                    }
+                    return std::function<std::shared_ptr<AV::Image::Image>(void)>(
+                        [image, scopeType, options]
+                        {
+                            return AV::Image::scope(*image, scopeType, options);
+                        });
+                });
+        }
+
+        ScopeWidget::ScopeWidget() :
+            _p(new Private)
+        {}
+
+        ScopeWidget::~ScopeWidget()
+        {}
+
+        std::shared_ptr<ScopeWidget> ScopeWidget::create(AV::Image::ScopeType scopeType, const std::shared_ptr<Context>& context)
+        {
+            auto out = std::shared_ptr<ScopeWidget>(new ScopeWidget);
+            out->_init(scopeType, context);
+            return out;
+        }
+
+        AV::Image::ScopeType ScopeWidget::getScopeType() const
+        {
+            return _p->scopeType;
+        }
+
+        void ScopeWidget::setScopeType(AV::Image::ScopeType value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value == p.scopeType)
+                return;
+            p.scopeType = value;
+            p.graphWidget->setScopeType(value);
+            p.graphWidget->setImage(nullptr);
+            p.scopeTask->update();
+            _widgetUpdate();
+        }
+
+        void ScopeWidget::_initEvent(Event::Init & event)
+        {
+            MDIWidget::_initEvent(event);
+            DJV_PRIVATE_PTR();
+            if (event.getData().text)
+            {
+                p.scopeTypeComboBox->setTooltip(_getText(DJV_TEXT("widget_scope_type_tooltip")));
+                _widgetUpdate();
+            }
+        }
+
+        void ScopeWidget::_updateEvent(Event::Update& event)
+        {
+            MDIWidget::_updateEvent(event);
+            _p->scopeTask->tick();
+        }
+
+        void ScopeWidget::_widgetUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            std::stringstream ss;
+            ss << p.scopeType;
+            setTitle(_getText(ss.str()));
+            std::vector<std::string> items;
+            for (auto i : AV::Image::getScopeTypeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                items.push_back(_getText(ss.str()));
+            }
+            p.scopeTypeComboBox->setItems(items);
+            p.scopeTypeComboBox->setCurrentItem(static_cast<int>(p.scopeType));
+        }
+
+    } // namespace ViewApp
+} // namespace djv
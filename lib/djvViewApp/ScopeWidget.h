@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvViewApp/MDIWidget.h>
+
+#include <djvAV/ImageScope.h>
+
+namespace djv
+{
+    namespace ViewApp
+    {
+        //! This class provides the waveform monitor and vectorscope widget.
+        //!
+        //! The scope is computed on a separate thread for the current image of
+        //! the active media. During playback the image is subsampled, and when
+        //! playback stops the scope is computed again at full resolution.
+        class ScopeWidget : public MDIWidget
+        {
+            DJV_NON_COPYABLE(ScopeWidget);
+
+        protected:
+            void _init(AV::Image::ScopeType, const std::shared_ptr<Core::Context>&);
+            ScopeWidget();
+
+        public:
+            ~ScopeWidget() override;
+
+            static std::shared_ptr<ScopeWidget> create(AV::Image::ScopeType, const std::shared_ptr<Core::Context>&);
+
+            AV::Image::ScopeType getScopeType() const;
+
+            void setScopeType(AV::Image::ScopeType);
+
+        protected:
+            void _initEvent(Core::Event::Init &) override;
+            void _updateEvent(Core::Event::Update&) override;
+
+        private:
+            void _widgetUpdate();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace ViewApp
+} // namespace djv
+
@@ -17,9 +17,11 @@
 #include <djvUI/Window.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/AudioWaveform.h>
 #include <djvAV/FontSystem.h>
 #include <djvAV/IOSystem.h>
 #include <djvAV/Render2D.h>
+#include <djvAV/WaveformSystem.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/Math.h>
@@ -34,6 +36,7 @@ namespace djv
         struct TimelineSlider::Private
         {
             std::shared_ptr<AV::Font::System> fontSystem;
+            std::shared_ptr<AV::WaveformSystem> waveformSystem;
             std::shared_ptr<Media> media;
             Math::Rational speed;
             Frame::Sequence sequence;
@@ -47,6 +50,8 @@ namespace djv
             AV::Font::FontInfo fontInfo;
             AV::Font::Metrics fontMetrics;
             std::future<AV::Font::Metrics> fontMetricsFuture;
+            AV::WaveformSystem::WaveformFuture waveformFuture;
+            std::shared_ptr<AV::Audio::Waveform> waveform;
             std::string currentFrameText;
             float currentFrameLength = 0.F;
             std::future<glm::vec2> currentFrameSizeFuture;
@@ -89,6 +94,7 @@ namespace djv
             setClassName("djv::ViewApp::TimelineSlider");
 
             p.fontSystem = context->getSystemT<AV::Font::System>();
+            p.waveformSystem = context->getSystemT<AV::WaveformSystem>();
 
             p.pipWidget = TimelinePIPWidget::create(context);
             p.pipOverlay = UI::Layout::Overlay::create(context);
@@ -132,7 +138,13 @@ namespace djv
         {}
 
         TimelineSlider::~TimelineSlider()
-        {}
+        {
+            DJV_PRIVATE_PTR();
+            if (p.waveformFuture.future.valid())
+            {
+                p.waveformSystem->cancelWaveform(p.waveformFuture.uid);
+            }
+        }
 
         std::shared_ptr<TimelineSlider> TimelineSlider::create(const std::shared_ptr<Context>& context)
         {
@@ -147,6 +159,12 @@ namespace djv
             if (value == p.media)
                 return;
             p.media = value;
+            if (p.waveformFuture.future.valid())
+            {
+                p.waveformSystem->cancelWaveform(p.waveformFuture.uid);
+                p.waveformFuture = AV::WaveformSystem::WaveformFuture();
+            }
+            p.waveform.reset();
             if (p.media)
             {
                 auto weak = std::weak_ptr<TimelineSlider>(std::dynamic_pointer_cast<TimelineSlider>(shared_from_this()));
@@ -157,6 +175,7 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_p->speed = value.videoSpeed;
+                        widget->_waveformUpdate(value);
                         widget->_textUpdate();
                         widget->_currentFrameUpdate();
                     }
@@ -377,13 +396,46 @@ namespace djv
                 const float m = style->getMetric(UI::MetricsRole::MarginSmall);
                 const float b = style->getMetric(UI::MetricsRole::Border);
                 const BBox2f& hg = _getHandleGeometry();
+                const auto& render = _getRender();
+                std::vector<BBox2f> rects;
+
+                // Draw the audio waveform, one column per pixel. The peaks are
+                // drawn faintly behind the RMS levels.
+                const float speedF = p.speed.toFloat();
+                const size_t width = static_cast<size_t>(g.w());
+                if (p.waveform && speedF > 0.F && width > 0)
+                {
+                    const size_t sampleEnd = static_cast<size_t>(
+                        p.sequence.getFrameCount() * p.waveform->getSampleRate() / speedF);
+                    const auto peaks = p.waveform->getPeaks(0, sampleEnd, width);
+                    const float y = g.min.y + (g.h() - b * 6.F) / 2.F;
+                    const float h = (g.h() - b * 6.F) / 2.F;
+                    std::vector<BBox2f> rmsRects;
+                    for (size_t i = 0; i < peaks.size(); ++i)
+                    {
+                        const auto& peak = peaks[i];
+                        const float x = g.min.x + i;
+                        const float max = Math::clamp(peak.max, -1.F, 1.F);
+                        const float min = Math::clamp(peak.min, -1.F, 1.F);
+                        const float rms = std::min(peak.rms, 1.F);
+                        rects.emplace_back(BBox2f(x, y - max * h, 1.F, std::max((max - min) * h, 1.F)));
+                        rmsRects.emplace_back(BBox2f(x, y - rms * h, 1.F, std::max(rms * 2.F * h, 1.F)));
+                    }
+                    auto color = style->getColor(UI::ColorRole::Foreground);
+                    color.setF32(color.getF32(3) * .1F, 3);
+                    render->setFillColor(color);
+                    render->drawRects(rects);
+                    color = style->getColor(UI::ColorRole::Foreground);
+                    color.setF32(color.getF32(3) * .2F, 3);
+                    render->setFillColor(color);
+                    render->drawRects(rmsRects);
+                    rects.clear();
+                }
 
                 // Draw the time ticks.
                 auto color = style->getColor(UI::ColorRole::Foreground);
                 color.setF32(color.getF32(3) * .4F, 3);
-                const auto& render = _getRender();
                 render->setFillColor(color);
-                std::vector<BBox2f> rects;
                 for (const auto& tick : p.timeTicks)
                 {
                     rects.emplace_back(BBox2f(
@@ -643,6 +695,19 @@ namespace djv
                     _log(e.what(), LogLevel::Error);
                 }
             }
+            if (p.waveformFuture.future.valid() &&
+                p.waveformFuture.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                try
+                {
+                    p.waveform = p.waveformFuture.future.get();
+                    _redraw();
+                }
+                catch (const std::exception & e)
+                {
+                    _log(e.what(), LogLevel::Error);
+                }
+            }
             for (const auto& i : p.timeTicks)
             {
                 if (i->glyphsFuture.valid() &&
@@ -729,6 +794,18 @@ namespace djv
             return out;
         }
 
+        void TimelineSlider::_waveformUpdate(const AV::IO::Info& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.media &&
+                value.audio.isValid() &&
+                !p.waveform &&
+                !p.waveformFuture.future.valid())
+            {
+                p.waveformFuture = p.waveformSystem->getWaveform(p.media->getFileInfo());
+            }
+        }
+
         void TimelineSlider::_textUpdate()
         {
             DJV_PRIVATE_PTR();
@@ -15,6 +15,12 @@ namespace djv
 {
     namespace AV
     {
+        namespace IO
+        {
+            class Info;
+
+        } // namespace IO
+
         namespace Render2D
         {
             class ImageOptions;
@@ -75,6 +81,7 @@ namespace djv
             float _getMinuteLength() const;
             float _getHourLength() const;
             Core::BBox2f _getHandleGeometry() const;
+            void _waveformUpdate(const AV::IO::Info&);
             void _textUpdate();
             void _currentFrameUpdate();
             void _showPIP(bool);
@@ -5,9 +5,11 @@
 #include <djvViewApp/ToolSystem.h>
 
 #include <djvViewApp/DebugWidget.h>
+#include <djvViewApp/HistogramWidget.h>
 #include <djvViewApp/IToolSystem.h>
 #include <djvViewApp/InfoWidget.h>
 #include <djvViewApp/MessagesWidget.h>
+#include <djvViewApp/ScopeWidget.h>
 #include <djvViewApp/SettingsSystem.h>
 #include <djvViewApp/SystemLogWidget.h>
 #include <djvViewApp/ToolSettings.h>
@@ -94,6 +96,12 @@ namespace djv
             p.toolActionGroup->setActions(actions);
             p.actions["Info"] = UI::Action::create();
             p.actions["Info"]->setButtonType(UI::ButtonType::Toggle);
+            p.actions["Histogram"] = UI::Action::create();
+            p.actions["Histogram"]->setButtonType(UI::ButtonType::Toggle);
+            p.actions["Waveform"] = UI::Action::create();
+            p.actions["Waveform"]->setButtonType(UI::ButtonType::Toggle);
+            p.actions["Vectorscope"] = UI::Action::create();
+            p.actions["Vectorscope"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["Messages"] = UI::Action::create();
             p.actions["Messages"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["SystemLog"] = UI::Action::create();
@@ -115,6 +123,9 @@ namespace djv
             }
             p.menu->addSeparator();
             p.menu->addAction(p.actions["Info"]);
+            p.menu->addAction(p.actions["Histogram"]);
+            p.menu->addAction(p.actions["Waveform"]);
+            p.menu->addAction(p.actions["Vectorscope"]);
             p.menu->addSeparator();
             p.menu->addAction(p.actions["Messages"]);
             p.menu->addAction(p.actions["SystemLog"]);
@@ -173,6 +184,69 @@ namespace djv
                     }
                 });
 
+            p.actionObservers["Histogram"] = ValueObserver<bool>::create(
+                p.actions["Histogram"]->observeChecked(),
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            if (value)
+                            {
+                                auto widget = HistogramWidget::create(context);
+                                system->_openWidget("Histogram", widget);
+                            }
+                            else
+                            {
+                                system->_closeWidget("Histogram");
+                            }
+                        }
+                    }
+                });
+
+            p.actionObservers["Waveform"] = ValueObserver<bool>::create(
+                p.actions["Waveform"]->observeChecked(),
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            if (value)
+                            {
+                                auto widget = ScopeWidget::create(AV::Image::ScopeType::Waveform, context);
+                                system->_openWidget("Waveform", widget);
+                            }
+                            else
+                            {
+                                system->_closeWidget("Waveform");
+                            }
+                        }
+                    }
+                });
+
+            p.actionObservers["Vectorscope"] = ValueObserver<bool>::create(
+                p.actions["Vectorscope"]->observeChecked(),
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            if (value)
+                            {
+                                auto widget = ScopeWidget::create(AV::Image::ScopeType::Vectorscope, context);
+                                system->_openWidget("Vectorscope", widget);
+                            }
+                            else
+                            {
+                                system->_closeWidget("Vectorscope");
+                            }
+                        }
+                    }
+                });
+
             p.actionObservers["Messages"] = ValueObserver<bool>::create(
                 p.actions["Messages"]->observeChecked(),
                 [weak, contextWeak](bool value)
@@ -318,6 +392,9 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             _closeWidget("Info");
+            _closeWidget("Histogram");
+            _closeWidget("Waveform");
+            _closeWidget("Vectorscope");
             _closeWidget("Messages");
             _closeWidget("SystemLog");
             _closeWidget("Debug");
@@ -385,6 +462,12 @@ namespace djv
             {
                 p.actions["Info"]->setText(_getText(DJV_TEXT("menu_tools_information")));
                 p.actions["Info"]->setTooltip(_getText(DJV_TEXT("menu_tools_information_widget_tooltip")));
+                p.actions["Histogram"]->setText(_getText(DJV_TEXT("menu_tools_histogram")));
+                p.actions["Histogram"]->setTooltip(_getText(DJV_TEXT("menu_tools_histogram_widget_tooltip")));
+                p.actions["Waveform"]->setText(_getText(DJV_TEXT("menu_tools_waveform")));
+                p.actions["Waveform"]->setTooltip(_getText(DJV_TEXT("menu_tools_waveform_widget_tooltip")));
+                p.actions["Vectorscope"]->setText(_getText(DJV_TEXT("menu_tools_vectorscope")));
+                p.actions["Vectorscope"]->setTooltip(_getText(DJV_TEXT("menu_tools_vectorscope_widget_tooltip")));
                 p.actions["Messages"]->setText(_getText(DJV_TEXT("menu_tools_messages")));
                 p.actions["Messages"]->setTooltip(_getText(DJV_TEXT("menu_tools_messages_widget_tooltip")));
                 p.actions["SystemLog"]->setText(_getText(DJV_TEXT("menu_tools_system_log")));
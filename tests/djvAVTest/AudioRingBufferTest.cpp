@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/AudioRingBufferTest.h>
+
+#include <djvAV/AudioRingBuffer.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        AudioRingBufferTest::AudioRingBufferTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::AudioRingBufferTest", context)
+        {}
+        
+        void AudioRingBufferTest::run()
+        {
+            _create();
+            _readWrite();
+            _counters();
+        }
+
+        void AudioRingBufferTest::_create()
+        {
+            const Audio::Info info(2, Audio::Type::S16, 44100, 1);
+            auto buffer = Audio::RingBuffer::create(info, 100);
+            DJV_ASSERT(2 == buffer->getInfo().channelCount);
+            DJV_ASSERT(100 == buffer->getInfo().sampleCount);
+            DJV_ASSERT(100 == buffer->getSize());
+            DJV_ASSERT(0 == buffer->getReadAvailable());
+            DJV_ASSERT(100 == buffer->getWriteAvailable());
+        }
+
+        void AudioRingBufferTest::_readWrite()
+        {
+            const Audio::Info info(1, Audio::Type::S16, 44100, 1);
+            auto buffer = Audio::RingBuffer::create(info, 10);
+            std::vector<Audio::S16_T> in(8);
+            for (size_t i = 0; i < in.size(); ++i)
+            {
+                in[i] = static_cast<Audio::S16_T>(i);
+            }
+            std::vector<Audio::S16_T> out(8);
+
+            // Advance the positions so the next write wraps around the end of
+            // the buffer.
+            DJV_ASSERT(8 == buffer->write(reinterpret_cast<uint8_t*>(in.data()), 8));
+            DJV_ASSERT(8 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 8));
+            DJV_ASSERT(in == out);
+
+            DJV_ASSERT(8 == buffer->write(reinterpret_cast<uint8_t*>(in.data()), 8));
+            DJV_ASSERT(8 == buffer->getReadAvailable());
+            DJV_ASSERT(2 == buffer->getWriteAvailable());
+            DJV_ASSERT(2 == buffer->write(reinterpret_cast<uint8_t*>(in.data()), 8));
+            std::fill(out.begin(), out.end(), 0);
+            DJV_ASSERT(8 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 8));
+            DJV_ASSERT(in == out);
+            DJV_ASSERT(2 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 8));
+            DJV_ASSERT(0 == out[0]);
+            DJV_ASSERT(1 == out[1]);
+
+            buffer->write(reinterpret_cast<uint8_t*>(in.data()), 8);
+            buffer->clear();
+            DJV_ASSERT(0 == buffer->getReadAvailable());
+            DJV_ASSERT(10 == buffer->getWriteAvailable());
+        }
+
+        void AudioRingBufferTest::_counters()
+        {
+            const Audio::Info info(1, Audio::Type::S16, 44100, 1);
+            auto buffer = Audio::RingBuffer::create(info, 4);
+            std::vector<Audio::S16_T> data(4);
+
+            DJV_ASSERT(0 == buffer->read(reinterpret_cast<uint8_t*>(data.data()), 4));
+            DJV_ASSERT(0 == buffer->getUnderrunCount());
+            DJV_ASSERT(2 == buffer->write(reinterpret_cast<uint8_t*>(data.data()), 2));
+            DJV_ASSERT(2 == buffer->read(reinterpret_cast<uint8_t*>(data.data()), 4));
+            DJV_ASSERT(1 == buffer->getUnderrunCount());
+            buffer->setFinished(true);
+            DJV_ASSERT(0 == buffer->read(reinterpret_cast<uint8_t*>(data.data()), 4));
+            DJV_ASSERT(1 == buffer->getUnderrunCount());
+
+            buffer->clear();
+            DJV_ASSERT(0 == buffer->read(reinterpret_cast<uint8_t*>(data.data()), 4));
+            DJV_ASSERT(1 == buffer->getUnderrunCount());
+
+            buffer->resetCounters();
+            DJV_ASSERT(0 == buffer->getUnderrunCount());
+        }
+        
+    } // namespace AVTest
+} // namespace djv
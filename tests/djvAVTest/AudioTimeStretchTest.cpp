@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/AudioTimeStretchTest.h>
+
+#include <djvAV/AudioTimeStretch.h>
+
+#include <djvCore/Math.h>
+
+#include <cmath>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        AudioTimeStretchTest::AudioTimeStretchTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::AudioTimeStretchTest", context)
+        {}
+        
+        void AudioTimeStretchTest::run()
+        {
+            _speed();
+            _stretch();
+        }
+
+        void AudioTimeStretchTest::_speed()
+        {
+            auto timeStretch = Audio::TimeStretch::create(Audio::Info(2, Audio::Type::S16, 44100, 0));
+            DJV_ASSERT(1.F == timeStretch->getSpeed());
+            timeStretch->setSpeed(2.F);
+            DJV_ASSERT(2.F == timeStretch->getSpeed());
+            timeStretch->setSpeed(0.F);
+            DJV_ASSERT(Audio::timeStretchSpeedMin == timeStretch->getSpeed());
+            timeStretch->setSpeed(100.F);
+            DJV_ASSERT(Audio::timeStretchSpeedMax == timeStretch->getSpeed());
+        }
+
+        void AudioTimeStretchTest::_stretch()
+        {
+            // Stretch a sine wave and check that the length changes by the speed
+            // and the amplitude is kept.
+            const size_t sampleRate = 44100;
+            const size_t sampleCount = 1024;
+            const size_t blockCount = 100;
+            for (const auto speed : { .5F, 2.F })
+            {
+                auto timeStretch = Audio::TimeStretch::create(Audio::Info(1, Audio::Type::F32, sampleRate, 0));
+                timeStretch->setSpeed(speed);
+                size_t inCount = 0;
+                size_t outCount = 0;
+                float max = 0.F;
+                for (size_t i = 0; i < blockCount; ++i)
+                {
+                    auto data = Audio::Data::create(Audio::Info(1, Audio::Type::F32, sampleRate, sampleCount));
+                    auto p = reinterpret_cast<Audio::F32_T*>(data->getData());
+                    for (size_t j = 0; j < sampleCount; ++j, ++inCount)
+                    {
+                        p[j] = .5F * sinf(2.F * Math::pi * 440.F * inCount / static_cast<float>(sampleRate));
+                    }
+                    timeStretch->addInput(data);
+                    while (auto out = timeStretch->getOutput())
+                    {
+                        DJV_ASSERT(Audio::Type::F32 == out->getType());
+                        const auto p = reinterpret_cast<const Audio::F32_T*>(out->getData());
+                        for (size_t j = 0; j < out->getSampleCount(); ++j, ++outCount)
+                        {
+                            // Skip the fade in of the first window.
+                            if (outCount > sampleRate / 10)
+                            {
+                                max = std::max(max, fabsf(p[j]));
+                            }
+                        }
+                    }
+                }
+                const float ratio = (inCount - timeStretch->getInputSampleCount()) / static_cast<float>(outCount);
+                DJV_ASSERT(fabsf(ratio - speed) / speed < .1F);
+                DJV_ASSERT(fabsf(max - .5F) < .05F);
+
+                timeStretch->clear();
+                DJV_ASSERT(0 == timeStretch->getInputSampleCount());
+                DJV_ASSERT(!timeStretch->getOutput());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
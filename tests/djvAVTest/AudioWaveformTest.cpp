@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/AudioWaveformTest.h>
+
+#include <djvAV/AudioWaveform.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/Math.h>
+
+#include <cmath>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        AudioWaveformTest::AudioWaveformTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::AudioWaveformTest", context)
+        {}
+        
+        void AudioWaveformTest::run()
+        {
+            _peaks();
+            _levels();
+            _io();
+        }
+
+        void AudioWaveformTest::_peaks()
+        {
+            // Add a square wave in blocks that do not line up with the peaks.
+            Audio::PeakExtractor extractor;
+            const size_t sampleCount = Audio::waveformPeakSampleCount * 2 + 100;
+            size_t sample = 0;
+            while (sample < sampleCount)
+            {
+                const size_t size = std::min(static_cast<size_t>(300), sampleCount - sample);
+                auto data = Audio::Data::create(Audio::Info(2, Audio::Type::F32, 44100, size));
+                auto p = reinterpret_cast<Audio::F32_T*>(data->getData());
+                for (size_t i = 0; i < size; ++i, ++sample)
+                {
+                    const float v = (sample / 10) % 2 ? .5F : -.25F;
+                    *p++ = v;
+                    *p++ = v;
+                }
+                extractor.add(data);
+            }
+            DJV_ASSERT(sampleCount == extractor.getSampleCount());
+            DJV_ASSERT(2 == extractor.getPeaks().size());
+            extractor.flush();
+            const auto& peaks = extractor.getPeaks();
+            DJV_ASSERT(3 == peaks.size());
+            for (const auto& i : peaks)
+            {
+                DJV_ASSERT(-.25F == i.min);
+                DJV_ASSERT(.5F == i.max);
+                DJV_ASSERT(i.rms > .25F && i.rms < .5F);
+            }
+        }
+
+        void AudioWaveformTest::_levels()
+        {
+            const size_t peakCount = 5;
+            auto waveform = Audio::Waveform::create(44100, Audio::waveformPeakSampleCount * peakCount);
+            DJV_ASSERT(44100 == waveform->getSampleRate());
+            DJV_ASSERT(Audio::waveformPeakSampleCount * peakCount == waveform->getSampleCount());
+            std::vector<Audio::Peak> peaks(peakCount);
+            for (size_t i = 0; i < peakCount; ++i)
+            {
+                peaks[i].min = -static_cast<float>(i);
+                peaks[i].max = static_cast<float>(i);
+                peaks[i].rms = 1.F;
+            }
+            waveform->setPeaks(0, peaks);
+            waveform->updateLevels();
+
+            // The levels halve in size until a single peak is left.
+            DJV_ASSERT(4 == waveform->getLevelCount());
+            DJV_ASSERT(peakCount == waveform->getLevel(0).size());
+            DJV_ASSERT(3 == waveform->getLevel(1).size());
+            DJV_ASSERT(2 == waveform->getLevel(2).size());
+            DJV_ASSERT(1 == waveform->getLevel(3).size());
+            const auto& top = waveform->getLevel(3)[0];
+            DJV_ASSERT(-4.F == top.min);
+            DJV_ASSERT(4.F == top.max);
+            DJV_ASSERT(fabsf(top.rms - 1.F) < .0001F);
+
+            // Get the peaks for a range of samples.
+            auto out = waveform->getPeaks(0, waveform->getSampleCount(), 1);
+            DJV_ASSERT(1 == out.size());
+            DJV_ASSERT(-4.F == out[0].min);
+            DJV_ASSERT(4.F == out[0].max);
+            out = waveform->getPeaks(0, waveform->getSampleCount(), peakCount);
+            DJV_ASSERT(peaks == out);
+            out = waveform->getPeaks(Audio::waveformPeakSampleCount, Audio::waveformPeakSampleCount * 2, 4);
+            for (const auto& i : out)
+            {
+                DJV_ASSERT(peaks[1] == i);
+            }
+        }
+
+        void AudioWaveformTest::_io()
+        {
+            const std::string fileName = "AudioWaveformTest.djvwaveform";
+            auto waveform = Audio::Waveform::create(48000, Audio::waveformPeakSampleCount * 3 + 1);
+            std::vector<Audio::Peak> peaks(4);
+            for (size_t i = 0; i < peaks.size(); ++i)
+            {
+                peaks[i].min = -.1F * i;
+                peaks[i].max = .2F * i;
+                peaks[i].rms = .05F * i;
+            }
+            waveform->setPeaks(0, peaks);
+            waveform->updateLevels();
+            waveform->write(fileName, "key");
+
+            auto waveform2 = Audio::Waveform::read(fileName, "key");
+            DJV_ASSERT(waveform2);
+            DJV_ASSERT(waveform->getSampleRate() == waveform2->getSampleRate());
+            DJV_ASSERT(waveform->getSampleCount() == waveform2->getSampleCount());
+            DJV_ASSERT(waveform->getLevelCount() == waveform2->getLevelCount());
+            for (size_t i = 0; i < waveform->getLevelCount(); ++i)
+            {
+                DJV_ASSERT(waveform->getLevel(i) == waveform2->getLevel(i));
+            }
+
+            // A different key means the waveform is out of date.
+            DJV_ASSERT(!Audio::Waveform::read(fileName, "key2"));
+
+            try
+            {
+                Audio::Waveform::read("AudioWaveformTest.missing", "key");
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
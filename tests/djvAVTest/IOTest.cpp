@@ -5,11 +5,31 @@
 #include <djvAVTest/IOTest.h>
 
 #include <djvAV/IOSystem.h>
+#if defined(FFmpeg_FOUND)
+#include <djvAV/FFmpeg.h>
+#endif // FFmpeg_FOUND
+#if defined(OpenEXR_FOUND)
+#include <djvAV/OpenEXR.h>
+#endif // OpenEXR_FOUND
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#if defined(FFmpeg_FOUND)
+extern "C"
+{
+#include <libavformat/avformat.h>
+
+} // extern "C"
+#endif // FFmpeg_FOUND
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -17,6 +37,137 @@ namespace djv
 {
     namespace AVTest
     {
+        namespace
+        {
+            std::shared_ptr<Image::Image> readFrame(
+                const std::shared_ptr<IO::System>& io,
+                const FileSystem::Path& path)
+            {
+                std::shared_ptr<Image::Image> out;
+                auto read = io->read(FileSystem::FileInfo(path));
+                bool running = true;
+                while (running)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& readQueue = read->getVideoQueue();
+                        if (!readQueue.isEmpty())
+                        {
+                            out = readQueue.popFrame().image;
+                            running = false;
+                        }
+                        else if (readQueue.isFinished())
+                        {
+                            running = false;
+                        }
+                    }
+                    if (running)
+                    {
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                }
+                return out;
+            }
+
+            std::vector<IO::VideoFrame> readFrames(const std::shared_ptr<IO::IRead>& read)
+            {
+                std::vector<IO::VideoFrame> out;
+                bool running = true;
+                while (running)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& readQueue = read->getVideoQueue();
+                        while (!readQueue.isEmpty())
+                        {
+                            out.push_back(readQueue.popFrame());
+                        }
+                        running = !readQueue.isFinished();
+                    }
+                    if (running)
+                    {
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                }
+                return out;
+            }
+
+#if defined(FFmpeg_FOUND)
+            //! Write a movie with a key frame every gopSize frames.
+            void writeMovie(const std::string& fileName, int frameCount, int gopSize)
+            {
+                AVFormatContext* avFormatContext = nullptr;
+                avformat_alloc_output_context2(&avFormatContext, nullptr, nullptr, fileName.c_str());
+                DJV_ASSERT(avFormatContext);
+                auto avCodec = avcodec_find_encoder(AV_CODEC_ID_MPEG4);
+                DJV_ASSERT(avCodec);
+                auto avStream = avformat_new_stream(avFormatContext, nullptr);
+                auto avCodecContext = avcodec_alloc_context3(avCodec);
+                avCodecContext->width = 64;
+                avCodecContext->height = 64;
+                avCodecContext->pix_fmt = AV_PIX_FMT_YUV420P;
+                avCodecContext->time_base = AVRational{ 1, 24 };
+                avCodecContext->framerate = AVRational{ 24, 1 };
+                avCodecContext->gop_size = gopSize;
+                avCodecContext->max_b_frames = 0;
+                if (avFormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+                {
+                    avCodecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+                }
+                DJV_ASSERT(avcodec_open2(avCodecContext, avCodec, nullptr) >= 0);
+                avcodec_parameters_from_context(avStream->codecpar, avCodecContext);
+                avStream->time_base = avCodecContext->time_base;
+                avStream->avg_frame_rate = avCodecContext->framerate;
+                DJV_ASSERT(avio_open(&avFormatContext->pb, fileName.c_str(), AVIO_FLAG_WRITE) >= 0);
+                DJV_ASSERT(avformat_write_header(avFormatContext, nullptr) >= 0);
+
+                AVFrame* avFrame = av_frame_alloc();
+                avFrame->format = avCodecContext->pix_fmt;
+                avFrame->width = avCodecContext->width;
+                avFrame->height = avCodecContext->height;
+                av_frame_get_buffer(avFrame, 0);
+                AVPacket* avPacket = av_packet_alloc();
+                auto encode = [avFormatContext, avStream, avCodecContext, avPacket](AVFrame* frame)
+                {
+                    avcodec_send_frame(avCodecContext, frame);
+                    while (avcodec_receive_packet(avCodecContext, avPacket) >= 0)
+                    {
+                        av_packet_rescale_ts(avPacket, avCodecContext->time_base, avStream->time_base);
+                        avPacket->stream_index = avStream->index;
+                        av_interleaved_write_frame(avFormatContext, avPacket);
+                    }
+                };
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    av_frame_make_writable(avFrame);
+                    for (int y = 0; y < avFrame->height; ++y)
+                    {
+                        for (int x = 0; x < avFrame->width; ++x)
+                        {
+                            avFrame->data[0][y * avFrame->linesize[0] + x] = static_cast<uint8_t>(i * 10 + x + y);
+                        }
+                    }
+                    for (int y = 0; y < avFrame->height / 2; ++y)
+                    {
+                        memset(avFrame->data[1] + y * avFrame->linesize[1], 128, avFrame->width / 2);
+                        memset(avFrame->data[2] + y * avFrame->linesize[2], 128, avFrame->width / 2);
+                    }
+                    avFrame->pts = i;
+                    encode(avFrame);
+                }
+                encode(nullptr);
+                av_write_trailer(avFormatContext);
+
+                av_packet_free(&avPacket);
+                av_frame_free(&avFrame);
+                avcodec_free_context(&avCodecContext);
+                avio_closep(&avFormatContext->pb);
+                avformat_free_context(avFormatContext);
+            }
+#endif // FFmpeg_FOUND
+
+        } // namespace
+
         IOTest::IOTest(const std::shared_ptr<Core::Context>& context) :
             ITest("djv::AVTest::IOTest", context)
         {}
@@ -29,7 +180,12 @@ namespace djv
             _audioFrame();
             _audioQueue();
             _cache();
+            _threadPool();
             _io();
+            _parallelRead();
+            _openEXRLayerCache();
+            _ffmpeg();
+            _proxy();
             _system();
         }
         
@@ -189,8 +345,202 @@ namespace djv
                     _print(ss.str());
                 }
             }
+
+            {
+                IO::Cache cache;
+                cache.setMax(100);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(10);
+                const auto image = Image::Image::create(Image::Info(2, 2, Image::Type::RGBA_U8));
+                const size_t imageByteCount = image->getDataByteCount();
+                for (Frame::Index i = 0; i < 100; ++i)
+                {
+                    cache.add(i, image);
+                }
+                DJV_ASSERT(100 == cache.getCount());
+                DJV_ASSERT(100 * imageByteCount == cache.getTotalByteCount());
+                DJV_ASSERT(imageByteCount == cache.getByteCount(0));
+
+                cache.setMaxByteCount(20 * imageByteCount);
+                DJV_ASSERT(20 == cache.getCount());
+                DJV_ASSERT(20 * imageByteCount == cache.getTotalByteCount());
+                DJV_ASSERT(80 == cache.getStats().evictionCount);
+                DJV_ASSERT(cache.contains(10));
+                DJV_ASSERT(!cache.contains(50));
+
+                std::shared_ptr<AV::Image::Image> tmp;
+                DJV_ASSERT(cache.get(10, tmp));
+                DJV_ASSERT(!cache.get(50, tmp));
+                DJV_ASSERT(1 == cache.getStats().hitCount);
+                DJV_ASSERT(1 == cache.getStats().missCount);
+
+                cache.clear();
+                DJV_ASSERT(0 == cache.getTotalByteCount());
+            }
+
+            {
+                IO::CacheStats stats;
+                stats.hitCount = 1;
+                stats.missCount = 2;
+                stats.evictionCount = 3;
+                IO::CacheStats stats2;
+                stats2 += stats;
+                stats2 += stats;
+                DJV_ASSERT(2 == stats2.hitCount);
+                DJV_ASSERT(4 == stats2.missCount);
+                DJV_ASSERT(6 == stats2.evictionCount);
+                DJV_ASSERT(stats == stats);
+            }
         }
         
+        void IOTest::_threadPool()
+        {
+            {
+                auto pool = IO::ThreadPool::create(2);
+                DJV_ASSERT(2 == pool->getThreadCount());
+                pool->setThreadCount(4);
+                DJV_ASSERT(4 == pool->getThreadCount());
+                pool->setThreadCount(0);
+                DJV_ASSERT(1 == pool->getThreadCount());
+            }
+
+            {
+                auto pool = IO::ThreadPool::create(2);
+                auto queue = pool->createQueue();
+                auto queue2 = pool->createQueue();
+                std::vector<std::future<int> > futures;
+                for (int i = 0; i < 100; ++i)
+                {
+                    futures.push_back((i % 2 ? queue : queue2)->add<int>(
+                        i % 3 ? IO::TaskPriority::Cache : IO::TaskPriority::Queue,
+                        [i]
+                        {
+                            return i;
+                        }));
+                }
+                queue->cancel(IO::TaskPriority::Cache);
+                size_t finished = 0;
+                size_t cancelled = 0;
+                for (size_t i = 0; i < futures.size(); ++i)
+                {
+                    try
+                    {
+                        DJV_ASSERT(static_cast<int>(i) == futures[i].get());
+                        ++finished;
+                    }
+                    catch (const std::future_error&)
+                    {
+                        ++cancelled;
+                    }
+                }
+                DJV_ASSERT(futures.size() == finished + cancelled);
+                DJV_ASSERT(0 == queue->getPendingCount());
+                DJV_ASSERT(0 == queue2->getPendingCount());
+                std::stringstream ss;
+                ss << "thread pool finished: " << finished << ", cancelled: " << cancelled;
+                _print(ss.str());
+            }
+
+            {
+                // Bands are only split across the pool when called from a task.
+                for (size_t threadCount : { 1, 4 })
+                {
+                    auto pool = IO::ThreadPool::create(threadCount);
+                    auto queue = pool->createQueue();
+                    const size_t count = 1000;
+                    auto future = queue->add<std::vector<int> >(
+                        IO::TaskPriority::Queue,
+                        [count]
+                        {
+                            std::vector<int> rows(count, 0);
+                            std::atomic<size_t> bands(0);
+                            IO::ThreadPool::parallel(
+                                count,
+                                count * Memory::megabyte,
+                                [&rows, &bands](size_t y0, size_t y1)
+                                {
+                                    for (size_t y = y0; y < y1; ++y)
+                                    {
+                                        ++rows[y];
+                                    }
+                                    ++bands;
+                                });
+                            rows.push_back(static_cast<int>(bands));
+                            return rows;
+                        });
+                    const auto rows = future.get();
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        DJV_ASSERT(1 == rows[i]);
+                    }
+                    DJV_ASSERT(static_cast<size_t>(rows[count]) == threadCount);
+                }
+
+                size_t bands = 0;
+                IO::ThreadPool::parallel(
+                    100,
+                    100 * Memory::megabyte,
+                    [&bands](size_t y0, size_t y1)
+                    {
+                        DJV_ASSERT(0 == y0);
+                        DJV_ASSERT(100 == y1);
+                        ++bands;
+                    });
+                DJV_ASSERT(1 == bands);
+
+                auto pool = IO::ThreadPool::create(4);
+                auto queue = pool->createQueue();
+                auto future = queue->add<bool>(
+                    IO::TaskPriority::Queue,
+                    []
+                    {
+                        IO::ThreadPool::parallel(
+                            100,
+                            100 * Memory::megabyte,
+                            [](size_t y0, size_t)
+                            {
+                                if (0 == y0)
+                                {
+                                    throw std::runtime_error("band");
+                                }
+                            });
+                        return true;
+                    });
+                try
+                {
+                    future.get();
+                    DJV_ASSERT(false);
+                }
+                catch (const std::runtime_error&)
+                {}
+            }
+
+            for (size_t i = 0; i < 100; ++i)
+            {
+                // Release the queues while the workers are looking for tasks,
+                // with the queue holding the last reference to the pool.
+                auto queue = IO::ThreadPool::create(2)->createQueue();
+                auto future = queue->add<int>(
+                    IO::TaskPriority::Queue,
+                    []
+                    {
+                        return 1;
+                    });
+                DJV_ASSERT(1 == future.get());
+                queue.reset();
+            }
+
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                DJV_ASSERT(io->getThreadPool());
+                const size_t threadCount = io->getThreadCount();
+                io->setThreadCount(threadCount + 1);
+                DJV_ASSERT(threadCount + 1 == io->getThreadCount());
+                io->setThreadCount(threadCount);
+            }
+        }
+
         void IOTest::_io()
         {
             if (auto context = getContext().lock())
@@ -290,6 +640,283 @@ namespace djv
             }
         }
         
+        void IOTest::_parallelRead()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                const size_t threadCount = io->getThreadCount();
+                const std::vector<std::pair<std::string, Image::Type> > files =
+                {
+                    { ".cin", Image::Type::RGB_U10 },
+                    { ".dpx", Image::Type::RGB_U10 },
+                    { ".tif", Image::Type::RGB_U16 }
+                };
+                for (const auto& file : files)
+                {
+                    const Image::Info imageInfo(1024, 512, file.second);
+                    auto image = Image::Image::create(imageInfo);
+                    for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                    {
+                        uint8_t* p = image->getData(y);
+                        for (size_t x = 0; x < imageInfo.getScanlineByteCount(); ++x)
+                        {
+                            p[x] = static_cast<uint8_t>(x * 3 + y);
+                        }
+                    }
+                    FileSystem::Path path("IOTest_parallel" + file.first);
+                    {
+                        IO::Info info;
+                        info.video.push_back(imageInfo);
+                        auto write = io->write(FileSystem::FileInfo(path), info);
+                        {
+                            std::lock_guard<std::mutex> lock(write->getMutex());
+                            auto& writeQueue = write->getVideoQueue();
+                            writeQueue.addFrame(IO::VideoFrame(0, image));
+                            writeQueue.setFinished(true);
+                        }
+                        while (write->isRunning())
+                        {}
+                    }
+
+                    // With one thread the frame is decoded serially, otherwise
+                    // the idle threads of the pool decode bands of the frame.
+                    io->setThreadCount(1);
+                    const auto serial = readFrame(io, path);
+                    io->setThreadCount(4);
+                    const auto parallel = readFrame(io, path);
+                    DJV_ASSERT(serial && parallel);
+                    DJV_ASSERT(serial->getInfo() == parallel->getInfo());
+                    for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                    {
+                        DJV_ASSERT(0 == memcmp(
+                            serial->getData(y),
+                            parallel->getData(y),
+                            serial->getInfo().getScanlineByteCount()));
+                    }
+                    if (".tif" == file.first)
+                    {
+                        Image::Info info = imageInfo;
+                        info.layout = parallel->getLayout();
+                        DJV_ASSERT(info == parallel->getInfo());
+                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        {
+                            DJV_ASSERT(0 == memcmp(
+                                image->getData(y),
+                                parallel->getData(y),
+                                imageInfo.getScanlineByteCount()));
+                        }
+                    }
+
+                    std::remove(path.get().c_str());
+                }
+                io->setThreadCount(threadCount);
+            }
+        }
+
+        void IOTest::_openEXRLayerCache()
+        {
+#if defined(OpenEXR_FOUND)
+            const std::string fileName = "IOTest_layerCache.exr";
+            auto writeFile = [fileName](size_t size)
+            {
+                FILE* f = fopen(fileName.c_str(), "wb");
+                DJV_ASSERT(f);
+                const std::vector<uint8_t> data(size, 0);
+                fwrite(data.data(), 1, size, f);
+                fclose(f);
+            };
+            writeFile(1);
+
+            const Image::Info imageInfo(16, 16, Image::Type::RGBA_U8);
+            std::vector<std::shared_ptr<Image::Image> > images;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                images.push_back(Image::Image::create(imageInfo));
+            }
+            auto layerCache = IO::OpenEXR::LayerCache::create();
+            layerCache->setMaxByteCount(imageInfo.getDataByteCount() * 2);
+            DJV_ASSERT(imageInfo.getDataByteCount() * 2 == layerCache->getMaxByteCount());
+            layerCache->add(fileName, 0, images[0]);
+            layerCache->add(fileName, 1, images[1]);
+            DJV_ASSERT(imageInfo.getDataByteCount() * 2 == layerCache->getByteCount());
+            std::shared_ptr<Image::Image> image;
+            DJV_ASSERT(layerCache->get(fileName, 0, image));
+            DJV_ASSERT(images[0] == image);
+
+            // Adding a layer past the maximum byte count removes the least
+            // recently used layer.
+            layerCache->add(fileName, 2, images[2]);
+            DJV_ASSERT(imageInfo.getDataByteCount() * 2 == layerCache->getByteCount());
+            DJV_ASSERT(!layerCache->get(fileName, 1, image));
+            DJV_ASSERT(layerCache->get(fileName, 0, image));
+            DJV_ASSERT(layerCache->get(fileName, 2, image));
+            DJV_ASSERT(images[2] == image);
+
+            // The layers are not used after the file changes.
+            writeFile(2);
+            DJV_ASSERT(!layerCache->get(fileName, 0, image));
+            DJV_ASSERT(!layerCache->get(fileName, 2, image));
+
+            layerCache->clear();
+            DJV_ASSERT(0 == layerCache->getByteCount());
+
+            std::remove(fileName.c_str());
+#endif // OpenEXR_FOUND
+        }
+
+        void IOTest::_ffmpeg()
+        {
+#if defined(FFmpeg_FOUND)
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                const std::string fileName = "IOTest_ffmpeg.mov";
+                const std::string indexFileName = fileName + ".djvindex";
+                const size_t frameCount = 20;
+                const size_t gopSize = 5;
+                writeMovie(fileName, static_cast<int>(frameCount), static_cast<int>(gopSize));
+
+                rapidjson::Document document;
+                auto& allocator = document.GetAllocator();
+                const auto options = io->getOptions(IO::FFmpeg::pluginName, allocator);
+                IO::FFmpeg::Options ffmpegOptions;
+                ffmpegOptions.saveIndex = true;
+                io->setOptions(IO::FFmpeg::pluginName, toJSON(ffmpegOptions, allocator));
+
+                // The key frame index is built when the file is opened.
+                auto read = io->read(FileSystem::FileInfo(fileName));
+                DJV_ASSERT(1 == read->getInfo().get().video.size());
+                std::vector<std::string> lines;
+                for (size_t i = 0; i < 1000 && lines.size() < 2 + frameCount / gopSize; ++i)
+                {
+                    std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    try
+                    {
+                        lines = FileSystem::FileIO::readLines(indexFileName);
+                    }
+                    catch (const std::exception&)
+                    {}
+                }
+                DJV_ASSERT(2 + frameCount / gopSize == lines.size());
+                DJV_ASSERT("djvindex 1" == lines[0]);
+                for (size_t i = 0; i < frameCount / gopSize; ++i)
+                {
+                    DJV_ASSERT(std::to_string(i * gopSize) == lines[2 + i]);
+                }
+
+                // Playing backwards decodes each group from its key frame and
+                // gives the same images as playing forwards.
+                read->seek(0, IO::Direction::Forward);
+                const auto forward = readFrames(read);
+                DJV_ASSERT(frameCount == forward.size());
+                read->seek(frameCount - 1, IO::Direction::Reverse);
+                const auto reverse = readFrames(read);
+                DJV_ASSERT(frameCount == reverse.size());
+                for (size_t i = 0; i < frameCount; ++i)
+                {
+                    const auto& a = forward[i];
+                    const auto& b = reverse[frameCount - 1 - i];
+                    DJV_ASSERT(static_cast<Frame::Number>(i) == a.frame);
+                    DJV_ASSERT(static_cast<Frame::Number>(i) == b.frame);
+                    DJV_ASSERT(a.image->getInfo() == b.image->getInfo());
+                    DJV_ASSERT(0 == memcmp(a.image->getData(), b.image->getData(), a.image->getDataByteCount()));
+                }
+
+                read.reset();
+                io->setOptions(IO::FFmpeg::pluginName, options);
+                std::remove(fileName.c_str());
+                std::remove(indexFileName.c_str());
+            }
+#endif // FFmpeg_FOUND
+        }
+
+        void IOTest::_proxy()
+        {
+            {
+                DJV_ASSERT(1 == IO::getProxyDenominator(IO::ProxyScale::None));
+                DJV_ASSERT(2 == IO::getProxyDenominator(IO::ProxyScale::Half));
+                DJV_ASSERT(4 == IO::getProxyDenominator(IO::ProxyScale::Quarter));
+                DJV_ASSERT(8 == IO::getProxyDenominator(IO::ProxyScale::Eighth));
+            }
+
+            {
+                const Image::Size size(1920, 1081);
+                DJV_ASSERT(size == IO::getProxySize(size, IO::ProxyScale::None));
+                DJV_ASSERT(Image::Size(960, 541) == IO::getProxySize(size, IO::ProxyScale::Half));
+                DJV_ASSERT(Image::Size(480, 271) == IO::getProxySize(size, IO::ProxyScale::Quarter));
+                DJV_ASSERT(Image::Size(240, 136) == IO::getProxySize(size, IO::ProxyScale::Eighth));
+                DJV_ASSERT(Image::Size(1, 1) == IO::getProxySize(Image::Size(1, 1), IO::ProxyScale::Eighth));
+            }
+
+            {
+                const Image::Size size(4096, 2160);
+                DJV_ASSERT(IO::ProxyScale::None == IO::getProxyScale(size, Image::Size()));
+                DJV_ASSERT(IO::ProxyScale::None == IO::getProxyScale(size, size));
+                DJV_ASSERT(IO::ProxyScale::Half == IO::getProxyScale(size, Image::Size(2048, 1080)));
+                DJV_ASSERT(IO::ProxyScale::Quarter == IO::getProxyScale(size, Image::Size(1024, 540)));
+                DJV_ASSERT(IO::ProxyScale::Eighth == IO::getProxyScale(size, Image::Size(128, 128)));
+            }
+
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<AV::IO::System>();
+                const Image::Info imageInfo(33, 17, Image::Type::RGB_U8);
+                auto image = Image::Image::create(imageInfo);
+                image->zero();
+                FileSystem::Path path("IOTest_proxy.ppm");
+                {
+                    IO::Info info;
+                    info.video.push_back(imageInfo);
+                    auto write = io->write(FileSystem::FileInfo(path), info);
+                    {
+                        std::lock_guard<std::mutex> lock(write->getMutex());
+                        auto& writeQueue = write->getVideoQueue();
+                        writeQueue.addFrame(IO::VideoFrame(0, image));
+                        writeQueue.setFinished(true);
+                    }
+                    while (write->isRunning())
+                    {}
+                }
+
+                // The PPM reader does not decode proxy images itself so they
+                // are resampled after reading.
+                IO::ReadOptions options;
+                options.proxyScale = IO::ProxyScale::Quarter;
+                auto read = io->read(FileSystem::FileInfo(path), options);
+                const auto info = read->getInfo().get();
+                DJV_ASSERT(1 == info.video.size());
+                DJV_ASSERT(Image::Size(9, 5) == info.video[0].size);
+                std::shared_ptr<Image::Image> proxyImage;
+                bool running = true;
+                while (running)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& readQueue = read->getVideoQueue();
+                        if (!readQueue.isEmpty())
+                        {
+                            proxyImage = readQueue.popFrame().image;
+                            running = false;
+                        }
+                        else if (readQueue.isFinished())
+                        {
+                            running = false;
+                        }
+                    }
+                    if (running)
+                    {
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                }
+                DJV_ASSERT(proxyImage);
+                DJV_ASSERT(Image::Size(9, 5) == proxyImage->getSize());
+
+                read.reset();
+                std::remove(path.get().c_str());
+            }
+        }
+
         void IOTest::_system()
         {
             if (auto context = getContext().lock())
@@ -359,6 +986,22 @@ namespace djv
                     ss << io->canWrite(FileSystem::FileInfo(i), IO::Info());
                     _print(ss.str());
                 }
+
+                io->setCacheMaxByteCount(Memory::gigabyte);
+                DJV_ASSERT(Memory::gigabyte == io->getCacheMaxByteCount());
+                io->tick();
+                {
+                    std::stringstream ss;
+                    ss << "cache byte count: " << io->getCacheByteCount();
+                    _print(ss.str());
+                }
+                {
+                    const auto stats = io->getCacheStats();
+                    std::stringstream ss;
+                    ss << "cache hits: " << stats.hitCount << ", misses: " << stats.missCount;
+                    _print(ss.str());
+                }
+                io->setCacheMaxByteCount(0);
             }
         }
                 
@@ -22,7 +22,12 @@ namespace djv
             void _audioFrame();
             void _audioQueue();
             void _cache();
+            void _threadPool();
             void _io();
+            void _parallelRead();
+            void _openEXRLayerCache();
+            void _ffmpeg();
+            void _proxy();
             void _system();
         };
         
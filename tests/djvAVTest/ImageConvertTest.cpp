@@ -4,11 +4,14 @@
 
 #include <djvAVTest/ImageConvertTest.h>
 
+#include <djvAV/IOThreadPool.h>
 #include <djvAV/ImageConvert.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/ResourceSystem.h>
 
+#include <cstring>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -21,6 +24,14 @@ namespace djv
         {}
         
         void ImageConvertTest::run()
+        {
+            _convert();
+            _cpu();
+            _layout();
+            _resample();
+        }
+
+        void ImageConvertTest::_convert()
         {
             if (auto context = getContext().lock())
             {
@@ -45,7 +56,138 @@ namespace djv
                     _print(ss.str());
                 }
                 //DJV_ASSERT(Image::U8Range.max == u8);
+
+                if (!convert->isOpenGL())
+                {
+                    // The output is written with the given information.
+                    Image::Info info3(64, 64, Image::Type::L_U16);
+                    info3.layout.mirror.y = true;
+                    convert->process(*data, info3, *data2);
+                    auto data3 = Image::Data::create(info3);
+                    Image::convert(*data, *data3);
+                    DJV_ASSERT(0 == memcmp(data2->getData(), data3->getData(), data3->getDataByteCount()));
+                }
+            }
+        }
+
+        void ImageConvertTest::_cpu()
+        {
+            // Compare the CPU conversion with the pixel conversion functions
+            // for every pair of types. The width is chosen so that both the
+            // vectorized and scalar loops are used.
+            const Image::Size size(37, 3);
+            auto rgba = Image::Data::create(Image::Info(size, Image::Type::RGBA_U8));
+            for (size_t i = 0; i < rgba->getDataByteCount(); ++i)
+            {
+                rgba->getData()[i] = static_cast<uint8_t>(i * 7);
+            }
+            for (auto inType : Image::getTypeEnums())
+            {
+                if (Image::Type::None == inType)
+                    continue;
+                auto in = Image::Data::create(Image::Info(size, inType));
+                in->zero();
+                Image::convert(*rgba, *in);
+                for (auto outType : Image::getTypeEnums())
+                {
+                    if (Image::Type::None == outType)
+                        continue;
+                    auto out = Image::Data::create(Image::Info(size, outType));
+                    out->zero();
+                    Image::convert(*in, *out);
+                    auto outRef = Image::Data::create(Image::Info(size, outType));
+                    outRef->zero();
+                    for (uint16_t y = 0; y < size.h; ++y)
+                    {
+                        Image::convert(in->getData(y), inType, outRef->getData(y), outType, size.w);
+                    }
+                    DJV_ASSERT(0 == memcmp(out->getData(), outRef->getData(), out->getDataByteCount()));
+                }
+            }
+
+            // Large images are split across the idle threads of the pool when
+            // converted from one of its tasks.
+            const Image::Size size2(512, 512);
+            auto in = Image::Data::create(Image::Info(size2, Image::Type::RGBA_U8));
+            for (size_t i = 0; i < in->getDataByteCount(); ++i)
+            {
+                in->getData()[i] = static_cast<uint8_t>(i * 7);
+            }
+            auto out = Image::Data::create(Image::Info(size2, Image::Type::RGB_F32));
+            auto threadPool = IO::ThreadPool::create(4);
+            auto taskQueue = threadPool->createQueue();
+            taskQueue->add<bool>(
+                IO::TaskPriority::Queue,
+                [in, out]
+                {
+                    Image::convert(*in, *out);
+                    return true;
+                }).get();
+            auto outRef = Image::Data::create(Image::Info(size2, Image::Type::RGB_F32));
+            Image::convert(in->getData(), in->getType(), outRef->getData(), outRef->getType(), size2.w * size2.h);
+            DJV_ASSERT(0 == memcmp(out->getData(), outRef->getData(), out->getDataByteCount()));
+        }
+
+        void ImageConvertTest::_layout()
+        {
+            {
+                auto in = Image::Data::create(Image::Info(2, 2, Image::Type::L_U8));
+                in->getData()[0] = 1;
+                in->getData()[1] = 2;
+                in->getData()[2] = 3;
+                in->getData()[3] = 4;
+                auto out = Image::Data::create(Image::Info(2, 2, Image::Type::L_U8, Image::Mirror(true, false)));
+                Image::convert(*in, *out);
+                DJV_ASSERT(2 == out->getData()[0]);
+                DJV_ASSERT(1 == out->getData()[1]);
+                DJV_ASSERT(4 == out->getData()[2]);
+                DJV_ASSERT(3 == out->getData()[3]);
+                out = Image::Data::create(Image::Info(2, 2, Image::Type::L_U8, Image::Mirror(false, true)));
+                Image::convert(*in, *out);
+                DJV_ASSERT(3 == out->getData()[0]);
+                DJV_ASSERT(4 == out->getData()[1]);
+                DJV_ASSERT(1 == out->getData()[2]);
+                DJV_ASSERT(2 == out->getData()[3]);
+            }
+            {
+                auto in = Image::Data::create(Image::Info(1, 1, Image::Type::L_U16));
+                reinterpret_cast<Image::U16_T*>(in->getData())[0] = 0x0102;
+                auto out = Image::Data::create(Image::Info(1, 1, Image::Type::L_U16,
+                    Image::Layout(Image::Mirror(), 1, Memory::opposite(Memory::getEndian()))));
+                Image::convert(*in, *out);
+                DJV_ASSERT(0x0201 == reinterpret_cast<const Image::U16_T*>(out->getData())[0]);
+                auto out2 = Image::Data::create(Image::Info(1, 1, Image::Type::L_U8));
+                Image::convert(*out, *out2);
+                DJV_ASSERT(1 == out2->getData()[0]);
+            }
+            {
+                auto in = Image::Data::create(Image::Info(3, 2, Image::Type::RGB_U8));
+                for (size_t i = 0; i < in->getDataByteCount(); ++i)
+                {
+                    in->getData()[i] = static_cast<uint8_t>(i);
+                }
+                auto out = Image::Data::create(Image::Info(3, 2, Image::Type::RGB_U8, Image::Layout(Image::Mirror(), 4)));
+                DJV_ASSERT(12 == out->getScanlineByteCount());
+                Image::convert(*in, *out);
+                DJV_ASSERT(8 == out->getData(0)[8]);
+                DJV_ASSERT(9 == out->getData(1)[0]);
+                DJV_ASSERT(17 == out->getData(1)[8]);
+            }
+        }
+
+        void ImageConvertTest::_resample()
+        {
+            auto in = Image::Data::create(Image::Info(4, 4, Image::Type::L_U8));
+            for (uint8_t i = 0; i < 16; ++i)
+            {
+                in->getData()[i] = i;
             }
+            auto out = Image::Data::create(Image::Info(2, 2, Image::Type::L_U8));
+            Image::convert(*in, *out);
+            DJV_ASSERT(5 == out->getData()[0]);
+            DJV_ASSERT(7 == out->getData()[1]);
+            DJV_ASSERT(13 == out->getData()[2]);
+            DJV_ASSERT(15 == out->getData()[3]);
         }
                 
     } // namespace AVTest
@@ -14,6 +14,12 @@ namespace djv
             ImageConvertTest(const std::shared_ptr<Core::Context>&);
             
             void run() override;
+
+        private:
+            void _convert();
+            void _cpu();
+            void _layout();
+            void _resample();
         };
         
     } // namespace AVTest
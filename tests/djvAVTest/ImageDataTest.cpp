@@ -6,8 +6,11 @@
 
 #include <djvAV/ImageData.h>
 
+#include <djvCore/FileIO.h>
 #include <djvCore/Memory.h>
 
+#include <cstdio>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -26,6 +29,7 @@ namespace djv
             _size();
             _info();
             _data();
+            _memoryMap();
             _operators();
             _serialize();
         }
@@ -218,6 +222,48 @@ namespace djv
             }
         }
         
+        void ImageDataTest::_memoryMap()
+        {
+            const std::string fileName = "ImageDataTest.memoryMap";
+            const Image::Info info(2, 2, Image::Type::L_U8);
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                const uint8_t header[] = { 0, 0 };
+                io->writeU8(header, 2);
+                const uint8_t pixels[] = { 1, 2, 3, 4 };
+                io->writeU8(pixels, 4);
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Read, true);
+                io->setPos(2);
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(data->isMemoryMapped());
+                DJV_ASSERT(info.getDataByteCount() == data->getDataByteCount());
+                DJV_ASSERT(io->mmapP() - 4 == static_cast<const Image::Data&>(*data).getData());
+                DJV_ASSERT(1 == static_cast<const Image::Data&>(*data).getData()[0]);
+
+                data->detach();
+                DJV_ASSERT(!data->isMemoryMapped());
+                DJV_ASSERT(1 == data->getData()[0]);
+                data->getData()[0] = 5;
+                DJV_ASSERT(5 == data->getData()[0]);
+                DJV_ASSERT(4 == data->getData()[3]);
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Read, true);
+                io->setPos(4);
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(!data->isMemoryMapped());
+            }
+
+            std::remove(fileName.c_str());
+        }
+
         void ImageDataTest::_util()
         {
             {
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ImageHistogramTest.h>
+
+#include <djvAV/ImageHistogram.h>
+
+#include <cstring>
+#include <limits>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageHistogramTest::ImageHistogramTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageHistogramTest", context)
+        {}
+        
+        void ImageHistogramTest::run()
+        {
+            _histogram();
+            _int();
+            _float();
+            _parallel();
+        }
+
+        void ImageHistogramTest::_histogram()
+        {
+            {
+                const Image::HistogramOptions options;
+                DJV_ASSERT(256 == options.binCount);
+                DJV_ASSERT(FloatRange(0.F, 1.F) == options.range);
+                DJV_ASSERT(Image::HistogramScale::Linear == options.scale);
+                Image::HistogramOptions options2;
+                options2.scale = Image::HistogramScale::Log;
+                DJV_ASSERT(options != options2);
+            }
+            {
+                const Image::Histogram histogram;
+                DJV_ASSERT(0 == histogram.getChannelCount());
+                DJV_ASSERT(0 == histogram.getBinCount());
+                DJV_ASSERT(0 == histogram.getMax());
+            }
+            {
+                Image::Histogram histogram(2, 4);
+                DJV_ASSERT(2 == histogram.getChannelCount());
+                DJV_ASSERT(4 == histogram.getBinCount());
+                histogram.getBins(0)[1] = 2;
+                histogram.getBins(1)[3] = 5;
+                Image::Histogram histogram2(2, 4);
+                histogram2.getBins(1)[3] = 1;
+                histogram.add(histogram2);
+                DJV_ASSERT(2 == histogram.getBins(0)[1]);
+                DJV_ASSERT(6 == histogram.getBins(1)[3]);
+                DJV_ASSERT(6 == histogram.getMax());
+                DJV_ASSERT(histogram != histogram2);
+            }
+        }
+
+        void ImageHistogramTest::_int()
+        {
+            {
+                auto data = Image::Data::create(Image::Info(4, 1, Image::Type::LA_U8));
+                const uint8_t values[] = { 0, 255, 127, 128, 128, 0, 255, 255 };
+                memcpy(data->getData(), values, sizeof(values));
+                Image::HistogramOptions options;
+                options.binCount = 2;
+                const auto histogram = Image::histogram(*data, options);
+                DJV_ASSERT(2 == histogram.getChannelCount());
+                DJV_ASSERT(2 == histogram.getBins(0)[0]);
+                DJV_ASSERT(2 == histogram.getBins(0)[1]);
+                DJV_ASSERT(1 == histogram.getBins(1)[0]);
+                DJV_ASSERT(3 == histogram.getBins(1)[1]);
+            }
+            {
+                auto data = Image::Data::create(Image::Info(2, 1, Image::Type::RGB_U10));
+                auto p = reinterpret_cast<Image::U10_S*>(data->getData());
+                p[0].r = 0;
+                p[0].g = 1023;
+                p[0].b = 512;
+                p[1].r = 1023;
+                p[1].g = 1023;
+                p[1].b = 0;
+                Image::HistogramOptions options;
+                options.binCount = 4;
+                const auto histogram = Image::histogram(*data, options);
+                DJV_ASSERT(3 == histogram.getChannelCount());
+                DJV_ASSERT(1 == histogram.getBins(0)[0]);
+                DJV_ASSERT(1 == histogram.getBins(0)[3]);
+                DJV_ASSERT(2 == histogram.getBins(1)[3]);
+                DJV_ASSERT(1 == histogram.getBins(2)[0]);
+                DJV_ASSERT(1 == histogram.getBins(2)[2]);
+            }
+            {
+                auto data = Image::Data::create(Image::Info(2, 1, Image::Type::L_U16, Image::Layout(Image::Mirror(), 1, Memory::opposite(Memory::getEndian()))));
+                auto p = reinterpret_cast<Image::U16_T*>(data->getData());
+                p[0] = 0x00FF;
+                p[1] = 0xFF00;
+                Image::HistogramOptions options;
+                options.binCount = 2;
+                const auto histogram = Image::histogram(*data, options);
+                DJV_ASSERT(1 == histogram.getBins(0)[0]);
+                DJV_ASSERT(1 == histogram.getBins(0)[1]);
+            }
+        }
+
+        void ImageHistogramTest::_float()
+        {
+            const float values[] =
+            {
+                -1.F,
+                0.F,
+                .9F,
+                1.1F,
+                3.9F,
+                100.F,
+                std::numeric_limits<float>::infinity(),
+                std::numeric_limits<float>::quiet_NaN()
+            };
+            const size_t count = sizeof(values) / sizeof(values[0]);
+            for (auto type : { Image::Type::L_F16, Image::Type::L_F32 })
+            {
+                auto data = Image::Data::create(Image::Info(count, 1, type));
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (Image::Type::L_F16 == type)
+                    {
+                        reinterpret_cast<Image::F16_T*>(data->getData())[i] = values[i];
+                    }
+                    else
+                    {
+                        reinterpret_cast<Image::F32_T*>(data->getData())[i] = values[i];
+                    }
+                }
+
+                // Values outside of the range are counted in the first and last
+                // bins, and NaNs in the first bin.
+                Image::HistogramOptions options;
+                options.binCount = 4;
+                options.range = FloatRange(0.F, 4.F);
+                auto histogram = Image::histogram(*data, options);
+                const size_t* bins = histogram.getBins(0);
+                DJV_ASSERT(4 == bins[0]);
+                DJV_ASSERT(1 == bins[1]);
+                DJV_ASSERT(0 == bins[2]);
+                DJV_ASSERT(3 == bins[3]);
+
+                // The logarithmic scale moves the values into higher bins.
+                options.scale = Image::HistogramScale::Log;
+                histogram = Image::histogram(*data, options);
+                bins = histogram.getBins(0);
+                DJV_ASSERT(3 == bins[0]);
+                DJV_ASSERT(2 == bins[1]);
+                DJV_ASSERT(0 == bins[2]);
+                DJV_ASSERT(3 == bins[3]);
+            }
+        }
+
+        void ImageHistogramTest::_parallel()
+        {
+            // Compare a large image that is split across threads with the
+            // histograms of the individual scanlines.
+            const uint16_t w = 1024;
+            const uint16_t h = 512;
+            for (auto type : { Image::Type::RGBA_U8, Image::Type::RGB_U16, Image::Type::RGBA_F32 })
+            {
+                auto data = Image::Data::create(Image::Info(w, h, type));
+                for (size_t i = 0; i < data->getDataByteCount(); ++i)
+                {
+                    data->getData()[i] = static_cast<uint8_t>((i * 7) % 251);
+                }
+                Image::HistogramOptions options;
+                options.binCount = 100;
+                const auto histogram = Image::histogram(*data, options);
+                Image::Histogram sum(Image::getChannelCount(type), options.binCount);
+                auto scanline = Image::Data::create(Image::Info(w, 1, type));
+                for (uint16_t y = 0; y < h; ++y)
+                {
+                    memcpy(scanline->getData(), data->getData(y), data->getScanlineByteCount());
+                    sum.add(Image::histogram(*scanline, options));
+                }
+                DJV_ASSERT(histogram == sum);
+                for (uint8_t c = 0; c < histogram.getChannelCount(); ++c)
+                {
+                    size_t total = 0;
+                    for (size_t i = 0; i < histogram.getBinCount(); ++i)
+                    {
+                        total += histogram.getBins(c)[i];
+                    }
+                    DJV_ASSERT(w * h == total);
+                }
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class ImageHistogramTest : public Test::ITest
+        {
+        public:
+            ImageHistogramTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _histogram();
+            void _int();
+            void _float();
+            void _parallel();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ImageResampleTest.h>
+
+#include <djvAV/IOThreadPool.h>
+#include <djvAV/ImageResample.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageResampleTest::ImageResampleTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageResampleTest", context)
+        {}
+        
+        void ImageResampleTest::run()
+        {
+            _identity();
+            _average();
+            _constant();
+            _layout();
+        }
+
+        void ImageResampleTest::_identity()
+        {
+            const Image::Info info(7, 5, Image::Type::L_F32);
+            auto in = Image::Data::create(info);
+            auto inP = reinterpret_cast<Image::F32_T*>(in->getData());
+            for (size_t i = 0; i < 7 * 5; ++i)
+            {
+                inP[i] = i / 35.F;
+            }
+            for (auto filter : Image::getResampleFilterEnums())
+            {
+                auto out = Image::Data::create(info);
+                Image::resample(*in, *out, filter);
+                auto outP = reinterpret_cast<const Image::F32_T*>(out->getData());
+                for (size_t i = 0; i < 7 * 5; ++i)
+                {
+                    DJV_ASSERT(fuzzyCompare(inP[i], outP[i], .0001F));
+                }
+            }
+        }
+
+        void ImageResampleTest::_average()
+        {
+            {
+                auto in = Image::Data::create(Image::Info(4, 1, Image::Type::L_U8));
+                in->getData()[0] = 0;
+                in->getData()[1] = 0;
+                in->getData()[2] = 255;
+                in->getData()[3] = 255;
+                auto out = Image::Data::create(Image::Info(2, 1, Image::Type::L_U8));
+                Image::resample(*in, *out, Image::ResampleFilter::Box);
+                DJV_ASSERT(0 == out->getData()[0]);
+                DJV_ASSERT(255 == out->getData()[1]);
+            }
+            {
+                // Every input pixel contributes when the image is made much smaller.
+                auto in = Image::Data::create(Image::Info(8, 8, Image::Type::L_F32));
+                auto inP = reinterpret_cast<Image::F32_T*>(in->getData());
+                for (size_t i = 0; i < 8 * 8; ++i)
+                {
+                    inP[i] = (i % 2) ? 1.F : 0.F;
+                }
+                auto out = Image::Data::create(Image::Info(1, 1, Image::Type::L_F32));
+                Image::resample(*in, *out, Image::ResampleFilter::Box);
+                DJV_ASSERT(fuzzyCompare(reinterpret_cast<const Image::F32_T*>(out->getData())[0], .5F, .0001F));
+            }
+        }
+
+        void ImageResampleTest::_constant()
+        {
+            // Large images are split across the idle threads of the pool when
+            // resampled from one of its tasks.
+            auto threadPool = IO::ThreadPool::create(4);
+            auto taskQueue = threadPool->createQueue();
+            auto in = Image::Data::create(Image::Info(1024, 768, Image::Type::RGBA_U8));
+            for (size_t i = 0; i < in->getDataByteCount(); i += 4)
+            {
+                in->getData()[i + 0] = 0;
+                in->getData()[i + 1] = 255;
+                in->getData()[i + 2] = 0;
+                in->getData()[i + 3] = 255;
+            }
+            for (auto filter : Image::getResampleFilterEnums())
+            {
+                for (const auto& size : { Image::Size(100, 40), Image::Size(1500, 1000) })
+                {
+                    auto out = Image::Data::create(Image::Info(size, Image::Type::RGB_F32));
+                    taskQueue->add<bool>(
+                        IO::TaskPriority::Queue,
+                        [in, out, filter]
+                        {
+                            Image::resample(*in, *out, filter);
+                            return true;
+                        }).get();
+                    auto outP = reinterpret_cast<const Image::F32_T*>(out->getData());
+                    for (size_t i = 0; i < static_cast<size_t>(size.w) * size.h * 3; i += 3)
+                    {
+                        DJV_ASSERT(fuzzyCompare(outP[i + 0], 0.F, .0001F));
+                        DJV_ASSERT(fuzzyCompare(outP[i + 1], 1.F, .0001F));
+                        DJV_ASSERT(fuzzyCompare(outP[i + 2], 0.F, .0001F));
+                    }
+                }
+            }
+        }
+
+        void ImageResampleTest::_layout()
+        {
+            auto in = Image::Data::create(Image::Info(2, 4, Image::Type::L_U8));
+            for (uint8_t i = 0; i < 8; ++i)
+            {
+                in->getData()[i] = i < 4 ? 0 : 255;
+            }
+            auto out = Image::Data::create(Image::Info(1, 2, Image::Type::L_U8, Image::Mirror(false, true)));
+            Image::resample(*in, *out, Image::ResampleFilter::Box);
+            DJV_ASSERT(255 == out->getData()[0]);
+            DJV_ASSERT(0 == out->getData()[1]);
+        }
+                
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class ImageResampleTest : public Test::ITest
+        {
+        public:
+            ImageResampleTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _identity();
+            void _average();
+            void _constant();
+            void _layout();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
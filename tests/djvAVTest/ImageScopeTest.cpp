@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ImageScopeTest.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ImageConvert.h>
+#include <djvAV/ImageScope.h>
+
+#include <cstring>
+#include <limits>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageScopeTest::ImageScopeTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageScopeTest", context)
+        {}
+        
+        void ImageScopeTest::run()
+        {
+            _options();
+            _waveform();
+            _parade();
+            _vectorscope();
+            _float();
+        }
+
+        void ImageScopeTest::_options()
+        {
+            const Image::ScopeOptions options;
+            DJV_ASSERT(Image::Size(256, 256) == options.size);
+            DJV_ASSERT(1 == options.subsample);
+            DJV_ASSERT(FloatRange(0.F, 1.F) == options.range);
+            Image::ScopeOptions options2;
+            options2.subsample = 2;
+            DJV_ASSERT(options != options2);
+            for (auto i : Image::getScopeTypeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("Scope type: " + _getText(ss.str()));
+            }
+        }
+
+        void ImageScopeTest::_waveform()
+        {
+            {
+                auto data = Image::Data::create(Image::Info(4, 2, Image::Type::L_U8));
+                const uint8_t values[] = { 0, 0, 255, 255, 0, 0, 255, 0 };
+                memcpy(data->getData(), values, sizeof(values));
+                Image::ScopeOptions options;
+                options.size = Image::Size(2, 2);
+                const auto image = Image::scope(*data, Image::ScopeType::Waveform, options);
+                DJV_ASSERT(Image::Type::RGBA_U8 == image->getType());
+                DJV_ASSERT(options.size == image->getSize());
+                // The brightest values are at the top.
+                DJV_ASSERT(0 == image->getData(0, 0)[3]);
+                DJV_ASSERT(255 == image->getData(0, 1)[3]);
+                DJV_ASSERT(image->getData(1, 0)[3] > image->getData(1, 1)[3]);
+                DJV_ASSERT(image->getData(1, 1)[3] > 0);
+                DJV_ASSERT(255 == image->getData(1, 0)[0]);
+            }
+            {
+                auto data = Image::Data::create(Image::Info(4, 1, Image::Type::L_U8));
+                const uint8_t values[] = { 255, 255, 0, 0 };
+                memcpy(data->getData(), values, sizeof(values));
+                Image::ScopeOptions options;
+                options.size = Image::Size(2, 2);
+                options.subsample = 2;
+                auto image = Image::scope(*data, Image::ScopeType::Waveform, options);
+                DJV_ASSERT(255 == image->getData(0, 0)[3]);
+                DJV_ASSERT(255 == image->getData(1, 1)[3]);
+                DJV_ASSERT(0 == image->getData(1, 0)[3]);
+            }
+            {
+                const auto image = Image::scope(*Image::Data::create(Image::Info()), Image::ScopeType::Waveform);
+                DJV_ASSERT(0 == image->getData(0, 0)[3]);
+            }
+        }
+
+        void ImageScopeTest::_parade()
+        {
+            auto data = Image::Data::create(Image::Info(1, 1, Image::Type::RGB_U8));
+            const uint8_t values[] = { 255, 0, 255 };
+            memcpy(data->getData(), values, sizeof(values));
+            Image::ScopeOptions options;
+            options.size = Image::Size(3, 2);
+            const auto image = Image::scope(*data, Image::ScopeType::RGBParade, options);
+            DJV_ASSERT(255 == image->getData(0, 0)[3]);
+            DJV_ASSERT(255 == image->getData(0, 0)[0]);
+            DJV_ASSERT(0 == image->getData(0, 0)[1]);
+            DJV_ASSERT(255 == image->getData(1, 1)[3]);
+            DJV_ASSERT(255 == image->getData(1, 1)[1]);
+            DJV_ASSERT(255 == image->getData(2, 0)[3]);
+            DJV_ASSERT(255 == image->getData(2, 0)[2]);
+            DJV_ASSERT(0 == image->getData(1, 0)[3]);
+        }
+
+        void ImageScopeTest::_vectorscope()
+        {
+            {
+                // Neutral colors are in the center.
+                auto data = Image::Data::create(Image::Info(2, 1, Image::Type::RGB_U8));
+                const uint8_t values[] = { 0, 0, 0, 128, 128, 128 };
+                memcpy(data->getData(), values, sizeof(values));
+                Image::ScopeOptions options;
+                options.size = Image::Size(3, 3);
+                const auto image = Image::scope(*data, Image::ScopeType::Vectorscope, options);
+                DJV_ASSERT(255 == image->getData(1, 1)[3]);
+                DJV_ASSERT(0 == image->getData(0, 0)[3]);
+            }
+            {
+                // Blue is to the right and red is at the top.
+                auto data = Image::Data::create(Image::Info(2, 1, Image::Type::RGB_U8));
+                const uint8_t values[] = { 0, 0, 255, 255, 0, 0 };
+                memcpy(data->getData(), values, sizeof(values));
+                Image::ScopeOptions options;
+                options.size = Image::Size(5, 5);
+                const auto image = Image::scope(*data, Image::ScopeType::Vectorscope, options);
+                uint16_t blueX = 0;
+                uint16_t redY = 4;
+                for (uint16_t y = 0; y < 5; ++y)
+                {
+                    for (uint16_t x = 0; x < 5; ++x)
+                    {
+                        const uint8_t* p = image->getData(x, y);
+                        if (p[3] && p[2] > p[0])
+                        {
+                            blueX = x;
+                        }
+                        else if (p[3] && p[0] > p[2])
+                        {
+                            redY = y;
+                        }
+                    }
+                }
+                DJV_ASSERT(blueX > 2);
+                DJV_ASSERT(redY < 2);
+            }
+        }
+
+        void ImageScopeTest::_float()
+        {
+            for (auto type : { Image::Type::L_F16, Image::Type::L_F32, Image::Type::L_U16, Image::Type::L_U32 })
+            {
+                auto data = Image::Data::create(Image::Info(5, 1, type));
+                const float values[] = { -1.F, 0.F, 1.F, 10.F, std::numeric_limits<float>::quiet_NaN() };
+                auto f32 = Image::Data::create(Image::Info(5, 1, Image::Type::L_F32));
+                memcpy(f32->getData(), values, sizeof(values));
+                Image::convert(*f32, *data);
+                Image::ScopeOptions options;
+                options.size = Image::Size(1, 4);
+                const auto image = Image::scope(*data, Image::ScopeType::Waveform, options);
+                // Out of range values are clamped to the top or bottom.
+                DJV_ASSERT(image->getData(0, 0)[3] > 0);
+                DJV_ASSERT(image->getData(0, 3)[3] > 0);
+                DJV_ASSERT(0 == image->getData(0, 1)[3]);
+                DJV_ASSERT(0 == image->getData(0, 2)[3]);
+            }
+            {
+                // Large images are counted in parallel.
+                auto data = Image::Data::create(Image::Info(1024, 1024, Image::Type::RGBA_F32));
+                float* p = reinterpret_cast<float*>(data->getData());
+                for (size_t i = 0; i < 1024 * 1024; ++i, p += 4)
+                {
+                    p[0] = p[1] = p[2] = (i % 1024) < 512 ? 0.F : 1.F;
+                    p[3] = 1.F;
+                }
+                Image::ScopeOptions options;
+                options.size = Image::Size(2, 2);
+                const auto image = Image::scope(*data, Image::ScopeType::Waveform, options);
+                DJV_ASSERT(255 == image->getData(0, 1)[3]);
+                DJV_ASSERT(255 == image->getData(1, 0)[3]);
+                DJV_ASSERT(0 == image->getData(0, 0)[3]);
+                DJV_ASSERT(0 == image->getData(1, 1)[3]);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class ImageScopeTest : public Test::ITest
+        {
+        public:
+            ImageScopeTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _options();
+            void _waveform();
+            void _parade();
+            void _vectorscope();
+            void _float();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
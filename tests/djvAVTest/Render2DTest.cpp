@@ -13,6 +13,11 @@
 #include <djvCore/Context.h>
 #include <djvCore/Timer.h>
 
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
+#include <cstring>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -20,6 +25,18 @@ namespace djv
 {
     namespace AVTest
     {
+        namespace
+        {
+            Image::Color getPixel(const Image::Size& size, int x, int y)
+            {
+                uint8_t data[4] = { 0, 0, 0, 0 };
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glReadPixels(x, size.h - 1 - y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                return Image::Color(data[0], data[1], data[2], data[3]);
+            }
+
+        } // namespace
+
         Render2DTest::Render2DTest(const std::shared_ptr<Core::Context>& context) :
             ITest("djv::AVTest::Render2DTest", context)
         {}
@@ -28,6 +45,8 @@ namespace djv
         {
             _operators();
             _system();
+            _drawList();
+            _batches();
         }
         
         void Render2DTest::_system()
@@ -112,6 +131,121 @@ namespace djv
             }
         }
 
+        void Render2DTest::_drawList()
+        {
+            if (auto context = getContext().lock())
+            {
+                const Image::Size size(64, 64);
+                auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(size, AV::Image::Type::RGBA_U8);
+                offscreenBuffer->bind();
+                auto render = context->getSystemT<AV::Render2D::Render>();
+                auto image = Image::Image::create(Image::Info(8, 8, AV::Image::Type::RGBA_U8));
+                memset(image->getData(), 255, image->getDataByteCount());
+
+                // Record under a transform; the transform is only applied
+                // when the list is drawn.
+                render->beginFrame(size);
+                render->pushTransform(glm::translate(glm::mat3x3(1.F), glm::vec2(16.F, 16.F)));
+                render->beginDrawList();
+                render->setFillColor(Image::Color(1.F, 0.F, 0.F));
+                render->drawRect(BBox2f(0.F, 0.F, 8.F, 8.F));
+                render->setFillColor(Image::Color(1.F, 1.F, 1.F));
+                render->drawImage(image, glm::vec2(8.F, 0.F));
+                auto drawList = render->endDrawList();
+                DJV_ASSERT(2 == drawList->getPrimitivesCount());
+                DJV_ASSERT(10 == drawList->getVertexCount());
+                DJV_ASSERT(BBox2f(0.F, 0.F, 16.F, 8.F) == drawList->getBBox());
+                DJV_ASSERT(render->drawList(drawList));
+                render->popTransform();
+                render->endFrame();
+                DJV_ASSERT(2 == render->getPrimitivesCount());
+                DJV_ASSERT(Image::Color(255, 0, 0, 255) == getPixel(size, 20, 20));
+                DJV_ASSERT(Image::Color(255, 255, 255, 255) == getPixel(size, 28, 20));
+                DJV_ASSERT(Image::Color(0, 0, 0, 0) == getPixel(size, 4, 4));
+                DJV_ASSERT(Image::Color(0, 0, 0, 0) == getPixel(size, 44, 36));
+
+                // The list can be drawn again in later frames.
+                render->beginFrame(size);
+                DJV_ASSERT(render->drawList(drawList));
+                render->endFrame();
+                DJV_ASSERT(2 == render->getPrimitivesCount());
+                DJV_ASSERT(Image::Color(255, 0, 0, 255) == getPixel(size, 4, 4));
+
+                // Lists that use textures that are no longer available need
+                // to be recorded again.
+                const auto imageFilterOptions = render->getImageFilterOptions();
+                render->beginFrame(size);
+                render->beginDrawList();
+                Render2D::ImageOptions options;
+                options.cache = Render2D::ImageCache::Dynamic;
+                render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                drawList = render->endDrawList();
+                DJV_ASSERT(1 == drawList->getPrimitivesCount());
+                render->endFrame();
+                render->setImageFilterOptions(Render2D::ImageFilterOptions(
+                    Render2D::ImageFilter::Nearest,
+                    Render2D::ImageFilter::Nearest));
+                render->beginFrame(size);
+                DJV_ASSERT(!render->drawList(drawList));
+                render->endFrame();
+                DJV_ASSERT(0 == render->getPrimitivesCount());
+                render->setImageFilterOptions(imageFilterOptions);
+
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            }
+        }
+
+        void Render2DTest::_batches()
+        {
+            if (auto context = getContext().lock())
+            {
+                const Image::Size size(64, 64);
+                auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(size, AV::Image::Type::RGBA_U8);
+                offscreenBuffer->bind();
+                auto render = context->getSystemT<AV::Render2D::Render>();
+                const Image::Color red(1.F, 0.F, 0.F);
+                const Image::Color green(0.F, 1.F, 0.F);
+
+                // Primitives that don't overlap are grouped by state.
+                render->beginFrame(size);
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    render->setFillColor(0 == i % 2 ? red : green);
+                    render->drawRect(BBox2f(i * 8.F, 0.F, 4.F, 4.F));
+                }
+                render->endFrame();
+                DJV_ASSERT(8 == render->getPrimitivesCount());
+                DJV_ASSERT(2 == render->getDrawCallsCount());
+                DJV_ASSERT(render->getStateChangesCount() < render->getPrimitivesCount());
+                DJV_ASSERT(Image::Color(255, 0, 0, 255) == getPixel(size, 2, 2));
+                DJV_ASSERT(Image::Color(0, 255, 0, 255) == getPixel(size, 10, 2));
+
+                // Primitives that overlap are drawn in order.
+                render->beginFrame(size);
+                render->setFillColor(red);
+                render->drawRect(BBox2f(0.F, 0.F, 16.F, 16.F));
+                render->setFillColor(green);
+                render->drawRect(BBox2f(8.F, 8.F, 16.F, 16.F));
+                render->setFillColor(red);
+                render->drawRect(BBox2f(40.F, 40.F, 8.F, 8.F));
+                render->setFillColor(green);
+                render->drawRect(BBox2f(40.F, 0.F, 8.F, 8.F));
+                render->setFillColor(red);
+                render->drawRect(BBox2f(12.F, 12.F, 4.F, 4.F));
+                render->endFrame();
+                DJV_ASSERT(5 == render->getPrimitivesCount());
+                DJV_ASSERT(3 == render->getDrawCallsCount());
+                DJV_ASSERT(Image::Color(255, 0, 0, 255) == getPixel(size, 4, 4));
+                DJV_ASSERT(Image::Color(0, 255, 0, 255) == getPixel(size, 10, 10));
+                DJV_ASSERT(Image::Color(255, 0, 0, 255) == getPixel(size, 14, 14));
+                DJV_ASSERT(Image::Color(0, 255, 0, 255) == getPixel(size, 20, 20));
+                DJV_ASSERT(Image::Color(255, 0, 0, 255) == getPixel(size, 44, 44));
+                DJV_ASSERT(Image::Color(0, 255, 0, 255) == getPixel(size, 44, 4));
+
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            }
+        }
+
         void Render2DTest::_operators()
         {
             {
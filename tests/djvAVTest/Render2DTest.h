@@ -17,6 +17,8 @@ namespace djv
             
         private:
             void _system();
+            void _drawList();
+            void _batches();
             void _operators();
         };
         
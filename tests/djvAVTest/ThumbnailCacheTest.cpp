@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ThumbnailCacheTest.h>
+
+#include <djvAV/IO.h>
+#include <djvAV/ThumbnailCache.h>
+
+#include <djvCore/FileInfo.h>
+#include <djvCore/Path.h>
+
+#include <cstring>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            const std::string cachePath = "ThumbnailCacheTestDir";
+
+            std::shared_ptr<Image::Image> createImage(uint8_t value)
+            {
+                auto out = Image::Image::create(Image::Info(16, 8, Image::Type::RGBA_U8));
+                memset(out->getData(), value, out->getDataByteCount());
+                out->setPluginName("plugin");
+                Tags tags;
+                tags.setTag("key", "value");
+                out->setTags(tags);
+                return out;
+            }
+
+        } // namespace
+
+        ThumbnailCacheTest::ThumbnailCacheTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ThumbnailCacheTest", context)
+        {}
+        
+        void ThumbnailCacheTest::run()
+        {
+            _info();
+            _image();
+            _prune();
+            _index();
+
+            // Remove the index written when the last cache was destroyed, and
+            // the cache directory.
+            const FileSystem::Path indexPath(cachePath, "index.djvthumbnailindex");
+            if (FileSystem::FileInfo(indexPath).doesExist())
+            {
+                FileSystem::Path::rm(indexPath);
+            }
+            FileSystem::Path::rmdir(FileSystem::Path(cachePath));
+        }
+
+        void ThumbnailCacheTest::_info()
+        {
+            auto cache = ThumbnailCache::create(FileSystem::Path(cachePath), 1024 * 1024);
+            cache->clear();
+            DJV_ASSERT(FileSystem::Path(cachePath) == cache->getPath());
+            DJV_ASSERT(1024 * 1024 == cache->getMaxByteCount());
+            DJV_ASSERT(0 == cache->getCount());
+
+            IO::Info info;
+            info.fileName = "render.#.exr";
+            info.videoSpeed = Math::Rational(24000, 1001);
+            info.videoSequence = Frame::Sequence(Frame::Range(1, 100), 4);
+            info.video.push_back(Image::Info(1920, 1080, Image::Type::RGBA_F16));
+            info.audio = Audio::Info(2, Audio::Type::F32, 48000, 123456);
+            info.tags.setTag("Camera", "A");
+            cache->addInfo("key", info);
+            DJV_ASSERT(1 == cache->getCount());
+            DJV_ASSERT(cache->getByteCount() > 0);
+
+            IO::Info info2;
+            DJV_ASSERT(cache->getInfo("key", info2));
+            DJV_ASSERT(info == info2);
+
+            // Keys that do not match are not found.
+            DJV_ASSERT(!cache->getInfo("key2", info2));
+            DJV_ASSERT(!cache->getImage("key"));
+        }
+
+        void ThumbnailCacheTest::_image()
+        {
+            auto cache = ThumbnailCache::create(FileSystem::Path(cachePath), 1024 * 1024);
+            cache->clear();
+            auto image = createImage(1);
+            cache->addImage("key", image);
+            auto image2 = cache->getImage("key");
+            DJV_ASSERT(image2);
+            DJV_ASSERT(image->getInfo() == image2->getInfo());
+            DJV_ASSERT(image->getPluginName() == image2->getPluginName());
+            DJV_ASSERT(image->getTags() == image2->getTags());
+            DJV_ASSERT(0 == memcmp(image->getData(), image2->getData(), image->getDataByteCount()));
+
+            // Replace the entry.
+            cache->addImage("key", createImage(2));
+            DJV_ASSERT(1 == cache->getCount());
+            image2 = cache->getImage("key");
+            DJV_ASSERT(image2);
+            DJV_ASSERT(2 == image2->getData()[0]);
+
+            // Entries that cannot be read are removed.
+            FileSystem::DirectoryListOptions options;
+            options.fileExtensions.insert(".djvthumbnail");
+            const auto fileInfoList = FileSystem::FileInfo::directoryList(FileSystem::Path(cachePath), options);
+            DJV_ASSERT(1 == fileInfoList.size());
+            FileSystem::Path::rm(fileInfoList[0].getPath());
+            DJV_ASSERT(!cache->getImage("key"));
+            DJV_ASSERT(0 == cache->getCount());
+            DJV_ASSERT(0 == cache->getByteCount());
+        }
+
+        void ThumbnailCacheTest::_prune()
+        {
+            auto cache = ThumbnailCache::create(FileSystem::Path(cachePath), 1024 * 1024);
+            cache->clear();
+            cache->addImage("0", createImage(0));
+            const size_t byteCount = cache->getByteCount();
+            cache->writeIndex();
+            cache = ThumbnailCache::create(FileSystem::Path(cachePath), byteCount * 3);
+            cache->addImage("1", createImage(1));
+            cache->addImage("2", createImage(2));
+            DJV_ASSERT(3 == cache->getCount());
+
+            // Adding another entry removes the least recently used entry.
+            DJV_ASSERT(cache->getImage("0"));
+            cache->addImage("3", createImage(3));
+            DJV_ASSERT(cache->getByteCount() <= cache->getMaxByteCount());
+            DJV_ASSERT(cache->getImage("0"));
+            DJV_ASSERT(!cache->getImage("1"));
+            DJV_ASSERT(cache->getImage("3"));
+        }
+
+        void ThumbnailCacheTest::_index()
+        {
+            size_t count = 0;
+            size_t byteCount = 0;
+            {
+                auto cache = ThumbnailCache::create(FileSystem::Path(cachePath), 1024 * 1024);
+                cache->clear();
+                cache->addImage("0", createImage(0));
+                cache->addImage("1", createImage(1));
+                count = cache->getCount();
+                byteCount = cache->getByteCount();
+            }
+            {
+                // The index is read when the cache is created again.
+                auto cache = ThumbnailCache::create(FileSystem::Path(cachePath), 1024 * 1024);
+                DJV_ASSERT(count == cache->getCount());
+                DJV_ASSERT(byteCount == cache->getByteCount());
+                DJV_ASSERT(cache->getImage("1"));
+            }
+            {
+                // The index is created from the entries if it is missing.
+                FileSystem::Path::rm(FileSystem::Path(cachePath, "index.djvthumbnailindex"));
+                auto cache = ThumbnailCache::create(FileSystem::Path(cachePath), 1024 * 1024);
+                DJV_ASSERT(count == cache->getCount());
+                DJV_ASSERT(byteCount == cache->getByteCount());
+                DJV_ASSERT(cache->getImage("0"));
+                cache->clear();
+                DJV_ASSERT(0 == cache->getCount());
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class ThumbnailCacheTest : public Test::ITest
+        {
+        public:
+            ThumbnailCacheTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _info();
+            void _image();
+            void _prune();
+            void _index();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
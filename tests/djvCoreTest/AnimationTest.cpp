@@ -35,6 +35,7 @@ namespace djv
             
             if (auto context = getContext().lock())
             {
+                auto system = context->getSystemT<Animation::System>();
                 for (auto i : Animation::getTypeEnums())
                 {
                     auto animation = Animation::Animation::create(context);
@@ -62,11 +63,13 @@ namespace djv
                             _print(ss.str());
                         });
                     DJV_ASSERT(animation->isActive());
+                    DJV_ASSERT(system->isActive());
                     
                     _tickFor(std::chrono::milliseconds(250));
                     
                     animation->stop();
                     DJV_ASSERT(!animation->isActive());
+                    DJV_ASSERT(!system->isActive());
                 }
             }
         }
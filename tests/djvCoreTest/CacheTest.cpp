@@ -6,12 +6,105 @@
 
 #include <djvCore/Cache.h>
 
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace CoreTest
     {
+        namespace
+        {
+            //! The previous cache implementation, kept for comparison in the
+            //! benchmark. Evicting entries sorts every entry by use.
+            template<typename T, typename U>
+            class LegacyCache
+            {
+            public:
+                void setMax(size_t value)
+                {
+                    _max = value;
+                    _maxUpdate();
+                }
+
+                bool get(const T& key, U& value) const
+                {
+                    auto i = _map.find(key);
+                    if (i != _map.end())
+                    {
+                        value = i->second;
+                        auto j = _counts.find(key);
+                        if (j != _counts.end())
+                        {
+                            ++_counter;
+                            j->second = _counter;
+                        }
+                        return true;
+                    }
+                    return false;
+                }
+
+                void add(const T& key, const U& value)
+                {
+                    _map[key] = value;
+                    ++_counter;
+                    _counts[key] = _counter;
+                    _maxUpdate();
+                }
+
+            private:
+                void _maxUpdate()
+                {
+                    if (_map.size() > _max)
+                    {
+                        std::map<int64_t, T> sorted;
+                        for (const auto& i : _counts)
+                        {
+                            sorted[i.second] = i.first;
+                        }
+                        while (_map.size() > _max)
+                        {
+                            auto begin = sorted.begin();
+                            _map.erase(begin->second);
+                            _counts.erase(begin->second);
+                            sorted.erase(begin);
+                        }
+                    }
+                }
+
+                size_t _max = 10000;
+                std::map<T, U> _map;
+                mutable std::map<T, int64_t> _counts;
+                mutable int64_t _counter = 0;
+            };
+
+            template<typename C>
+            float benchmark(C& cache, size_t size, size_t count)
+            {
+                cache.setMax(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    cache.add(static_cast<int>(i), static_cast<int>(i));
+                }
+                const auto start = std::chrono::steady_clock::now();
+                int value = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    // Touch an existing entry and then overflow the cache.
+                    cache.get(static_cast<int>(size + i - size / 2), value);
+                    cache.add(static_cast<int>(size + i), static_cast<int>(i));
+                }
+                const auto end = std::chrono::steady_clock::now();
+                const std::chrono::duration<float, std::micro> delta = end - start;
+                return delta.count() / static_cast<float>(count);
+            }
+
+        } // namespace
+
         CacheTest::CacheTest(const std::shared_ptr<Core::Context>& context) :
             ITest("djv::CoreTest::CacheTest", context)
         {}
@@ -41,8 +134,133 @@ namespace djv
                 DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
                 DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "b", "c" }));
             }
+
+            _lru();
+            _byteCount();
+            _sharded();
+            _benchmark();
+        }
+
+        void CacheTest::_lru()
+        {
+            Memory::Cache<int, std::string> cache;
+            cache.setMax(3);
+            cache.add(1, "a");
+            cache.add(2, "b");
+            cache.add(3, "c");
+            std::string value;
+            DJV_ASSERT(cache.get(1, value));
+            cache.add(4, "d");
+            DJV_ASSERT(cache.contains(1));
+            DJV_ASSERT(!cache.contains(2));
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 1, 3, 4 }));
+
+            cache.add(3, "C");
+            cache.add(5, "e");
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 3, 4, 5 }));
+            DJV_ASSERT(cache.get(3, value));
+            DJV_ASSERT("C" == value);
+
+            cache.remove(4);
+            DJV_ASSERT(2 == cache.getSize());
+            cache.setMax(1);
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 3 }));
+            cache.clear();
+            DJV_ASSERT(0 == cache.getSize());
+        }
+
+        void CacheTest::_byteCount()
+        {
+            Memory::Cache<int, std::string> cache;
+            cache.setMaxByteCount(10);
+            cache.add(1, "a", 4);
+            cache.add(2, "b", 4);
+            DJV_ASSERT(8 == cache.getByteCount());
+            DJV_ASSERT(80.F == cache.getPercentageUsed());
+            cache.add(3, "c", 4);
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
+            DJV_ASSERT(8 == cache.getByteCount());
+
+            cache.add(2, "B", 1);
+            DJV_ASSERT(5 == cache.getByteCount());
+            cache.add(4, "d", 9);
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 4 }));
+            DJV_ASSERT(10 == cache.getByteCount());
+
+            cache.remove(2);
+            cache.remove(4);
+            DJV_ASSERT(0 == cache.getByteCount());
+            cache.add(5, "e", 20);
+            DJV_ASSERT(0 == cache.getSize());
+            DJV_ASSERT(0 == cache.getByteCount());
+        }
+
+        void CacheTest::_sharded()
+        {
+            {
+                Memory::ShardedCache<int, int> cache(4);
+                cache.setMax(100);
+                for (int i = 0; i < 100; ++i)
+                {
+                    cache.add(i, i * 2, 1);
+                }
+                DJV_ASSERT(cache.getSize() <= 100);
+                DJV_ASSERT(cache.getByteCount() == cache.getSize());
+                int value = 0;
+                DJV_ASSERT(cache.get(99, value));
+                DJV_ASSERT(198 == value);
+                cache.remove(99);
+                DJV_ASSERT(!cache.contains(99));
+                cache.clear();
+                DJV_ASSERT(0 == cache.getSize());
+            }
+
+            {
+                Memory::ShardedCache<int, int> cache;
+                cache.setMax(1000);
+                std::vector<std::thread> threads;
+                for (int i = 0; i < 4; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [&cache, i]
+                        {
+                            for (int j = 0; j < 10000; ++j)
+                            {
+                                const int key = (i * 10000 + j) % 2000;
+                                int value = 0;
+                                if (!cache.get(key, value))
+                                {
+                                    cache.add(key, key);
+                                }
+                                else
+                                {
+                                    DJV_ASSERT(key == value);
+                                }
+                            }
+                        }));
+                }
+                for (auto& i : threads)
+                {
+                    i.join();
+                }
+                DJV_ASSERT(cache.getSize() <= 1000 + 16);
+            }
+        }
+
+        void CacheTest::_benchmark()
+        {
+            for (const size_t size : { 10000, 100000 })
+            {
+                LegacyCache<int, int> legacyCache;
+                Memory::Cache<int, int> cache;
+                const float legacyTime = benchmark(legacyCache, size, 10);
+                const float time = benchmark(cache, size, size);
+                std::stringstream ss;
+                ss << "Cache benchmark (" << size << " entries): legacy " <<
+                    legacyTime << "us, LRU " << time << "us per operation";
+                _print(ss.str());
+            }
         }
         
     } // namespace CoreTest
 } // namespace djv
-
@@ -16,6 +16,12 @@ namespace djv
             CacheTest(const std::shared_ptr<Core::Context>&);
             
             void run() override;
+
+        private:
+            void _lru();
+            void _byteCount();
+            void _sharded();
+            void _benchmark();
         };
         
     } // namespace CoreTest
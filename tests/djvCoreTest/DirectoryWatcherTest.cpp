@@ -33,6 +33,12 @@ namespace djv
                     {
                         changed = true;
                     });
+                std::vector<FileSystem::DirectoryWatcher::Change> changes;
+                watcher->setChangesCallback(
+                    [&changes](const std::vector<FileSystem::DirectoryWatcher::Change>& value)
+                    {
+                        changes.insert(changes.end(), value.begin(), value.end());
+                    });
                 
                 _tickFor(std::chrono::milliseconds(1000));
                 
@@ -44,9 +50,17 @@ namespace djv
                 
                 _tickFor(std::chrono::milliseconds(1000));
                 
-                std::stringstream ss;
-                ss << "changed: " << changed;
-                _print(ss.str());
+                {
+                    std::stringstream ss;
+                    ss << "changed: " << changed;
+                    _print(ss.str());
+                }
+                for (const auto& i : changes)
+                {
+                    std::stringstream ss;
+                    ss << "change: " << static_cast<int>(i.type) << " " << i.fileName;
+                    _print(ss.str());
+                }
             }
         }
         
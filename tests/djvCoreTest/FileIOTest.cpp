@@ -27,6 +27,7 @@ namespace djv
             _error();
             _endian();
             _temp();
+            _memoryMap();
         }
 
         void FileIOTest::_io()
@@ -238,7 +239,53 @@ namespace djv
                 io->writeU8(i);
             }
         }
+
+        void FileIOTest::_memoryMap()
+        {
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(_fileName, FileSystem::FileIO::Mode::Write);
+                io->write(_text + " " + _text2);
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(_fileName, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT(!io->isMemoryMapped());
+                DJV_ASSERT(!io->mmapP());
+
+                io->open(_fileName, FileSystem::FileIO::Mode::Read, true);
+                DJV_ASSERT(io->isOpen());
+                DJV_ASSERT(io->isMemoryMapped());
+                DJV_ASSERT(io->mmapEnd() - io->mmapP() == static_cast<int64_t>(io->getSize()));
+                char buf[String::cStringLength] = "";
+                io->read(buf, _text.size());
+                DJV_ASSERT(_text == std::string(buf, _text.size()));
+                io->seek(1);
+                DJV_ASSERT(_text2 == std::string(reinterpret_cast<const char*>(io->mmapP()), _text2.size()));
+                io->setPos(0);
+                DJV_ASSERT(FileSystem::FileIO::readContents(io) == _text + " " + _text2);
+                try
+                {
+                    io->setPos(io->getSize() + 1);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(e.what());
+                }
+
+                io->close();
+                DJV_ASSERT(!io->isOpen());
+                DJV_ASSERT(!io->isMemoryMapped());
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(_fileName, FileSystem::FileIO::Mode::ReadWrite, true);
+                DJV_ASSERT(!io->isMemoryMapped());
+            }
+        }
         
     } // namespace CoreTest
 } // namespace djv
-
@@ -22,6 +22,7 @@ namespace djv
             void _error();
             void _endian();
             void _temp();
+            void _memoryMap();
 
             std::string _fileName;
             std::string _text;
@@ -7,7 +7,9 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileInfo.h>
 
+#include <cstdio>
 #include <iomanip>
+#include <map>
 
 using namespace djv::Core;
 
@@ -28,6 +30,8 @@ namespace djv
             _path();
             _sequences();
             _util();
+            _directoryList();
+            _directoryListUpdate();
             _operators();
             _serialize();
         }
@@ -249,6 +253,10 @@ namespace djv
                 ss << "file sequence: " << fileInfo;
                 _print(ss.str());
                 DJV_ASSERT(fileInfo.getFileName(Frame::invalid, false) == "render.1-3.exr");
+                for (const auto& i : fileNames)
+                {
+                    FileSystem::Path::rm(FileSystem::Path(path, i));
+                }
             }
             
             {
@@ -258,6 +266,170 @@ namespace djv
             }
         }
 
+        void FileInfoTest::_directoryList()
+        {
+            const FileSystem::Path path("FileInfoTestDir");
+            if (!FileSystem::FileInfo(path).doesExist())
+            {
+                FileSystem::Path::mkdir(path);
+            }
+            const std::vector<std::string> fileNames =
+            {
+                "shot.0003.exr",
+                "shot.0001.exr",
+                "shot.0010.exr",
+                "shot.0002.exr",
+                "shot.0012.EXR",
+                "shot.0011.exr",
+                "matte.5.exr",
+                "matte.1.exr",
+                "single.7.exr",
+                "render.1.png",
+                "render.2.png",
+                "notes.txt",
+                ".hidden.1.exr"
+            };
+            for (const auto& i : fileNames)
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(FileSystem::Path(path, i).get(), FileSystem::FileIO::Mode::Write);
+                io->writeU8(0);
+            }
+
+            {
+                FileSystem::DirectoryListOptions options;
+                options.fileSequences = true;
+                options.fileSequenceExtensions = { ".exr" };
+                const auto list = FileSystem::FileInfo::directoryList(path, options);
+                std::vector<std::string> names;
+                for (const auto& i : list)
+                {
+                    names.push_back(i.getFileName(Frame::invalid, false));
+                    _print("directory list: " + names.back());
+                }
+                const std::vector<std::string> result =
+                {
+                    "matte.1,5.exr",
+                    "notes.txt",
+                    "render.1.png",
+                    "render.2.png",
+                    "shot.0001-0003,0010-0011.exr",
+                    "shot.0012.EXR",
+                    "single.7.exr"
+                };
+                DJV_ASSERT(result == names);
+                DJV_ASSERT(FileSystem::FileType::Sequence == list[4].getType());
+                DJV_ASSERT(5 == list[4].getSize());
+                DJV_ASSERT(FileSystem::FileType::File == list[6].getType());
+            }
+
+            {
+                FileSystem::DirectoryListOptions options;
+                options.fileExtensions = { ".exr" };
+                options.showHidden = true;
+                options.filter = "shot";
+                const auto list = FileSystem::FileInfo::directoryList(path, options);
+                DJV_ASSERT(6 == list.size());
+                options.filter = "[";
+                DJV_ASSERT(FileSystem::FileInfo::directoryList(path, options).empty());
+                options.filter = std::string();
+                DJV_ASSERT(10 == FileSystem::FileInfo::directoryList(path, options).size());
+            }
+        }
+
+        void FileInfoTest::_directoryListUpdate()
+        {
+            const FileSystem::Path path("FileInfoTestDir");
+            FileSystem::DirectoryListOptions options;
+            options.fileSequences = true;
+            options.fileSequenceExtensions = { ".exr" };
+            std::map<std::string, uint64_t> frameSizes;
+            auto list = FileSystem::FileInfo::directoryList(path, options, &frameSizes);
+            DJV_ASSERT(1 == frameSizes.count(FileSystem::Path(path, "shot.0001.exr").get()));
+            DJV_ASSERT(0 == frameSizes.count(FileSystem::Path(path, "single.7.exr").get()));
+            const auto getNames = [&list]
+            {
+                std::vector<std::string> out;
+                for (const auto& i : list)
+                {
+                    out.push_back(i.getFileName(Frame::invalid, false));
+                }
+                return out;
+            };
+
+            for (const auto& i : { "shot.0004.exr", "single.8.exr", "new.txt" })
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(FileSystem::Path(path, i).get(), FileSystem::FileIO::Mode::Write);
+                io->writeU8(0);
+            }
+            std::remove(FileSystem::Path(path, "shot.0002.exr").get().c_str());
+            std::remove(FileSystem::Path(path, "notes.txt").get().c_str());
+            FileSystem::FileInfo::directoryListUpdate(
+                list,
+                path,
+                { "shot.0004.exr", "shot.0002.exr", "single.8.exr", "new.txt", "notes.txt" },
+                options,
+                &frameSizes);
+            for (const auto& i : getNames())
+            {
+                _print("directory list update: " + i);
+            }
+            DJV_ASSERT(getNames() == std::vector<std::string>({
+                "matte.1,5.exr",
+                "new.txt",
+                "render.1.png",
+                "render.2.png",
+                "shot.0001,0003-0004,0010-0011.exr",
+                "shot.0012.EXR",
+                "single.7-8.exr" }));
+            DJV_ASSERT(5 == list[4].getSize());
+            DJV_ASSERT(FileSystem::FileType::Sequence == list[6].getType());
+
+            // Modifying a frame only updates the information for that frame.
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(FileSystem::Path(path, "shot.0004.exr").get(), FileSystem::FileIO::Mode::Write);
+                io->writeU8(0);
+                io->writeU8(0);
+                io->writeU8(0);
+            }
+            FileSystem::FileInfo::directoryListUpdate(list, path, { "shot.0004.exr" }, options, &frameSizes);
+            DJV_ASSERT("shot.0001,0003-0004,0010-0011.exr" == list[4].getFileName(Frame::invalid, false));
+            DJV_ASSERT(7 == list[4].getSize());
+
+            // The sizes of the frames from the directory listing are also known.
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(FileSystem::Path(path, "shot.0001.exr").get(), FileSystem::FileIO::Mode::Write);
+                io->writeU8(0);
+                io->writeU8(0);
+            }
+            FileSystem::FileInfo::directoryListUpdate(list, path, { "shot.0001.exr" }, options, &frameSizes);
+            DJV_ASSERT(8 == list[4].getSize());
+
+            std::remove(FileSystem::Path(path, "single.8.exr").get().c_str());
+            FileSystem::FileInfo::directoryListUpdate(list, path, { "single.8.exr" }, options);
+            DJV_ASSERT("single.7.exr" == list[6].getFileName(Frame::invalid, false));
+            DJV_ASSERT(FileSystem::FileType::File == list[6].getType());
+
+            std::vector<std::string> names;
+            for (const auto& i : FileSystem::FileInfo::directoryList(path, options))
+            {
+                names.push_back(i.getFileName(Frame::invalid, false));
+            }
+            DJV_ASSERT(getNames() == names);
+
+            // Remove the test directory.
+            FileSystem::DirectoryListOptions rmOptions;
+            rmOptions.showHidden = true;
+            for (const auto& i : FileSystem::FileInfo::directoryList(path, rmOptions))
+            {
+                FileSystem::Path::rm(i.getPath());
+            }
+            FileSystem::Path::rmdir(path);
+        }
+
         void FileInfoTest::_operators()
         {
             {
@@ -23,6 +23,8 @@ namespace djv
             void _path();
             void _sequences();
             void _util();
+            void _directoryList();
+            void _directoryListUpdate();
             void _operators();
             void _serialize();
 
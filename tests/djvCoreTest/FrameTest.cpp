@@ -84,6 +84,24 @@ namespace djv
                 sequence.add(Frame::Range(12, 100));
                 DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
             }
+
+            {
+                Frame::Sequence sequence(Frame::Range(1, 10));
+                sequence.remove(5);
+                DJV_ASSERT(2 == sequence.getRanges().size());
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 4));
+                DJV_ASSERT(sequence.getRanges()[1] == Frame::Range(6, 10));
+                sequence.remove(1);
+                sequence.remove(10);
+                sequence.remove(11);
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(2, 4));
+                DJV_ASSERT(sequence.getRanges()[1] == Frame::Range(6, 9));
+                sequence.remove(6);
+                sequence.remove(7);
+                sequence.remove(8);
+                sequence.remove(9);
+                DJV_ASSERT(1 == sequence.getRanges().size());
+            }
         }
         
         void FrameTest::_conversion()
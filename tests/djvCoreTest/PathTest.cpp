@@ -5,6 +5,8 @@
 #include <djvCoreTest/PathTest.h>
 
 #include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
 #include <djvCore/Path.h>
 
 using namespace djv::Core;
@@ -216,6 +218,24 @@ namespace djv
                 FileSystem::Path::rmdir(path);
             }
 
+            {
+                const FileSystem::Path path("foo");
+                auto io = FileSystem::FileIO::create();
+                io->open(path.get(), FileSystem::FileIO::Mode::Write);
+                io->close();
+                FileSystem::Path::rm(path);
+                DJV_ASSERT(!FileSystem::FileInfo(path).doesExist());
+                try
+                {
+                    FileSystem::Path::rm(path);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(Error::format(e));
+                }
+            }
+
             {            
                 const FileSystem::Path path("foo");
                 try
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/TimerTest.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Timer.h>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        TimerTest::TimerTest(const std::shared_ptr<Core::Context>& context) :
+            ITickTest("djv::CoreTest::TimerTest", context)
+        {}
+        
+        void TimerTest::run()
+        {
+            _enum();
+            _timer();
+            _repeating();
+            _restart();
+            _deadline();
+        }
+
+        void TimerTest::_enum()
+        {
+            for (auto i : Time::getTimerValueEnums())
+            {
+                std::stringstream ss;
+                ss << "Timer value: " << Time::getValue(i);
+                _print(ss.str());
+                DJV_ASSERT(Time::getTime(i) > Time::Duration::zero());
+            }
+        }
+
+        void TimerTest::_timer()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto timer = Time::Timer::create(context);
+                DJV_ASSERT(!timer->isActive());
+                DJV_ASSERT(!timer->isRepeating());
+                size_t count = 0;
+                timer->start(
+                    Time::Duration::zero(),
+                    [&count](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        ++count;
+                    });
+                DJV_ASSERT(timer->isActive());
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(1 == count);
+                DJV_ASSERT(!timer->isActive());
+
+                timer->start(
+                    std::chrono::hours(1),
+                    [&count](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        ++count;
+                    });
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(1 == count);
+                timer->stop();
+                DJV_ASSERT(!timer->isActive());
+            }
+        }
+
+        void TimerTest::_repeating()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto timer = Time::Timer::create(context);
+                timer->setRepeating(true);
+                DJV_ASSERT(timer->isRepeating());
+                size_t count = 0;
+                timer->start(
+                    Time::Duration::zero(),
+                    [&count](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        ++count;
+                    });
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(count > 1);
+                DJV_ASSERT(timer->isActive());
+
+                timer->stop();
+                const size_t stopCount = count;
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(stopCount == count);
+            }
+        }
+
+        void TimerTest::_restart()
+        {
+            if (auto context = getContext().lock())
+            {
+                // Restarting a timer many times only leaves one active entry.
+                auto timer = Time::Timer::create(context);
+                size_t count = 0;
+                for (size_t i = 0; i < 5000; ++i)
+                {
+                    timer->start(
+                        Time::Duration::zero(),
+                        [&count](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                        {
+                            ++count;
+                        });
+                }
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(1 == count);
+
+                // Restarting a timer from the callback.
+                count = 0;
+                std::weak_ptr<Time::Timer> weak(timer);
+                std::function<void(const std::chrono::steady_clock::time_point&, const Time::Duration&)> callback;
+                callback = [&count, &callback, weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                {
+                    ++count;
+                    if (count < 3)
+                    {
+                        if (auto timer = weak.lock())
+                        {
+                            timer->start(Time::Duration::zero(), callback);
+                        }
+                    }
+                };
+                timer->start(Time::Duration::zero(), callback);
+                _tickFor(std::chrono::milliseconds(200));
+                DJV_ASSERT(3 == count);
+                DJV_ASSERT(!timer->isActive());
+            }
+        }
+
+        void TimerTest::_deadline()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto system = context->getSystemT<Time::TimerSystem>();
+                const auto time = std::chrono::steady_clock::now();
+                auto timer = Time::Timer::create(context);
+                timer->start(
+                    Time::Duration::zero(),
+                    [](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {});
+                DJV_ASSERT(system->getNextDeadline() <= std::chrono::steady_clock::now());
+                timer->stop();
+                context->tick();
+                DJV_ASSERT(system->getNextDeadline() > time);
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
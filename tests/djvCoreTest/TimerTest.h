@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/TickTest.h>
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        class TimerTest : public Test::ITickTest
+        {
+        public:
+            TimerTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _enum();
+            void _timer();
+            void _repeating();
+            void _restart();
+            void _deadline();
+        };
+        
+    } // namespace CoreTest
+} // namespace djv
@@ -32,12 +32,16 @@
 #include <djvCoreTest/StringTest.h>
 #include <djvCoreTest/TextSystemTest.h>
 #include <djvCoreTest/TimeTest.h>
+#include <djvCoreTest/TimerTest.h>
 #include <djvCoreTest/UndoStackTest.h>
 #include <djvCoreTest/ValueObserverTest.h>
 #include <djvCoreTest/VectorTest.h>
 
 #include <djvAVTest/AVSystemTest.h>
 #include <djvAVTest/AudioDataTest.h>
+#include <djvAVTest/AudioRingBufferTest.h>
+#include <djvAVTest/AudioTimeStretchTest.h>
+#include <djvAVTest/AudioWaveformTest.h>
 #include <djvAVTest/AudioTest.h>
 #include <djvAVTest/ColorTest.h>
 #include <djvAVTest/EnumTest.h>
@@ -45,11 +49,15 @@
 #include <djvAVTest/IOTest.h>
 #include <djvAVTest/ImageConvertTest.h>
 #include <djvAVTest/ImageDataTest.h>
+#include <djvAVTest/ImageHistogramTest.h>
+#include <djvAVTest/ImageResampleTest.h>
+#include <djvAVTest/ImageScopeTest.h>
 #include <djvAVTest/ImageTest.h>
 #include <djvAVTest/OCIOSystemTest.h>
 #include <djvAVTest/OCIOTest.h>
 #include <djvAVTest/PixelTest.h>
 #include <djvAVTest/Render2DTest.h>
+#include <djvAVTest/ThumbnailCacheTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TagsTest.h>
 
@@ -120,12 +128,16 @@ int main(int argc, char ** argv)
             tests.emplace_back(new CoreTest::StringTest(context));
             tests.emplace_back(new CoreTest::TextSystemTest(context));
             tests.emplace_back(new CoreTest::TimeTest(context));
+            tests.emplace_back(new CoreTest::TimerTest(context));
             tests.emplace_back(new CoreTest::UndoStackTest(context));
             tests.emplace_back(new CoreTest::ValueObserverTest(context));
             tests.emplace_back(new CoreTest::VectorTest(context));
 
             tests.emplace_back(new AVTest::AVSystemTest(context));
             tests.emplace_back(new AVTest::AudioDataTest(context));
+            tests.emplace_back(new AVTest::AudioRingBufferTest(context));
+            tests.emplace_back(new AVTest::AudioTimeStretchTest(context));
+            tests.emplace_back(new AVTest::AudioWaveformTest(context));
             tests.emplace_back(new AVTest::AudioTest(context));
             tests.emplace_back(new AVTest::ColorTest(context));
             tests.emplace_back(new AVTest::EnumTest(context));
@@ -133,11 +145,15 @@ int main(int argc, char ** argv)
             tests.emplace_back(new AVTest::IOTest(context));
             tests.emplace_back(new AVTest::ImageConvertTest(context));
             tests.emplace_back(new AVTest::ImageDataTest(context));
+            tests.emplace_back(new AVTest::ImageHistogramTest(context));
+            tests.emplace_back(new AVTest::ImageResampleTest(context));
+            tests.emplace_back(new AVTest::ImageScopeTest(context));
             tests.emplace_back(new AVTest::ImageTest(context));
             tests.emplace_back(new AVTest::OCIOSystemTest(context));
             tests.emplace_back(new AVTest::OCIOTest(context));
             tests.emplace_back(new AVTest::PixelTest(context));
             tests.emplace_back(new AVTest::Render2DTest(context));
+            tests.emplace_back(new AVTest::ThumbnailCacheTest(context));
             tests.emplace_back(new AVTest::ThumbnailSystemTest(context));
             tests.emplace_back(new AVTest::TagsTest(context));
 
@@ -15,10 +15,12 @@
 #include <djvUI/Label.h>
 #include <djvUI/LineEdit.h>
 #include <djvUI/ListButton.h>
+#include <djvUI/ListWidget.h>
 #include <djvUI/PushButton.h>
 #include <djvUI/ToggleButton.h>
 #include <djvUI/ToolButton.h>
 #include <djvUI/RowLayout.h>
+#include <djvUI/ScrollWidget.h>
 #include <djvUI/StackLayout.h>
 #include <djvUI/Window.h>
 
@@ -34,6 +36,41 @@ namespace djv
 {
     namespace UITest
     {
+        class CountWidget : public Widget
+        {
+            DJV_NON_COPYABLE(CountWidget);
+            void _init(const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+            }
+
+            CountWidget()
+            {}
+
+        public:
+            static std::shared_ptr<CountWidget> create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<CountWidget>(new CountWidget);
+                out->_init(context);
+                return out;
+            }
+
+            size_t preLayoutCount = 0;
+            size_t layoutCount = 0;
+
+        protected:
+            void _preLayoutEvent(Event::PreLayout&) override
+            {
+                ++preLayoutCount;
+                _setMinimumSize(glm::vec2(10.F, 10.F));
+            }
+
+            void _layoutEvent(Event::Layout&) override
+            {
+                ++layoutCount;
+            }
+        };
+
         class TestEventSystem : public EventSystem
         {
             DJV_NON_COPYABLE(TestEventSystem);
@@ -65,18 +102,23 @@ namespace djv
                 {
                     i->resize(size);
 
+                    Event::InitLayout initLayout;
+                    _initLayoutUpdate(i, initLayout);
+
                     Event::PreLayout preLayout;
-                    _preLayoutRecursive(i, preLayout);
+                    _preLayoutUpdate(i, preLayout);
 
                     if (i->isVisible())
                     {
                         Event::Layout layout;
-                        _layoutRecursive(i, layout);
+                        _layoutUpdate(i, layout);
 
                         Event::Clip clip(BBox2f(0.F, 0.F, size.x, size.y));
-                        _clipRecursive(i, clip);
+                        _clipUpdate(i, clip);
                     }
                 }
+                const auto rects = _getRedrawRects();
+                redrawRects.insert(redrawRects.end(), rects.begin(), rects.end());
                 
                 for (const auto & i : windows)
                 {
@@ -117,6 +159,8 @@ namespace djv
                 }
                 ++_tick;
             }
+
+            std::vector<BBox2f> redrawRects;
             
         protected:
             void _hover(const std::shared_ptr<IObject>& object, Core::Event::PointerMove& event, std::shared_ptr<Core::IObject>& hover)
@@ -222,6 +266,87 @@ namespace djv
                 window->show();
                     
                 _tickFor(std::chrono::milliseconds(1000));
+
+                // Only the widgets affected by a resize are laid out again.
+                auto countWidget = CountWidget::create(context);
+                auto countWidget2 = CountWidget::create(context);
+                auto countLayout = VerticalLayout::create(context);
+                countLayout->addChild(countWidget);
+                countLayout->addChild(countWidget2);
+                gridLayout->addChild(countLayout);
+                gridLayout->setGridPos(countLayout, 1, 1);
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(countWidget->preLayoutCount > 0);
+                DJV_ASSERT(countWidget->layoutCount > 0);
+                const size_t preLayoutCount = countWidget->preLayoutCount;
+                const size_t layoutCount = countWidget->layoutCount;
+                const size_t preLayoutCount2 = countWidget2->preLayoutCount;
+                countWidget2->setHAlign(HAlign::Left);
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(preLayoutCount == countWidget->preLayoutCount);
+                DJV_ASSERT(layoutCount == countWidget->layoutCount);
+                DJV_ASSERT(countWidget2->preLayoutCount > preLayoutCount2);
+
+                // Only the area of the widget is redrawn.
+                system->redrawRects.clear();
+                countWidget2->setBackgroundRole(ColorRole::Button);
+                _tickFor(std::chrono::milliseconds(100));
+                bool redraw = false;
+                for (const auto& i : system->redrawRects)
+                {
+                    redraw |= i.contains(countWidget2->getClipRect());
+                    DJV_ASSERT(!i.contains(countWidget->getClipRect()));
+                    DJV_ASSERT(!i.contains(window->getGeometry()));
+                }
+                DJV_ASSERT(redraw);
+
+                // Only the visible rows of a list widget have buttons.
+                auto listWidget = ListWidget::create(ButtonType::Radio, context);
+                std::vector<std::string> items;
+                for (size_t i = 0; i < 1000; ++i)
+                {
+                    items.push_back(std::to_string(i));
+                }
+                listWidget->setItems(items);
+                DJV_ASSERT(0 == listWidget->getChecked());
+                listWidget->setChecked(500);
+                DJV_ASSERT(500 == listWidget->getChecked());
+                auto scrollWidget = ScrollWidget::create(ScrollType::Vertical, context);
+                scrollWidget->addChild(listWidget);
+                gridLayout->addChild(scrollWidget);
+                gridLayout->setGridPos(scrollWidget, 2, 1);
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(listWidget->getChildWidgets().size() < items.size());
+                listWidget->setFilter("99");
+                _tickFor(std::chrono::milliseconds(100));
+                DJV_ASSERT(500 == listWidget->getChecked());
+
+                // Scrolling rebinds the buttons to the visible items, and the
+                // keyboard focus does not stay with a rebound button.
+                listWidget->setFilter(std::string());
+                scrollWidget->moveToBegin();
+                _tickFor(std::chrono::milliseconds(100));
+                std::shared_ptr<ListButton> focusButton;
+                for (const auto& i : listWidget->getChildrenT<ListButton>())
+                {
+                    if (i->isVisible() && "0" == i->getText())
+                    {
+                        focusButton = i;
+                    }
+                }
+                DJV_ASSERT(focusButton);
+                focusButton->takeTextFocus();
+                DJV_ASSERT(focusButton->hasTextFocus());
+                scrollWidget->moveToEnd();
+                _tickFor(std::chrono::milliseconds(100));
+                bool visible = false;
+                for (const auto& i : listWidget->getChildrenT<ListButton>())
+                {
+                    visible |= i->isVisible() && "999" == i->getText();
+                }
+                DJV_ASSERT(visible);
+                DJV_ASSERT(!focusButton->hasTextFocus());
+                DJV_ASSERT(listWidget->getChildWidgets().size() < items.size());
                     
                 window->close();
             }